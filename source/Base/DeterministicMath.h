@@ -0,0 +1,24 @@
+#pragma once
+
+#include <math.h>
+
+#include "HostDeviceFunctions.h"
+
+/**
+ * Helpers for the deterministic simulation mode. The result of floating point atomics depends on the order in
+ * which threads arrive since every addition is rounded. Values snapped to a grid of 2^-fractionBits are added
+ * without rounding as long as the sums stay below 2^(24 - fractionBits), hence in any order to the same result.
+ */
+class DeterministicMath
+{
+public:
+    static constexpr int EnergyFractionBits = 8;            //exact below 65536
+    static constexpr int VelocityFractionBits = 16;         //exact below 256
+    static constexpr int AngularVelocityFractionBits = 12;  //exact below 4096
+
+    HOST_DEVICE_FUNCTION static float snapToGrid(float value, int fractionBits)
+    {
+        auto const scale = static_cast<float>(1 << fractionBits);
+        return rintf(value * scale) / scale;
+    }
+};
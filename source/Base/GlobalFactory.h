@@ -8,4 +8,8 @@ public:
 	virtual ~GlobalFactory() = default;
 
 	virtual NumberGenerator* buildRandomNumberGenerator() const = 0;
+
+	//seed for all number generators built afterwards (host and GPU), random by default
+	virtual void setRandomSeed(uint64_t seed) = 0;
+	virtual uint64_t getRandomSeed() const = 0;
 };
@@ -1,3 +1,5 @@
+#include <QRandomGenerator>
+
 #include "ServiceLocator.h"
 
 #include "GlobalFactoryImpl.h"
@@ -8,11 +10,22 @@ namespace {
 }
 
 GlobalFactoryImpl::GlobalFactoryImpl()
+	: _randomSeed(QRandomGenerator::global()->generate64())
 {
 	ServiceLocator::getInstance().registerService<GlobalFactory>(this);
 }
 
 NumberGenerator * GlobalFactoryImpl::buildRandomNumberGenerator() const
 {
-	return new NumberGeneratorImpl();
+	return new NumberGeneratorImpl(_randomSeed);
+}
+
+void GlobalFactoryImpl::setRandomSeed(uint64_t seed)
+{
+	_randomSeed = seed;
+}
+
+uint64_t GlobalFactoryImpl::getRandomSeed() const
+{
+	return _randomSeed;
 }
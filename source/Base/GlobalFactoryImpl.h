@@ -10,4 +10,10 @@ public:
 	virtual ~GlobalFactoryImpl() = default;
 
 	virtual NumberGenerator* buildRandomNumberGenerator() const override;
+
+	virtual void setRandomSeed(uint64_t seed) override;
+	virtual uint64_t getRandomSeed() const override;
+
+private:
+	uint64_t _randomSeed = 0;
 };
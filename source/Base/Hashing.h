@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Non-cryptographic hash building blocks: FNV-1a for sequential data and the splitmix64 finalizer for spreading the
+ * bits of values which are combined order-independently (e.g. summed up) or with a seed.
+ */
+class Hashing
+{
+public:
+    static constexpr uint64_t FnvOffset = 0xcbf29ce484222325ull;
+    static constexpr uint64_t FnvPrime = 0x100000001b3ull;
+
+    //one FNV-1a step, value is used as a whole (e.g. a pixel) instead of byte-wise
+    static uint64_t addFnv1a(uint64_t hash, uint64_t value) { return (hash ^ value) * FnvPrime; }
+
+    static uint64_t addFnv1a(uint64_t hash, void const* data, size_t size)
+    {
+        auto const bytes = static_cast<unsigned char const*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash = addFnv1a(hash, bytes[i]);
+        }
+        return hash;
+    }
+
+    //splitmix64 finalizer
+    static uint64_t mix(uint64_t value)
+    {
+        value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+        value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+        return value ^ (value >> 31);
+    }
+
+    //order-dependent combination of a seed with a value
+    static uint64_t combine(uint64_t seed, uint64_t value) { return mix(seed + 0x9e3779b97f4a7c15ull + value); }
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#ifdef __CUDACC__
+#define HOST_DEVICE_FUNCTION __host__ __device__ __forceinline__
+#else
+#define HOST_DEVICE_FUNCTION inline
+#endif
+
+/**
+ * Atomic operations for data structures which are used by GPU kernels as well as by host code (e.g. unit tests).
+ * On the host they are plain operations, hence host code must not call them concurrently.
+ */
+class HostDeviceAtomics
+{
+public:
+    //returns the old value
+    HOST_DEVICE_FUNCTION static int add(int* address, int value)
+    {
+#ifdef __CUDA_ARCH__
+        return atomicAdd(address, value);
+#else
+        auto const result = *address;
+        *address += value;
+        return result;
+#endif
+    }
+
+    //returns the old value
+    HOST_DEVICE_FUNCTION static int compareAndSwap(int* address, int compare, int value)
+    {
+        return compareAndSwapImpl(address, compare, value);
+    }
+
+    HOST_DEVICE_FUNCTION static unsigned long long
+    compareAndSwap(unsigned long long* address, unsigned long long compare, unsigned long long value)
+    {
+        return compareAndSwapImpl(address, compare, value);
+    }
+
+    //returns the old value
+    HOST_DEVICE_FUNCTION static int exchange(int* address, int value)
+    {
+#ifdef __CUDA_ARCH__
+        return atomicExch(address, value);
+#else
+        auto const result = *address;
+        *address = value;
+        return result;
+#endif
+    }
+
+    HOST_DEVICE_FUNCTION static void threadFence()
+    {
+#ifdef __CUDA_ARCH__
+        __threadfence();
+#endif
+    }
+
+private:
+    template <typename T>
+    HOST_DEVICE_FUNCTION static T compareAndSwapImpl(T* address, T compare, T value)
+    {
+#ifdef __CUDA_ARCH__
+        return atomicCAS(address, compare, value);
+#else
+        auto const result = *address;
+        if (compare == result) {
+            *address = value;
+        }
+        return result;
+#endif
+    }
+};
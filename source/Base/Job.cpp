@@ -10,4 +10,9 @@ Job::Job(string id, QObject* parent)
 string const& Job::getId() const
 {
     return _id;
-}
\ No newline at end of file
+}
+
+void Job::setExecutor(JobExecutor* executor)
+{
+    _executor = executor;
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Definitions.h"
+#include "JobExecutor.h"
 
 class BASE_EXPORT Job : public QObject
 {
@@ -15,6 +16,40 @@ public:
     virtual bool isFinished() const = 0;
     virtual bool isBlocking() const = 0;
 
+    void setExecutor(JobExecutor* executor);
+
+protected:
+    //runs func on the executor of the worker or directly if the job is not processed by a worker
+    template <typename Func>
+    auto runInBackground(Func&& func, vector<TaskId> const& dependencies = {})
+        -> pair<TaskId, std::future<decltype(func())>>;
+
+    //non-blocking check for use in process()
+    template <typename T>
+    static bool isReady(std::future<T> const& future);
+
 private:
     string _id;
+    JobExecutor* _executor = nullptr;
 };
+
+
+//implementations
+template <typename Func>
+auto Job::runInBackground(Func&& func, vector<TaskId> const& dependencies)
+    -> pair<TaskId, std::future<decltype(func())>>
+{
+    if (_executor) {
+        return _executor->submit(std::forward<Func>(func), TaskPriority::Normal, dependencies);
+    }
+    std::packaged_task<decltype(func())()> task(std::forward<Func>(func));
+    auto future = task.get_future();
+    task();
+    return {0, std::move(future)};
+}
+
+template <typename T>
+bool Job::isReady(std::future<T> const& future)
+{
+    return future.valid() && future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
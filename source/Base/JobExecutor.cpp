@@ -0,0 +1,242 @@
+#include "JobExecutor.h"
+
+namespace
+{
+    auto const NumPriorities = 3;
+
+    thread_local JobExecutor* currentExecutor = nullptr;
+    thread_local int currentThreadIndex = -1;
+}
+
+JobExecutor::JobExecutor(int numThreads, QObject* parent)
+    : QObject(parent)
+{
+    if (numThreads <= 0) {
+        numThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+    for (int i = 0; i < numThreads; ++i) {
+        _queues.emplace_back(std::make_unique<WorkerQueue>());
+    }
+    for (int i = 0; i < numThreads; ++i) {
+        _threads.emplace_back(&JobExecutor::run, this, i);
+    }
+}
+
+JobExecutor::~JobExecutor()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (auto const& [id, task] : _openTaskById) {
+            if (State::Running != task->state) {
+                task->state = State::Cancelled;
+                task->func = nullptr;
+            }
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _shutdown = true;
+    }
+    _wakeUp.notify_all();
+    for (auto& thread : _threads) {
+        thread.join();
+    }
+}
+
+JobExecutor& JobExecutor::getInstance()
+{
+    static JobExecutor instance;
+    return instance;
+}
+
+bool JobExecutor::cancel(TaskId id)
+{
+    vector<TaskId> cancelledIds;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto const findResult = _openTaskById.find(id);
+        if (findResult == _openTaskById.end() || State::Running == findResult->second->state) {
+            return false;
+        }
+        cancelImpl(findResult->second, cancelledIds);
+    }
+    for (auto const& cancelledId : cancelledIds) {
+        Q_EMIT taskCancelled(cancelledId);
+    }
+    return true;
+}
+
+int JobExecutor::getNumThreads() const
+{
+    return static_cast<int>(_threads.size());
+}
+
+TaskId JobExecutor::submitImpl(
+    std::function<void()>&& func,
+    TaskPriority priority,
+    vector<TaskId> const& dependencies)
+{
+    auto task = std::make_shared<Task>();
+    task->func = std::move(func);
+    task->priority = priority;
+
+    bool dependencyCancelled = false;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        task->id = _nextId++;
+        for (auto const& dependency : dependencies) {
+            if (_cancelledIds.find(dependency) != _cancelledIds.end()) {
+                dependencyCancelled = true;
+                break;
+            }
+            auto const findResult = _openTaskById.find(dependency);
+            if (findResult != _openTaskById.end()) {
+                ++task->numOpenDependencies;
+                findResult->second->dependents.emplace_back(task);
+            }
+        }
+        if (dependencyCancelled) {
+            vector<TaskId> cancelledIds;
+            cancelImpl(task, cancelledIds);
+        }
+        else {
+            _openTaskById.emplace(task->id, task);
+            if (0 == task->numOpenDependencies) {
+                task->state = State::Queued;
+            }
+        }
+    }
+
+    if (dependencyCancelled) {
+        Q_EMIT taskCancelled(task->id);
+    }
+    else if (State::Queued == task->state) {
+        enqueue(task);
+    }
+    return task->id;
+}
+
+void JobExecutor::enqueue(TaskPtr const& task)
+{
+    //tasks created by a task stay on the same thread, others are distributed round robin
+    auto const queueIndex = currentExecutor == this
+        ? currentThreadIndex
+        : static_cast<int>(_nextQueueIndex++ % _queues.size());
+    {
+        auto& queue = *_queues.at(queueIndex);
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasksByPriority[static_cast<int>(task->priority)].emplace_back(task);
+    }
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        ++_numQueuedTasks;
+    }
+    _wakeUp.notify_one();
+}
+
+auto JobExecutor::pop(int threadIndex) -> TaskPtr
+{
+    auto const numQueues = static_cast<int>(_queues.size());
+    for (int priority = NumPriorities - 1; priority >= 0; --priority) {
+
+        //own queue is processed in LIFO order for better cache locality, other queues are stolen from the front
+        auto result = popFromQueue(*_queues.at(threadIndex), priority, true);
+        for (int i = 1; !result && i < numQueues; ++i) {
+            result = popFromQueue(*_queues.at((threadIndex + i) % numQueues), priority, false);
+        }
+        if (result) {
+            std::lock_guard<std::mutex> lock(_sleepMutex);
+            --_numQueuedTasks;
+            return result;
+        }
+    }
+    return nullptr;
+}
+
+auto JobExecutor::popFromQueue(WorkerQueue& queue, int priority, bool back) -> TaskPtr
+{
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    auto& tasks = queue.tasksByPriority[priority];
+    if (tasks.empty()) {
+        return nullptr;
+    }
+    TaskPtr result;
+    if (back) {
+        result = tasks.back();
+        tasks.pop_back();
+    }
+    else {
+        result = tasks.front();
+        tasks.pop_front();
+    }
+    return result;
+}
+
+void JobExecutor::cancelImpl(TaskPtr task, vector<TaskId>& cancelledIds)
+{
+    task->state = State::Cancelled;
+    task->func = nullptr;   //destroys the promise of the task
+    _openTaskById.erase(task->id);
+    _cancelledIds.insert(task->id);
+    cancelledIds.emplace_back(task->id);
+
+    for (auto const& dependent : task->dependents) {
+        if (State::Cancelled != dependent->state) {
+            cancelImpl(dependent, cancelledIds);
+        }
+    }
+    task->dependents.clear();
+}
+
+void JobExecutor::run(int threadIndex)
+{
+    currentExecutor = this;
+    currentThreadIndex = threadIndex;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(_sleepMutex);
+            _wakeUp.wait(lock, [this] { return _shutdown || _numQueuedTasks > 0; });
+            if (_shutdown) {
+                return;
+            }
+        }
+
+        auto const task = pop(threadIndex);
+        if (!task) {
+            continue;
+        }
+
+        std::function<void()> func;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (State::Queued != task->state) {
+                continue;
+            }
+            task->state = State::Running;
+            func = std::move(task->func);
+        }
+
+        func();
+
+        vector<TaskPtr> readyTasks;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _openTaskById.erase(task->id);
+            if (_openTaskById.empty()) {
+                _cancelledIds.clear();
+            }
+            for (auto const& dependent : task->dependents) {
+                if (State::Waiting == dependent->state && 0 == --dependent->numOpenDependencies) {
+                    dependent->state = State::Queued;
+                    readyTasks.emplace_back(dependent);
+                }
+            }
+            task->dependents.clear();
+        }
+        for (auto const& readyTask : readyTasks) {
+            enqueue(readyTask);
+        }
+        Q_EMIT taskFinished(task->id);
+    }
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "Definitions.h"
+
+enum class TaskPriority
+{
+    Low,
+    Normal,
+    High
+};
+
+using TaskId = uint64_t;
+
+/**
+ * Executes tasks on a fixed number of background threads. Every thread owns a queue per priority and steals
+ * from the queues of the other threads if its own queues are empty, higher priorities are always served first.
+ *
+ * A task is only queued when all tasks it depends on are finished. Unknown ids (e.g. of already finished tasks)
+ * are treated as finished dependencies. Cancelling a task which has not started yet also cancels all tasks
+ * depending on it, their futures report std::future_error (broken_promise). Tasks submitted later with a dependency
+ * on a cancelled task are cancelled as well until the executor runs idle, the ids of cancelled tasks are forgotten
+ * then.
+ */
+class BASE_EXPORT JobExecutor : public QObject
+{
+    Q_OBJECT
+public:
+    JobExecutor(int numThreads = 0, QObject* parent = nullptr);   //0 = hardware concurrency
+    virtual ~JobExecutor();   //cancels all pending tasks and waits for running ones
+
+    //executor with hardware concurrency threads shared by all workers
+    static JobExecutor& getInstance();
+
+    template <typename Func>
+    auto submit(Func&& func, TaskPriority priority = TaskPriority::Normal, vector<TaskId> const& dependencies = {})
+        -> pair<TaskId, std::future<decltype(func())>>;
+
+    //returns false if task is already running or finished
+    bool cancel(TaskId id);
+
+    int getNumThreads() const;
+
+    Q_SIGNAL void taskFinished(quint64 id);
+    Q_SIGNAL void taskCancelled(quint64 id);
+
+private:
+    enum class State
+    {
+        Waiting,
+        Queued,
+        Running,
+        Cancelled
+    };
+    struct Task
+    {
+        TaskId id = 0;
+        std::function<void()> func;
+        TaskPriority priority = TaskPriority::Normal;
+        State state = State::Waiting;
+        int numOpenDependencies = 0;
+        vector<std::shared_ptr<Task>> dependents;
+    };
+    using TaskPtr = std::shared_ptr<Task>;
+
+    struct WorkerQueue
+    {
+        std::mutex mutex;
+        std::deque<TaskPtr> tasksByPriority[3];
+    };
+
+    TaskId submitImpl(std::function<void()>&& func, TaskPriority priority, vector<TaskId> const& dependencies);
+    void enqueue(TaskPtr const& task);
+    TaskPtr pop(int threadIndex);
+    TaskPtr popFromQueue(WorkerQueue& queue, int priority, bool back);
+    void cancelImpl(TaskPtr task, vector<TaskId>& cancelledIds);  //by value since it may be erased from the map
+    void run(int threadIndex);
+
+    vector<std::unique_ptr<WorkerQueue>> _queues;
+    vector<std::thread> _threads;
+
+    std::mutex _mutex;  //for task states and dependencies
+    unordered_map<TaskId, TaskPtr> _openTaskById;
+    unordered_set<TaskId> _cancelledIds;   //cleared when no task is open anymore
+    TaskId _nextId = 1;
+
+    std::mutex _sleepMutex;
+    std::condition_variable _wakeUp;
+    int _numQueuedTasks = 0;
+    bool _shutdown = false;
+    std::atomic<uint32_t> _nextQueueIndex{0};
+};
+
+
+//implementations
+template <typename Func>
+auto JobExecutor::submit(Func&& func, TaskPriority priority, vector<TaskId> const& dependencies)
+    -> pair<TaskId, std::future<decltype(func())>>
+{
+    using Result = decltype(func());
+    auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Func>(func));
+    auto future = task->get_future();
+    auto const id = submitImpl([task] { (*task)(); }, priority, dependencies);
+    return {id, std::move(future)};
+}
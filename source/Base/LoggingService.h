@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <string>
 
 enum class Priority
@@ -11,16 +12,41 @@ enum class Priority
 class LoggingCallBack
 {
 public:
+    virtual ~LoggingCallBack() = default;
+
+    //called on the logging thread
     virtual void newLogMessage(Priority priority, std::string const& message) = 0;
+
+    //messages with lower priority are discarded at the call site
+    virtual Priority getMinPriority() const { return Priority::Unimportant; }
 };
 
+/**
+ * Messages are queued without blocking the caller and passed to the callbacks on a background thread.
+ */
 class LoggingService
 {
 public:
     virtual ~LoggingService() = default;
 
+    //false if no callback is interested in messages of this priority
+    virtual bool isLogged(Priority priority) const = 0;
+
     virtual void logMessage(Priority priority, std::string const& message) = 0;
 
+    void logMessage(Priority priority, char const* message)
+    {
+        if (isLogged(priority)) {
+            logMessage(priority, std::string(message));
+        }
+    }
+
+    //messageBuilder is called on the logging thread, it must only capture copies
+    virtual void logDeferredMessage(Priority priority, std::function<std::string()> messageBuilder) = 0;
+
+    //blocks until all messages logged so far are passed to the callbacks
+    virtual void flush() = 0;
+
     virtual void registerCallBack(LoggingCallBack* callback) = 0;
-    virtual void unregisterCallBack(LoggingCallBack* callback) = 0;
+    virtual void unregisterCallBack(LoggingCallBack* callback) = 0;    //flushes before unregistering
 };
@@ -1,36 +1,233 @@
 #include "LoggingServiceImpl.h"
 
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
 #include <ctime>
 #include <sstream>
 
+namespace
+{
+    size_t const Capacity = 4096;   //must be a power of 2
+    size_t const Mask = Capacity - 1;
+    auto const NoCallbacks = static_cast<int>(Priority::Important) + 1;
+}
+
+LoggingServiceImpl::LoggingServiceImpl()
+    : _slots(new Slot[Capacity])
+    , _minPriority(NoCallbacks)
+{
+    for (size_t i = 0; i < Capacity; ++i) {
+        _slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    _thread = std::thread(&LoggingServiceImpl::run, this);
+}
+
+LoggingServiceImpl::~LoggingServiceImpl()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _shutdown = true;
+    }
+    _wakeUp.notify_one();
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+}
+
+bool LoggingServiceImpl::isLogged(Priority priority) const
+{
+    return static_cast<int>(priority) >= _minPriority.load(std::memory_order_relaxed);
+}
+
 void LoggingServiceImpl::logMessage(Priority priority, std::string const& message)
 {
-    std::lock_guard<std::mutex> lock(_mutex);
+    if (!isLogged(priority)) {
+        return;
+    }
+    enqueue(priority, message, nullptr);
+}
+
+void LoggingServiceImpl::logDeferredMessage(Priority priority, std::function<std::string()> messageBuilder)
+{
+    if (!isLogged(priority)) {
+        return;
+    }
+    enqueue(priority, std::string(), std::move(messageBuilder));
+}
+
+void LoggingServiceImpl::flush()
+{
+    if (std::this_thread::get_id() == _thread.get_id()) {
+        return;
+    }
+    auto const targetPos = _enqueuePos.load();
+    _wakeUp.notify_one();
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    _processed.wait(lock, [&] { return _dequeuePos.load() >= targetPos || _shutdown; });
+}
+
+void LoggingServiceImpl::registerCallBack(LoggingCallBack* callback)
+{
+    std::lock_guard<std::mutex> lock(_callbackMutex);
+    _callbacks.emplace_back(callback);
+    updateMinPriority();
+}
+
+void LoggingServiceImpl::unregisterCallBack(LoggingCallBack* callback)
+{
+    flush();
+
+    {
+        std::lock_guard<std::mutex> lock(_callbackMutex);
+        auto end = std::remove_if(_callbacks.begin(), _callbacks.end(), [&](auto const& callback_) {
+            return callback_ == callback;
+        });
+
+        _callbacks.erase(end, _callbacks.end());
+        updateMinPriority();
+    }
+
+    //the callback may still be called by a running dispatch, unless it unregisters itself from within it
+    if (std::this_thread::get_id() != _thread.get_id()) {
+        std::lock_guard<std::mutex> lock(_dispatchMutex);
+    }
+}
+
+void LoggingServiceImpl::enqueue(
+    Priority priority,
+    std::string const& message,
+    std::function<std::string()>&& messageBuilder)
+{
+    auto pos = _enqueuePos.load(std::memory_order_relaxed);
+    Slot* slot = nullptr;
+    while (true) {
+        slot = &_slots[pos & Mask];
+        auto const sequence = slot->sequence.load(std::memory_order_acquire);
+        auto const diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+        if (0 == diff) {
+            if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            ++_numDroppedMessages;  //buffer is full
+            return;
+        } else {
+            pos = _enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->time = std::chrono::system_clock::now();
+    slot->priority = priority;
+    slot->message = message;
+    slot->messageBuilder = std::move(messageBuilder);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+
+    //pairs with the fence in run(): either the logging thread sees the message or this thread sees it sleeping
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_sleeping.load(std::memory_order_relaxed)) {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+        }
+        _wakeUp.notify_one();
+    }
+}
+
+void LoggingServiceImpl::run()
+{
+    while (true) {
+        if (auto const numDroppedMessages = _numDroppedMessages.exchange(0)) {
+            std::stringstream stream;
+            stream << numDroppedMessages << " log message(s) dropped";
+            dispatch(Priority::Important, std::chrono::system_clock::now(), stream.str());
+        }
+        if (processNextSlot()) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        _processed.notify_all();
+        if (_shutdown) {
+            return;
+        }
+        _sleeping.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        _wakeUp.wait(lock, [this] { return _shutdown || _numDroppedMessages.load() > 0 || hasNextSlot(); });
+        _sleeping.store(false, std::memory_order_relaxed);
+    }
+}
+
+bool LoggingServiceImpl::hasNextSlot() const
+{
+    auto const pos = _dequeuePos.load(std::memory_order_relaxed);
+    return _slots[pos & Mask].sequence.load(std::memory_order_acquire) == pos + 1;
+}
 
-    auto t = std::time(nullptr);
+bool LoggingServiceImpl::processNextSlot()
+{
+    auto const pos = _dequeuePos.load(std::memory_order_relaxed);
+    auto& slot = _slots[pos & Mask];
+    if (slot.sequence.load(std::memory_order_acquire) != pos + 1) {
+        return false;
+    }
+    auto const priority = slot.priority;
+    auto const time = slot.time;
+    auto message = std::move(slot.message);
+    auto const messageBuilder = std::move(slot.messageBuilder);
+    slot.messageBuilder = nullptr;
+    slot.sequence.store(pos + Capacity, std::memory_order_release);
+
+    if (messageBuilder) {
+        message = messageBuilder();
+    }
+    dispatch(priority, time, message);
+
+    _dequeuePos.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+void LoggingServiceImpl::dispatch(
+    Priority priority,
+    std::chrono::system_clock::time_point const& time,
+    std::string const& message)
+{
+    auto t = std::chrono::system_clock::to_time_t(time);
     auto tm = *std::localtime(&t);
 
     std::stringstream stream;
     stream << std::put_time(&tm, "%Y-%m-%d %H-%M-%S") << ": " << message;
 
     auto enrichedMessage = stream.str();
-    for (auto const& callback : _callbacks) {
-        callback->newLogMessage(priority, enrichedMessage);
+
+    //callbacks are called without holding _callbackMutex so that they can (un)register callbacks
+    std::lock_guard<std::mutex> dispatchLock(_dispatchMutex);
+    std::vector<LoggingCallBack*> callbacks;
+    {
+        std::lock_guard<std::mutex> lock(_callbackMutex);
+        callbacks = _callbacks;
+    }
+    for (auto const& callback : callbacks) {
+        if (!isRegistered(callback)) {
+            continue;   //unregistered by a previous callback
+        }
+        if (priority >= callback->getMinPriority()) {
+            callback->newLogMessage(priority, enrichedMessage);
+        }
     }
 }
 
-void LoggingServiceImpl::registerCallBack(LoggingCallBack* callback)
+bool LoggingServiceImpl::isRegistered(LoggingCallBack* callback)
 {
-    _callbacks.emplace_back(callback);
+    std::lock_guard<std::mutex> lock(_callbackMutex);
+    return std::find(_callbacks.begin(), _callbacks.end(), callback) != _callbacks.end();
 }
 
-void LoggingServiceImpl::unregisterCallBack(LoggingCallBack* callback)
+void LoggingServiceImpl::updateMinPriority()
 {
-    auto end = std::remove_if(_callbacks.begin(), _callbacks.end(), [&](auto const& callback_) {
-        return callback_ == callback;
-    });
-
-    _callbacks.erase(end, _callbacks.end());
+    auto minPriority = NoCallbacks;
+    for (auto const& callback : _callbacks) {
+        minPriority = std::min(minPriority, static_cast<int>(callback->getMinPriority()));
+    }
+    _minPriority.store(minPriority);
 }
@@ -1,20 +1,67 @@
 #pragma once
-#include <vector>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
 #include <mutex>
+#include <thread>
+#include <vector>
 
 #include "LoggingService.h"
 
+/**
+ * Producers reserve a slot of a bounded ring buffer via compare-and-swap and never wait for locks. If the buffer
+ * is full the message is dropped and the number of dropped messages is logged later. Timestamp formatting and
+ * the callbacks run on the logging thread.
+ */
 class LoggingServiceImpl : public LoggingService
 {
 public:
-    virtual ~LoggingServiceImpl() = default;
+    LoggingServiceImpl();
+    virtual ~LoggingServiceImpl();
 
+    using LoggingService::logMessage;
+
+    bool isLogged(Priority priority) const override;
     void logMessage(Priority priority, std::string const& message) override;
+    void logDeferredMessage(Priority priority, std::function<std::string()> messageBuilder) override;
+    void flush() override;
 
     void registerCallBack(LoggingCallBack* callback) override;
     void unregisterCallBack(LoggingCallBack* callback) override;
 
 private:
+    struct Slot
+    {
+        std::atomic<size_t> sequence{0};
+        std::chrono::system_clock::time_point time;
+        Priority priority = Priority::Unimportant;
+        std::string message;
+        std::function<std::string()> messageBuilder;
+    };
+
+    void enqueue(Priority priority, std::string const& message, std::function<std::string()>&& messageBuilder);
+    void run();
+    bool hasNextSlot() const;
+    bool processNextSlot();
+    void dispatch(Priority priority, std::chrono::system_clock::time_point const& time, std::string const& message);
+    bool isRegistered(LoggingCallBack* callback);
+    void updateMinPriority();
+
+    std::unique_ptr<Slot[]> _slots;
+    alignas(64) std::atomic<size_t> _enqueuePos{0};
+    alignas(64) std::atomic<size_t> _dequeuePos{0};     //only written by logging thread
+    std::atomic<int> _numDroppedMessages{0};
+    std::atomic<int> _minPriority;
+
+    std::mutex _callbackMutex;
     std::vector<LoggingCallBack*> _callbacks;
+    std::mutex _dispatchMutex;  //held while callbacks are called
+
     std::mutex _mutex;
+    std::condition_variable _wakeUp;
+    std::condition_variable _processed;
+    std::atomic<bool> _sleeping{false};
+    bool _shutdown = false;
+    std::thread _thread;
 };
@@ -10,7 +10,10 @@ public:
 	NumberGenerator(QObject* parent = nullptr) : QObject(parent) {}
 	virtual ~NumberGenerator() = default;
 
-	virtual void init(uint32_t arraySize = 1323781, uint16_t threadId = 0) = 0;
+	//numbers are drawn from stream threadId of the seed given by the factory, generators with the same seed and
+	//thread id produce the same sequence
+	virtual void init(uint16_t threadId = 0) = 0;
+	virtual uint64_t getSeed() const = 0;
 
 	virtual uint32_t getRandomInt() = 0;
 	virtual uint32_t getRandomInt(uint32_t range) = 0;
@@ -19,5 +22,9 @@ public:
     virtual double getRandomReal(double min, double max) = 0;
 	virtual QByteArray getRandomArray(int length) = 0;
 
+	//bulk versions, continue the same sequence as the single number versions
+	virtual void fillRandomInts(uint32_t* target, int count) = 0;
+	virtual void fillRandomReals(float* target, int count) = 0;	//[0, 1)
+
 	virtual uint64_t getId() = 0;
 };
@@ -1,69 +1,100 @@
-#include <sstream>
-#include <thread>
-
-#include <QRandomGenerator>
+#include <algorithm>
 
 #include "NumberGeneratorImpl.h"
+#include "Philox.h"
 
-namespace
+NumberGeneratorImpl::NumberGeneratorImpl(uint64_t seed, QObject * parent)
+	: NumberGenerator(parent), _seed(seed)
 {
-    double const RandMax = 4294967296.0;
 }
 
-NumberGeneratorImpl::NumberGeneratorImpl(QObject * parent)
-	: NumberGenerator(parent)
+void NumberGeneratorImpl::init(uint16_t threadId)
 {
+	_threadId = static_cast<uint64_t>(threadId) << 48;
+	_runningNumber = 0;
+	_stream = threadId;
+	_counter = 0;
+	_blockIndex = 4;
 }
 
-void NumberGeneratorImpl::init(uint32_t arraySize, uint16_t threadId)
+uint64_t NumberGeneratorImpl::getSeed() const
 {
-	_threadId = static_cast<uint64_t>(threadId) << 48;
-	_arrayOfRandomNumbers.clear();
-	_runningNumber = 0;
-	for (uint32_t i = 0; i < arraySize; ++i) {
-        _arrayOfRandomNumbers.push_back(QRandomGenerator::global()->generate());
-	}
+	return _seed;
 }
 
 uint32_t NumberGeneratorImpl::getRandomInt()
 {
-	return getNumberFromArray();
+	return getNextNumber();
 }
 
 uint32_t NumberGeneratorImpl::getRandomInt(uint32_t range)
 {
-	return getNumberFromArray() % range;
+	return Philox::toRange(getNextNumber(), range);
 }
 
 uint32_t NumberGeneratorImpl::getRandomInt(uint32_t min, uint32_t max)
 {
     auto delta = max - min + 1;
-    return min + (getNumberFromArray() % delta);
-}
-
-uint32_t NumberGeneratorImpl::getLargeRandomInt(uint32_t range)
-{
-	return getNumberFromArray() % (range + 1);
+    if (0 == delta) {
+        return getNextNumber();     //full range
+    }
+    return min + Philox::toRange(getNextNumber(), delta);
 }
 
 double NumberGeneratorImpl::getRandomReal(double min, double max)
 {
-	return static_cast<double>(getLargeRandomInt((max - min) * 1000) / 1000.0 + min);
+	return min + (max - min) * getRandomReal();
 }
 
 double NumberGeneratorImpl::getRandomReal()
 {
-    return static_cast<double>(getNumberFromArray()) / RandMax;
+    auto const value1 = getNextNumber();
+    auto const value2 = getNextNumber();
+    return Philox::toDouble(value1, value2);
 }
 
 QByteArray NumberGeneratorImpl::getRandomArray(int length)
 {
-	QByteArray bytes;
-	for (int i = 0; i < length; ++i) {
-		bytes[i] =getRandomInt(256);
+	QByteArray result(length, 0);
+	for (int i = 0; i < length; i += 4) {
+		auto const number = getNextNumber();
+		std::copy_n(reinterpret_cast<char const*>(&number), std::min(4, length - i), result.data() + i);
+	}
+	return result;
+}
+
+void NumberGeneratorImpl::fillRandomInts(uint32_t* target, int count)
+{
+	int i = 0;
+	for (; i < count && _blockIndex < 4; ++i) {
+		target[i] = getNextNumber();
 	}
 
-	return std::move(bytes);
+	//whole blocks are written directly
+	for (; i + 4 <= count; i += 4) {
+		auto const block = Philox::generate(_seed, _stream, _counter++);
+		std::copy_n(block.values, 4, target + i);
+	}
+	for (; i < count; ++i) {
+		target[i] = getNextNumber();
+	}
+}
+
+void NumberGeneratorImpl::fillRandomReals(float* target, int count)
+{
+	int i = 0;
+	for (; i < count && _blockIndex < 4; ++i) {
+		target[i] = Philox::toFloat(getNextNumber());
+	}
+	for (; i + 4 <= count; i += 4) {
+		auto const block = Philox::generate(_seed, _stream, _counter++);
+		for (int j = 0; j < 4; ++j) {
+			target[i + j] = Philox::toFloat(block.values[j]);
+		}
+	}
+	for (; i < count; ++i) {
+		target[i] = Philox::toFloat(getNextNumber());
+	}
 }
 
 uint64_t NumberGeneratorImpl::getId()
@@ -71,8 +102,12 @@ uint64_t NumberGeneratorImpl::getId()
 	return _threadId | ++_runningNumber;
 }
 
-uint32_t NumberGeneratorImpl::getNumberFromArray()
+uint32_t NumberGeneratorImpl::getNextNumber()
 {
-	_index = (_index + 1) % _arrayOfRandomNumbers.size();
-	return _arrayOfRandomNumbers[_index];
+	if (4 == _blockIndex) {
+		auto const block = Philox::generate(_seed, _stream, _counter++);
+		std::copy_n(block.values, 4, _block);
+		_blockIndex = 0;
+	}
+	return _block[_blockIndex++];
 }
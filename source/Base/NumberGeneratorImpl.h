@@ -6,10 +6,11 @@ class NumberGeneratorImpl
 	: public NumberGenerator
 {
 public:
-	NumberGeneratorImpl(QObject* parent = nullptr);
+	NumberGeneratorImpl(uint64_t seed, QObject* parent = nullptr);
 	virtual ~NumberGeneratorImpl() = default;
 
-	virtual void init(uint32_t arraySize, uint16_t threadId) override;
+	virtual void init(uint16_t threadId) override;
+	virtual uint64_t getSeed() const override;
 
 	virtual uint32_t getRandomInt() override;
 	virtual uint32_t getRandomInt(uint32_t range) override;
@@ -18,15 +19,20 @@ public:
     virtual double getRandomReal(double min, double max) override;
 	virtual QByteArray getRandomArray(int length) override;
 
+	virtual void fillRandomInts(uint32_t* target, int count) override;
+	virtual void fillRandomReals(float* target, int count) override;
+
 	virtual uint64_t getId() override;
 
 private:
-    uint32_t getLargeRandomInt(uint32_t range);
-    quint32 getNumberFromArray();
+    uint32_t getNextNumber();
+
+	uint64_t _seed = 0;
+	uint64_t _stream = 0;
+	uint64_t _counter = 0;
+	uint32_t _block[4];
+	int _blockIndex = 4;	//4 = block is used up
 
-	int _index = 0;
-	vector<uint32_t> _arrayOfRandomNumbers;
 	uint64_t _runningNumber = 0;
 	uint64_t _threadId = 0;
 };
-
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+
+#include "HostDeviceFunctions.h"
+
+/**
+ * Counter-based random number generator Philox4x32-10 (Salmon et al., "Parallel random numbers: as easy as
+ * 1, 2, 3"). Every (seed, stream, counter) triple is mapped to 4 independent 32-bit numbers without any state,
+ * so streams can be generated in parallel and reproduced from their coordinates.
+ *
+ * Stream ids: host number generators use their thread id, GPU threads use DeviceStreamOffset + thread index.
+ * Entity streams are tagged by the highest bit (see generateForEntity).
+ */
+class Philox
+{
+public:
+    struct Block
+    {
+        uint32_t values[4];
+    };
+
+    static constexpr uint64_t DeviceStreamOffset = 1ull << 32;
+    static constexpr uint64_t EntityStreamTag = 1ull << 63;
+
+    HOST_DEVICE_FUNCTION static Block generate(uint64_t seed, uint64_t stream, uint64_t counter)
+    {
+        uint32_t c0 = static_cast<uint32_t>(counter);
+        uint32_t c1 = static_cast<uint32_t>(counter >> 32);
+        uint32_t c2 = static_cast<uint32_t>(stream);
+        uint32_t c3 = static_cast<uint32_t>(stream >> 32);
+        uint32_t k0 = static_cast<uint32_t>(seed);
+        uint32_t k1 = static_cast<uint32_t>(seed >> 32);
+
+        for (int round = 0; round < 10; ++round) {
+            if (round > 0) {
+                k0 += 0x9E3779B9;
+                k1 += 0xBB67AE85;
+            }
+            uint64_t const product0 = static_cast<uint64_t>(0xD2511F53) * c0;
+            uint64_t const product1 = static_cast<uint64_t>(0xCD9E8D57) * c2;
+            uint32_t const hi0 = static_cast<uint32_t>(product0 >> 32);
+            uint32_t const hi1 = static_cast<uint32_t>(product1 >> 32);
+
+            c0 = hi1 ^ c1 ^ k0;
+            c1 = static_cast<uint32_t>(product1);
+            c2 = hi0 ^ c3 ^ k1;
+            c3 = static_cast<uint32_t>(product0);
+        }
+        return {{c0, c1, c2, c3}};
+    }
+
+    //numbers of an entity in a given timestep, independent of the thread processing the entity
+    HOST_DEVICE_FUNCTION static Block
+    generateForEntity(uint64_t seed, uint64_t entityId, uint32_t timestep, uint32_t index)
+    {
+        return generate(seed, entityId ^ EntityStreamTag, (static_cast<uint64_t>(timestep) << 32) | index);
+    }
+
+    //[0, 1)
+    HOST_DEVICE_FUNCTION static float toFloat(uint32_t value)
+    {
+        return static_cast<float>(value >> 8) * (1.0f / 16777216.0f);
+    }
+
+    //[0, 1) with 53 bits precision
+    HOST_DEVICE_FUNCTION static double toDouble(uint32_t value1, uint32_t value2)
+    {
+        auto const value = (static_cast<uint64_t>(value1) << 21) | static_cast<uint64_t>(value2 >> 11);
+        return static_cast<double>(value) * (1.0 / 9007199254740992.0);
+    }
+
+    //[0, range) by multiply-shift, avoids the division of a modulo
+    HOST_DEVICE_FUNCTION static uint32_t toRange(uint32_t value, uint32_t range)
+    {
+        return static_cast<uint32_t>((static_cast<uint64_t>(value) * range) >> 32);
+    }
+};
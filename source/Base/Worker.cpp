@@ -1,16 +1,30 @@
 #include "Worker.h"
 
+_Worker::_Worker(JobExecutor* executor)
+    : _executor(executor ? executor : &JobExecutor::getInstance())
+{
+}
+
 bool _Worker::contains(string const& id)
 {
     return _jobById.find(id) != _jobById.end();
 }
 
-bool _Worker::add(Job* job)
+bool _Worker::add(Job* job, vector<string> const& dependencies)
 {
     if (_jobById.find(job->getId()) != _jobById.end()) {
         return false;
     }
 
+    auto& jobDependencies = _dependenciesById[job->getId()];
+    jobDependencies = dependencies;
+    for (auto const& otherJob : _jobs) {
+        if (otherJob->isBlocking()) {
+            jobDependencies.emplace_back(otherJob->getId());
+        }
+    }
+
+    job->setExecutor(_executor);
     _jobs.emplace_back(job);
     _jobById.emplace(job->getId(), job);
 
@@ -22,9 +36,8 @@ void _Worker::process()
     vector<Job*> newJobQueue;
     newJobQueue.reserve(_jobs.size());
 
-    bool blockingJobs = false;
     for (auto const& job : _jobs) {
-        if (blockingJobs) {
+        if (hasOpenDependencies(job)) {
             newJobQueue.emplace_back(job);
             continue;
         }
@@ -32,14 +45,30 @@ void _Worker::process()
         if (!job->isFinished()) {
             newJobQueue.emplace_back(job);
         }
-        if (job->isBlocking()) {
-            blockingJobs = true;
-        }
-        if (job->isFinished()) {
+        else {
             _jobById.erase(job->getId());
+            _dependenciesById.erase(job->getId());
             delete job;
         }
     }
     _jobs = newJobQueue;
 }
 
+JobExecutor* _Worker::getExecutor() const
+{
+    return _executor;
+}
+
+bool _Worker::hasOpenDependencies(Job* job) const
+{
+    auto const findResult = _dependenciesById.find(job->getId());
+    if (findResult == _dependenciesById.end()) {
+        return false;
+    }
+    for (auto const& dependency : findResult->second) {
+        if (_jobById.find(dependency) != _jobById.end()) {
+            return true;
+        }
+    }
+    return false;
+}
@@ -1,38 +1,34 @@
 #pragma 
 
 #include "Job.h"
+#include "JobExecutor.h"
 #include "Definitions.h"
 
+/**
+ * Processes jobs on the calling (usually GUI) thread. A job is only processed after all jobs it depends on are
+ * finished. Blocking jobs are implicit dependencies of all jobs added after them. CPU-heavy parts of jobs run
+ * on the executor of the worker (see Job::runInBackground).
+ */
 class BASE_EXPORT _Worker
 {
 public:
+    _Worker(JobExecutor* executor = nullptr);  //nullptr = JobExecutor::getInstance()
+
     bool contains(string const& id);
 
     //returns false if job is already in queue
-    bool add(Job* job);
-
-    /*
-    Job get(string const& id) const
-    {
-    auto findResult = _jobById.find(id);
-    if (findResult != _jobById.end()) {
-    return findResult->second;
-    }
-    return nullptr;
-    }
-
-    Job getFirst() const
-    {
-    if (_jobs.empty()) {
-    return nullptr;
-    }
-    return _jobs.front();
-    }
-    */
+    bool add(Job* job, vector<string> const& dependencies = {});
 
     void process();
+
+    JobExecutor* getExecutor() const;
+
 private:
+    bool hasOpenDependencies(Job* job) const;
+
     vector<Job*> _jobs;
     unordered_map<string, Job*> _jobById;
-};
+    unordered_map<string, vector<string>> _dependenciesById;
 
+    JobExecutor* _executor = nullptr;
+};
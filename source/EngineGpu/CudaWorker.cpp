@@ -13,6 +13,7 @@
 #include "Base/LoggingService.h"
 #include "EngineInterface/SpaceProperties.h"
 #include "EngineInterface/PhysicalActions.h"
+#include "EngineInterface/TiledPixelImage.h"
 #include "EngineGpuKernels/AccessTOs.cuh"
 
 #include "CudaJobs.h"
@@ -31,6 +32,7 @@ CudaWorker::~CudaWorker()
 {
     delete _surface;
 	delete _cudaSimulation;
+    delete _tiledPixelImage;
 }
 
 void CudaWorker::init(
@@ -44,7 +46,10 @@ void CudaWorker::init(
 
     auto size = space->getSize();
 	delete _cudaSimulation;
-    _cudaSimulation = new CudaSimulation({ size.x, size.y }, timestep, parameters, cudaConstants);
+    _cudaSimulation =
+        new CudaSimulation({size.x, size.y}, timestep, parameters, cudaConstants, _numberGenerator->getSeed());
+    delete _tiledPixelImage;
+    _tiledPixelImage = new TiledPixelImage(size);
 }
 
 void CudaWorker::terminateWorker()
@@ -140,9 +145,26 @@ void CudaWorker::processJobs()
             auto image = _job->getTargetImage();
             auto& mutex = _job->getMutex();
 
+            IntVector2D const rectSize{rect.p2.x - rect.p1.x, rect.p2.y - rect.p1.y};
+            IntVector2D const imageSize{image->width(), image->height()};
+            auto const level = TiledPixelImage::calcLevel(rectSize, imageSize);
+            auto const tileRect = _tiledPixelImage->getTileRect(rect, level);
+
+            //only changed tiles are transferred from the GPU
+            vector<int> tileIndices;
+            vector<unsigned int> tilePixels;
+            _cudaSimulation->getPixelImageTiles(
+                level, {tileRect.p1.x, tileRect.p1.y}, {tileRect.p2.x, tileRect.p2.y}, tileIndices, tilePixels);
+            auto const numTilePixels = TiledPixelImage::TileSize * TiledPixelImage::TileSize;
+            for (int i = 0; i < tileIndices.size(); ++i) {
+                std::copy_n(
+                    tilePixels.begin() + i * numTilePixels,
+                    numTilePixels,
+                    _tiledPixelImage->getTile(level, tileIndices[i]));
+            }
+
             std::lock_guard<std::mutex> lock(mutex);
-            _cudaSimulation->getPixelImage(
-                {rect.p1.x, rect.p1.y}, {rect.p2.x, rect.p2.y}, {image->width(), image->height()}, image->bits());
+            _tiledPixelImage->drawImage(rect, imageSize, reinterpret_cast<unsigned int*>(image->bits()));
         }
 
         if (auto _job = boost::dynamic_pointer_cast<_GetVectorImageJob>(job)) {
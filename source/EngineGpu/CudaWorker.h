@@ -48,6 +48,7 @@ private:
 
 private:
     CudaSimulation* _cudaSimulation = nullptr;
+    TiledPixelImage* _tiledPixelImage = nullptr; //host copy of the pixel image tiles transferred so far
     NumberGenerator* _numberGenerator = nullptr;
 
     mutable std::mutex _mutex;
@@ -17,6 +17,15 @@ namespace
     string const maxTokenPointers_key = "maxTokenPointers";
     string const dynamicMemorySize_key = "dynamicMemorySize";
     string const metadataDynamicMemorySize_key = "metadataDynamicMemorySize";
+    string const maxFillLevelPercent_key = "maxFillLevelPercent";
+    string const maxFragmentationPercent_key = "maxFragmentationPercent";
+
+    //for data saved before the key existed
+    int getValueOrDefault(map<string, int> const& data, string const& key, int defaultValue)
+    {
+        auto const findResult = data.find(key);
+        return findResult != data.end() ? findResult->second : defaultValue;
+    }
 }
 
 
@@ -35,6 +44,8 @@ EngineGpuData::EngineGpuData(CudaConstants const & value)
     _data.insert_or_assign(maxTokens_key, value.MAX_TOKENS);
     _data.insert_or_assign(dynamicMemorySize_key, value.DYNAMIC_MEMORY_SIZE);
     _data.insert_or_assign(metadataDynamicMemorySize_key, value.METADATA_DYNAMIC_MEMORY_SIZE);
+    _data.insert_or_assign(maxFillLevelPercent_key, value.MAX_FILL_LEVEL_PERCENT);
+    _data.insert_or_assign(maxFragmentationPercent_key, value.MAX_FRAGMENTATION_PERCENT);
 }
 
 CudaConstants EngineGpuData::getCudaConstants() const
@@ -52,6 +63,10 @@ CudaConstants EngineGpuData::getCudaConstants() const
     result.MAX_TOKENPOINTERS = result.MAX_TOKENS * 10;
     result.DYNAMIC_MEMORY_SIZE = _data.at(dynamicMemorySize_key);
     result.METADATA_DYNAMIC_MEMORY_SIZE = _data.at(metadataDynamicMemorySize_key);
+    result.MAX_FILL_LEVEL_PERCENT =
+        getValueOrDefault(_data, maxFillLevelPercent_key, CudaConstants().MAX_FILL_LEVEL_PERCENT);
+    result.MAX_FRAGMENTATION_PERCENT =
+        getValueOrDefault(_data, maxFragmentationPercent_key, CudaConstants().MAX_FRAGMENTATION_PERCENT);
     return result;
 }
 
@@ -15,6 +15,8 @@ CudaConstants EngineGpuSettings::getDefaultCudaConstants()
     result.MAX_PARTICLEPOINTERS = result.MAX_PARTICLES;
     result.DYNAMIC_MEMORY_SIZE = 50000000;
     result.METADATA_DYNAMIC_MEMORY_SIZE = 10000000;
+    result.MAX_FILL_LEVEL_PERCENT = 66;
+    result.MAX_FRAGMENTATION_PERCENT = 50;
 
     return result;
 }
@@ -199,6 +199,7 @@ string SimulationAccessGpuImpl::getObjectId() const
 
 SimulationAccessGpuImpl::_DataTOCache::_DataTOCache(CudaConstants const& cudaConstants)
     : _cudaConstants(cudaConstants)
+    , _layout(calcAccessTOLayout(cudaConstants))
 {}
 
 SimulationAccessGpuImpl::_DataTOCache::~_DataTOCache()
@@ -238,19 +239,16 @@ void SimulationAccessGpuImpl::_DataTOCache::releaseDataTO(DataAccessTO const& da
 
 DataAccessTO SimulationAccessGpuImpl::_DataTOCache::getNewDataTO()
 {
+    auto buffer = CudaSimulation::acquirePageLockedMemory(_layout.getSize());
+    if (buffer) {
+        _pageLockedBuffers.insert(buffer);
+        return createDataAccessTO(buffer, _layout);
+    }
+
+    //page-locked memory is limited, pageable memory is transferred slower but works as well
     try {
-        DataAccessTO result;
-        result.numClusters = new int;
-        result.numCells = new int;
-        result.numParticles = new int;
-        result.numTokens = new int;
-        result.numStringBytes = new int;
-        result.clusters = new ClusterAccessTO[_cudaConstants.MAX_CLUSTERS];
-        result.cells = new CellAccessTO[_cudaConstants.MAX_CELLS];
-        result.particles = new ParticleAccessTO[_cudaConstants.MAX_PARTICLES];
-        result.tokens = new TokenAccessTO[_cudaConstants.MAX_TOKENS];
-        result.stringBytes = new char[_cudaConstants.METADATA_DYNAMIC_MEMORY_SIZE];
-        return result;
+        buffer = new unsigned char[_layout.getSize()];
+        return createDataAccessTO(buffer, _layout);
     } catch (std::bad_alloc const& exception) {
         throw BugReportException("There is not sufficient CPU memory available.");
     }
@@ -258,14 +256,9 @@ DataAccessTO SimulationAccessGpuImpl::_DataTOCache::getNewDataTO()
 
 void SimulationAccessGpuImpl::_DataTOCache::deleteDataTO(DataAccessTO const& dataTO)
 {
-    delete dataTO.numClusters;
-    delete dataTO.numCells;
-    delete dataTO.numParticles;
-    delete dataTO.numTokens;
-    delete dataTO.numStringBytes;
-    delete[] dataTO.clusters;
-    delete[] dataTO.cells;
-    delete[] dataTO.particles;
-    delete[] dataTO.tokens;
-    delete[] dataTO.stringBytes;
+    if (_pageLockedBuffers.erase(dataTO.buffer) > 0) {
+        CudaSimulation::freePageLockedMemory(dataTO.buffer);
+    } else {
+        delete[] dataTO.buffer;
+    }
 }
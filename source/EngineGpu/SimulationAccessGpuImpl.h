@@ -1,5 +1,8 @@
 #pragma once
 
+#include <set>
+
+#include "EngineGpuKernels/AccessTOLayout.h"
 #include "EngineGpuKernels/CudaConstants.h"
 #include "EngineInterface/ChangeDescriptions.h"
 #include "EngineInterface/SimulationAccess.h"
@@ -41,6 +44,8 @@ private:
 
     string getObjectId() const;
 
+    //access data is held in one buffer per DataAccessTO (see AccessTOLayout), page-locked if possible for faster
+    //transfers to and from the device
     class _DataTOCache
     {
     public:
@@ -55,6 +60,8 @@ private:
         void deleteDataTO(DataAccessTO const& dataTO);
 
         CudaConstants _cudaConstants;
+        AccessTOLayout _layout;
+        std::set<unsigned char*> _pageLockedBuffers;
         vector<DataAccessTO> _freeDataTOs;
         vector<DataAccessTO> _usedDataTOs;
     };
@@ -110,38 +110,38 @@ __global__ void getClusterAccessData(int2 universeSize, int2 rectUpperLeft, int2
                 cellTO.branchNumber = cell.branchNumber;
                 cellTO.tokenBlocked = cell.tokenBlocked;
                 cellTO.cellFunctionType = cell.getCellFunctionType();
-                cellTO.numStaticBytes = cell.numStaticBytes;
+                cellTO.numStaticBytes = cell.coldData->numStaticBytes;
                 cellTO.tokenUsages = cell.tokenUsages;
-                cellTO.metadata.color = cell.metadata.color;
+                cellTO.metadata.color = cell.coldData->metadata.color;
 
                 copyString(
                     cellTO.metadata.nameLen,
                     cellTO.metadata.nameStringIndex,
-                    cell.metadata.nameLen,
-                    cell.metadata.name,
+                    cell.coldData->metadata.nameLen,
+                    cell.coldData->metadata.name,
                     *dataTO.numStringBytes,
                     dataTO.stringBytes);
                 copyString(
                     cellTO.metadata.descriptionLen,
                     cellTO.metadata.descriptionStringIndex,
-                    cell.metadata.descriptionLen,
-                    cell.metadata.description,
+                    cell.coldData->metadata.descriptionLen,
+                    cell.coldData->metadata.description,
                     *dataTO.numStringBytes,
                     dataTO.stringBytes);
                 copyString(
                     cellTO.metadata.sourceCodeLen,
                     cellTO.metadata.sourceCodeStringIndex,
-                    cell.metadata.sourceCodeLen,
-                    cell.metadata.sourceCode,
+                    cell.coldData->metadata.sourceCodeLen,
+                    cell.coldData->metadata.sourceCode,
                     *dataTO.numStringBytes,
                     dataTO.stringBytes);
 
                 for (int i = 0; i < MAX_CELL_STATIC_BYTES; ++i) {
-                    cellTO.staticData[i] = cell.staticData[i];
+                    cellTO.staticData[i] = cell.coldData->staticData[i];
                 }
-                cellTO.numMutableBytes = cell.numMutableBytes;
+                cellTO.numMutableBytes = cell.coldData->numMutableBytes;
                 for (int i = 0; i < MAX_CELL_MUTABLE_BYTES; ++i) {
-                    cellTO.mutableData[i] = cell.mutableData[i];
+                    cellTO.mutableData[i] = cell.coldData->mutableData[i];
                 }
                 for (int i = 0; i < cell.numConnections; ++i) {
                     int connectingCellIndex = cell.connections[i]->tag + cellTOIndex;
@@ -308,13 +308,42 @@ __global__ void deselectParticles(Array<Particle*> particles)
     }
 }
 
+//moves the arrays in place to their positions in the layout for the numbers of elements in the header
+//(see AccessTOLayout::pack), one block since the arrays may overlap
+__global__ void packAccessData(unsigned char* buffer, AccessTOLayout layout)
+{
+    auto const packedLayout = layout.getPackedLayout(AccessTOLayout::getHeader(buffer));
+    for (int array = 0; array < AccessTOLayout::NumArrays; ++array) {
+        auto const type = static_cast<AccessTOLayout::Array>(array);
+        auto const source = reinterpret_cast<int4*>(buffer + layout.getOffset(type));
+        auto const target = reinterpret_cast<int4*>(buffer + packedLayout.getOffset(type));
+        if (source == target) {
+            continue;
+        }
+
+        //target precedes source, hence a chunk only overwrites source words which have already been read
+        auto const numWords = packedLayout.getArraySize(type) / sizeof(int4);
+        for (uint64_t chunkStart = 0; chunkStart < numWords; chunkStart += blockDim.x) {
+            auto const index = chunkStart + threadIdx.x;
+            int4 word;
+            if (index < numWords) {
+                word = source[index];
+            }
+            __syncthreads();
+            if (index < numWords) {
+                target[index] = word;
+            }
+            __syncthreads();
+        }
+    }
+}
 
 /************************************************************************/
 /* Main      															*/
 /************************************************************************/
 
 __global__ void cudaGetSimulationAccessData(int2 rectUpperLeft, int2 rectLowerRight,
-    SimulationData data, DataAccessTO access)
+    SimulationData data, DataAccessTO access, AccessTOLayout layout)
 {
     *access.numClusters = 0;
     *access.numCells = 0;
@@ -325,6 +354,7 @@ __global__ void cudaGetSimulationAccessData(int2 rectUpperLeft, int2 rectLowerRi
     KERNEL_CALL(getClusterAccessData, data.size, rectUpperLeft, rectLowerRight, data.entities.clusterPointers, access);
     KERNEL_CALL(getClusterAccessData, data.size, rectUpperLeft, rectLowerRight, data.entities.clusterFreezedPointers, access);
     KERNEL_CALL(getParticleAccessData, rectUpperLeft, rectLowerRight, data, access);
+    KERNEL_CALL_1_BLOCK(packAccessData, access.buffer, layout);
 }
 
 __global__ void cudaSetSimulationAccessData(int2 rectUpperLeft, int2 rectLowerRight,
@@ -332,6 +362,7 @@ __global__ void cudaSetSimulationAccessData(int2 rectUpperLeft, int2 rectLowerRi
 {
     KERNEL_CALL_1_1(unfreeze, data);
     data.entities.clusterFreezedPointers.reset();
+    KERNEL_CALL(wakeUpAllRegions, data);
 
     KERNEL_CALL(filterClusters, rectUpperLeft, rectLowerRight, data.entities.clusterPointers);
     KERNEL_CALL(filterParticles, rectUpperLeft, rectLowerRight, data.entities.particlePointers);
@@ -346,10 +377,15 @@ __global__ void cudaClearData(SimulationData data)
     data.entities.cellPointers.reset();
     data.entities.tokenPointers.reset();
     data.entities.particlePointers.reset();
+    data.entities.clearedClusterPointers.reset();
+    data.entities.clearedParticlePointers.reset();
     data.entities.clusters.reset();
     data.entities.cells.reset();
+    data.entities.cellColdData.reset();
     data.entities.tokens.reset();
     data.entities.particles.reset();
+
+    KERNEL_CALL(wakeUpAllRegions, data);
 }
 
 __global__ void cudaSelectData(int2 pos, SimulationData data)
@@ -357,6 +393,7 @@ __global__ void cudaSelectData(int2 pos, SimulationData data)
     KERNEL_CALL(selectClusters, pos, data.entities.clusterPointers);
     KERNEL_CALL(selectClusters, pos, data.entities.clusterFreezedPointers);
     KERNEL_CALL(selectParticles, pos, data.entities.particlePointers);
+    KERNEL_CALL_1_1(wakeUpRegionsByUserAction, data);
 }
 
 __global__ void cudaDeselectData(SimulationData data)
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include "Base/HostDeviceFunctions.h"
+
+/**
+ * Layout of the access data (see DataAccessTO) in one contiguous buffer so that it can be transferred between host
+ * and device with few copies: a header with the numbers of elements is followed by the arrays, each aligned to
+ * Alignment bytes.
+ *
+ * The buffers which are filled by the kernels or by DataConverter have the layout for the maximum numbers of
+ * elements. Before a transfer the arrays are packed, i.e. moved to the positions of the layout for the actual numbers
+ * of elements in the header, such that the used bytes form one piece. Afterwards they are unpacked again if needed.
+ */
+class AccessTOLayout
+{
+public:
+    enum Array
+    {
+        Clusters = 0,
+        Cells,
+        Particles,
+        Tokens,
+        StringBytes,
+        NumArrays
+    };
+
+    static constexpr uint64_t Alignment = 16;
+
+    //located at the beginning of the buffer
+    struct Header
+    {
+        int numElements[NumArrays];
+    };
+
+    HOST_DEVICE_FUNCTION void init(uint64_t const (&elementSizes)[NumArrays], Header const& numElements)
+    {
+        auto offset = align(sizeof(Header));
+        for (int array = 0; array < NumArrays; ++array) {
+            _elementSizes[array] = elementSizes[array];
+            _numElements[array] = numElements.numElements[array];
+            _offsets[array] = offset;
+            offset += align(elementSizes[array] * numElements.numElements[array]);
+        }
+        _size = offset;
+    }
+
+    HOST_DEVICE_FUNCTION static Header& getHeader(unsigned char* buffer)
+    {
+        return *reinterpret_cast<Header*>(buffer);
+    }
+
+    //does not access the buffer, hence it can be used for device buffers on the host
+    HOST_DEVICE_FUNCTION static int* getNumElements(unsigned char* buffer, Array array)
+    {
+        return reinterpret_cast<int*>(buffer) + array;
+    }
+
+    //does not access the buffer, see getNumElements
+    template <typename T>
+    HOST_DEVICE_FUNCTION T* getArray(unsigned char* buffer, Array array) const
+    {
+        return reinterpret_cast<T*>(buffer + _offsets[array]);
+    }
+
+    HOST_DEVICE_FUNCTION int getNumElements(Array array) const { return _numElements[array]; }
+    HOST_DEVICE_FUNCTION uint64_t getOffset(Array array) const { return _offsets[array]; }
+
+    //aligned, i.e. including padding
+    HOST_DEVICE_FUNCTION uint64_t getArraySize(Array array) const
+    {
+        return align(_elementSizes[array] * _numElements[array]);
+    }
+
+    //size of the buffer
+    HOST_DEVICE_FUNCTION uint64_t getSize() const { return _size; }
+
+    //layout with the same element sizes for the numbers of elements in header
+    HOST_DEVICE_FUNCTION AccessTOLayout getPackedLayout(Header const& header) const
+    {
+        AccessTOLayout result;
+        result.init(_elementSizes, header);
+        return result;
+    }
+
+    //moves the arrays of a buffer with this layout in place to their positions in packedLayout
+    //packedLayout must not contain more elements than this layout
+    void pack(unsigned char* buffer, AccessTOLayout const& packedLayout) const
+    {
+        //ascending order since the arrays are moved towards the beginning of the buffer
+        for (int array = 0; array < NumArrays; ++array) {
+            auto const type = static_cast<Array>(array);
+            std::memmove(
+                buffer + packedLayout.getOffset(type), buffer + getOffset(type), packedLayout.getArraySize(type));
+        }
+    }
+
+    //inverse of pack
+    void unpack(unsigned char* buffer, AccessTOLayout const& packedLayout) const
+    {
+        for (int array = NumArrays - 1; array >= 0; --array) {
+            auto const type = static_cast<Array>(array);
+            std::memmove(
+                buffer + getOffset(type), buffer + packedLayout.getOffset(type), packedLayout.getArraySize(type));
+        }
+    }
+
+private:
+    HOST_DEVICE_FUNCTION static uint64_t align(uint64_t size)
+    {
+        return (size + Alignment - 1) / Alignment * Alignment;
+    }
+
+    uint64_t _elementSizes[NumArrays];
+    int _numElements[NumArrays];
+    uint64_t _offsets[NumArrays];
+    uint64_t _size;
+};
@@ -2,6 +2,7 @@
 
 #include <cuda_runtime.h>
 
+#include "AccessTOLayout.h"
 #include "CudaSimulation.cuh"
 
 #define MAX_TOKEN_MEM_SIZE 256
@@ -83,8 +84,10 @@ struct ClusterAccessTO
     ClusterMetadataAccessTO metadata;
 };
 
+//counters and arrays are located in buffer according to an AccessTOLayout
 struct DataAccessTO
 {
+    unsigned char* buffer = nullptr;
 	int* numClusters = nullptr;
 	ClusterAccessTO* clusters = nullptr;
 	int* numCells = nullptr;
@@ -98,7 +101,8 @@ struct DataAccessTO
 
 	bool operator==(DataAccessTO const& other) const
 	{
-		return numClusters == other.numClusters
+		return buffer == other.buffer
+            && numClusters == other.numClusters
 			&& clusters == other.clusters
 			&& numCells == other.numCells
 			&& cells == other.cells
@@ -111,3 +115,41 @@ struct DataAccessTO
 	}
 };
 
+inline AccessTOLayout calcAccessTOLayout(AccessTOLayout::Header const& numElements)
+{
+    uint64_t const elementSizes[AccessTOLayout::NumArrays] = {
+        sizeof(ClusterAccessTO), sizeof(CellAccessTO), sizeof(ParticleAccessTO), sizeof(TokenAccessTO), sizeof(char)};
+    AccessTOLayout result;
+    result.init(elementSizes, numElements);
+    return result;
+}
+
+//layout for the maximum numbers of elements
+inline AccessTOLayout calcAccessTOLayout(CudaConstants const& cudaConstants)
+{
+    AccessTOLayout::Header numElements;
+    numElements.numElements[AccessTOLayout::Clusters] = cudaConstants.MAX_CLUSTERS;
+    numElements.numElements[AccessTOLayout::Cells] = cudaConstants.MAX_CELLS;
+    numElements.numElements[AccessTOLayout::Particles] = cudaConstants.MAX_PARTICLES;
+    numElements.numElements[AccessTOLayout::Tokens] = cudaConstants.MAX_TOKENS;
+    numElements.numElements[AccessTOLayout::StringBytes] = cudaConstants.METADATA_DYNAMIC_MEMORY_SIZE;
+    return calcAccessTOLayout(numElements);
+}
+
+//buffer is not accessed, hence it may be located on the device
+inline DataAccessTO createDataAccessTO(unsigned char* buffer, AccessTOLayout const& layout)
+{
+    DataAccessTO result;
+    result.buffer = buffer;
+    result.numClusters = AccessTOLayout::getNumElements(buffer, AccessTOLayout::Clusters);
+    result.clusters = layout.getArray<ClusterAccessTO>(buffer, AccessTOLayout::Clusters);
+    result.numCells = AccessTOLayout::getNumElements(buffer, AccessTOLayout::Cells);
+    result.cells = layout.getArray<CellAccessTO>(buffer, AccessTOLayout::Cells);
+    result.numParticles = AccessTOLayout::getNumElements(buffer, AccessTOLayout::Particles);
+    result.particles = layout.getArray<ParticleAccessTO>(buffer, AccessTOLayout::Particles);
+    result.numTokens = AccessTOLayout::getNumElements(buffer, AccessTOLayout::Tokens);
+    result.tokens = layout.getArray<TokenAccessTO>(buffer, AccessTOLayout::Tokens);
+    result.numStringBytes = AccessTOLayout::getNumElements(buffer, AccessTOLayout::StringBytes);
+    result.stringBytes = layout.getArray<char>(buffer, AccessTOLayout::StringBytes);
+    return result;
+}
@@ -6,11 +6,15 @@
 #include <device_launch_parameters.h>
 #include <helper_cuda.h>
 
+#include "Base/DeterministicMath.h"
+#include "Base/Philox.h"
+
 #include "Array.cuh"
+#include "ConstantMemory.cuh"
 #include "CudaConstants.h"
 #include "CudaMemoryManager.cuh"
 #include "Definitions.cuh"
-#include "HashSet.cuh"
+#include "HashSet.h"
 
 __device__ inline float toFloat(int value)
 {
@@ -30,72 +34,124 @@ struct PartitionData
     __inline__ __device__ int numElements() const { return endIndex - startIndex + 1; }
 };
 
+/**
+ * Counter-based generator (see Philox): every GPU thread draws from its own stream with its own counter, so no
+ * atomics are needed and the numbers are reproducible for a given seed and thread assignment.
+ */
+namespace RandomPurpose
+{
+    enum Type
+    {
+        Creation,
+        Decomposition,
+        CellDestruction,
+        CellFunction,
+        Radiation,
+        MaxForceDecay,
+        TokenUsageDecay,
+        Transformation,
+        ConstructionMutation,
+        StaticDataMutation,
+        MutableDataMutation,
+        TokenMemoryMutation,
+        IdCreation
+    };
+}
+
 class CudaNumberGenerator
 {
 private:
-    unsigned int* _currentIndex;
-    int* _array;
-    int _size;
+    uint64_t _seed;
+    int _numCounters;
+    uint64_t* _counters;    //one per thread of a kernel launch
+
+    //deterministic mode: numbers are drawn from the stream of the entity a thread is processing
+    uint64_t* _entityIds;
+    uint64_t* _entityCounters;
 
     uint64_t* _currentId;
 
 public:
-    void init(int size)
+    void init(int numThreads, uint64_t seed)
     {
-        _size = size;
+        _seed = seed;
+        _numCounters = numThreads;
 
-        CudaMemoryManager::getInstance().acquireMemory<unsigned int>(1, _currentIndex);
-        CudaMemoryManager::getInstance().acquireMemory<int>(size, _array);
+        CudaMemoryManager::getInstance().acquireMemory<uint64_t>(numThreads, _counters);
+        CudaMemoryManager::getInstance().acquireMemory<uint64_t>(numThreads, _entityIds);
+        CudaMemoryManager::getInstance().acquireMemory<uint64_t>(numThreads, _entityCounters);
         CudaMemoryManager::getInstance().acquireMemory<uint64_t>(1, _currentId);
 
-        checkCudaErrors(cudaMemset(_currentIndex, 0, sizeof(unsigned int)));
+        checkCudaErrors(cudaMemset(_counters, 0, sizeof(uint64_t) * numThreads));
+        checkCudaErrors(cudaMemset(_entityIds, 0, sizeof(uint64_t) * numThreads));
+        checkCudaErrors(cudaMemset(_entityCounters, 0, sizeof(uint64_t) * numThreads));
         uint64_t hostCurrentId = 1;
         checkCudaErrors(cudaMemcpy(_currentId, &hostCurrentId, sizeof(uint64_t), cudaMemcpyHostToDevice));
-
-        std::vector<int> randomNumbers(size);
-        for (int i = 0; i < size; ++i) {
-            randomNumbers[i] = rand();
-        }
-        checkCudaErrors(cudaMemcpy(_array, randomNumbers.data(), sizeof(int) * size, cudaMemcpyHostToDevice));
     }
 
 
     __device__ __inline__ int random(int maxVal)
     {
-        int number = getRandomNumber();
-        return number % (maxVal + 1);
+        return static_cast<int>(Philox::toRange(getRandomNumber(), static_cast<uint32_t>(maxVal) + 1));
     }
 
     __device__ __inline__ float random(float maxVal)
     {
-        int number = getRandomNumber();
-        return maxVal * static_cast<float>(number) / RAND_MAX;
+        return maxVal * Philox::toFloat(getRandomNumber());
     }
 
     __device__ __inline__ float random()
     {
-        int number = getRandomNumber();
-        return static_cast<float>(number) / RAND_MAX;
+        return Philox::toFloat(getRandomNumber());
     }
 
-    __device__ __inline__ uint64_t createNewId_kernel() { return atomicAdd(_currentId, 1); }
+    //has only an effect in deterministic mode: following numbers of the calling thread depend on entity, timestep,
+    //purpose and index instead of on the thread index (up to 256 numbers per sub-stream)
+    __device__ __inline__ void beginEntity(uint64_t entityId, int timestep, RandomPurpose::Type purpose, int index = 0)
+    {
+        if (cudaExecutionParameters.deterministic) {
+            auto const threadIndex = getThreadIndex();
+            _entityIds[threadIndex] = entityId;
+            _entityCounters[threadIndex] = (static_cast<uint64_t>(timestep) << 32)
+                | (static_cast<uint64_t>(purpose) << 24) | (static_cast<uint64_t>(index & 0xffff) << 8);
+        }
+    }
+
+    //deterministic mode: ids are drawn from the entity stream, tagged by the highest bit, since the order of the
+    //atomic counter depends on the thread scheduling. Hence beginEntity has to be called for the creating entity first.
+    __device__ __inline__ uint64_t createNewId_kernel()
+    {
+        if (cudaExecutionParameters.deterministic) {
+            auto const high = static_cast<uint64_t>(getRandomNumber());
+            auto const low = static_cast<uint64_t>(getRandomNumber());
+            return (high << 32) | low | Philox::EntityStreamTag;
+        }
+        return atomicAdd(_currentId, 1);
+    }
 
     void free()
     {
-        CudaMemoryManager::getInstance().freeMemory(_currentIndex);
-        CudaMemoryManager::getInstance().freeMemory(_array);
+        CudaMemoryManager::getInstance().freeMemory(_counters);
+        CudaMemoryManager::getInstance().freeMemory(_entityIds);
+        CudaMemoryManager::getInstance().freeMemory(_entityCounters);
         CudaMemoryManager::getInstance().freeMemory(_currentId);
-
-        cudaFree(_currentId);
-        cudaFree(_currentIndex);
-        cudaFree(_array);
     }
 
 private:
-    __device__ __inline__ int getRandomNumber()
+    __device__ __inline__ int getThreadIndex() const
+    {
+        return (blockIdx.x * blockDim.x + threadIdx.x) % _numCounters;
+    }
+
+    __device__ __inline__ uint32_t getRandomNumber()
     {
-        int index = atomicInc(_currentIndex, _size - 1);
-        return _array[index];
+        auto const threadIndex = getThreadIndex();
+        if (cudaExecutionParameters.deterministic) {
+            auto const counter = _entityCounters[threadIndex]++;
+            return Philox::generate(_seed, _entityIds[threadIndex] ^ Philox::EntityStreamTag, counter).values[0];
+        }
+        auto const counter = _counters[threadIndex]++;
+        return Philox::generate(_seed, Philox::DeviceStreamOffset + threadIndex, counter).values[0];
     }
 };
 
@@ -113,6 +169,42 @@ __device__ __inline__ PartitionData calcPartition(int numEntities, int division,
     return result;
 }
 
+constexpr int MaxThreadsPerBlock = 1024;
+
+//exclusive scan by a single block: every thread sums up a contiguous range of values, offsets has numValues + 1
+//elements
+template <typename Func>
+__device__ __inline__ void scanExclusive_block(int numValues, int* offsets, Func const& getValue)
+{
+    __shared__ int rangeOffsets[MaxThreadsPerBlock + 1];
+
+    auto const partition = calcPartition(numValues, threadIdx.x, blockDim.x);
+
+    auto rangeSum = 0;
+    for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+        rangeSum += getValue(index);
+    }
+    rangeOffsets[threadIdx.x + 1] = rangeSum;
+    __syncthreads();
+
+    if (0 == threadIdx.x) {
+        rangeOffsets[0] = 0;
+        for (int index = 1; index <= blockDim.x; ++index) {
+            rangeOffsets[index] += rangeOffsets[index - 1];
+        }
+        offsets[numValues] = rangeOffsets[blockDim.x];
+    }
+    __syncthreads();
+
+    auto offset = rangeOffsets[threadIdx.x];
+    for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+        auto const value = getValue(index);
+        offsets[index] = offset;
+        offset += value;
+    }
+    __syncthreads();
+}
+
 __host__ __device__ __inline__ int2 toInt2(float2 const& p)
 {
     return {static_cast<int>(p.x), static_cast<int>(p.y)};
@@ -123,6 +215,18 @@ __host__ __device__ __inline__ float2 toFloat2(int2 const& p)
     return {static_cast<float>(p.x), static_cast<float>(p.y)};
 }
 
+template <>
+struct HashKey<int2>
+{
+    static constexpr unsigned long long Empty = 0x8000000080000000ull;  //{INT_MIN, INT_MIN} cannot be inserted
+
+    __host__ __device__ __inline__ static unsigned long long encode(int2 const& key)
+    {
+        return static_cast<unsigned int>(key.x)
+            | (static_cast<unsigned long long>(static_cast<unsigned int>(key.y)) << 32);
+    }
+};
+
 __host__ __device__ __inline__ int floorInt(float v)
 {
     int result = static_cast<int>(v);
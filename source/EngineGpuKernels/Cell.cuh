@@ -19,6 +19,21 @@ struct CellMetadata
     char* sourceCode;
 };
 
+//data only needed by cell functions, rendering and data access, stored apart from Cell so that the per-step passes
+//(movement, collision, token spreading) read fewer bytes per cell
+struct CellColdData
+{
+    unsigned char numStaticBytes;
+    char staticData[MAX_CELL_STATIC_BYTES];
+    unsigned char numMutableBytes;
+    char mutableData[MAX_CELL_MUTABLE_BYTES];
+    CellMetadata metadata;
+
+    //pixel and color of the last drawing into the pixel image (see TileChanges)
+    int drawnPixel;
+    unsigned int drawnColor;
+};
+
 struct Cell
 {
     uint64_t id;
@@ -31,12 +46,8 @@ struct Cell
     int maxConnections;
     int numConnections;
     Cell* connections[MAX_CELL_BONDS];
-    unsigned char numStaticBytes;
-    char staticData[MAX_CELL_STATIC_BYTES];
-    unsigned char numMutableBytes;
-    char mutableData[MAX_CELL_MUTABLE_BYTES];
     int tokenUsages;
-    CellMetadata metadata;
+    CellColdData* coldData;    //element of Entities::cellColdData
 
     //auxiliary data
     int locked;	//0 = unlocked, 1 = locked
@@ -83,11 +94,17 @@ struct Cell
 
     __device__ __inline__ void setEnergy_safe(float value)
     {
+        if (cudaExecutionParameters.deterministic) {
+            value = DeterministicMath::snapToGrid(value, DeterministicMath::EnergyFractionBits);
+        }
         atomicExch(&_energy, value);
     }
 
     __device__ __inline__ void changeEnergy_safe(float changeValue)
     {
+        if (cudaExecutionParameters.deterministic) {
+            changeValue = DeterministicMath::snapToGrid(changeValue, DeterministicMath::EnergyFractionBits);
+        }
         atomicAdd(&_energy, changeValue);
     }
 
@@ -142,12 +159,3 @@ private:
     int _fused;
 };
 
-template<>
-struct HashFunctor<Cell*>
-{
-    __device__ __inline__ int operator()(Cell* const& cell)
-    {
-        return abs(static_cast<int>(cell->id));
-    }
-};
-
@@ -30,12 +30,12 @@ __inline__ __device__ void CellComputerFunction::processing(Token* token)
     auto cell = token->cell;
     bool condTable[MAX_CELL_STATIC_BYTES / 3 + 1];
     int condPointer(0);
-    int numStaticBytes = min(cell->numStaticBytes, cudaSimulationParameters.cellFunctionComputerMaxInstructions * 3);
+    int numStaticBytes = min(cell->coldData->numStaticBytes, cudaSimulationParameters.cellFunctionComputerMaxInstructions * 3);
     for (int instructionPointer = 0; instructionPointer < numStaticBytes; ) {
 
         //decode instruction
         InstructionCoded instruction;
-        readInstruction(cell->staticData, instructionPointer, instruction);
+        readInstruction(cell->coldData->staticData, instructionPointer, instruction);
 
         //operand 1: pointer to mem
         uint8_t opPointer1 = 0;
@@ -59,7 +59,7 @@ __inline__ __device__ void CellComputerFunction::processing(Token* token)
             instruction.operand2 = token->memory[convertToAddress(instruction.operand2, cudaSimulationParameters.tokenMemorySize)];
         }
         if (instruction.opType2 == Enums::ComputerOptype::CMEM)
-            instruction.operand2 = cell->mutableData[convertToAddress(instruction.operand2, cudaSimulationParameters.cellFunctionComputerCellMemorySize)];
+            instruction.operand2 = cell->coldData->mutableData[convertToAddress(instruction.operand2, cudaSimulationParameters.cellFunctionComputerCellMemorySize)];
 
         //execute instruction
         bool execute = true;
@@ -68,29 +68,29 @@ __inline__ __device__ void CellComputerFunction::processing(Token* token)
                 execute = false;
         if (execute) {
             if (instruction.operation == Enums::ComputerOperation::MOV)
-                setMemoryByte(token->memory, cell->mutableData, opPointer1, instruction.operand2, memType);
+                setMemoryByte(token->memory, cell->coldData->mutableData, opPointer1, instruction.operand2, memType);
             if (instruction.operation == Enums::ComputerOperation::ADD)
-                setMemoryByte(token->memory, cell->mutableData, opPointer1, getMemoryByte(token->memory, cell->mutableData, opPointer1, memType) + instruction.operand2, memType);
+                setMemoryByte(token->memory, cell->coldData->mutableData, opPointer1, getMemoryByte(token->memory, cell->coldData->mutableData, opPointer1, memType) + instruction.operand2, memType);
             if (instruction.operation == Enums::ComputerOperation::SUB)
-                setMemoryByte(token->memory, cell->mutableData, opPointer1, getMemoryByte(token->memory, cell->mutableData, opPointer1, memType) - instruction.operand2, memType);
+                setMemoryByte(token->memory, cell->coldData->mutableData, opPointer1, getMemoryByte(token->memory, cell->coldData->mutableData, opPointer1, memType) - instruction.operand2, memType);
             if (instruction.operation == Enums::ComputerOperation::MUL)
-                setMemoryByte(token->memory, cell->mutableData, opPointer1, getMemoryByte(token->memory, cell->mutableData, opPointer1, memType) * instruction.operand2, memType);
+                setMemoryByte(token->memory, cell->coldData->mutableData, opPointer1, getMemoryByte(token->memory, cell->coldData->mutableData, opPointer1, memType) * instruction.operand2, memType);
             if (instruction.operation == Enums::ComputerOperation::DIV) {
                 if (instruction.operand2 > 0)
-                    setMemoryByte(token->memory, cell->mutableData, opPointer1, getMemoryByte(token->memory, cell->mutableData, opPointer1, memType) / instruction.operand2, memType);
+                    setMemoryByte(token->memory, cell->coldData->mutableData, opPointer1, getMemoryByte(token->memory, cell->coldData->mutableData, opPointer1, memType) / instruction.operand2, memType);
                 else
-                    setMemoryByte(token->memory, cell->mutableData, opPointer1, 0, memType);
+                    setMemoryByte(token->memory, cell->coldData->mutableData, opPointer1, 0, memType);
             }
             if (instruction.operation == Enums::ComputerOperation::XOR)
-                setMemoryByte(token->memory, cell->mutableData, opPointer1, getMemoryByte(token->memory, cell->mutableData, opPointer1, memType) ^ instruction.operand2, memType);
+                setMemoryByte(token->memory, cell->coldData->mutableData, opPointer1, getMemoryByte(token->memory, cell->coldData->mutableData, opPointer1, memType) ^ instruction.operand2, memType);
             if (instruction.operation == Enums::ComputerOperation::OR)
-                setMemoryByte(token->memory, cell->mutableData, opPointer1, getMemoryByte(token->memory, cell->mutableData, opPointer1, memType) | instruction.operand2, memType);
+                setMemoryByte(token->memory, cell->coldData->mutableData, opPointer1, getMemoryByte(token->memory, cell->coldData->mutableData, opPointer1, memType) | instruction.operand2, memType);
             if (instruction.operation == Enums::ComputerOperation::AND)
-                setMemoryByte(token->memory, cell->mutableData, opPointer1, getMemoryByte(token->memory, cell->mutableData, opPointer1, memType) & instruction.operand2, memType);
+                setMemoryByte(token->memory, cell->coldData->mutableData, opPointer1, getMemoryByte(token->memory, cell->coldData->mutableData, opPointer1, memType) & instruction.operand2, memType);
         }
 
         //if instructions
-        instruction.operand1 = getMemoryByte(token->memory, cell->mutableData, opPointer1, memType);
+        instruction.operand1 = getMemoryByte(token->memory, cell->coldData->mutableData, opPointer1, memType);
         if (instruction.operation == Enums::ComputerOperation::IFG) {
             if (instruction.operand1 > instruction.operand2)
                 condTable[condPointer] = true;
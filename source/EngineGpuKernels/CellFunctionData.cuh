@@ -1,18 +1,31 @@
 #pragma once
 
+#include "EngineInterface/ElementaryTypes.h"
+
+#include "Definitions.cuh"
+#include "Array.cuh"
 #include "MapSectionCollector.cuh"
 
 struct CellFunctionData
 {
     MapSectionCollector mapSectionCollector;
+    Array<Token*> weaponTokens;    //deterministic mode: tokens whose strikes are applied after token processing
+    unsigned long long* numProcessedTokens;     //[cell function], since simulation start
 
-    __host__ __inline__ void init(int2 const& universeSize)
+    __host__ __inline__ void init(int2 const& universeSize, int maxClusters, int maxTokens)
     {
-        mapSectionCollector.init(universeSize, 50);
+        mapSectionCollector.init(universeSize, 50, maxClusters);
+        weaponTokens.init(maxTokens);
+        CudaMemoryManager::getInstance().acquireMemory<unsigned long long>(
+            Enums::CellFunction::_COUNTER, numProcessedTokens);
+        checkCudaErrors(
+            cudaMemset(numProcessedTokens, 0, sizeof(unsigned long long) * Enums::CellFunction::_COUNTER));
     }
 
     __host__ __inline__ void free()
     {
         mapSectionCollector.free();
+        weaponTokens.free();
+        CudaMemoryManager::getInstance().freeMemory(numProcessedTokens);
     }
 };
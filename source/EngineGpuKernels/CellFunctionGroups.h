@@ -0,0 +1,86 @@
+#pragma once
+
+#include "Base/HostDeviceFunctions.h"
+#include "EngineInterface/ElementaryTypes.h"
+
+/**
+ * Token indices of a cluster ordered by the cell function of their cells, so that neighboring threads process
+ * tokens of the same cell function instead of branching into different functions. Within a group the tokens keep
+ * their order (stable counting sort), since constructors, sensors and communicators process the tokens of a cluster
+ * one after another.
+ *
+ * Passes: countToken for every token, calcOffsets, insertToken for every token with its rank among the preceding
+ * tokens of the same group. The ranks are calculated by sort on the host and by warp votes on the device.
+ */
+class CellFunctionGroups
+{
+public:
+    static constexpr int NumGroups = Enums::CellFunction::_COUNTER;
+
+    //initial content: counts = 0
+    struct Memory
+    {
+        int* counts = nullptr;          //NumGroups elements, number of inserted tokens after calcOffsets
+        int* offsets = nullptr;         //NumGroups + 1 elements
+        int* tokenIndices = nullptr;    //numTokens elements
+    };
+
+    HOST_DEVICE_FUNCTION void init(Memory const& memory, int numTokens)
+    {
+        _memory = memory;
+        _numTokens = numTokens;
+    }
+
+    HOST_DEVICE_FUNCTION Memory const& getMemory() const { return _memory; }
+    HOST_DEVICE_FUNCTION int getNumTokens() const { return _numTokens; }
+    HOST_DEVICE_FUNCTION int getNumTokens(int group) const
+    {
+        return _memory.offsets[group + 1] - _memory.offsets[group];
+    }
+
+    //index in [0, getNumTokens()) runs through all groups
+    HOST_DEVICE_FUNCTION int getTokenIndex(int index) const { return _memory.tokenIndices[index]; }
+    HOST_DEVICE_FUNCTION int getTokenIndex(int group, int index) const
+    {
+        return _memory.tokenIndices[_memory.offsets[group] + index];
+    }
+
+    //pass 1
+    HOST_DEVICE_FUNCTION void countToken(int group) { HostDeviceAtomics::add(&_memory.counts[group], 1); }
+
+    //pass 2, single thread
+    HOST_DEVICE_FUNCTION void calcOffsets()
+    {
+        auto offset = 0;
+        for (int group = 0; group < NumGroups; ++group) {
+            _memory.offsets[group] = offset;
+            offset += _memory.counts[group];
+            _memory.counts[group] = 0;
+        }
+        _memory.offsets[NumGroups] = offset;
+    }
+
+    //pass 3
+    HOST_DEVICE_FUNCTION void insertToken(int group, int rank, int tokenIndex)
+    {
+        _memory.tokenIndices[_memory.offsets[group] + rank] = tokenIndex;
+    }
+
+    //sequential version of all passes for the host
+    template <typename Func>
+    HOST_DEVICE_FUNCTION void sort(Func const& getGroup)
+    {
+        for (int tokenIndex = 0; tokenIndex < _numTokens; ++tokenIndex) {
+            countToken(getGroup(tokenIndex));
+        }
+        calcOffsets();
+        for (int tokenIndex = 0; tokenIndex < _numTokens; ++tokenIndex) {
+            auto const group = getGroup(tokenIndex);
+            insertToken(group, _memory.counts[group]++, tokenIndex);
+        }
+    }
+
+private:
+    Memory _memory;
+    int _numTokens = 0;
+};
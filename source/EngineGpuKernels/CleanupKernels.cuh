@@ -8,9 +8,26 @@
 #include "Cell.cuh"
 #include "Token.cuh"
 #include "FreezingKernels.cuh"
+#include "Compaction.h"
 
-namespace {
-    __device__ const float FillLevelFactor = 2.0f / 3.0f;
+template<typename T>
+__global__ void collectMovedPointers(IncrementalCompaction<T*> compaction)
+{
+    auto const tailBlock = calcPartition(
+        compaction.getNumTailEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+    for (int tailIndex = tailBlock.startIndex; tailIndex <= tailBlock.endIndex; ++tailIndex) {
+        compaction.collectMovedEntry(tailIndex);
+    }
+}
+
+template<typename T>
+__global__ void fillClearedPointers(IncrementalCompaction<T*> compaction, int numClearedPointers)
+{
+    auto const clearedBlock =
+        calcPartition(numClearedPointers, threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+    for (int index = clearedBlock.startIndex; index <= clearedBlock.endIndex; ++index) {
+        compaction.fillGap(index);
+    }
 }
 
 __global__ void cleanupParticlePointers(SimulationData data)
@@ -158,15 +175,17 @@ __global__ void cleanupCellPointers(Array<Cluster*> clusterPointers, Array<Cell*
     }
 }
 
-__global__ void cleanupCells(Array<Cluster*> clusterPointers, Array<Cell> cells)
+__global__ void cleanupCells(Array<Cluster*> clusterPointers, Array<Cell> cells, Array<CellColdData> cellColdData)
 {
     PartitionData clusterBlock = calcPartition(clusterPointers.getNumEntries(), blockIdx.x, gridDim.x);
     for (int clusterIndex = clusterBlock.startIndex; clusterIndex <= clusterBlock.endIndex; ++clusterIndex) {
         auto& cluster = clusterPointers.at(clusterIndex);
 
         __shared__ Cell* newCells;
+        __shared__ CellColdData* newCellColdData;
         if (0 == threadIdx.x) {
             newCells = cells.getNewSubarray(cluster->numCellPointers);
+            newCellColdData = cellColdData.getNewSubarray(cluster->numCellPointers);
         }
         __syncthreads();
 
@@ -177,6 +196,8 @@ __global__ void cleanupCells(Array<Cluster*> clusterPointers, Array<Cell> cells)
             auto& origCellPtr = cluster->cellPointers[cellIndex];
             auto& newCell = newCells[cellIndex];
             newCell = *origCellPtr;
+            newCellColdData[cellIndex] = *newCell.coldData;
+            newCell.coldData = &newCellColdData[cellIndex];
             origCellPtr = &newCells[cellIndex];
 
             for (int i = 0; i < newCell.numConnections; ++i) {
@@ -259,6 +280,12 @@ __global__ void cleanupParticleMap(SimulationData data)
     data.particleMap.cleanup_system();
 }
 
+__global__ void releaseMapTiles(SimulationData data)
+{
+    data.cellMap.releaseTiles_system();
+    data.particleMap.releaseTiles_system();
+}
+
 __global__ void cleanupMetadata(Array<Cluster*> clusterPointers, DynamicMemory strings)
 {
     auto const clusterBlock = calcPartition(clusterPointers.getNumEntries(), blockIdx.x, gridDim.x);
@@ -278,94 +305,201 @@ __global__ void cleanupMetadata(Array<Cluster*> clusterPointers, DynamicMemory s
         for (int cellIndex = cellBlock.startIndex; cellIndex <= cellBlock.endIndex; ++cellIndex) {
             auto& cell = cluster->cellPointers[cellIndex];
             {
-                auto const len = cell->metadata.nameLen;
+                auto const len = cell->coldData->metadata.nameLen;
                 auto newName = strings.getArray<char>(len);
                 for (int i = 0; i < len; ++i) {
-                    newName[i] = cell->metadata.name[i];
+                    newName[i] = cell->coldData->metadata.name[i];
                 }
-                cell->metadata.name = newName;
+                cell->coldData->metadata.name = newName;
             }
             {
-                auto const len = cell->metadata.descriptionLen;
+                auto const len = cell->coldData->metadata.descriptionLen;
                 auto newDescription = strings.getArray<char>(len);
                 for (int i = 0; i < len; ++i) {
-                    newDescription[i] = cell->metadata.description[i];
+                    newDescription[i] = cell->coldData->metadata.description[i];
                 }
-                cell->metadata.description = newDescription;
+                cell->coldData->metadata.description = newDescription;
             }
             {
-                auto const len = cell->metadata.sourceCodeLen;
+                auto const len = cell->coldData->metadata.sourceCodeLen;
                 auto newSourceCode = strings.getArray<char>(len);
                 for (int i = 0; i < len; ++i) {
-                    newSourceCode[i] = cell->metadata.sourceCode[i];
+                    newSourceCode[i] = cell->coldData->metadata.sourceCode[i];
                 }
-                cell->metadata.sourceCode = newSourceCode;
+                cell->coldData->metadata.sourceCode = newSourceCode;
             }
         }
     }
 }
 
+__global__ void countLiveEntities(Array<Cluster*> clusterPointers, Array<int> counters)
+{
+    PartitionData clusterBlock = calcPartition(
+        clusterPointers.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+
+    int numCells = 0;
+    int numTokens = 0;
+    for (int clusterIndex = clusterBlock.startIndex; clusterIndex <= clusterBlock.endIndex; ++clusterIndex) {
+        auto const& cluster = clusterPointers.at(clusterIndex);
+        numCells += cluster->numCellPointers;
+        numTokens += cluster->numTokenPointers;
+    }
+    atomicAdd(&counters.at(Entities::LiveCells), numCells);
+    atomicAdd(&counters.at(Entities::LiveTokens), numTokens);
+}
+
 /************************************************************************/
 /* Main                                                                 */
 /************************************************************************/
 
+//only the entries recorded in clearedPointers are touched instead of copying the whole array
+template<typename T>
+__device__ void compactPointers(
+    Array<T*>& pointers,
+    Array<int>& clearedPointers,
+    Array<int>& movedPointers,
+    Array<int>& counters)
+{
+    auto const numClearedPointers = clearedPointers.getNumEntries();
+    if (0 == numClearedPointers) {
+        return;
+    }
+    counters.at(0) = 0;
+    counters.at(1) = 0;
+
+    typename IncrementalCompaction<T*>::Memory memory;
+    memory.entries = pointers.getArrayForDevice();
+    memory.clearedIndices = clearedPointers.getArrayForDevice();
+    memory.movedIndices = movedPointers.getArrayForDevice();
+    memory.numMovedIndices = &counters.at(0);
+    memory.numFilledGaps = &counters.at(1);
+
+    IncrementalCompaction<T*> compaction;
+    compaction.init(memory, pointers.getNumEntries(), numClearedPointers);
+    KERNEL_CALL(collectMovedPointers<T>, compaction);
+    KERNEL_CALL(fillClearedPointers<T>, compaction, numClearedPointers);
+
+    pointers.setNumEntries(compaction.getNewNumEntries());
+    clearedPointers.reset();
+}
+
 __global__ void cleanupAfterSimulation(SimulationData data)
 {
     KERNEL_CALL(cleanupCellMap, data);  //should be called before cleanupClusters and cleanupCells due to freezing
     KERNEL_CALL(cleanupParticleMap, data);
-
-    data.entitiesForCleanup.clusterPointers.reset();
-    KERNEL_CALL(cleanupClusterPointers, data.entities.clusterPointers, data.entitiesForCleanup.clusterPointers);
-    data.entities.clusterPointers.swapContent(data.entitiesForCleanup.clusterPointers);
-
-    data.entitiesForCleanup.particlePointers.reset();
-    KERNEL_CALL(cleanupParticlePointers, data);
-    data.entities.particlePointers.swapContent(data.entitiesForCleanup.particlePointers);
+    KERNEL_CALL(releaseMapTiles, data);
+
+    compactPointers(
+        data.entities.clusterPointers,
+        data.entities.clearedClusterPointers,
+        data.entitiesForCleanup.clearedClusterPointers,
+        data.entitiesForCleanup.compactionCounters);
+    compactPointers(
+        data.entities.particlePointers,
+        data.entities.clearedParticlePointers,
+        data.entitiesForCleanup.clearedParticlePointers,
+        data.entitiesForCleanup.compactionCounters);
 
     auto const freezingTimesteps =
         cudaExecutionParameters.activateFreezing ? cudaExecutionParameters.freezingTimesteps : 1;
     if ((data.timestep % freezingTimesteps) == 0) {
-        KERNEL_CALL_1_1(unfreeze, data);
-        data.entities.clusterFreezedPointers.reset();
-        if (data.entities.particles.getNumEntries() > cudaConstants.MAX_PARTICLES * FillLevelFactor) {
+
+        //clusters of sleeping regions stay frozen, hence the compactions below include the frozen clusters
+        if (cudaExecutionParameters.regionSleeping) {
+            if (cudaExecutionParameters.activateFreezing) {
+                resumeClusters(data, false);
+            }
+        } else {
+            KERNEL_CALL_1_1(unfreeze, data);
+            data.entities.clusterFreezedPointers.reset();
+        }
+        auto& frozenClusters = data.entities.clusterFreezedPointers;
+        auto const hasFrozenClusters = frozenClusters.getNumEntries() > 0;
+
+        auto& liveEntityCounters = data.entitiesForCleanup.liveEntityCounters;
+        liveEntityCounters.at(Entities::LiveCells) = 0;
+        liveEntityCounters.at(Entities::LiveTokens) = 0;
+        KERNEL_CALL(countLiveEntities, data.entities.clusterPointers, liveEntityCounters);
+        if (hasFrozenClusters) {
+            KERNEL_CALL(countLiveEntities, frozenClusters, liveEntityCounters);
+        }
+        auto const numCells = liveEntityCounters.at(Entities::LiveCells);
+        auto const numTokens = liveEntityCounters.at(Entities::LiveTokens);
+
+        CompactionPolicy const policy(cudaConstants.MAX_FILL_LEVEL_PERCENT, cudaConstants.MAX_FRAGMENTATION_PERCENT);
+        auto const numClusters = data.entities.clusterPointers.getNumEntries() + frozenClusters.getNumEntries();
+        if (policy.isCompactionRequired(
+                data.entities.particles.getNumEntries(),
+                data.entities.particlePointers.getNumEntries(),
+                cudaConstants.MAX_PARTICLES)) {
             data.entitiesForCleanup.particles.reset();
             KERNEL_CALL(cleanupParticles, data);
             data.entities.particles.swapContent(data.entitiesForCleanup.particles);
         }
 
-        if (data.entities.clusters.getNumEntries() > cudaConstants.MAX_CLUSTERS * FillLevelFactor) {
+        if (policy.isCompactionRequired(
+                data.entities.clusters.getNumEntries(), numClusters, cudaConstants.MAX_CLUSTERS)) {
             data.entitiesForCleanup.clusters.reset();
             KERNEL_CALL(cleanupClusters, data.entities.clusterPointers, data.entitiesForCleanup.clusters);
+            if (hasFrozenClusters) {
+                KERNEL_CALL(cleanupClusters, frozenClusters, data.entitiesForCleanup.clusters);
+            }
             data.entities.clusters.swapContent(data.entitiesForCleanup.clusters);
         }
 
-        if (data.entities.cellPointers.getNumEntries() > cudaConstants.MAX_CELLPOINTERS * FillLevelFactor) {
+        if (policy.isCompactionRequired(
+                data.entities.cellPointers.getNumEntries(), numCells, cudaConstants.MAX_CELLPOINTERS)) {
             data.entitiesForCleanup.cellPointers.reset();
             KERNEL_CALL(cleanupCellPointers, data.entities.clusterPointers, data.entitiesForCleanup.cellPointers);
+            if (hasFrozenClusters) {
+                KERNEL_CALL(cleanupCellPointers, frozenClusters, data.entitiesForCleanup.cellPointers);
+            }
             data.entities.cellPointers.swapContent(data.entitiesForCleanup.cellPointers);
         }
 
-        if (data.entities.cells.getNumEntries() > cudaConstants.MAX_CELLS * FillLevelFactor) {
+        if (policy.isCompactionRequired(data.entities.cells.getNumEntries(), numCells, cudaConstants.MAX_CELLS)) {
             data.entitiesForCleanup.cells.reset();
-            KERNEL_CALL(cleanupCells, data.entities.clusterPointers, data.entitiesForCleanup.cells);
+            data.entitiesForCleanup.cellColdData.reset();
+            KERNEL_CALL(
+                cleanupCells,
+                data.entities.clusterPointers,
+                data.entitiesForCleanup.cells,
+                data.entitiesForCleanup.cellColdData);
+            if (hasFrozenClusters) {
+                KERNEL_CALL(
+                    cleanupCells, frozenClusters, data.entitiesForCleanup.cells, data.entitiesForCleanup.cellColdData);
+            }
             data.entities.cells.swapContent(data.entitiesForCleanup.cells);
+            data.entities.cellColdData.swapContent(data.entitiesForCleanup.cellColdData);
         }
-        
-        if (data.entities.tokenPointers.getNumEntries() > cudaConstants.MAX_TOKENPOINTERS * FillLevelFactor) {
+
+        if (policy.isCompactionRequired(
+                data.entities.tokenPointers.getNumEntries(), numTokens, cudaConstants.MAX_TOKENPOINTERS)) {
             data.entitiesForCleanup.tokenPointers.reset();
             KERNEL_CALL(cleanupTokenPointers, data.entities.clusterPointers, data.entitiesForCleanup.tokenPointers);
+            if (hasFrozenClusters) {
+                KERNEL_CALL(cleanupTokenPointers, frozenClusters, data.entitiesForCleanup.tokenPointers);
+            }
             data.entities.tokenPointers.swapContent(data.entitiesForCleanup.tokenPointers);
         }
 
-        if (data.entities.tokens.getNumEntries() > cudaConstants.MAX_TOKENS * FillLevelFactor) {
+        if (policy.isCompactionRequired(data.entities.tokens.getNumEntries(), numTokens, cudaConstants.MAX_TOKENS)) {
             data.entitiesForCleanup.tokens.reset();
             KERNEL_CALL(cleanupTokens, data.entities.clusterPointers, data.entitiesForCleanup.tokens);
+            if (hasFrozenClusters) {
+                KERNEL_CALL(cleanupTokens, frozenClusters, data.entitiesForCleanup.tokens);
+            }
             data.entities.tokens.swapContent(data.entitiesForCleanup.tokens);
         }
 
-        if (data.entities.strings.getNumBytes() > cudaConstants.METADATA_DYNAMIC_MEMORY_SIZE * FillLevelFactor) {
+        //the live bytes of the strings are not tracked, hence they are only compacted when the memory runs full
+        if (policy.isFillLevelExceeded(
+                data.entities.strings.getNumBytes(), cudaConstants.METADATA_DYNAMIC_MEMORY_SIZE)) {
             data.entitiesForCleanup.strings.reset();
             KERNEL_CALL(cleanupMetadata, data.entities.clusterPointers, data.entitiesForCleanup.strings);
+            if (hasFrozenClusters) {
+                KERNEL_CALL(cleanupMetadata, frozenClusters, data.entitiesForCleanup.strings);
+            }
             data.entities.strings.swapContent(data.entitiesForCleanup.strings);
         }
     }
@@ -373,6 +507,9 @@ __global__ void cleanupAfterSimulation(SimulationData data)
 
 __global__ void cleanupAfterDataManipulation(SimulationData data)
 {
+    //all pointers are copied, hence the recorded entries are obsolete
+    data.entities.clearedClusterPointers.reset();
+    data.entities.clearedParticlePointers.reset();
 
     data.entitiesForCleanup.clusterPointers.reset();
     KERNEL_CALL(cleanupClusterPointers, data.entities.clusterPointers, data.entitiesForCleanup.clusterPointers);
@@ -395,8 +532,14 @@ __global__ void cleanupAfterDataManipulation(SimulationData data)
     data.entities.cellPointers.swapContent(data.entitiesForCleanup.cellPointers);
 
     data.entitiesForCleanup.cells.reset();
-    KERNEL_CALL(cleanupCells, data.entities.clusterPointers, data.entitiesForCleanup.cells);
+    data.entitiesForCleanup.cellColdData.reset();
+    KERNEL_CALL(
+        cleanupCells,
+        data.entities.clusterPointers,
+        data.entitiesForCleanup.cells,
+        data.entitiesForCleanup.cellColdData);
     data.entities.cells.swapContent(data.entitiesForCleanup.cells);
+    data.entities.cellColdData.swapContent(data.entitiesForCleanup.cellColdData);
 
     data.entitiesForCleanup.tokenPointers.reset();
     KERNEL_CALL(cleanupTokenPointers, data.entities.clusterPointers, data.entitiesForCleanup.tokenPointers);
@@ -44,8 +44,12 @@ struct Cluster
         return{ atomicAdd(&vel.x, 0), atomicAdd(&vel.y, 0) };
     }
 
-    __device__ __inline__ void addVelocity_safe(float2 const& value)
+    __device__ __inline__ void addVelocity_safe(float2 value)
     {
+        if (cudaExecutionParameters.deterministic) {
+            value.x = DeterministicMath::snapToGrid(value.x, DeterministicMath::VelocityFractionBits);
+            value.y = DeterministicMath::snapToGrid(value.y, DeterministicMath::VelocityFractionBits);
+        }
         atomicAdd(&vel.x, value.x);
         atomicAdd(&vel.y, value.y);
     }
@@ -59,6 +63,10 @@ struct Cluster
     __device__ __inline__ void setVelocity(float2 const& value)
     {
         vel = value;
+        if (cudaExecutionParameters.deterministic) {
+            vel.x = DeterministicMath::snapToGrid(vel.x, DeterministicMath::VelocityFractionBits);
+            vel.y = DeterministicMath::snapToGrid(vel.y, DeterministicMath::VelocityFractionBits);
+        }
     }
 
     __device__ __inline__ float& getAngularVelocity()
@@ -74,10 +82,16 @@ struct Cluster
     __device__ __inline__ void setAngularVelocity(float const& value)
     {
         angularVel = value;
+        if (cudaExecutionParameters.deterministic) {
+            angularVel = DeterministicMath::snapToGrid(angularVel, DeterministicMath::AngularVelocityFractionBits);
+        }
     }
 
-    __device__ __inline__ void addAngularVelocity_safe(float const& value)
+    __device__ __inline__ void addAngularVelocity_safe(float value)
     {
+        if (cudaExecutionParameters.deterministic) {
+            value = DeterministicMath::snapToGrid(value, DeterministicMath::AngularVelocityFractionBits);
+        }
         atomicAdd(&angularVel, value);
     }
 
@@ -93,10 +107,29 @@ struct Cluster
 
     __device__ __inline__ void freeze(Cluster** pointerArrayElement)
     {
-        atomicExch(&_freezed, 1);
+        if (0 == atomicExch(&_freezed, 1)) {
+            _frozenRadius = calcRadius();   //frozen clusters do not move
+        }
         _pointerArrayElement = pointerArrayElement;
     }
 
+    //only valid for frozen clusters
+    __device__ __inline__ float getFrozenRadius() const
+    {
+        return _frozenRadius;
+    }
+
+    //distance of the farthest cell from pos
+    __device__ __inline__ float calcRadius() const
+    {
+        auto maxDistanceSquared = 0.0f;
+        for (int cellIndex = 0; cellIndex < numCellPointers; ++cellIndex) {
+            auto const& relPos = cellPointers[cellIndex]->relPos;
+            maxDistanceSquared = max(maxDistanceSquared, relPos.x * relPos.x + relPos.y * relPos.y);
+        }
+        return sqrtf(maxDistanceSquared);
+    }
+
     __device__ __inline__ Cluster** getPointerArrayElement()
     {
         return _pointerArrayElement;
@@ -159,5 +192,6 @@ private:
     int _freezed;       // 0 = unfreezed, 1 = freezed
     int _timestepsUntilFreezing;
     Cluster** _pointerArrayElement;
+    float _frozenRadius;
     bool _selected;
 };
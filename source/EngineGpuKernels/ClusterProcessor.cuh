@@ -40,6 +40,10 @@ private:
     __inline__ __device__ void destroyCloseCell(float2 const& pos, Cell *cell);
     __inline__ __device__ bool areConnectable(Cell *cell1, Cell *cell2);
 
+    //candidates for a collision with cell: cell map lookups or, with spatial binning, all cells within cellMaxDistance
+    template <typename Func>
+    __inline__ __device__ void forEachCloseCell(Cell* cell, Func const& func);
+
     __inline__ __device__ void copyClusterWithDecomposition_block();
     __inline__ __device__ void copyClusterWithFusion_block();
     __inline__ __device__ void copyTokenPointers_block(Cluster* sourceCluster, Cluster* targetCluster);
@@ -81,36 +85,30 @@ private:
     //find colliding cluster
     for (auto index = _cellBlock.startIndex; index <= _cellBlock.endIndex; ++index) {
         Cell* cell = cluster->cellPointers[index];
-        for (float dx = -0.5f; dx < 0.51f; dx += 1.0f) {
-            for (float dy = -0.5f; dy < 0.51f; dy += 1.0f) {
-                Cell* otherCell = _data->cellMap.get(cell->absPos + float2{ dx, dy });
-
-                if (!otherCell || otherCell == cell) {
-                    continue;
-                }
-
-                auto const otherCluster = otherCell->cluster;
-                if (cluster == otherCluster) {
-                    continue;
-                }
-                if (cluster->isActive()) {
-                    otherCluster->unfreeze(30);
-                }
+        forEachCloseCell(cell, [&](Cell* otherCell) {
+            auto const otherCluster = otherCell->cluster;
+            if (cluster == otherCluster) {
+                return;
+            }
+            if (cluster->isActive()) {
+                otherCluster->unfreeze(30);
+            }
 
-                if (cell->getProtectionCounter_safe() > 0 || otherCell->getProtectionCounter_safe() > 0) {
-                    continue;
-                }
-                if (0 == cell->alive || 0 == otherCell->alive) {
-                    continue;
-                }
-                if (_data->cellMap.mapDistance(cell->absPos, otherCell->absPos) >= cudaSimulationParameters.cellMaxDistance) {
-                    continue;
-                }
-                unsigned long long int otherClusterData = otherCell->cluster - clustersArray;
-                otherClusterData |= (static_cast<unsigned long long int>(otherCluster->numCellPointers) << 32);
-                atomicMax_block(&largestOtherClusterData, otherClusterData);
+            if (cell->getProtectionCounter_safe() > 0 || otherCell->getProtectionCounter_safe() > 0) {
+                return;
             }
-        }
+            if (0 == cell->alive || 0 == otherCell->alive) {
+                return;
+            }
+            if (_data->cellMap.mapDistance(cell->absPos, otherCell->absPos) >= cudaSimulationParameters.cellMaxDistance) {
+                return;
+            }
+            //deterministic mode: array positions depend on the allocation order, ties are broken by ids below
+            unsigned long long int otherClusterData =
+                cudaExecutionParameters.deterministic ? 0 : otherCell->cluster - clustersArray;
+            otherClusterData |= (static_cast<unsigned long long int>(otherCluster->numCellPointers) << 32);
+            atomicMax_block(&largestOtherClusterData, otherClusterData);
+        });
     }
     __syncthreads();
 
@@ -119,6 +117,53 @@ private:
         return;
     }
 
+    if (cudaExecutionParameters.deterministic) {
+        __shared__ unsigned long long int smallestOtherClusterId;
+        auto const largestNumCells = static_cast<int>(largestOtherClusterData >> 32);
+        auto const forEachCloseOtherCell = [&](auto const& func) {
+            for (auto index = _cellBlock.startIndex; index <= _cellBlock.endIndex; ++index) {
+                Cell* cell = cluster->cellPointers[index];
+                forEachCloseCell(cell, [&](Cell* otherCell) {
+                    if (cluster != otherCell->cluster) {
+                        func(cell, otherCell);
+                    }
+                });
+            }
+        };
+        if (0 == threadIdx.x) {
+            smallestOtherClusterId = 0xffffffffffffffffull;
+        }
+        __syncthreads();
+
+        forEachCloseOtherCell([&](Cell* cell, Cell* otherCell) {
+            if (otherCell->cluster->numCellPointers != largestNumCells) {
+                return;
+            }
+            if (cell->getProtectionCounter_safe() > 0 || otherCell->getProtectionCounter_safe() > 0) {
+                return;
+            }
+            if (0 == cell->alive || 0 == otherCell->alive) {
+                return;
+            }
+            if (_data->cellMap.mapDistance(cell->absPos, otherCell->absPos) >= cudaSimulationParameters.cellMaxDistance) {
+                return;
+            }
+            atomicMin_block(&smallestOtherClusterId, static_cast<unsigned long long int>(otherCell->cluster->id));
+        });
+        __syncthreads();
+
+        if (0xffffffffffffffffull == smallestOtherClusterId) {
+            __syncthreads();
+            return;
+        }
+        forEachCloseOtherCell([&](Cell* cell, Cell* otherCell) {
+            if (otherCell->cluster->id == smallestOtherClusterId) {
+                largestOtherClusterData = otherCell->cluster - clustersArray;
+            }
+        });
+        __syncthreads();
+    }
+
     __shared__ SystemDoubleLock lock;
     __shared__ Cluster* largestOtherCluster;
     __shared__ float2 collisionCenterPos;
@@ -148,40 +193,33 @@ private:
         Cell* cell = cluster->cellPointers[index];
         Cell* closestOtherCell = nullptr;
         float distanceOfClosestOtherCell = 0;
-        for (float dx = -0.5f; dx < 0.51f; dx += 1.0f) {
-            for (float dy = -0.5f; dy < 0.51f; dy += 1.0f) {
-                Cell* otherCell = _data->cellMap.get(cell->absPos + float2{ dx, dy });
-                if (!otherCell || otherCell == cell) {
-                    continue;
-                }
-                if (largestOtherCluster != otherCell->cluster) {
-                    continue;
-                }
-                if (0 == cell->alive || 0 == otherCell->alive) {
-                    continue;
-                }
-                if (_data->cellMap.mapDistance(cell->absPos, otherCell->absPos)
-                    >= cudaSimulationParameters.cellMaxDistance) {
-                    continue;
-                }
-                if (cell->getProtectionCounter_safe() > 0 || otherCell->getProtectionCounter_safe() > 0) {
-                    continue;
-                }
-                if (Math::length(cell->vel - otherCell->vel) >= cudaSimulationParameters.cellFusionVelocity
-                    && areConnectable(cell, otherCell)) {
-                    state = CollisionState::Fusion;
-                }
-                
-                auto const distance = _data->cellMap.mapDistance(cell->absPos, otherCell->absPos);
-                if (!closestOtherCell || distance < distanceOfClosestOtherCell) {
-                    closestOtherCell = otherCell;
-                    distanceOfClosestOtherCell = distance;
-                }
+        forEachCloseCell(cell, [&](Cell* otherCell) {
+            if (largestOtherCluster != otherCell->cluster) {
+                return;
             }
-            if (avoidCollision) {
-                break;
+            if (0 == cell->alive || 0 == otherCell->alive) {
+                return;
             }
-        }
+            if (_data->cellMap.mapDistance(cell->absPos, otherCell->absPos)
+                >= cudaSimulationParameters.cellMaxDistance) {
+                return;
+            }
+            if (cell->getProtectionCounter_safe() > 0 || otherCell->getProtectionCounter_safe() > 0) {
+                return;
+            }
+            if (Math::length(cell->vel - otherCell->vel) >= cudaSimulationParameters.cellFusionVelocity
+                && areConnectable(cell, otherCell)) {
+                state = CollisionState::Fusion;
+            }
+
+            //ties are broken by id since the order of the cells in a bucket is arbitrary
+            auto const distance = _data->cellMap.mapDistance(cell->absPos, otherCell->absPos);
+            if (!closestOtherCell || distance < distanceOfClosestOtherCell
+                || (distance == distanceOfClosestOtherCell && otherCell->id < closestOtherCell->id)) {
+                closestOtherCell = otherCell;
+                distanceOfClosestOtherCell = distance;
+            }
+        });
         if (avoidCollision) {
             break;
         }
@@ -377,10 +415,11 @@ __inline__ __device__ void ClusterProcessor::processingCellDeath_block()
         for (int cellIndex = _cellBlock.startIndex; cellIndex <= _cellBlock.endIndex; ++cellIndex) {
             auto cell = _cluster->cellPointers[cellIndex];
             if (0 == cell->alive) {
+                _data->numberGen.beginEntity(cell->id, _data->timestep, RandomPurpose::CellDestruction);
                 auto pos = cell->absPos;
                 _data->cellMap.mapPosCorrection(pos);
                 auto const kineticEnergy = Physics::linearKineticEnergy(1.0f, cell->vel);
-                _factory.createParticle(cell->getEnergy_safe() + kineticEnergy, pos, cell->vel, { cell->metadata.color });
+                _factory.createParticle(cell->getEnergy_safe() + kineticEnergy, pos, cell->vel, { cell->coldData->metadata.color });
                 cell->setEnergy_safe(0);
             }
         }
@@ -438,6 +477,7 @@ __inline__ __device__ void ClusterProcessor::processingRadiation_block()
     for (int cellIndex = _cellBlock.startIndex; cellIndex <= _cellBlock.endIndex; ++cellIndex) {
         Cell *cell = _cluster->cellPointers[cellIndex];
 
+        _data->numberGen.beginEntity(cell->id, _data->timestep, RandomPurpose::Radiation);
         if (_data->numberGen.random() < cudaSimulationParameters.radiationProb) {
             auto const cellEnergy = cell->getEnergy_safe();
             auto &pos = cell->absPos;
@@ -456,7 +496,7 @@ __inline__ __device__ void ClusterProcessor::processingRadiation_block()
                     radiationEnergy = cellEnergy - 1;
                 }
                 cell->changeEnergy_safe(-radiationEnergy);
-                auto particle = _factory.createParticle(radiationEnergy, particlePos, particleVel, { cell->metadata.color });
+                auto particle = _factory.createParticle(radiationEnergy, particlePos, particleVel, { cell->coldData->metadata.color });
             }
         }
         if (cell->getEnergy_safe() < cudaSimulationParameters.cellMinEnergy) {
@@ -479,6 +519,7 @@ __inline__ __device__ void ClusterProcessor::updateCellVelocity_block(Cluster* c
 
         auto a = newVel - cell->vel;
         if (Math::length(a) > cudaSimulationParameters.cellMaxForce) {
+            _data->numberGen.beginEntity(cell->id, _data->timestep, RandomPurpose::MaxForceDecay);
             if (_data->numberGen.random() < cudaSimulationParameters.cellMaxForceDecayProb) {
                 atomicExch(&cell->alive, 0);
                 atomicExch(&cluster->decompositionRequired, 1);
@@ -492,6 +533,7 @@ __inline__ __device__ void ClusterProcessor::updateCellVelocity_block(Cluster* c
 __inline__ __device__ void ClusterProcessor::destroyDyingCell(Cell * cell)
 {
     if (cell->tokenUsages > cudaSimulationParameters.cellMinTokenUsages) {
+        _data->numberGen.beginEntity(cell->id, _data->timestep, RandomPurpose::TokenUsageDecay);
         if (_data->numberGen.random() < cudaSimulationParameters.cellTokenUsageDecayProb) {
             atomicExch(&cell->alive, 0);
             atomicExch(&cell->cluster->decompositionRequired, 1);
@@ -534,6 +576,27 @@ __inline__ __device__ bool ClusterProcessor::areConnectable(Cell * cell1, Cell *
     return cell1->numConnections < cell1->maxConnections && cell2->numConnections < cell2->maxConnections;
 }
 
+template <typename Func>
+__inline__ __device__ void ClusterProcessor::forEachCloseCell(Cell* cell, Func const& func)
+{
+    if (cudaExecutionParameters.spatialBinning) {
+        _data->cellBins.forEachCloseCell(cell->absPos, cudaSimulationParameters.cellMaxDistance, [&](Cell* otherCell) {
+            if (otherCell != cell) {
+                func(otherCell);
+            }
+        });
+        return;
+    }
+    for (float dx = -0.5f; dx < 0.51f; dx += 1.0f) {
+        for (float dy = -0.5f; dy < 0.51f; dy += 1.0f) {
+            Cell* otherCell = _data->cellMap.get(cell->absPos + float2{dx, dy});
+            if (otherCell && otherCell != cell) {
+                func(otherCell);
+            }
+        }
+    }
+}
+
 __inline__ __device__ void ClusterProcessor::init_block(SimulationData& data, int clusterIndex)
 {
     _data = &data;
@@ -558,7 +621,7 @@ __inline__ __device__ void ClusterProcessor::copyClusterWithDecomposition_block(
     };
     __shared__ Entry entries[MAX_DECOMPOSITIONS];
     if (0 == threadIdx.x) {
-        *_clusterPointer = nullptr;
+        _data->entities.clearClusterPointer(*_clusterPointer);
         numDecompositions = 0;
         for (int i = 0; i < MAX_DECOMPOSITIONS; ++i) {
             entries[i].tag = -1;
@@ -581,6 +644,7 @@ __inline__ __device__ void ClusterProcessor::copyClusterWithDecomposition_block(
     for (int cellIndex = _cellBlock.startIndex; cellIndex <= _cellBlock.endIndex; ++cellIndex) {
         Cell* cell = _cluster->cellPointers[cellIndex];
         if (0 == cell->alive) {
+            _data->tileChanges.registerPixel(cell->coldData->drawnPixel);
             continue;
         }
         bool foundMatch = false;
@@ -593,6 +657,7 @@ __inline__ __device__ void ClusterProcessor::copyClusterWithDecomposition_block(
                 atomicAdd(&entries[index].cluster.pos.y, cell->absPos.y);
                 entries[index].cluster.addVelocity_safe(cell->vel);
 
+                _data->numberGen.beginEntity(_cluster->id, _data->timestep, RandomPurpose::Decomposition, cell->tag);
                 entries[index].cluster.id = _data->numberGen.createNewId_kernel();
                 Math::inverseRotationMatrix(entries[index].cluster.angle, entries[index].invRotMatrix);
                 foundMatch = true;
@@ -843,7 +908,7 @@ __inline__ __device__ void ClusterProcessor::copyClusterWithFusion_block()
     }
     else {
         if (0 == threadIdx.x) {
-            *_clusterPointer = nullptr;
+            _data->entities.clearClusterPointer(*_clusterPointer);
         }
     }
     __syncthreads();
@@ -946,7 +1011,8 @@ __inline__ __device__ void ClusterProcessor::processingClusterCopy_block()
 {
     if (_cluster->numCellPointers == 1 && 0 == _cluster->cellPointers[0]->alive && !_cluster->clusterToFuse) {
         if (0 == threadIdx.x) {
-            *_clusterPointer = nullptr;
+            _data->tileChanges.registerPixel(_cluster->cellPointers[0]->coldData->drawnPixel);
+            _data->entities.clearClusterPointer(*_clusterPointer);
         }
         __syncthreads();
         return;
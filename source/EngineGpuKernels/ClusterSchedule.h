@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Base/HostDeviceFunctions.h"
+
+/**
+ * Assignment of clusters to blocks by their costs instead of their number: the costs of a cluster grow with its
+ * number of cells and every block processes a contiguous range of clusters with about the same total costs. Hence
+ * many small clusters are packed into one block while the block of a large cluster gets correspondingly fewer other
+ * clusters. A cluster is still processed by a single block since the cluster processors synchronize via shared
+ * memory.
+ *
+ * The costs are stored as exclusive prefix sums (offsets), a block finds its range by binary search. The memory is
+ * provided by the caller so that the schedule can be calculated on the GPU as well as simulated on the host.
+ */
+class ClusterSchedule
+{
+public:
+    //costs of a cluster independent of its cells (block synchronizations, shared memory setup) in units of a cell
+    static constexpr int ClusterCosts = 32;
+
+    //inclusive bounds, empty if endIndex < startIndex
+    struct Range
+    {
+        int startIndex;
+        int endIndex;
+
+        HOST_DEVICE_FUNCTION int numElements() const { return endIndex - startIndex + 1; }
+    };
+
+    HOST_DEVICE_FUNCTION static int calcCosts(int numCells) { return ClusterCosts + numCells; }
+
+    //offsets: numClusters + 1 elements
+    HOST_DEVICE_FUNCTION void init(int* offsets, int numClusters)
+    {
+        _offsets = offsets;
+        _numClusters = numClusters;
+    }
+
+    HOST_DEVICE_FUNCTION int* getOffsets() const { return _offsets; }
+    HOST_DEVICE_FUNCTION int getNumClusters() const { return _numClusters; }
+    HOST_DEVICE_FUNCTION int getTotalCosts() const { return _offsets[_numClusters]; }
+
+    //sequential version for the host (the device uses a block-wide scan on getOffsets())
+    template <typename Func>
+    HOST_DEVICE_FUNCTION void calcOffsets(Func const& getNumCells)
+    {
+        auto offset = 0;
+        for (int clusterIndex = 0; clusterIndex < _numClusters; ++clusterIndex) {
+            _offsets[clusterIndex] = offset;
+            offset += calcCosts(getNumCells(clusterIndex));
+        }
+        _offsets[_numClusters] = offset;
+    }
+
+    //a cluster belongs to the block whose share of the total costs contains the start of the cluster's costs
+    HOST_DEVICE_FUNCTION Range getRange(int block, int numBlocks) const
+    {
+        auto const totalCosts = static_cast<int64_t>(getTotalCosts());
+        auto const startCosts = static_cast<int>(totalCosts * block / numBlocks);
+        auto const endCosts = static_cast<int>(totalCosts * (block + 1) / numBlocks);
+        return {findFirstCluster(startCosts), findFirstCluster(endCosts) - 1};
+    }
+
+private:
+    //first cluster whose costs start at or after the given costs, _numClusters if there is none
+    HOST_DEVICE_FUNCTION int findFirstCluster(int costs) const
+    {
+        auto lower = 0;
+        auto upper = _numClusters;
+        while (lower < upper) {
+            auto const middle = (lower + upper) / 2;
+            if (_offsets[middle] < costs) {
+                lower = middle + 1;
+            } else {
+                upper = middle;
+            }
+        }
+        return lower;
+    }
+
+    int* _offsets = nullptr;
+    int _numClusters = 0;
+};
@@ -119,52 +119,52 @@ __inline__ __device__ Enums::CommunicatorIn::Type CommunicatorFunction::getComma
 
 __inline__ __device__ void CommunicatorFunction::setListeningChannel(Cell* cell, unsigned char channel) const
 {
-    cell->staticData[StaticDataInternal::Channel] = channel;
+    cell->coldData->staticData[StaticDataInternal::Channel] = channel;
 }
 
 __inline__ __device__ unsigned char CommunicatorFunction::getListeningChannel(Cell * cell) const
 {
-    return cell->staticData[StaticDataInternal::Channel];
+    return cell->coldData->staticData[StaticDataInternal::Channel];
 }
 
 __inline__ __device__ void CommunicatorFunction::setAngle(Cell * cell, unsigned char angle) const
 {
-    cell->staticData[StaticDataInternal::OriginAngle] = angle;
+    cell->coldData->staticData[StaticDataInternal::OriginAngle] = angle;
 }
 
 __inline__ __device__ unsigned char CommunicatorFunction::getAngle(Cell * cell) const
 {
-    return cell->staticData[StaticDataInternal::OriginAngle];
+    return cell->coldData->staticData[StaticDataInternal::OriginAngle];
 }
 
 __inline__ __device__ void CommunicatorFunction::setDistance(Cell * cell, unsigned char distance) const
 {
-    cell->staticData[StaticDataInternal::OriginDistance] = distance;
+    cell->coldData->staticData[StaticDataInternal::OriginDistance] = distance;
 }
 
 __inline__ __device__ unsigned char CommunicatorFunction::getDistance(Cell * cell) const
 {
-    return cell->staticData[StaticDataInternal::OriginDistance];
+    return cell->coldData->staticData[StaticDataInternal::OriginDistance];
 }
 
 __inline__ __device__ void CommunicatorFunction::setMessage(Cell * cell, unsigned char message) const
 {
-    cell->staticData[StaticDataInternal::MessageCode] = message;
+    cell->coldData->staticData[StaticDataInternal::MessageCode] = message;
 }
 
 __inline__ __device__ unsigned char CommunicatorFunction::getMessage(Cell * cell) const
 {
-    return cell->staticData[StaticDataInternal::MessageCode];
+    return cell->coldData->staticData[StaticDataInternal::MessageCode];
 }
 
 __inline__ __device__ void CommunicatorFunction::setNewMessageReceived(Cell * cell, bool value) const
 {
-    cell->staticData[StaticDataInternal::NewMessageReceived] = value;
+    cell->coldData->staticData[StaticDataInternal::NewMessageReceived] = value;
 }
 
 __inline__ __device__ bool CommunicatorFunction::getNewMessageReceived(Cell * cell) const
 {
-    return cell->staticData[StaticDataInternal::NewMessageReceived];
+    return cell->coldData->staticData[StaticDataInternal::NewMessageReceived];
 }
 
 __inline__ __device__ void CommunicatorFunction::sendMessage_block(Token * token) const
@@ -209,35 +209,26 @@ __inline__ __device__ void CommunicatorFunction::receiveMessage(Token * token) c
 __inline__ __device__ void CommunicatorFunction::sendMessageToNearbyCommunicators(MessageData const & messageDataToSend, 
     Cell * senderCell, Cell * senderPreviousCell, int & numMessages) const
 { 
-    __shared__ List<Cluster*> clusterList;
-    _data->cellFunctionData.mapSectionCollector.getClusters_block(senderCell->absPos,
-        cudaSimulationParameters.cellFunctionCommunicatorRange, _data->cellMap, &_data->dynamicMemory, clusterList);
-
-    __shared__ Cluster** clusters;
-
     if (0 == threadIdx.x) {
         numMessages = 0;
-        clusters = clusterList.asArray(&_data->dynamicMemory);
     }
     __syncthreads();
 
-    auto const clusterPartition = calcPartition(clusterList.getSize(), threadIdx.x, blockDim.x);
-
-    for (auto clusterIndex = clusterPartition.startIndex; clusterIndex <= clusterPartition.endIndex; ++clusterIndex) {
-        auto const& cluster = clusters[clusterIndex];
-        for (auto cellIndex = 0; cellIndex < cluster->numCellPointers; ++cellIndex) {
-            auto const& cell = cluster->cellPointers[cellIndex];
-            if (cell == senderCell) {
-                continue;
-            }
-            if (Enums::CellFunction::COMMUNICATOR != cell->getCellFunctionType()) {
-                continue;
+    _data->cellFunctionData.mapSectionCollector.forEachCluster_block(
+        senderCell->absPos, cudaSimulationParameters.cellFunctionCommunicatorRange, [&](Cluster* cluster) {
+            for (auto cellIndex = 0; cellIndex < cluster->numCellPointers; ++cellIndex) {
+                auto const& cell = cluster->cellPointers[cellIndex];
+                if (cell == senderCell) {
+                    continue;
+                }
+                if (Enums::CellFunction::COMMUNICATOR != cell->getCellFunctionType()) {
+                    continue;
+                }
+                if (sendMessageToCommunicatorAndReturnSuccess(messageDataToSend, senderCell, senderPreviousCell, cell)) {
+                    atomicAdd_block(&numMessages, 1);
+                }
             }
-            if (sendMessageToCommunicatorAndReturnSuccess(messageDataToSend, senderCell, senderPreviousCell, cell)) {
-                atomicAdd_block(&numMessages, 1);
-            }
-        }
-    }
+        });
 }
 
 __inline__ __device__ bool CommunicatorFunction::sendMessageToCommunicatorAndReturnSuccess(
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Base/HostDeviceFunctions.h"
+
+/**
+ * Compaction of an array in which some entries have been cleared (set to T(), e.g. nullptr). Instead of copying all
+ * entries into a new array, the cleared entries in front of the new end are filled with the remaining entries
+ * behind it, so the work is proportional to the number of cleared entries. The order of the entries changes.
+ *
+ * Passes (on the device in separate kernels, the calls of a pass may run concurrently):
+ * 1. collectMovedEntry for every tail index in [0, getNumTailEntries())
+ * 2. fillGap for every index in [0, numClearedEntries)
+ * Afterwards the array consists of the first getNewNumEntries() entries.
+ */
+template <typename T>
+class IncrementalCompaction
+{
+public:
+    struct Memory
+    {
+        T* entries = nullptr;
+        int const* clearedIndices = nullptr;    //every cleared entry exactly once
+        int* movedIndices = nullptr;            //numClearedEntries elements
+        int* numMovedIndices = nullptr;         //1 element, 0 before pass 1
+        int* numFilledGaps = nullptr;           //1 element, 0 before pass 2
+    };
+
+    HOST_DEVICE_FUNCTION void init(Memory const& memory, int numEntries, int numClearedEntries)
+    {
+        _memory = memory;
+        _numEntries = numEntries;
+        _numClearedEntries = numClearedEntries;
+    }
+
+    HOST_DEVICE_FUNCTION int getNewNumEntries() const { return _numEntries - _numClearedEntries; }
+    HOST_DEVICE_FUNCTION int getNumTailEntries() const { return _numClearedEntries; }
+
+    //pass 1: the tail holds as many remaining entries as there are gaps in front of it
+    HOST_DEVICE_FUNCTION void collectMovedEntry(int tailIndex)
+    {
+        auto const index = getNewNumEntries() + tailIndex;
+        if (_memory.entries[index] != T()) {
+            _memory.movedIndices[HostDeviceAtomics::add(_memory.numMovedIndices, 1)] = index;
+        }
+    }
+
+    //pass 2
+    HOST_DEVICE_FUNCTION void fillGap(int index)
+    {
+        auto const clearedIndex = _memory.clearedIndices[index];
+        if (clearedIndex < getNewNumEntries()) {
+            auto const movedIndex = _memory.movedIndices[HostDeviceAtomics::add(_memory.numFilledGaps, 1)];
+            _memory.entries[clearedIndex] = _memory.entries[movedIndex];
+        }
+    }
+
+    //sequential version of both passes for the host
+    HOST_DEVICE_FUNCTION void compact()
+    {
+        *_memory.numMovedIndices = 0;
+        *_memory.numFilledGaps = 0;
+        for (int tailIndex = 0; tailIndex < getNumTailEntries(); ++tailIndex) {
+            collectMovedEntry(tailIndex);
+        }
+        for (int index = 0; index < _numClearedEntries; ++index) {
+            fillGap(index);
+        }
+    }
+
+private:
+    Memory _memory;
+    int _numEntries = 0;
+    int _numClearedEntries = 0;
+};
+
+/**
+ * Decides when an array of entities is compacted by copying all live entities. Dead entities are skipped until
+ * then, since they are not referenced anymore. New entities are always appended, hence the array has to be compacted
+ * before it runs full (fill level) or when most of the copied bytes would be garbage (fragmentation).
+ */
+class CompactionPolicy
+{
+public:
+    HOST_DEVICE_FUNCTION CompactionPolicy(int maxFillLevelPercent, int maxFragmentationPercent)
+        : _maxFillLevelPercent(maxFillLevelPercent)
+        , _maxFragmentationPercent(maxFragmentationPercent)
+    {}
+
+    HOST_DEVICE_FUNCTION bool isCompactionRequired(int numEntries, int numLiveEntries, int capacity) const
+    {
+        if (isFillLevelExceeded(numEntries, capacity)) {
+            return true;
+        }
+        return static_cast<int64_t>(numEntries - numLiveEntries) * 100
+            > static_cast<int64_t>(numEntries) * _maxFragmentationPercent;
+    }
+
+    //for arrays whose number of live entries is not known
+    HOST_DEVICE_FUNCTION bool isFillLevelExceeded(int numEntries, int capacity) const
+    {
+        return static_cast<int64_t>(numEntries) * 100 > static_cast<int64_t>(capacity) * _maxFillLevelPercent;
+    }
+
+private:
+    int _maxFillLevelPercent;
+    int _maxFragmentationPercent;
+};
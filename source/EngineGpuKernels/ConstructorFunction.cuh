@@ -1,7 +1,7 @@
 #pragma once
 #include "EngineInterface/ElementaryTypes.h"
 
-#include "HashMap.cuh"
+#include "HashMap.h"
 #include "Math.cuh"
 #include "QuantityConverter.cuh"
 #include "SimulationData.cuh"
@@ -145,7 +145,7 @@ private:
         bool ignoreOwnCluster,
         Cell* cell,
         float2 const& absPos,
-        HashMap<int2, CellAndNewAbsPos, HashFunctor<int2>>& tempMap);
+        HashMap<int2, CellAndNewAbsPos>& tempMap);
 
     __inline__ __device__ void constructNewCell(
         float2 const& relPosOfNewCell,
@@ -194,12 +194,13 @@ private:
     Token* _token;
     Cluster* _cluster;
     PartitionData _cellBlock;
+    int _numConstructedCells;   //used by thread 0 only
 
     struct DynamicMemory
     {
         Cell** cellPointerArray1;
         Cell** cellPointerArray2;
-        HashMap<int2, CellAndNewAbsPos, HashFunctor<int2>> cellPosMap;
+        HashMap<int2, CellAndNewAbsPos> cellPosMap;
     };
     DynamicMemory _dynamicMemory;
 };
@@ -248,7 +249,7 @@ __inline__ __device__ void ConstructorFunction::processing_block(Token* token)
         cellPointerArray1 = _data->dynamicMemory.getArray<Cell*>(_cluster->numCellPointers);
         cellPointerArray2 = _data->dynamicMemory.getArray<Cell*>(_cluster->numCellPointers);
     }
-    _dynamicMemory.cellPosMap.init_block(_cluster->numCellPointers * 2, _data->dynamicMemory);
+    _dynamicMemory.cellPosMap.init_block(_cluster->numCellPointers, _data->dynamicMemory);
     __syncthreads();
 
     _dynamicMemory.cellPointerArray1 = cellPointerArray1;
@@ -275,6 +276,7 @@ __inline__ __device__ void ConstructorFunction::init_block(Cluster* cluster, Sim
     _data = data;
     _cluster = cluster;
     _cellBlock = calcPartition(_cluster->numCellPointers, threadIdx.x, blockDim.x);
+    _numConstructedCells = 0;
 }
 
 __inline__ __device__ void ConstructorFunction::checkMaxRadius(bool& result)
@@ -314,6 +316,7 @@ __inline__ __device__ Cell* ConstructorFunction::getFirstCellOfConstructionSite(
 
 __inline__ __device__ void ConstructorFunction::mutateConstructionData(ConstructionData& constructionData)
 {
+    _data->numberGen.beginEntity(_token->cell->id, _data->timestep, RandomPurpose::ConstructionMutation);
     if (_data->numberGen.random() < cudaSimulationParameters.cellFunctionConstructorCellPropertyMutationProb) {
         constructionData.constrInOption = static_cast<Enums::ConstrInOption::Type>(
             static_cast<unsigned char>(_data->numberGen.random(255)) % Enums::ConstrInOption::_COUNTER);
@@ -341,30 +344,34 @@ __inline__ __device__ void ConstructorFunction::mutateConstructionData(Construct
 __inline__ __device__ void ConstructorFunction::mutateCellFunctionData(Cell * cell)
 {
     if (0 == threadIdx.x) {
+        _data->numberGen.beginEntity(cell->id, _data->timestep, RandomPurpose::StaticDataMutation);
         if (_data->numberGen.random() < cudaSimulationParameters.cellFunctionConstructorCellDataMutationProb) {
-            cell->numStaticBytes = _data->numberGen.random(MAX_CELL_STATIC_BYTES);
+            cell->coldData->numStaticBytes = _data->numberGen.random(MAX_CELL_STATIC_BYTES);
         }
     }
     __syncthreads();
 
     auto const staticDataBlock = calcPartition(MAX_CELL_STATIC_BYTES, threadIdx.x, blockDim.x);
     for (int i = staticDataBlock.startIndex; i <= staticDataBlock.endIndex; ++i) {
+        _data->numberGen.beginEntity(cell->id, _data->timestep, RandomPurpose::StaticDataMutation, i + 1);
         if (_data->numberGen.random() < cudaSimulationParameters.cellFunctionConstructorCellDataMutationProb) {
-            cell->staticData[i] = _data->numberGen.random(255);
+            cell->coldData->staticData[i] = _data->numberGen.random(255);
         }
     }
 
     if (0 == threadIdx.x) {
+        _data->numberGen.beginEntity(cell->id, _data->timestep, RandomPurpose::MutableDataMutation);
         if (_data->numberGen.random() < cudaSimulationParameters.cellFunctionConstructorCellDataMutationProb) {
-            cell->numMutableBytes = _data->numberGen.random(MAX_CELL_MUTABLE_BYTES);
+            cell->coldData->numMutableBytes = _data->numberGen.random(MAX_CELL_MUTABLE_BYTES);
         }
     }
     __syncthreads();
 
     auto const mutableDataBlock = calcPartition(MAX_CELL_MUTABLE_BYTES, threadIdx.x, blockDim.x);
     for (int i = mutableDataBlock.startIndex; i <= mutableDataBlock.endIndex; ++i) {
+        _data->numberGen.beginEntity(cell->id, _data->timestep, RandomPurpose::MutableDataMutation, i + 1);
         if (_data->numberGen.random() < cudaSimulationParameters.cellFunctionConstructorCellDataMutationProb) {
-            cell->mutableData[i] = _data->numberGen.random(255);
+            cell->coldData->mutableData[i] = _data->numberGen.random(255);
         }
     }
 }
@@ -373,6 +380,7 @@ __inline__ __device__ void ConstructorFunction::mutateDuplicatedToken(Token * to
 {
     auto const memoryPartition = calcPartition(MAX_TOKEN_MEM_SIZE, threadIdx.x, blockDim.x);
     for (auto index = memoryPartition.startIndex; index <= memoryPartition.endIndex; ++index) {
+        _data->numberGen.beginEntity(token->cell->id, _data->timestep, RandomPurpose::TokenMemoryMutation, index);
         if (_data->numberGen.random() < cudaSimulationParameters.cellFunctionConstructorTokenDataMutationProb) {
             token->memory[index] = _data->numberGen.random(255);
         }
@@ -1168,7 +1176,7 @@ __inline__ __device__ void ConstructorFunction::isObstaclePresent_onlyRotation(
     RotationMatrices const& rotationMatrices,
     bool& result)
 {
-    __shared__ HashMap<int2, CellAndNewAbsPos, HashFunctor<int2>> tempCellMap;
+    __shared__ HashMap<int2, CellAndNewAbsPos> tempCellMap;
     if (0 == threadIdx.x) {
         tempCellMap = _dynamicMemory.cellPosMap;
     }
@@ -1199,16 +1207,18 @@ __inline__ __device__ void ConstructorFunction::isObstaclePresent_onlyRotation(
     __syncthreads();
 
     if (!ignoreOwnCluster) {
-        for (int cellIndex = _cellBlock.startIndex; cellIndex <= _cellBlock.endIndex; ++cellIndex) {
-            auto const& cell = _cluster->cellPointers[cellIndex];
-            auto relPos =
-                getTransformedCellRelPos(cell, centerOfRotation, rotationMatrices, { 0,0 });
-            relPos = relPos - newCenter;
-            auto const absPos = _cluster->pos + Math::applyMatrix(relPos, clusterMatrix);
-            tempCellMap.insertOrAssign(toInt2(absPos), CellAndNewAbsPos{ cell, absPos });
-        }
+        tempCellMap.insertOrAssign_block(
+            _cluster->numCellPointers, [&](int cellIndex, int2& key, CellAndNewAbsPos& value) {
+                auto const& cell = _cluster->cellPointers[cellIndex];
+                auto relPos =
+                    getTransformedCellRelPos(cell, centerOfRotation, rotationMatrices, { 0,0 });
+                relPos = relPos - newCenter;
+                auto const absPos = _cluster->pos + Math::applyMatrix(relPos, clusterMatrix);
+                key = toInt2(absPos);
+                value = CellAndNewAbsPos{cell, absPos};
+                return true;
+            });
     }
-    __syncthreads();
 
     for (int cellIndex = _cellBlock.startIndex; cellIndex <= _cellBlock.endIndex; ++cellIndex) {
         auto const& cell = _cluster->cellPointers[cellIndex];
@@ -1231,7 +1241,7 @@ __inline__ __device__ void ConstructorFunction::isObstaclePresent_rotationAndCre
     bool& result)
 {
 
-    __shared__ HashMap<int2, CellAndNewAbsPos, HashFunctor<int2>> tempCellMap;
+    __shared__ HashMap<int2, CellAndNewAbsPos> tempCellMap;
     if (0 == threadIdx.x) {
         tempCellMap = _dynamicMemory.cellPosMap;
     }
@@ -1264,16 +1274,18 @@ __inline__ __device__ void ConstructorFunction::isObstaclePresent_rotationAndCre
     __syncthreads();
 
     if (!ignoreOwnCluster) {
-        for (int cellIndex = _cellBlock.startIndex; cellIndex <= _cellBlock.endIndex; ++cellIndex) {
-            auto const& cell = _cluster->cellPointers[cellIndex];
-            auto relPos =
-                getTransformedCellRelPos(cell, centerOfRotation, rotationMatrices, displacementOfConstructionSite);
-            relPos = relPos - newCenter;
-            auto const absPos = _cluster->pos + Math::applyMatrix(relPos, clusterMatrix);
-            tempCellMap.insertOrAssign(toInt2(absPos), CellAndNewAbsPos{ cell, absPos });
-        }
+        tempCellMap.insertOrAssign_block(
+            _cluster->numCellPointers, [&](int cellIndex, int2& key, CellAndNewAbsPos& value) {
+                auto const& cell = _cluster->cellPointers[cellIndex];
+                auto relPos =
+                    getTransformedCellRelPos(cell, centerOfRotation, rotationMatrices, displacementOfConstructionSite);
+                relPos = relPos - newCenter;
+                auto const absPos = _cluster->pos + Math::applyMatrix(relPos, clusterMatrix);
+                key = toInt2(absPos);
+                value = CellAndNewAbsPos{cell, absPos};
+                return true;
+            });
     }
-    __syncthreads();
 
     for (int cellIndex = _cellBlock.startIndex; cellIndex <= _cellBlock.endIndex; ++cellIndex) {
         auto const& cell = _cluster->cellPointers[cellIndex];
@@ -1293,7 +1305,7 @@ __inline__ __device__ void ConstructorFunction::isObstaclePresent_firstCreation(
     float2 const& relPosOfNewCell,
     bool& result)
 {
-    __shared__ HashMap<int2, CellAndNewAbsPos, HashFunctor<int2>> tempCellMap;
+    __shared__ HashMap<int2, CellAndNewAbsPos> tempCellMap;
     if (0 == threadIdx.x) {
         tempCellMap = _dynamicMemory.cellPosMap;
     }
@@ -1323,14 +1335,16 @@ __inline__ __device__ void ConstructorFunction::isObstaclePresent_firstCreation(
     __syncthreads();
     
     if (!ignoreOwnCluster) {
-        for (auto cellIndex = _cellBlock.startIndex; cellIndex <= _cellBlock.endIndex; ++cellIndex) {
-            auto const& cell = _cluster->cellPointers[cellIndex];
-            auto const relPos = cell->relPos - newCenter;
-            auto const absPos = _cluster->pos + Math::applyMatrix(relPos, clusterMatrix);
-            tempCellMap.insertOrAssign(toInt2(absPos), CellAndNewAbsPos{ cell, absPos });
-        }
+        tempCellMap.insertOrAssign_block(
+            _cluster->numCellPointers, [&](int cellIndex, int2& key, CellAndNewAbsPos& value) {
+                auto const& cell = _cluster->cellPointers[cellIndex];
+                auto const relPos = cell->relPos - newCenter;
+                auto const absPos = _cluster->pos + Math::applyMatrix(relPos, clusterMatrix);
+                key = toInt2(absPos);
+                value = CellAndNewAbsPos{cell, absPos};
+                return true;
+            });
     }
-    __syncthreads();
     
     for (auto cellIndex = _cellBlock.startIndex; cellIndex <= _cellBlock.endIndex; ++cellIndex) {
         auto const& cell = _cluster->cellPointers[cellIndex];
@@ -1356,7 +1370,7 @@ __inline__ __device__ bool ConstructorFunction::isObstaclePresent_helper(
     bool ignoreOwnCluster,
     Cell* cell,
     float2 const& absPos,
-    HashMap<int2, CellAndNewAbsPos, HashFunctor<int2>>& tempMap)
+    HashMap<int2, CellAndNewAbsPos>& tempMap)
 {
     auto const map = _data->cellMap;
     for (int dx = -1; dx <= 1; ++dx) {
@@ -1386,9 +1400,8 @@ __inline__ __device__ bool ConstructorFunction::isObstaclePresent_helper(
                 }
             }
             if (!ignoreOwnCluster) {
-                auto const lookupPosInt = toInt2(lookupPos);
-                if (tempMap.contains(lookupPosInt)) {
-                    auto otherCellAndNewPos = tempMap.at(lookupPosInt);
+                CellAndNewAbsPos otherCellAndNewPos;
+                if (tempMap.find(toInt2(lookupPos), otherCellAndNewPos)) {
                     if (cell != otherCellAndNewPos.cell) {
                         if (map.mapDistance(otherCellAndNewPos.newAbsPos, absPos)
                             < cudaSimulationParameters.cellMinDistance) {
@@ -1412,7 +1425,7 @@ __inline__ __device__ void ConstructorFunction::constructNewCell(
     if (0 == threadIdx.x) {
         EntityFactory factory;
         factory.init(_data);
-        result = factory.createCell(_cluster);
+        result = factory.createCell(_cluster, _numConstructedCells++);
         result->setEnergy_safe(energyOfNewCell);
         result->relPos = relPosOfNewCell;
         float rotMatrix[2][2];
@@ -1424,22 +1437,22 @@ __inline__ __device__ void ConstructorFunction::constructNewCell(
             static_cast<unsigned char>(constructionData.branchNumber) % cudaSimulationParameters.cellMaxTokenBranchNumber;
         result->tokenBlocked = true;
         result->setCellFunctionType(constructionData.cellFunctionType);
-        result->numStaticBytes = static_cast<unsigned char>(_token->memory[Enums::Constr::IN_CELL_FUNCTION_DATA])
+        result->coldData->numStaticBytes = static_cast<unsigned char>(_token->memory[Enums::Constr::IN_CELL_FUNCTION_DATA])
             % (MAX_CELL_STATIC_BYTES + 1);
-        offset = result->numStaticBytes + 1;
-        result->numMutableBytes = static_cast<unsigned char>(_token->memory[(Enums::Constr::IN_CELL_FUNCTION_DATA + offset) % MAX_TOKEN_MEM_SIZE])
+        offset = result->coldData->numStaticBytes + 1;
+        result->coldData->numMutableBytes = static_cast<unsigned char>(_token->memory[(Enums::Constr::IN_CELL_FUNCTION_DATA + offset) % MAX_TOKEN_MEM_SIZE])
             % (MAX_CELL_MUTABLE_BYTES + 1);
-        result->metadata.color = constructionData.metaData;
+        result->coldData->metadata.color = constructionData.metaData;
     }
     __syncthreads();
 
-    auto const staticDataBlock = calcPartition(result->numStaticBytes, threadIdx.x, blockDim.x);
+    auto const staticDataBlock = calcPartition(result->coldData->numStaticBytes, threadIdx.x, blockDim.x);
     for (int i = staticDataBlock.startIndex; i <= staticDataBlock.endIndex; ++i) {
-        result->staticData[i] = _token->memory[(Enums::Constr::IN_CELL_FUNCTION_DATA + i + 1) % MAX_TOKEN_MEM_SIZE];
+        result->coldData->staticData[i] = _token->memory[(Enums::Constr::IN_CELL_FUNCTION_DATA + i + 1) % MAX_TOKEN_MEM_SIZE];
     }
-    auto const mutableDataBlock = calcPartition(result->numMutableBytes, threadIdx.x, blockDim.x);
+    auto const mutableDataBlock = calcPartition(result->coldData->numMutableBytes, threadIdx.x, blockDim.x);
     for (int i = mutableDataBlock.startIndex; i <= mutableDataBlock.endIndex; ++i) {
-        result->mutableData[i] = _token->memory[(Enums::Constr::IN_CELL_FUNCTION_DATA + offset + i + 1) % MAX_TOKEN_MEM_SIZE];
+        result->coldData->mutableData[i] = _token->memory[(Enums::Constr::IN_CELL_FUNCTION_DATA + offset + i + 1) % MAX_TOKEN_MEM_SIZE];
     }
     __syncthreads();
 
@@ -18,4 +18,8 @@ struct ENGINEGPUKERNELS_EXPORT CudaConstants
 
     int DYNAMIC_MEMORY_SIZE = 0;
     int METADATA_DYNAMIC_MEMORY_SIZE = 0;
+
+    //entity arrays are compacted if more entries are used or more used entries are dead (see CompactionPolicy)
+    int MAX_FILL_LEVEL_PERCENT = 66;
+    int MAX_FRAGMENTATION_PERCENT = 50;
 };
@@ -3,8 +3,10 @@
 #include "EngineInterface/MonitorData.h"
 
 #include "Base.cuh"
+#include "CellFunctionData.cuh"
 #include "Definitions.cuh"
 #include "Entities.cuh"
+#include "SleepingRegions.h"
 
 class CudaMonitorData
 {
@@ -15,7 +17,11 @@ public:
         CudaMemoryManager::getInstance().acquireMemory<int>(1, _numClustersWithTokens);
         CudaMemoryManager::getInstance().acquireMemory<int>(1, _numCells);
         CudaMemoryManager::getInstance().acquireMemory<int>(1, _numTokens);
+        CudaMemoryManager::getInstance().acquireMemory<int>(Enums::CellFunction::_COUNTER, _numTokensByCellFunction);
+        CudaMemoryManager::getInstance().acquireMemory<unsigned long long>(
+            Enums::CellFunction::_COUNTER, _numProcessedTokensByCellFunction);
         CudaMemoryManager::getInstance().acquireMemory<int>(1, _numParticles);
+        CudaMemoryManager::getInstance().acquireMemory<int>(SleepingRegions::NumCounters, _sleepingRegionCounters);
         CudaMemoryManager::getInstance().acquireMemory<double>(1, _rotationalKineticEnergy);
         CudaMemoryManager::getInstance().acquireMemory<double>(1, _linearKineticEnergy);
         CudaMemoryManager::getInstance().acquireMemory<double>(1, _internalEnergy);
@@ -24,7 +30,11 @@ public:
         checkCudaErrors(cudaMemset(_numClustersWithTokens, 0, sizeof(int)));
         checkCudaErrors(cudaMemset(_numCells, 0, sizeof(int)));
         checkCudaErrors(cudaMemset(_numTokens, 0, sizeof(int)));
+        checkCudaErrors(cudaMemset(_numTokensByCellFunction, 0, sizeof(int) * Enums::CellFunction::_COUNTER));
+        checkCudaErrors(cudaMemset(
+            _numProcessedTokensByCellFunction, 0, sizeof(unsigned long long) * Enums::CellFunction::_COUNTER));
         checkCudaErrors(cudaMemset(_numParticles, 0, sizeof(int)));
+        checkCudaErrors(cudaMemset(_sleepingRegionCounters, 0, sizeof(int) * SleepingRegions::NumCounters));
 
         double zero = 0.0;
         checkCudaErrors(cudaMemcpy(_rotationalKineticEnergy, &zero, sizeof(double), cudaMemcpyHostToDevice));
@@ -39,7 +49,10 @@ public:
         CudaMemoryManager::getInstance().freeMemory(_numClustersWithTokens);
         CudaMemoryManager::getInstance().freeMemory(_numCells);
         CudaMemoryManager::getInstance().freeMemory(_numTokens);
+        CudaMemoryManager::getInstance().freeMemory(_numTokensByCellFunction);
+        CudaMemoryManager::getInstance().freeMemory(_numProcessedTokensByCellFunction);
         CudaMemoryManager::getInstance().freeMemory(_numParticles);
+        CudaMemoryManager::getInstance().freeMemory(_sleepingRegionCounters);
         CudaMemoryManager::getInstance().freeMemory(_rotationalKineticEnergy);
         CudaMemoryManager::getInstance().freeMemory(_linearKineticEnergy);
         CudaMemoryManager::getInstance().freeMemory(_internalEnergy);
@@ -53,6 +66,27 @@ public:
         checkCudaErrors(cudaMemcpy(&result.numCells, _numCells, sizeof(int), cudaMemcpyDeviceToHost));
         checkCudaErrors(cudaMemcpy(&result.numParticles, _numParticles, sizeof(int), cudaMemcpyDeviceToHost));
         checkCudaErrors(cudaMemcpy(&result.numTokens, _numTokens, sizeof(int), cudaMemcpyDeviceToHost));
+        checkCudaErrors(cudaMemcpy(
+            result.numTokensByCellFunction,
+            _numTokensByCellFunction,
+            sizeof(int) * Enums::CellFunction::_COUNTER,
+            cudaMemcpyDeviceToHost));
+        checkCudaErrors(cudaMemcpy(
+            result.numProcessedTokensByCellFunction,
+            _numProcessedTokensByCellFunction,
+            sizeof(unsigned long long) * Enums::CellFunction::_COUNTER,
+            cudaMemcpyDeviceToHost));
+
+        int sleepingRegionCounters[SleepingRegions::NumCounters];
+        checkCudaErrors(cudaMemcpy(
+            sleepingRegionCounters,
+            _sleepingRegionCounters,
+            sizeof(int) * SleepingRegions::NumCounters,
+            cudaMemcpyDeviceToHost));
+        result.numSleepingRegions = sleepingRegionCounters[SleepingRegions::NumSleepingRegions];
+        result.numRegionsFallenAsleep = sleepingRegionCounters[SleepingRegions::NumRegionsFallenAsleep];
+        result.numRegionsWokenUp = sleepingRegionCounters[SleepingRegions::NumRegionsWokenUp];
+
         checkCudaErrors(cudaMemcpy(&result.totalRotationalKineticEnergy, _rotationalKineticEnergy, sizeof(double), cudaMemcpyDeviceToHost));
         checkCudaErrors(cudaMemcpy(&result.totalLinearKineticEnergy, _linearKineticEnergy, sizeof(double), cudaMemcpyDeviceToHost));
         checkCudaErrors(cudaMemcpy(&result.totalInternalEnergy, _internalEnergy, sizeof(double), cudaMemcpyDeviceToHost));
@@ -66,6 +100,9 @@ public:
         *_numClustersWithTokens = 0;
         *_numCells = 0;
         *_numTokens = 0;
+        for (int cellFunction = 0; cellFunction < Enums::CellFunction::_COUNTER; ++cellFunction) {
+            _numTokensByCellFunction[cellFunction] = 0;
+        }
         *_numParticles = 0;
         *_rotationalKineticEnergy = 0.0f;
         *_linearKineticEnergy = 0.0f;
@@ -97,6 +134,28 @@ public:
         atomicAdd(_numTokens, changeValue);
     }
 
+    __inline__ __device__ void incNumTokensByCellFunction(Enums::CellFunction::Type cellFunction, int changeValue)
+    {
+        atomicAdd(&_numTokensByCellFunction[cellFunction], changeValue);
+    }
+
+    //single thread
+    __inline__ __device__ void setNumProcessedTokens(CellFunctionData const& cellFunctionData)
+    {
+        for (int cellFunction = 0; cellFunction < Enums::CellFunction::_COUNTER; ++cellFunction) {
+            _numProcessedTokensByCellFunction[cellFunction] = cellFunctionData.numProcessedTokens[cellFunction];
+        }
+    }
+
+    //single thread
+    __inline__ __device__ void setSleepingRegionCounters(SleepingRegions const& sleepingRegions)
+    {
+        for (int counter = 0; counter < SleepingRegions::NumCounters; ++counter) {
+            _sleepingRegionCounters[counter] =
+                sleepingRegions.getCounter(static_cast<SleepingRegions::Counter>(counter));
+        }
+    }
+
     __inline__ __device__ void incRotationalKineticEnergy(float changeValue)
     {
         atomicAdd(_rotationalKineticEnergy, static_cast<double>(changeValue));
@@ -117,7 +176,10 @@ private:
     int* _numClustersWithTokens;
     int* _numCells;
     int* _numTokens;
+    int* _numTokensByCellFunction;
+    unsigned long long* _numProcessedTokensByCellFunction;
     int* _numParticles;
+    int* _sleepingRegionCounters;
     double* _rotationalKineticEnergy;
     double* _linearKineticEnergy;
     double* _internalEnergy;
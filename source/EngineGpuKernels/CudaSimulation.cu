@@ -12,6 +12,7 @@
 
 #include "Base/Exceptions.h"
 #include "EngineInterface/SimulationParameters.h"
+#include "EngineInterface/PixelImageConstants.h"
 
 #include "AccessKernels.cuh"
 #include "AccessTOs.cuh"
@@ -28,6 +29,7 @@
 #include "Map.cuh"
 #include "MonitorKernels.cuh"
 #include "PhysicalActionKernels.cuh"
+#include "PixelImageKernels.cuh"
 #include "RenderingKernels.cuh"
 #include "SimulationData.cuh"
 #include "SimulationKernels.cuh"
@@ -113,7 +115,8 @@ CudaSimulation::CudaSimulation(
     int2 const& worldSize,
     int timestep,
     SimulationParameters const& parameters,
-    CudaConstants const& cudaConstants)
+    CudaConstants const& cudaConstants,
+    uint64_t randomSeed)
 {
     CudaInitializer::init();
     CudaMemoryManager::getInstance().reset();
@@ -127,25 +130,17 @@ CudaSimulation::CudaSimulation(
     _cudaSimulationData = new SimulationData();
     _cudaAccessTO = new DataAccessTO();
     _cudaMonitorData = new CudaMonitorData();
+    _cudaTiledImageData = new TiledImageData();
 
     auto const memorySizeBefore = CudaMemoryManager::getInstance().getSizeOfAcquiredMemory();
 
-    _cudaSimulationData->init(worldSize, cudaConstants, timestep);
+    _cudaSimulationData->init(worldSize, cudaConstants, timestep, randomSeed);
     _cudaMonitorData->init();
+    _cudaTiledImageData->init(worldSize);
 
-    CudaMemoryManager::getInstance().acquireMemory<int>(1, _cudaAccessTO->numCells);
-    CudaMemoryManager::getInstance().acquireMemory<int>(1, _cudaAccessTO->numClusters);
-    CudaMemoryManager::getInstance().acquireMemory<int>(1, _cudaAccessTO->numParticles);
-    CudaMemoryManager::getInstance().acquireMemory<int>(1, _cudaAccessTO->numTokens);
-    CudaMemoryManager::getInstance().acquireMemory<int>(1, _cudaAccessTO->numStringBytes);
-    CudaMemoryManager::getInstance().acquireMemory<ClusterAccessTO>(
-        cudaConstants.MAX_CLUSTERS, _cudaAccessTO->clusters);
-    CudaMemoryManager::getInstance().acquireMemory<CellAccessTO>(cudaConstants.MAX_CELLS, _cudaAccessTO->cells);
-    CudaMemoryManager::getInstance().acquireMemory<ParticleAccessTO>(
-        cudaConstants.MAX_PARTICLES, _cudaAccessTO->particles);
-    CudaMemoryManager::getInstance().acquireMemory<TokenAccessTO>(cudaConstants.MAX_TOKENS, _cudaAccessTO->tokens);
-    CudaMemoryManager::getInstance().acquireMemory<char>(
-        cudaConstants.METADATA_DYNAMIC_MEMORY_SIZE, _cudaAccessTO->stringBytes);
+    _accessTOLayout = calcAccessTOLayout(cudaConstants);
+    CudaMemoryManager::getInstance().acquireMemory<unsigned char>(_accessTOLayout.getSize(), _cudaAccessBuffer);
+    *_cudaAccessTO = createDataAccessTO(_cudaAccessBuffer, _accessTOLayout);
 
     auto const memorySizeAfter = CudaMemoryManager::getInstance().getSizeOfAcquiredMemory();
 
@@ -159,17 +154,9 @@ CudaSimulation::~CudaSimulation()
 {
     _cudaSimulationData->free();
     _cudaMonitorData->free();
+    _cudaTiledImageData->free();
 
-    CudaMemoryManager::getInstance().freeMemory(_cudaAccessTO->numClusters);
-    CudaMemoryManager::getInstance().freeMemory(_cudaAccessTO->numCells);
-    CudaMemoryManager::getInstance().freeMemory(_cudaAccessTO->numParticles);
-    CudaMemoryManager::getInstance().freeMemory(_cudaAccessTO->numTokens);
-    CudaMemoryManager::getInstance().freeMemory(_cudaAccessTO->numStringBytes);
-    CudaMemoryManager::getInstance().freeMemory(_cudaAccessTO->clusters);
-    CudaMemoryManager::getInstance().freeMemory(_cudaAccessTO->cells);
-    CudaMemoryManager::getInstance().freeMemory(_cudaAccessTO->particles);
-    CudaMemoryManager::getInstance().freeMemory(_cudaAccessTO->tokens);
-    CudaMemoryManager::getInstance().freeMemory(_cudaAccessTO->stringBytes);
+    CudaMemoryManager::getInstance().freeMemory(_cudaAccessBuffer);
 
     auto loggingService = ServiceLocator::getInstance().getService<LoggingService>();
     loggingService->logMessage(Priority::Important, "GPU memory released");
@@ -177,6 +164,22 @@ CudaSimulation::~CudaSimulation()
     delete _cudaAccessTO;
     delete _cudaSimulationData;
     delete _cudaMonitorData;
+    delete _cudaTiledImageData;
+}
+
+unsigned char* CudaSimulation::acquirePageLockedMemory(uint64_t size)
+{
+    unsigned char* result = nullptr;
+    if (cudaSuccess != cudaMallocHost(&result, size)) {
+        cudaGetLastError();
+        return nullptr;
+    }
+    return result;
+}
+
+void CudaSimulation::freePageLockedMemory(unsigned char* memory)
+{
+    CHECK_FOR_CUDA_ERROR(cudaFreeHost(memory));
 }
 
 void* CudaSimulation::registerImageResource(GLuint image)
@@ -207,24 +210,45 @@ void CudaSimulation::DEBUG_printNumEntries()
     loggingService->logMessage(Priority::Important, stream.str());
 }
 
-void CudaSimulation::getPixelImage(
-    int2 const& rectUpperLeft,
-    int2 const& rectLowerRight,
-    int2 const& imageSize,
-    unsigned char* imageData)
+void CudaSimulation::getPixelImageTiles(
+    int level,
+    int2 const& tileRectUpperLeft,
+    int2 const& tileRectLowerRight,
+    std::vector<int>& tileIndices,
+    std::vector<unsigned int>& tilePixels)
 {
-    if (imageSize.x * imageSize.y > _cudaSimulationData->numImageBytes) {
-        _cudaSimulationData->resizeImage(imageSize);
-    }
+    auto const& levelData = _cudaTiledImageData->getLevel(level);
+    _cudaTiledImageData->reserveTiles(
+        (tileRectLowerRight.x - tileRectUpperLeft.x) * (tileRectLowerRight.y - tileRectUpperLeft.y));
+    GPU_FUNCTION(
+        drawTiledImage, levelData, tileRectUpperLeft, tileRectLowerRight, *_cudaSimulationData, *_cudaTiledImageData);
 
-/*
-    GPU_FUNCTION(cudaDrawImage_pixelStyle, rectUpperLeft, rectLowerRight, imageSize, * _cudaSimulationData);
-*/
+    int numDirtyTiles;
+    CHECK_FOR_CUDA_ERROR(
+        cudaMemcpy(&numDirtyTiles, _cudaTiledImageData->numDirtyTiles, sizeof(int), cudaMemcpyDeviceToHost));
+
+    auto const numTilePixels = Const::PixelImageTileSize * Const::PixelImageTileSize;
+    tileIndices.resize(numDirtyTiles);
+    tilePixels.resize(numDirtyTiles * numTilePixels);
+    if (0 == numDirtyTiles) {
+        return;
+    }
     CHECK_FOR_CUDA_ERROR(cudaMemcpy(
-        imageData,
-        _cudaSimulationData->imageData,
-        sizeof(unsigned int) * imageSize.x * imageSize.y,
+        tileIndices.data(),
+        _cudaTiledImageData->dirtyTileIndices,
+        sizeof(int) * numDirtyTiles,
         cudaMemcpyDeviceToHost));
+
+    //staging memory on the GPU is limited to one batch
+    for (int firstTile = 0; firstTile < numDirtyTiles; firstTile += TiledImageData::MaxTilesPerBatch) {
+        auto const numTiles = std::min(TiledImageData::MaxTilesPerBatch, numDirtyTiles - firstTile);
+        GPU_FUNCTION(gatherDirtyTileBatch, levelData, *_cudaTiledImageData, firstTile, numTiles);
+        CHECK_FOR_CUDA_ERROR(cudaMemcpy(
+            tilePixels.data() + firstTile * numTilePixels,
+            _cudaTiledImageData->dirtyTilePixels,
+            sizeof(unsigned int) * numTiles * numTilePixels,
+            cudaMemcpyDeviceToHost));
+    }
 }
 
 void CudaSimulation::getVectorImage(
@@ -267,35 +291,27 @@ void CudaSimulation::getSimulationData(
     int2 const& rectLowerRight,
     DataAccessTO const& dataTO)
 {
-    GPU_FUNCTION(cudaGetSimulationAccessData, rectUpperLeft, rectLowerRight, *_cudaSimulationData, *_cudaAccessTO);
+    GPU_FUNCTION(
+        cudaGetSimulationAccessData,
+        rectUpperLeft,
+        rectLowerRight,
+        *_cudaSimulationData,
+        *_cudaAccessTO,
+        _accessTOLayout);
 
+    //the arrays are packed on the device: the header yields the size of the remaining piece
     CHECK_FOR_CUDA_ERROR(
-        cudaMemcpy(dataTO.numClusters, _cudaAccessTO->numClusters, sizeof(int), cudaMemcpyDeviceToHost));
-    CHECK_FOR_CUDA_ERROR(cudaMemcpy(dataTO.numCells, _cudaAccessTO->numCells, sizeof(int), cudaMemcpyDeviceToHost));
-    CHECK_FOR_CUDA_ERROR(
-        cudaMemcpy(dataTO.numParticles, _cudaAccessTO->numParticles, sizeof(int), cudaMemcpyDeviceToHost));
-    CHECK_FOR_CUDA_ERROR(cudaMemcpy(dataTO.numTokens, _cudaAccessTO->numTokens, sizeof(int), cudaMemcpyDeviceToHost));
-    CHECK_FOR_CUDA_ERROR(
-        cudaMemcpy(dataTO.numStringBytes, _cudaAccessTO->numStringBytes, sizeof(int), cudaMemcpyDeviceToHost));
+        cudaMemcpy(dataTO.buffer, _cudaAccessBuffer, sizeof(AccessTOLayout::Header), cudaMemcpyDeviceToHost));
+    auto const packedLayout = _accessTOLayout.getPackedLayout(AccessTOLayout::getHeader(dataTO.buffer));
+    auto const headerSize = packedLayout.getOffset(AccessTOLayout::Clusters);
     CHECK_FOR_CUDA_ERROR(cudaMemcpy(
-        dataTO.clusters,
-        _cudaAccessTO->clusters,
-        sizeof(ClusterAccessTO) * (*dataTO.numClusters),
-        cudaMemcpyDeviceToHost));
-    CHECK_FOR_CUDA_ERROR(cudaMemcpy(
-        dataTO.cells, _cudaAccessTO->cells, sizeof(CellAccessTO) * (*dataTO.numCells), cudaMemcpyDeviceToHost));
-    CHECK_FOR_CUDA_ERROR(cudaMemcpy(
-        dataTO.particles,
-        _cudaAccessTO->particles,
-        sizeof(ParticleAccessTO) * (*dataTO.numParticles),
-        cudaMemcpyDeviceToHost));
-    CHECK_FOR_CUDA_ERROR(cudaMemcpy(
-        dataTO.tokens, _cudaAccessTO->tokens, sizeof(TokenAccessTO) * (*dataTO.numTokens), cudaMemcpyDeviceToHost));
-    CHECK_FOR_CUDA_ERROR(cudaMemcpy(
-        dataTO.stringBytes,
-        _cudaAccessTO->stringBytes,
-        sizeof(char) * (*dataTO.numStringBytes),
+        dataTO.buffer + headerSize,
+        _cudaAccessBuffer + headerSize,
+        packedLayout.getSize() - headerSize,
         cudaMemcpyDeviceToHost));
+
+    //DataConverter may append elements
+    _accessTOLayout.unpack(dataTO.buffer, packedLayout);
 }
 
 void CudaSimulation::setSimulationData(
@@ -303,35 +319,21 @@ void CudaSimulation::setSimulationData(
     int2 const& rectLowerRight,
     DataAccessTO const& dataTO)
 {
+    auto const packedLayout = _accessTOLayout.getPackedLayout(AccessTOLayout::getHeader(dataTO.buffer));
+    _accessTOLayout.pack(dataTO.buffer, packedLayout);
     CHECK_FOR_CUDA_ERROR(
-        cudaMemcpy(_cudaAccessTO->numClusters, dataTO.numClusters, sizeof(int), cudaMemcpyHostToDevice));
-    CHECK_FOR_CUDA_ERROR(cudaMemcpy(_cudaAccessTO->numCells, dataTO.numCells, sizeof(int), cudaMemcpyHostToDevice));
-    CHECK_FOR_CUDA_ERROR(
-        cudaMemcpy(_cudaAccessTO->numParticles, dataTO.numParticles, sizeof(int), cudaMemcpyHostToDevice));
-    CHECK_FOR_CUDA_ERROR(cudaMemcpy(_cudaAccessTO->numTokens, dataTO.numTokens, sizeof(int), cudaMemcpyHostToDevice));
-    CHECK_FOR_CUDA_ERROR(
-        cudaMemcpy(_cudaAccessTO->numStringBytes, dataTO.numStringBytes, sizeof(int), cudaMemcpyHostToDevice));
-    CHECK_FOR_CUDA_ERROR(cudaMemcpy(
-        _cudaAccessTO->clusters,
-        dataTO.clusters,
-        sizeof(ClusterAccessTO) * (*dataTO.numClusters),
-        cudaMemcpyHostToDevice));
-    CHECK_FOR_CUDA_ERROR(cudaMemcpy(
-        _cudaAccessTO->cells, dataTO.cells, sizeof(CellAccessTO) * (*dataTO.numCells), cudaMemcpyHostToDevice));
-    CHECK_FOR_CUDA_ERROR(cudaMemcpy(
-        _cudaAccessTO->particles,
-        dataTO.particles,
-        sizeof(ParticleAccessTO) * (*dataTO.numParticles),
-        cudaMemcpyHostToDevice));
-    CHECK_FOR_CUDA_ERROR(cudaMemcpy(
-        _cudaAccessTO->tokens, dataTO.tokens, sizeof(TokenAccessTO) * (*dataTO.numTokens), cudaMemcpyHostToDevice));
-    CHECK_FOR_CUDA_ERROR(cudaMemcpy(
-        _cudaAccessTO->stringBytes,
-        dataTO.stringBytes,
-        sizeof(char) * (*dataTO.numStringBytes),
-        cudaMemcpyHostToDevice));
+        cudaMemcpy(_cudaAccessBuffer, dataTO.buffer, packedLayout.getSize(), cudaMemcpyHostToDevice));
+
+    //the kernels read the packed arrays directly
+    GPU_FUNCTION(
+        cudaSetSimulationAccessData,
+        rectUpperLeft,
+        rectLowerRight,
+        *_cudaSimulationData,
+        createDataAccessTO(_cudaAccessBuffer, packedLayout));
 
-    GPU_FUNCTION(cudaSetSimulationAccessData, rectUpperLeft, rectLowerRight, *_cudaSimulationData, *_cudaAccessTO);
+    //removed entities are not tracked by TileChanges
+    _cudaTiledImageData->invalidate();
 }
 
 void CudaSimulation::selectData(int2 const& pos)
@@ -391,6 +393,7 @@ void CudaSimulation::setExecutionParameters(ExecutionParameters const& parameter
 void CudaSimulation::clear()
 {
     GPU_FUNCTION(cudaClearData, *_cudaSimulationData);
+    _cudaTiledImageData->invalidate();
 }
 
 namespace
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <vector>
+
 #include <windows.h>
 #include <GL/gl.h>
 
+#include "AccessTOLayout.h"
 #include "CudaConstants.h"
 #include "Definitions.cuh"
 #include "DllExport.h"
@@ -16,25 +19,34 @@ public:
         int2 const& worldSize,
         int timestep,
         SimulationParameters const& parameters,
-        CudaConstants const& cudaConstants);
+        CudaConstants const& cudaConstants,
+        uint64_t randomSeed);
     ~CudaSimulation();
 
+    //page-locked host memory, e.g. for buffers of DataAccessTO, returns nullptr if not available
+    static unsigned char* acquirePageLockedMemory(uint64_t size);
+    static void freePageLockedMemory(unsigned char* memory);
+
     void* registerImageResource(GLuint image);
 
     void calcCudaTimestep();
 
-    void getPixelImage(
-        int2 const& rectUpperLeft,
-        int2 const& rectLowerRight,
-        int2 const& imageSize,
-        unsigned char* imageData);
+    //renders the tiles of the pixel image level whose content has changed and returns them (see TiledPixelImage)
+    void getPixelImageTiles(
+        int level,
+        int2 const& tileRectUpperLeft,
+        int2 const& tileRectLowerRight,
+        std::vector<int>& tileIndices,
+        std::vector<unsigned int>& tilePixels);
     void getVectorImage(
         float2 const& rectUpperLeft,
         float2 const& rectLowerRight,
         void* const& resource,
         int2 const& imageSize,
         double zoom);
+    //dataTO: buffer with the layout calcAccessTOLayout(getCudaConstants()), preferably page-locked
     void getSimulationData(int2 const& rectUpperLeft, int2 const& rectLowerRight, DataAccessTO const& dataTO);
+    //the content of dataTO is packed in place (see AccessTOLayout) and cannot be used afterwards
     void setSimulationData(int2 const& rectUpperLeft, int2 const& rectLowerRight, DataAccessTO const& dataTO);
 
     void selectData(int2 const& pos);
@@ -67,6 +79,9 @@ private:
 private:
     CudaConstants _cudaConstants;
     SimulationData* _cudaSimulationData;
+    AccessTOLayout _accessTOLayout;
+    unsigned char* _cudaAccessBuffer;
     DataAccessTO* _cudaAccessTO;
     CudaMonitorData* _cudaMonitorData;
+    TiledImageData* _cudaTiledImageData;
 };
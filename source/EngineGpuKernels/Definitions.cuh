@@ -1,6 +1,7 @@
 #pragma once
 
 struct Cell;
+struct CellColdData;
 struct Cluster;
 struct Token;
 struct Particle;
@@ -13,6 +14,7 @@ struct DataAccessTO;
 struct SimulationParameters;
 struct CudaConstants;
 class CudaMonitorData;
+class TiledImageData;
 
 #define FP_PRECISION 0.00001
 
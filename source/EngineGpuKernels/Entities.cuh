@@ -12,8 +12,23 @@ struct Entities
     Array<Token*> tokenPointers;
     Array<Particle*> particlePointers;
 
+    //indices of the entries of clusterPointers and particlePointers cleared since the last compaction
+    Array<int> clearedClusterPointers;
+    Array<int> clearedParticlePointers;
+    Array<int> compactionCounters;
+
+    //numbers of cells and tokens referenced by the clusters, counted before compaction
+    enum LiveEntityCounter
+    {
+        LiveCells,
+        LiveTokens,
+        NumLiveEntityCounters
+    };
+    Array<int> liveEntityCounters;
+
     Array<Cluster> clusters;
     Array<Cell> cells;
+    Array<CellColdData> cellColdData;   //one element per cell, compacted together with cells
     Array<Token> tokens;
     Array<Particle> particles;
 
@@ -26,10 +41,15 @@ struct Entities
         clusters.init(cudaConstants.MAX_CLUSTERS);
         cellPointers.init(cudaConstants.MAX_CELLPOINTERS);
         cells.init(cudaConstants.MAX_CELLS);
+        cellColdData.init(cudaConstants.MAX_CELLS);
         tokenPointers.init(cudaConstants.MAX_TOKENPOINTERS);
         tokens.init(cudaConstants.MAX_TOKENS);
         particles.init(cudaConstants.MAX_PARTICLES);
         particlePointers.init(cudaConstants.MAX_PARTICLEPOINTERS);
+        clearedClusterPointers.init(cudaConstants.MAX_CLUSTERPOINTERS);
+        clearedParticlePointers.init(cudaConstants.MAX_PARTICLEPOINTERS);
+        compactionCounters.init(2);
+        liveEntityCounters.init(NumLiveEntityCounters);
         strings.init(cudaConstants.METADATA_DYNAMIC_MEMORY_SIZE);
     }
 
@@ -40,11 +60,28 @@ struct Entities
         clusters.free();
         cellPointers.free();
         cells.free();
+        cellColdData.free();
         tokenPointers.free();
         tokens.free();
         particles.free();
         particlePointers.free();
+        clearedClusterPointers.free();
+        clearedParticlePointers.free();
+        compactionCounters.free();
+        liveEntityCounters.free();
         strings.free();
     }
+
+    __device__ __inline__ void clearClusterPointer(Cluster*& clusterPointer)
+    {
+        clusterPointer = nullptr;
+        *clearedClusterPointers.getNewElement() = &clusterPointer - clusterPointers.getArrayForDevice();
+    }
+
+    __device__ __inline__ void clearParticlePointer(Particle*& particlePointer)
+    {
+        particlePointer = nullptr;
+        *clearedParticlePointers.getNewElement() = &particlePointer - particlePointers.getArrayForDevice();
+    }
 };
 
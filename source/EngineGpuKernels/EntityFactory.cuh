@@ -20,10 +20,13 @@ private:
 
 public:
     __inline__ __device__ void init(SimulationData* data);
-    __inline__ __device__ Cell* createCell(Cluster* cluster);
+    //index distinguishes the cells created for the same cluster in a timestep
+    __inline__ __device__ Cell* createCell(Cluster* cluster, int index);
     __inline__ __device__ Token* createToken(Cell* cell, Cell* sourceCell);
     __inline__ __device__ Particle* createParticleFromTO(
         ParticleAccessTO const& particleTO);  //TODO: not adding to simulation!
+    //deterministic mode: the id is drawn from the stream of the calling thread, hence the caller has to call
+    //beginEntity for the emitting entity first
     __inline__ __device__ Particle* createParticle(
         float energy,
         float2 const& pos,
@@ -33,9 +36,13 @@ public:
     __inline__ __device__ void createClusterFromTO_block(
         ClusterAccessTO const& clusterTO,
         DataAccessTO const* _simulationTO);
-    __inline__ __device__ Cluster* createClusterWithRandomCell(float energy, float2 const& pos, float2 const& vel);
+    __inline__ __device__ Cluster*
+    createClusterWithRandomCell(uint64_t originId, float energy, float2 const& pos, float2 const& vel);
 
 private:
+    //deterministic mode: ids only depend on the creating entity, the timestep and the index of the creation
+    __inline__ __device__ uint64_t createNewId(uint64_t originId, int index);
+
     __inline__ __device__ void
     copyString(int& targetLen, char*& targetString, int sourceLen, int sourceStringIndex, char* stringBytes);
 };
@@ -67,6 +74,7 @@ __inline__ __device__ void EntityFactory::createClusterFromTO_block(
 {
     __shared__ Cluster* cluster;
     __shared__ Cell* cells;
+    __shared__ CellColdData* cellColdData;
     __shared__ Token* tokens;
     __shared__ float angularMass;
     __shared__ float invRotMatrix[2][2];
@@ -87,6 +95,7 @@ __inline__ __device__ void EntityFactory::createClusterFromTO_block(
         cluster->numCellPointers = clusterTO.numCells;
         cluster->cellPointers = _data->entities.cellPointers.getNewSubarray(cluster->numCellPointers);
         cells = _data->entities.cells.getNewSubarray(cluster->numCellPointers);
+        cellColdData = _data->entities.cellColdData.getNewSubarray(cluster->numCellPointers);
         cluster->numTokenPointers = clusterTO.numTokens;
         cluster->tokenPointers = _data->entities.tokenPointers.getNewSubarray(cluster->numTokenPointers);
         tokens = _data->entities.tokens.getNewSubarray(cluster->numTokenPointers);
@@ -115,6 +124,7 @@ __inline__ __device__ void EntityFactory::createClusterFromTO_block(
         auto const& cellTO = simulationTO->cells[clusterTO.cellStartIndex + cellIndex];
         cell.id = cellTO.id;
         cell.cluster = cluster;
+        cell.coldData = &cellColdData[cellIndex];
         cell.absPos = cellTO.pos + posCorrection;
 
         float2 deltaPos = cell.absPos - clusterTO.pos;
@@ -141,44 +151,44 @@ __inline__ __device__ void EntityFactory::createClusterFromTO_block(
 
         switch (cell.getCellFunctionType()) {
         case Enums::CellFunction::COMPUTER: {
-            cell.numStaticBytes = cellTO.numStaticBytes;
-            cell.numMutableBytes = cudaSimulationParameters.cellFunctionComputerCellMemorySize;
+            cell.coldData->numStaticBytes = cellTO.numStaticBytes;
+            cell.coldData->numMutableBytes = cudaSimulationParameters.cellFunctionComputerCellMemorySize;
         } break;
         case Enums::CellFunction::SENSOR: {
-            cell.numStaticBytes = 0;
-            cell.numMutableBytes = 5;
+            cell.coldData->numStaticBytes = 0;
+            cell.coldData->numMutableBytes = 5;
         } break;
         default: {
-            cell.numStaticBytes = 0;
-            cell.numMutableBytes = 0;
+            cell.coldData->numStaticBytes = 0;
+            cell.coldData->numMutableBytes = 0;
         }
         }
         for (int i = 0; i < MAX_CELL_STATIC_BYTES; ++i) {
-            cell.staticData[i] = cellTO.staticData[i];
+            cell.coldData->staticData[i] = cellTO.staticData[i];
         }
         for (int i = 0; i < MAX_CELL_MUTABLE_BYTES; ++i) {
-            cell.mutableData[i] = cellTO.mutableData[i];
+            cell.coldData->mutableData[i] = cellTO.mutableData[i];
         }
         cell.tokenUsages = cellTO.tokenUsages;
-        cell.metadata.color = cellTO.metadata.color;
+        cell.coldData->metadata.color = cellTO.metadata.color;
 
         copyString(
-            cell.metadata.nameLen,
-            cell.metadata.name,
+            cell.coldData->metadata.nameLen,
+            cell.coldData->metadata.name,
             cellTO.metadata.nameLen,
             cellTO.metadata.nameStringIndex,
             simulationTO->stringBytes);
 
         copyString(
-            cell.metadata.descriptionLen,
-            cell.metadata.description,
+            cell.coldData->metadata.descriptionLen,
+            cell.coldData->metadata.description,
             cellTO.metadata.descriptionLen,
             cellTO.metadata.descriptionStringIndex,
             simulationTO->stringBytes);
 
         copyString(
-            cell.metadata.sourceCodeLen,
-            cell.metadata.sourceCode,
+            cell.coldData->metadata.sourceCodeLen,
+            cell.coldData->metadata.sourceCode,
             cellTO.metadata.sourceCodeLen,
             cellTO.metadata.sourceCodeStringIndex,
             simulationTO->stringBytes);
@@ -186,6 +196,7 @@ __inline__ __device__ void EntityFactory::createClusterFromTO_block(
         cell.initProtectionCounter();
         cell.alive = 1;
         cell.locked = 0;
+        cell.coldData->drawnPixel = TileChanges::NoPixel;
     }
 
     PartitionData tokenBlock = calcPartition(cluster->numTokenPointers, threadIdx.x, blockDim.x);
@@ -211,19 +222,21 @@ __inline__ __device__ void EntityFactory::createClusterFromTO_block(
     }
 }
 
-__inline__ __device__ Cell* EntityFactory::createCell(Cluster* cluster)
+__inline__ __device__ Cell* EntityFactory::createCell(Cluster* cluster, int index)
 {
     auto result = _data->entities.cells.getNewSubarray(1);
+    result->coldData = _data->entities.cellColdData.getNewElement();
     result->cluster = cluster;
     result->tokenUsages = 0;
-    result->id = _data->numberGen.createNewId_kernel();
+    result->id = createNewId(cluster->id, index);
     result->locked = 0;
     result->initProtectionCounter();
     result->alive = 1;
-    result->metadata.color = 0;
-    result->metadata.nameLen = 0;
-    result->metadata.descriptionLen = 0;
-    result->metadata.sourceCodeLen = 0;
+    result->coldData->metadata.color = 0;
+    result->coldData->metadata.nameLen = 0;
+    result->coldData->metadata.descriptionLen = 0;
+    result->coldData->metadata.sourceCodeLen = 0;
+    result->coldData->drawnPixel = TileChanges::NoPixel;
     result->setFused(false);
     return result;
 }
@@ -249,22 +262,24 @@ __inline__ __device__ Particle* EntityFactory::createParticleFromTO(ParticleAcce
     particle->setEnergy(particleTO.energy);
     particle->locked = 0;
     particle->alive = 1;
+    particle->drawnPixel = TileChanges::NoPixel;
     particle->metadata.color = particleTO.metadata.color;
     particle->setSelected(false);
     return particle;
 }
 
 __inline__ __device__ Cluster*
-EntityFactory::createClusterWithRandomCell(float energy, float2 const& pos, float2 const& vel)
+EntityFactory::createClusterWithRandomCell(uint64_t originId, float energy, float2 const& pos, float2 const& vel)
 {
     auto clusterPointer = _data->entities.clusterPointers.getNewElement();
     auto cluster = _data->entities.clusters.getNewElement();
     *clusterPointer = cluster;
 
     auto cell = _data->entities.cells.getNewElement();
+    cell->coldData = _data->entities.cellColdData.getNewElement();
     auto cellPointers = _data->entities.cellPointers.getNewElement();
 
-    cluster->id = _data->numberGen.createNewId_kernel();
+    cluster->id = createNewId(originId, 0);
     cluster->pos = pos;
     cluster->setVelocity(vel);
     cluster->setSelected(false);
@@ -282,11 +297,12 @@ EntityFactory::createClusterWithRandomCell(float energy, float2 const& pos, floa
     cluster->decompositionRequired = 0;
     cluster->init();
 
-    cell->id = _data->numberGen.createNewId_kernel();
+    cell->id = createNewId(originId, 1);
     cell->absPos = pos;
     cell->relPos = {0.0f, 0.0f};
     cell->vel = vel;
     cell->setEnergy_safe(energy);
+    _data->numberGen.beginEntity(cell->id, _data->timestep, RandomPurpose::Creation);
     cell->maxConnections = _data->numberGen.random(MAX_CELL_BONDS);
     cell->cluster = cluster;
     cell->branchNumber = _data->numberGen.random(cudaSimulationParameters.cellMaxTokenBranchNumber - 1);
@@ -296,30 +312,31 @@ EntityFactory::createClusterWithRandomCell(float energy, float2 const& pos, floa
     cell->initProtectionCounter();
     cell->locked = 0;
     cell->setFused(false);
-    cell->metadata.color = 0;
-    cell->metadata.nameLen = 0;
-    cell->metadata.descriptionLen = 0;
-    cell->metadata.sourceCodeLen = 0;
+    cell->coldData->metadata.color = 0;
+    cell->coldData->metadata.nameLen = 0;
+    cell->coldData->metadata.descriptionLen = 0;
+    cell->coldData->metadata.sourceCodeLen = 0;
+    cell->coldData->drawnPixel = TileChanges::NoPixel;
     cell->setCellFunctionType(_data->numberGen.random(static_cast<int>(Enums::CellFunction::_COUNTER) - 1));
     switch (cell->getCellFunctionType()) {
     case Enums::CellFunction::COMPUTER: {
-        cell->numStaticBytes = cudaSimulationParameters.cellFunctionComputerMaxInstructions * 3;
-        cell->numMutableBytes = cudaSimulationParameters.cellFunctionComputerCellMemorySize;
+        cell->coldData->numStaticBytes = cudaSimulationParameters.cellFunctionComputerMaxInstructions * 3;
+        cell->coldData->numMutableBytes = cudaSimulationParameters.cellFunctionComputerCellMemorySize;
     } break;
     case Enums::CellFunction::SENSOR: {
-        cell->numStaticBytes = 0;
-        cell->numMutableBytes = 5;
+        cell->coldData->numStaticBytes = 0;
+        cell->coldData->numMutableBytes = 5;
     } break;
     default: {
-        cell->numStaticBytes = 0;
-        cell->numMutableBytes = 0;
+        cell->coldData->numStaticBytes = 0;
+        cell->coldData->numMutableBytes = 0;
     }
     }
     for (int i = 0; i < MAX_CELL_STATIC_BYTES; ++i) {
-        cell->staticData[i] = _data->numberGen.random(255);
+        cell->coldData->staticData[i] = _data->numberGen.random(255);
     }
     for (int i = 0; i < MAX_CELL_MUTABLE_BYTES; ++i) {
-        cell->mutableData[i] = _data->numberGen.random(255);
+        cell->coldData->mutableData[i] = _data->numberGen.random(255);
     }
     cell->tokenUsages = 0;
     return cluster;
@@ -337,6 +354,12 @@ EntityFactory::copyString(int& targetLen, char*& targetString, int sourceLen, in
     }
 }
 
+__inline__ __device__ uint64_t EntityFactory::createNewId(uint64_t originId, int index)
+{
+    _data->numberGen.beginEntity(originId, _data->timestep, RandomPurpose::IdCreation, index);
+    return _data->numberGen.createNewId_kernel();
+}
+
 __inline__ __device__ Particle*
 EntityFactory::createParticle(float energy, float2 const& pos, float2 const& vel, ParticleMetadata const& metadata)
 {
@@ -346,6 +369,7 @@ EntityFactory::createParticle(float energy, float2 const& pos, float2 const& vel
     particle->id = _data->numberGen.createNewId_kernel();
     particle->locked = 0;
     particle->alive = 1;
+    particle->drawnPixel = TileChanges::NoPixel;
     particle->setEnergy(energy);
     particle->absPos = pos;
     particle->vel = vel;
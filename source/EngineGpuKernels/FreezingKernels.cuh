@@ -16,18 +16,45 @@
 /* Helpers                                                              */
 /************************************************************************/
 
+//all regions covered by the cells of the cluster have to sleep
+__device__ __inline__ bool isInSleepingRegion(SimulationData const& data, Cluster* cluster)
+{
+    auto pos = cluster->pos;
+    data.cellMap.mapPosCorrection(pos);
+    if (!data.sleepingRegions.isSleeping(pos.x, pos.y)) {
+        return false;
+    }
+    return data.sleepingRegions.areAllSleeping(pos.x, pos.y, cluster->calcRadius());
+}
+
+//clusters at rest without pending processing do not keep their regions awake
+__device__ __inline__ bool isIdle(Cluster* cluster)
+{
+    return cluster->isCandidateToFreeze()
+        && Math::length(cluster->getVelocity()) < SleepingRegions::MaxIdleVelocity
+        && abs(cluster->getAngularVelocity()) < SleepingRegions::MaxIdleAngularVelocity;
+}
+
+__device__ __inline__ bool isFreezingAllowed(SimulationData const& data, Cluster* cluster)
+{
+    if (cudaExecutionParameters.activateFreezing && cluster->isCandidateToFreeze()) {
+        return true;
+    }
+    return cudaExecutionParameters.regionSleeping && isInSleepingRegion(data, cluster);
+}
+
 __global__ void freezeClustersIfAllowed(SimulationData data)
 {
-    if (cudaExecutionParameters.activateFreezing) {
+    if (cudaExecutionParameters.activateFreezing || cudaExecutionParameters.regionSleeping) {
         auto const clusterPartition = calcPartition(
             data.entities.clusterPointers.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
         for (auto clusterIndex = clusterPartition.startIndex; clusterIndex <= clusterPartition.endIndex; ++clusterIndex) {
             auto& cluster = data.entities.clusterPointers.at(clusterIndex);
-            if (cluster && cluster->isCandidateToFreeze()) {
+            if (cluster && isFreezingAllowed(data, cluster)) {
                 auto clusterFreezedPointer = data.entities.clusterFreezedPointers.getNewElement();
                 *clusterFreezedPointer = cluster;
                 cluster->freeze(clusterFreezedPointer);
-                cluster = nullptr;
+                data.entities.clearClusterPointer(cluster);
             }
         }
     }
@@ -48,6 +75,118 @@ __global__ void unfreezeAllClusters(SimulationData data)
 
 }
 
+__global__ void markActiveRegionsByClusters(SimulationData data)
+{
+    auto const clusterPartition = calcPartition(data.entities.clusterPointers.getNumEntries(), blockIdx.x, gridDim.x);
+    for (auto clusterIndex = clusterPartition.startIndex; clusterIndex <= clusterPartition.endIndex; ++clusterIndex) {
+        auto const& cluster = data.entities.clusterPointers.at(clusterIndex);
+        if (nullptr == cluster || isIdle(cluster)) {
+            continue;
+        }
+        auto const cellPartition = calcPartition(cluster->numCellPointers, threadIdx.x, blockDim.x);
+        for (auto cellIndex = cellPartition.startIndex; cellIndex <= cellPartition.endIndex; ++cellIndex) {
+            auto const& cell = cluster->cellPointers[cellIndex];
+            auto pos = cell->absPos;
+            data.cellMap.mapPosCorrection(pos);
+            data.sleepingRegions.markActive(
+                pos.x, pos.y, Math::length(cell->vel) + cudaSimulationParameters.cellMaxDistance);
+        }
+    }
+}
+
+__global__ void markActiveRegionsByParticles(SimulationData data)
+{
+    auto const particlePartition = calcPartition(
+        data.entities.particlePointers.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+    for (auto index = particlePartition.startIndex; index <= particlePartition.endIndex; ++index) {
+        auto const& particle = data.entities.particlePointers.at(index);
+        if (nullptr == particle) {
+            continue;
+        }
+        auto const speed = Math::length(particle->vel);
+        if (speed >= SleepingRegions::MaxIdleVelocity) {
+            auto pos = particle->absPos;
+            data.particleMap.mapPosCorrection(pos);
+            data.sleepingRegions.markActive(pos.x, pos.y, speed + cudaSimulationParameters.cellMaxDistance);
+        }
+    }
+}
+
+__global__ void updateSleepingRegions(SimulationData data)
+{
+    auto const regionPartition = calcPartition(
+        data.sleepingRegions.getLayout().getNumRegions(),
+        threadIdx.x + blockIdx.x * blockDim.x,
+        blockDim.x * gridDim.x);
+    for (auto region = regionPartition.startIndex; region <= regionPartition.endIndex; ++region) {
+        data.sleepingRegions.update(region);
+    }
+}
+
+__global__ void wakeUpAllRegions(SimulationData data)
+{
+    auto const regionPartition = calcPartition(
+        data.sleepingRegions.getLayout().getNumRegions(),
+        threadIdx.x + blockIdx.x * blockDim.x,
+        blockDim.x * gridDim.x);
+    for (auto region = regionPartition.startIndex; region <= regionPartition.endIndex; ++region) {
+        data.sleepingRegions.wakeUp(region);
+    }
+}
+
+//user actions on frozen clusters: selection or changed velocities (e.g. applied forces)
+__global__ void wakeUpRegionsOfTouchedClusters(SimulationData data)
+{
+    auto const clusterPartition = calcPartition(
+        data.entities.clusterFreezedPointers.getNumEntries(),
+        threadIdx.x + blockIdx.x * blockDim.x,
+        blockDim.x * gridDim.x);
+    for (auto clusterIndex = clusterPartition.startIndex; clusterIndex <= clusterPartition.endIndex; ++clusterIndex) {
+        auto const& cluster = data.entities.clusterFreezedPointers.at(clusterIndex);
+        if (cluster->isSelected() || !isIdle(cluster)) {
+            auto pos = cluster->pos;
+            data.cellMap.mapPosCorrection(pos);
+            data.sleepingRegions.wakeUp(data.sleepingRegions.getRegion(pos.x, pos.y));
+        }
+    }
+}
+
+//frozen clusters which are kept are copied to entitiesForCleanup.clusterFreezedPointers
+__global__ void resumeClustersOfAwakeRegions(SimulationData data, bool onlyWokenUpRegions)
+{
+    auto const clusterPartition = calcPartition(
+        data.entities.clusterFreezedPointers.getNumEntries(),
+        threadIdx.x + blockIdx.x * blockDim.x,
+        blockDim.x * gridDim.x);
+    for (auto clusterIndex = clusterPartition.startIndex; clusterIndex <= clusterPartition.endIndex; ++clusterIndex) {
+        auto const& cluster = data.entities.clusterFreezedPointers.at(clusterIndex);
+        auto pos = cluster->pos;
+        data.cellMap.mapPosCorrection(pos);
+        auto const radius = cluster->getFrozenRadius();
+        auto const resume = onlyWokenUpRegions ? data.sleepingRegions.isAnyWokenUp(pos.x, pos.y, radius)
+                                               : !data.sleepingRegions.areAllSleeping(pos.x, pos.y, radius);
+        if (resume) {
+            *data.entities.clusterPointers.getNewElement() = cluster;
+            cluster->unfreeze(SleepingRegions::TimestepsUntilSleep);
+        } else {
+            auto const clusterFreezedPointer = data.entitiesForCleanup.clusterFreezedPointers.getNewElement();
+            *clusterFreezedPointer = cluster;
+            cluster->freeze(clusterFreezedPointer);
+        }
+    }
+}
+
+//onlyWokenUpRegions = false: also clusters which have been frozen individually are resumed
+__device__ void resumeClusters(SimulationData& data, bool onlyWokenUpRegions)
+{
+    if (0 == data.entities.clusterFreezedPointers.getNumEntries()) {
+        return;
+    }
+    data.entitiesForCleanup.clusterFreezedPointers.reset();
+    KERNEL_CALL(resumeClustersOfAwakeRegions, data, onlyWokenUpRegions);
+    data.entities.clusterFreezedPointers.swapContent(data.entitiesForCleanup.clusterFreezedPointers);
+}
+
 /************************************************************************/
 /* Main      															*/
 /************************************************************************/
@@ -57,3 +196,25 @@ __global__ void unfreeze(SimulationData data)
     KERNEL_CALL(unfreezeAllClusters, data);
 }
 
+//clusters of regions without activity are frozen, clusters of woken up regions are resumed
+__global__ void sleepOrWakeUpRegions(SimulationData data)
+{
+    KERNEL_CALL(markActiveRegionsByClusters, data);
+    KERNEL_CALL(markActiveRegionsByParticles, data);
+
+    auto const origNumRegionsWokenUp = data.sleepingRegions.getCounter(SleepingRegions::NumRegionsWokenUp);
+    KERNEL_CALL(updateSleepingRegions, data);
+    if (data.sleepingRegions.getCounter(SleepingRegions::NumRegionsWokenUp) != origNumRegionsWokenUp) {
+        resumeClusters(data, true);
+    }
+}
+
+__global__ void wakeUpRegionsByUserAction(SimulationData data)
+{
+    auto const origNumRegionsWokenUp = data.sleepingRegions.getCounter(SleepingRegions::NumRegionsWokenUp);
+    KERNEL_CALL(wakeUpRegionsOfTouchedClusters, data);
+    if (data.sleepingRegions.getCounter(SleepingRegions::NumRegionsWokenUp) != origNumRegionsWokenUp) {
+        resumeClusters(data, true);
+    }
+}
+
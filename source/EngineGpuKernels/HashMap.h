@@ -0,0 +1,129 @@
+#pragma once
+
+#include "HashSet.h"
+
+/**
+ * Lock-free open addressing map: the keys are held by a HashSet and the value of a key is stored at the index of its
+ * slot. Hence an insert claims the key with a single compare-and-swap and no thread has to wait for another one.
+ *
+ * Values written concurrently for the same key overwrite each other in unspecified order, values are valid for
+ * lookups after the inserts are completed (bulk build, then query).
+ */
+template <typename Key, typename Value>
+class HashMap
+{
+public:
+    using Slot = typename HashSet<Key>::Slot;
+
+    //initial content of slots: see HashSet
+    struct Memory
+    {
+        Slot* slots;
+        Value* values;
+    };
+
+    HOST_DEVICE_FUNCTION static int calcCapacity(int maxEntries) { return HashSet<Key>::calcCapacity(maxEntries); }
+
+    HOST_DEVICE_FUNCTION void init(Memory const& memory, int capacity)
+    {
+        _keys.init(memory.slots, capacity);
+        _values = memory.values;
+    }
+
+    HOST_DEVICE_FUNCTION int getCapacity() const { return _keys.getCapacity(); }
+
+    //single thread
+    HOST_DEVICE_FUNCTION void reset() { _keys.reset(); }
+
+    //returns false if the map is full
+    HOST_DEVICE_FUNCTION bool insertOrAssign(Key const& key, Value const& value)
+    {
+        auto const index = _keys.insertSlot(key);
+        if (-1 == index) {
+            return false;
+        }
+        _values[index] = value;
+        return true;
+    }
+
+    HOST_DEVICE_FUNCTION bool contains(Key const& key) const { return _keys.contains(key); }
+
+    //returns false if key is not present, value remains unchanged in this case
+    HOST_DEVICE_FUNCTION bool find(Key const& key, Value& value) const
+    {
+        auto const index = _keys.findSlot(key);
+        if (-1 == index) {
+            return false;
+        }
+        value = _values[index];
+        return true;
+    }
+
+    //Value() if key is not present
+    HOST_DEVICE_FUNCTION Value at(Key const& key) const
+    {
+        Value result = Value();
+        find(key, result);
+        return result;
+    }
+
+#ifdef __CUDACC__
+    //memory: provides getArray<T>(numElements), e.g. DynamicMemory
+    template <typename Allocator>
+    __device__ __inline__ void init_block(int maxEntries, Allocator& memory)
+    {
+        _keys.init_block(maxEntries, memory);
+
+        __shared__ Value* values;
+        if (0 == threadIdx.x) {
+            values = memory.template getArray<Value>(_keys.getCapacity());
+        }
+        __syncthreads();
+
+        _values = values;
+    }
+
+    __device__ __inline__ void reset_block() { _keys.reset_block(); }
+
+    //bulk build: getEntry(index, key, value) returns false if no entry should be inserted for index
+    //returns false if the map is full, lookups are valid afterwards in all threads of the block
+    template <typename Func>
+    __device__ __inline__ bool insertOrAssign_block(int numEntries, Func const& getEntry)
+    {
+        __shared__ bool success;
+        if (0 == threadIdx.x) {
+            success = true;
+        }
+        __syncthreads();
+
+        for (int index = threadIdx.x; index < numEntries; index += blockDim.x) {
+            Key key;
+            Value value;
+            if (getEntry(index, key, value) && !insertOrAssign(key, value)) {
+                success = false;
+            }
+        }
+        __syncthreads();
+
+        auto const result = success;
+        __syncthreads();
+        return result;
+    }
+
+    //bulk query: calls func(index, value) for every index whose key getKey(index) is present
+    template <typename KeyFunc, typename Func>
+    __device__ __inline__ void find_block(int numKeys, KeyFunc const& getKey, Func const& func) const
+    {
+        for (int index = threadIdx.x; index < numKeys; index += blockDim.x) {
+            Value value;
+            if (find(getKey(index), value)) {
+                func(index, value);
+            }
+        }
+    }
+#endif
+
+private:
+    HashSet<Key> _keys;
+    Value* _values;
+};
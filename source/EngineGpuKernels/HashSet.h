@@ -0,0 +1,152 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Base/HostDeviceFunctions.h"
+
+/**
+ * Packing of keys into 64 bit slots. A key type needs a specialization providing encode and a slot value Empty which
+ * no insertable key is encoded to.
+ */
+template <typename T>
+struct HashKey
+{};
+
+template <typename T>
+struct HashKey<T*>
+{
+    static constexpr unsigned long long Empty = 0;  //nullptr cannot be inserted
+
+    HOST_DEVICE_FUNCTION static unsigned long long encode(T* key)
+    {
+        return static_cast<unsigned long long>(reinterpret_cast<std::uintptr_t>(key));
+    }
+};
+
+template <>
+struct HashKey<int>
+{
+    static constexpr unsigned long long Empty = ~0ull;
+
+    HOST_DEVICE_FUNCTION static unsigned long long encode(int key) { return static_cast<unsigned int>(key); }
+};
+
+/**
+ * Lock-free open addressing set: a key is inserted by claiming an empty slot with a single compare-and-swap on its
+ * packed representation, collisions are resolved by linear probing. Probing only stops at the key, at an empty slot
+ * or after all slots have been visited, hence lookups are exact at any load. The capacity is a power of 2 and should
+ * be calculated by calcCapacity to keep the probe sequences short.
+ *
+ * Concurrent inserts are safe, lookups are exact after the inserts are completed (e.g. after __syncthreads). The
+ * memory is provided by the caller so that the set can be used on the GPU as well as tested on the host.
+ */
+template <typename Key>
+class HashSet
+{
+public:
+    using Slot = unsigned long long;
+    static constexpr int MaxLoadPercent = 50;
+
+    //smallest power of 2 which keeps the load of maxElements at most MaxLoadPercent
+    HOST_DEVICE_FUNCTION static int calcCapacity(int maxElements)
+    {
+        auto result = 1;
+        while (result * MaxLoadPercent < maxElements * 100) {
+            result *= 2;
+        }
+        return result;
+    }
+
+    //capacity must be a power of 2, slots must be reset before the first insert
+    HOST_DEVICE_FUNCTION void init(Slot* slots, int capacity)
+    {
+        _slots = slots;
+        _capacity = capacity;
+    }
+
+    HOST_DEVICE_FUNCTION Slot* getSlots() const { return _slots; }
+    HOST_DEVICE_FUNCTION int getCapacity() const { return _capacity; }
+
+    //single thread
+    HOST_DEVICE_FUNCTION void reset()
+    {
+        for (int index = 0; index < _capacity; ++index) {
+            _slots[index] = HashKey<Key>::Empty;
+        }
+    }
+
+    //returns false if the set is full
+    HOST_DEVICE_FUNCTION bool insert(Key const& key) { return -1 != insertSlot(key); }
+
+    HOST_DEVICE_FUNCTION bool contains(Key const& key) const { return -1 != findSlot(key); }
+
+    //slot of the key which is claimed if the key is not present yet, -1 if the set is full
+    HOST_DEVICE_FUNCTION int insertSlot(Key const& key)
+    {
+        auto const code = HashKey<Key>::encode(key);
+        auto index = hash(code) & (_capacity - 1);
+        for (int probe = 0; probe < _capacity; ++probe, index = (index + 1) & (_capacity - 1)) {
+            auto const origCode = HostDeviceAtomics::compareAndSwap(&_slots[index], HashKey<Key>::Empty, code);
+            if (HashKey<Key>::Empty == origCode || code == origCode) {
+                return index;
+            }
+        }
+        return -1;
+    }
+
+    //slot of the key, -1 if not present
+    HOST_DEVICE_FUNCTION int findSlot(Key const& key) const
+    {
+        auto const code = HashKey<Key>::encode(key);
+        auto index = hash(code) & (_capacity - 1);
+        for (int probe = 0; probe < _capacity; ++probe, index = (index + 1) & (_capacity - 1)) {
+            auto const slotCode = _slots[index];
+            if (code == slotCode) {
+                return index;
+            }
+            if (HashKey<Key>::Empty == slotCode) {
+                return -1;
+            }
+        }
+        return -1;
+    }
+
+#ifdef __CUDACC__
+    //memory: provides getArray<T>(numElements), e.g. DynamicMemory
+    template <typename Memory>
+    __device__ __inline__ void init_block(int maxElements, Memory& memory)
+    {
+        __shared__ Slot* slots;
+        auto const capacity = calcCapacity(maxElements);
+        if (0 == threadIdx.x) {
+            slots = memory.template getArray<Slot>(capacity);
+        }
+        __syncthreads();
+
+        init(slots, capacity);
+    }
+
+    __device__ __inline__ void reset_block()
+    {
+        for (int index = threadIdx.x; index < _capacity; index += blockDim.x) {
+            _slots[index] = HashKey<Key>::Empty;
+        }
+        __syncthreads();
+    }
+#endif
+
+private:
+    //finalizer of MurmurHash3, spreads clustered keys (e.g. neighboring positions) over the slots
+    HOST_DEVICE_FUNCTION static int hash(Slot code)
+    {
+        code ^= code >> 33;
+        code *= 0xff51afd7ed558ccdull;
+        code ^= code >> 33;
+        code *= 0xc4ceb9fe1a85ec53ull;
+        code ^= code >> 33;
+        return static_cast<int>(code & 0x7fffffff);
+    }
+
+    Slot* _slots;
+    int _capacity;
+};
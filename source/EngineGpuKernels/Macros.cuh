@@ -16,6 +16,10 @@
         func<<<1, 1>>>(##__VA_ARGS__); \
         cudaDeviceSynchronize();
 
+#define KERNEL_CALL_1_BLOCK(func, ...)  \
+        func<<<1, cudaConstants.NUM_THREADS_PER_BLOCK>>>(##__VA_ARGS__); \
+        cudaDeviceSynchronize();
+
 template< typename T >
 void checkAndThrowError(T result, char const *const func, const char *const file, int const line)
 {
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <numeric>
+
 #include "Cluster.cuh"
 #include "Particle.cuh"
+#include "SpatialBins.h"
+#include "TiledMap.h"
 #include "cuda_runtime_api.h"
 
 class MapInfo
@@ -63,36 +67,83 @@ template <typename T>
 class BasicMap : public MapInfo
 {
 public:
-    __host__ __inline__ void init(int2 const& size, int maxEntries)
+    //maxEntities: maximum number of entities in the map at the same time, bounds the number of tiles
+    __host__ __inline__ void init(int2 const& size, int maxEntries, int maxEntities)
     {
         MapInfo::init(size);
-        CudaMemoryManager::getInstance().acquireMemory<T>(size.x * size.y, _map);
         _mapEntries.init(maxEntries);
 
-        std::vector<T> hostMap(size.x * size.y, 0);
-        checkCudaErrors(cudaMemcpy(_map, hostMap.data(), sizeof(T) * size.x * size.y, cudaMemcpyHostToDevice));
+        auto const layout = TiledMap<T>::calcLayout(size.x, size.y, maxEntities);
+        typename TiledMap<T>::Memory memory;
+        CudaMemoryManager::getInstance().acquireMemory<int>(layout.getNumTiles(), memory.tileIndices);
+        CudaMemoryManager::getInstance().acquireMemory<T>(
+            static_cast<uint64_t>(layout.maxTiles) * TiledMap<T>::TileArea, memory.tiles);
+        CudaMemoryManager::getInstance().acquireMemory<int>(layout.maxTiles, memory.freeTiles);
+        CudaMemoryManager::getInstance().acquireMemory<int>(1, memory.numFreeTiles);
+
+        std::vector<int> hostTileIndices(layout.getNumTiles(), TiledMap<T>::NoTile);
+        std::vector<int> hostFreeTiles(layout.maxTiles);
+        std::iota(hostFreeTiles.begin(), hostFreeTiles.end(), 0);
+        checkCudaErrors(cudaMemcpy(
+            memory.tileIndices, hostTileIndices.data(), sizeof(int) * layout.getNumTiles(), cudaMemcpyHostToDevice));
+        checkCudaErrors(
+            cudaMemset(memory.tiles, 0, sizeof(T) * static_cast<uint64_t>(layout.maxTiles) * TiledMap<T>::TileArea));
+        checkCudaErrors(cudaMemcpy(
+            memory.freeTiles, hostFreeTiles.data(), sizeof(int) * layout.maxTiles, cudaMemcpyHostToDevice));
+        checkCudaErrors(
+            cudaMemcpy(memory.numFreeTiles, &layout.maxTiles, sizeof(int), cudaMemcpyHostToDevice));
+
+        _tiledMap.init(layout, memory);
     }
 
     __device__ __inline__ void reset() { _mapEntries.reset(); }
 
+    //first pass of cleanup: clears all entries set since last reset
+    __device__ __inline__ void cleanup_system()
+    {
+        auto partition =
+            calcPartition(_mapEntries.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+            auto const& mapEntry = _mapEntries.at(index);
+            if (auto const entry = _tiledMap.getEntry(mapEntry % _size.x, mapEntry / _size.x)) {
+                *entry = T();
+            }
+        }
+    }
+
+    //second pass of cleanup (separate kernel): returns the now empty tiles to the pool
+    __device__ __inline__ void releaseTiles_system()
+    {
+        auto partition =
+            calcPartition(_mapEntries.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+            auto const& mapEntry = _mapEntries.at(index);
+            _tiledMap.releaseTile(mapEntry % _size.x, mapEntry / _size.x);
+        }
+    }
+
     __host__ __inline__ void free()
     {
-        CudaMemoryManager::getInstance().freeMemory(_map);
+        auto memory = _tiledMap.getMemory();
+        CudaMemoryManager::getInstance().freeMemory(memory.tileIndices);
+        CudaMemoryManager::getInstance().freeMemory(memory.tiles);
+        CudaMemoryManager::getInstance().freeMemory(memory.freeTiles);
+        CudaMemoryManager::getInstance().freeMemory(memory.numFreeTiles);
         _mapEntries.free();
     }
 
 protected:
-    T* _map;
+    TiledMap<T> _tiledMap;
     Array<int> _mapEntries;
 };
 
 class CellMap : public BasicMap<unsigned long long int>
 {
 public:
-    __host__ __inline__ void init(int2 const& size, int maxEntries, Cell** cellPointerArray)
+    __host__ __inline__ void init(int2 const& size, int maxEntries, int maxCells, Cell** cellPointerArray)
     {
         _cellPointersArray = cellPointerArray;
-        BasicMap<unsigned long long int>::init(size, maxEntries);
+        BasicMap<unsigned long long int>::init(size, maxEntries, maxCells);
     }
 
     __device__ __inline__ void set_block(int numEntities, Cell** cellsToSet)
@@ -114,12 +165,20 @@ public:
             auto const& entity = cellsToSet[index];
             int2 posInt = {floorInt(entity->absPos.x), floorInt(entity->absPos.y)};
             mapPosCorrection(posInt);
-            auto mapEntry = posInt.x + posInt.y * _size.x;
-        
+            entrySubarray[index] = posInt.x + posInt.y * _size.x;
+
+            auto const entry = _tiledMap.getOrCreateEntry(posInt.x, posInt.y);
+            if (!entry) {
+                continue;
+            }
             unsigned long long int value =  &entity - _cellPointersArray;
             value |= numEntriesBits;
-            atomicMax(_map + mapEntry, value);
-            entrySubarray[index] = mapEntry;
+            if (cudaExecutionParameters.deterministic) {
+                setPreferringLowerId(entry, value);
+            }
+            else {
+                atomicMax(entry, value);
+            }
         }
         __syncthreads();
     }
@@ -128,25 +187,29 @@ public:
     {
         int2 posInt = { floorInt(pos.x), floorInt(pos.y) };
         mapPosCorrection(posInt);
-        auto mapEntry = posInt.x + posInt.y * _size.x;
-        auto cellIndex = _map[mapEntry];
-        if (0 == cellIndex) {
+        auto const entry = _tiledMap.getEntry(posInt.x, posInt.y);
+        if (!entry || 0 == *entry) {
             return nullptr;
         }
-        return _cellPointersArray[cellIndex & 0xffffffff];
+        return _cellPointersArray[*entry & 0xffffffff];
     }
 
-    __device__ __inline__ void cleanup_system()
+private:
+    //larger clusters win as with atomicMax, ties are broken by cell id instead of the position in the pointer array
+    __device__ __inline__ void setPreferringLowerId(unsigned long long int* entry, unsigned long long int value)
     {
-        auto partition =
-            calcPartition(_mapEntries.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
-        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
-            auto const& mapEntry = _mapEntries.at(index);
-            _map[mapEntry] = 0;
+        auto const id = _cellPointersArray[value & 0xffffffff]->id;
+        auto origValue = *entry;
+        while (0 == origValue || (value >> 32) > (origValue >> 32)
+               || ((value >> 32) == (origValue >> 32) && id < _cellPointersArray[origValue & 0xffffffff]->id)) {
+            auto const prevValue = atomicCAS(entry, origValue, value);
+            if (prevValue == origValue) {
+                break;
+            }
+            origValue = prevValue;
         }
     }
 
-private:
     Cell** _cellPointersArray;
 
 };
@@ -171,9 +234,18 @@ public:
             auto const& entity = entities[index];
             int2 posInt = {floorInt(entity->absPos.x), floorInt(entity->absPos.y)};
             mapPosCorrection(posInt);
-            auto mapEntry = posInt.x + posInt.y * _size.x;
-            _map[mapEntry] = entity;
-            entrySubarray[index] = mapEntry;
+            entrySubarray[index] = posInt.x + posInt.y * _size.x;
+
+            auto const entry = _tiledMap.getOrCreateEntry(posInt.x, posInt.y);
+            if (!entry) {
+                continue;
+            }
+            if (cudaExecutionParameters.deterministic) {
+                setPreferringLowerId(entry, entity);
+            }
+            else {
+                *entry = entity;
+            }
         }
         __syncthreads();
     }
@@ -182,17 +254,99 @@ public:
     {
         int2 posInt = { floorInt(pos.x), floorInt(pos.y) };
         mapPosCorrection(posInt);
-        auto mapEntry = posInt.x + posInt.y * _size.x;
-        return _map[mapEntry];
+        auto const entry = _tiledMap.getEntry(posInt.x, posInt.y);
+        return entry ? *entry : nullptr;
     }
 
-    __device__ __inline__ void cleanup_system()
+private:
+    __device__ __inline__ void setPreferringLowerId(Particle** entry, Particle* entity)
     {
-        auto partition =
-            calcPartition(_mapEntries.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+        auto const mapElement = reinterpret_cast<unsigned long long int*>(entry);
+        auto origEntity = *entry;
+        while (!origEntity || entity->id < origEntity->id) {
+            auto const prevEntity = reinterpret_cast<Particle*>(atomicCAS(
+                mapElement,
+                reinterpret_cast<unsigned long long int>(origEntity),
+                reinterpret_cast<unsigned long long int>(entity)));
+            if (prevEntity == origEntity) {
+                break;
+            }
+            origEntity = prevEntity;
+        }
+    }
+};
+
+//cells sorted by buckets of the world for neighbour queries (see SpatialBins), rebuilt by count_block,
+//calcOffsets_block and insert_block in separate kernels
+class CellBins : public MapInfo
+{
+public:
+    __host__ __inline__ void init(int2 const& size, int maxCells)
+    {
+        MapInfo::init(size);
+
+        auto const layout = SpatialBins<Cell*>::calcLayout(size.x, size.y, maxCells);
+        SpatialBins<Cell*>::Memory memory;
+        CudaMemoryManager::getInstance().acquireMemory<int>(layout.numBuckets, memory.counts);
+        CudaMemoryManager::getInstance().acquireMemory<int>(layout.numBuckets + 1, memory.offsets);
+        CudaMemoryManager::getInstance().acquireMemory<Cell*>(layout.maxEntries, memory.entries);
+        checkCudaErrors(cudaMemset(memory.counts, 0, sizeof(int) * layout.numBuckets));
+        checkCudaErrors(cudaMemset(memory.offsets, 0, sizeof(int) * (layout.numBuckets + 1)));
+
+        _bins.init(layout, memory);
+    }
+
+    __host__ __inline__ void free()
+    {
+        auto memory = _bins.getMemory();
+        CudaMemoryManager::getInstance().freeMemory(memory.counts);
+        CudaMemoryManager::getInstance().freeMemory(memory.offsets);
+        CudaMemoryManager::getInstance().freeMemory(memory.entries);
+    }
+
+    __device__ __inline__ void count_block(int numCells, Cell** cells)
+    {
+        auto const partition = calcPartition(numCells, threadIdx.x, blockDim.x);
         for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
-            auto const& mapEntry = _mapEntries.at(index);
-            _map[mapEntry] = nullptr;
+            _bins.countEntry(getBucket(cells[index]->absPos));
         }
     }
+
+    __device__ __inline__ void calcOffsets_block()
+    {
+        auto const& memory = _bins.getMemory();
+        scanExclusive_block(
+            _bins.getLayout().numBuckets, memory.offsets, [&](int bucket) { return memory.counts[bucket]; });
+    }
+
+    //cell positions must not change since count_block
+    __device__ __inline__ void insert_block(int numCells, Cell** cells)
+    {
+        auto const partition = calcPartition(numCells, threadIdx.x, blockDim.x);
+        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+            auto const& cell = cells[index];
+            _bins.insertEntry(getBucket(cell->absPos), cell);
+        }
+    }
+
+    //visits exactly the cells closer than radius
+    template <typename Func>
+    __device__ __inline__ void forEachCloseCell(float2 pos, float radius, Func const& func) const
+    {
+        mapPosCorrection(pos);
+        _bins.forEachEntry(pos.x, pos.y, radius, [&](Cell* cell) {
+            if (mapDistance(pos, cell->absPos) < radius) {
+                func(cell);
+            }
+        });
+    }
+
+private:
+    __device__ __inline__ int getBucket(float2 pos) const
+    {
+        mapPosCorrection(pos);
+        return _bins.getBucket(pos.x, pos.y);
+    }
+
+    SpatialBins<Cell*> _bins;
 };
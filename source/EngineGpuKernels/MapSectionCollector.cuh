@@ -4,106 +4,95 @@
 
 #include "Base.cuh"
 #include "Array.cuh"
-#include "List.cuh"
+#include "Map.cuh"
+#include "SpatialBins.h"
 
 #include "Cluster.cuh"
 
-class MapSectionCollector
+/**
+ * Clusters sorted by map sections, rebuilt every timestep: clusters are registered by insert, the sections are
+ * laid out by a scan (calcOffsets_block) and the clusters are scattered (sort_system). Afterwards the clusters of a
+ * section form a contiguous slice, so that queries need neither list walks nor allocations.
+ */
+class MapSectionCollector : public MapInfo
 {
 public:
-    __host__ __inline__ void
-    init(int2 const& universeSize, int sectionSize)
+    __host__ __inline__ void init(int2 const& universeSize, int sectionSize, int maxClusters)
     {
-        _numSections = { universeSize.x / sectionSize, universeSize.y / sectionSize };
-        _sectionSize = sectionSize;
-        _clusterListBySectionIndex.init(_numSections.x *_numSections.y);
+        MapInfo::init(universeSize);
+        _clusters.init(maxClusters);
+
+        auto const layout = SpatialBins<Cluster*>::calcLayout(universeSize.x, universeSize.y, maxClusters, sectionSize);
+        SpatialBins<Cluster*>::Memory memory;
+        CudaMemoryManager::getInstance().acquireMemory<int>(layout.numBuckets, memory.counts);
+        CudaMemoryManager::getInstance().acquireMemory<int>(layout.numBuckets + 1, memory.offsets);
+        CudaMemoryManager::getInstance().acquireMemory<Cluster*>(layout.maxEntries, memory.entries);
+        checkCudaErrors(cudaMemset(memory.counts, 0, sizeof(int) * layout.numBuckets));
+        checkCudaErrors(cudaMemset(memory.offsets, 0, sizeof(int) * (layout.numBuckets + 1)));
+
+        _sections.init(layout, memory);
     }
 
     __host__ __inline__ void free()
     {
-        _clusterListBySectionIndex.free();
+        _clusters.free();
+
+        auto memory = _sections.getMemory();
+        CudaMemoryManager::getInstance().freeMemory(memory.counts);
+        CudaMemoryManager::getInstance().freeMemory(memory.offsets);
+        CudaMemoryManager::getInstance().freeMemory(memory.entries);
     }
 
-    __device__ __inline__ void reset_system()
+    //single thread, counts are zero again after sort_system
+    __device__ __inline__ void reset() { _clusters.reset(); }
+
+    __device__ __inline__ void insert(Cluster* cluster)
     {
-        auto const partition = calcPartition(
-            _numSections.x * _numSections.y, threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
-        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
-            _clusterListBySectionIndex.at(index).init();
-        }
+        *_clusters.getNewElement() = cluster;
+        _sections.countEntry(getSection(cluster->pos));
     }
 
-    __device__ __inline__ void insert(Cluster* cluster, DynamicMemory* dynamicMemory)
+    __device__ __inline__ void calcOffsets_block()
     {
-        auto const section = getSection(cluster->pos);
-
-        auto& clusterList = _clusterListBySectionIndex.at(section.x + section.y * _numSections.x);
-        clusterList.pushBack(cluster, dynamicMemory);
+        auto const& memory = _sections.getMemory();
+        scanExclusive_block(
+            _sections.getLayout().numBuckets, memory.offsets, [&](int section) { return memory.counts[section]; });
     }
 
-    __device__ __inline__ void getClusters_block(float2 const& pos, float radius, MapInfo const& map, 
-        DynamicMemory* dynamicMemory, List<Cluster*>& result)
+    //cluster positions must not change since insert
+    __device__ __inline__ void sort_system()
     {
-        __shared__ int2 sectionCenter;
-        __shared__ int sectionLength;
-        if (0 == threadIdx.x) {
-            sectionCenter = getSection(pos);
-            sectionLength = floorInt(radius) / _sectionSize + 1;
-            result.init();
+        auto const partition = calcPartition(
+            _clusters.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+            auto const& cluster = _clusters.at(index);
+            _sections.insertEntry(getSection(cluster->pos), cluster);
         }
-        __syncthreads();
-
-        int2 section;
-        for (section.x = sectionCenter.x - sectionLength; section.x <= sectionCenter.x + sectionLength; ++section.x) {
-            for (section.y = sectionCenter.y - sectionLength; section.y <= sectionCenter.y + sectionLength; ++section.y) {
-                __shared__ int numClusters;
-                __shared__ Cluster** clusterArray;
-                if (0 == threadIdx.x) {
-                    auto const& clusterList = getClusters(section);
-                    numClusters = clusterList.getSize();
-                    clusterArray = clusterList.asArray(dynamicMemory);
-                }
-                __syncthreads();
+    }
 
-                if (numClusters > 0) {
-                    auto const partition = calcPartition(numClusters, threadIdx.x, blockDim.x);
-                    for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
-                        auto const& cluster = clusterArray[index];
-                        auto const distance = map.mapDistance(cluster->pos, pos);
-                        if (distance < radius) {
-                            result.pushBack(cluster, dynamicMemory);
-                        }
-                    }
+    //visits every cluster closer than radius once, the clusters are distributed among the threads of the block
+    template <typename Func>
+    __device__ __inline__ void forEachCluster_block(float2 pos, float radius, Func const& func) const
+    {
+        mapPosCorrection(pos);
+        auto const& entries = _sections.getMemory().entries;
+        _sections.forEachRange(pos.x, pos.y, radius, [&](int startIndex, int endIndex) {
+            for (int index = startIndex + threadIdx.x; index < endIndex; index += blockDim.x) {
+                auto const& cluster = entries[index];
+                if (mapDistance(cluster->pos, pos) < radius) {
+                    func(cluster);
                 }
-                __syncthreads();
             }
-        }
+        });
     }
 
 private:
-    __device__ __inline__ int2 getSection(float2 const& pos)
-    {
-        auto const intPos = toInt2(pos);
-        auto section = int2{ intPos.x / _sectionSize, intPos.y / _sectionSize };
-        correctSection(section);
-        return section;
-
-    }
-
-    __device__ __inline__ List<Cluster*> const& getClusters(int2 section)
+    __device__ __inline__ int getSection(float2 pos) const
     {
-        correctSection(section);
-        return _clusterListBySectionIndex.at(section.x + section.y * _numSections.x);
+        mapPosCorrection(pos);
+        return _sections.getBucket(pos.x, pos.y);
     }
 
-    __device__ __inline__ void correctSection(int2& section)
-    {
-        section.x = ((section.x % _numSections.x) + _numSections.x) % _numSections.x;
-        section.y = ((section.y % _numSections.y) + _numSections.y) % _numSections.y;
-    }
-
-private:
-    int2 _numSections;
-    int _sectionSize;
-    Array<List<Cluster*>> _clusterListBySectionIndex;
+    Array<Cluster*> _clusters;  //inserted clusters in arbitrary order
+    SpatialBins<Cluster*> _sections;
 };
@@ -50,6 +50,7 @@ getMonitorDataForClusters(Array<Cluster*> clusterPointers, CudaMonitorData monit
         for (auto tokenIndex = tokenPartition.startIndex; tokenIndex <= tokenPartition.endIndex; ++tokenIndex) {
             auto const token = cluster->tokenPointers[tokenIndex];
             atomicAdd_block(&clusterInternalEnergy, token->getEnergy());
+            monitorData.incNumTokensByCellFunction(token->cell->getCellFunctionType(), 1);
         }
         __syncthreads();
 
@@ -83,6 +84,8 @@ __global__ void getMonitorDataForParticles(SimulationData data, CudaMonitorData
 __global__ void cudaGetCudaMonitorData(SimulationData data, CudaMonitorData monitorData)
 {
     monitorData.reset();
+    monitorData.setNumProcessedTokens(data.cellFunctionData);
+    monitorData.setSleepingRegionCounters(data.sleepingRegions);
 
     KERNEL_CALL(getMonitorDataForClusters, data.entities.clusterPointers, monitorData);
     KERNEL_CALL(getMonitorDataForClusters, data.entities.clusterFreezedPointers, monitorData);
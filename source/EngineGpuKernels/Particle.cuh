@@ -17,6 +17,8 @@ struct Particle
     //auxiliary data
     int locked;	//0 = unlocked, 1 = locked
     int alive;  //0 = dead, 1 == alive
+    int drawnPixel;     //pixel and color of the last drawing into the pixel image (see TileChanges)
+    unsigned int drawnColor;
 
     __device__ __inline__ float getEnergy_safe()
     {
@@ -30,16 +32,25 @@ struct Particle
 
     __device__ __inline__ void setEnergy_safe(float value)
     {
+        if (cudaExecutionParameters.deterministic) {
+            value = DeterministicMath::snapToGrid(value, DeterministicMath::EnergyFractionBits);
+        }
         atomicExch(&_energy, value);
     }
 
     __device__ __inline__ void setEnergy(float value)
     {
+        if (cudaExecutionParameters.deterministic) {
+            value = DeterministicMath::snapToGrid(value, DeterministicMath::EnergyFractionBits);
+        }
         _energy = value;
     }
 
     __device__ __inline__ void changeEnergy(float changeValue)
     {
+        if (cudaExecutionParameters.deterministic) {
+            changeValue = DeterministicMath::snapToGrid(changeValue, DeterministicMath::EnergyFractionBits);
+        }
         atomicAdd(&_energy, changeValue);
     }
 
@@ -22,6 +22,7 @@ public:
     __inline__ __device__ void repair_system();
 
 private:
+    __inline__ __device__ void fuse(Particle* particle, Particle* otherParticle);
 
 	SimulationData* _data;
 
@@ -67,36 +68,53 @@ __inline__ __device__ void ParticleProcessor::processingCollision_system()
 
                 SystemDoubleLock lock;
                 lock.init(&particle->locked, &otherParticle->locked);
+
+                //deterministic mode: no collision is skipped and the particle with the lowest id at a position
+                //(the one in the map) absorbs the others
+                if (cudaExecutionParameters.deterministic) {
+                    lock.getLock();
+                    if (1 == particle->alive && 1 == otherParticle->alive) {
+                        fuse(otherParticle, particle);
+                    }
+                    lock.releaseLock();
+                    continue;
+                }
+
                 lock.tryLock();
                 if (!lock.isLocked()) {
                     continue;
                 }
-
-                auto const particleEnergy = particle->getEnergy_safe();
-                float factor1 = particleEnergy / (particleEnergy + otherParticle->getEnergy_safe());
-                float factor2 = 1.0f - factor1;
-                particle->vel = particle->vel * factor1 + otherParticle->vel * factor2;
-                particle->changeEnergy(otherParticle->getEnergy_safe());
-                otherParticle->setEnergy_safe(0);
-                atomicExch(&otherParticle->alive, 0);
-
+                fuse(particle, otherParticle);
                 lock.releaseLock();
             }
         }
     }
 }
 
+__inline__ __device__ void ParticleProcessor::fuse(Particle* particle, Particle* otherParticle)
+{
+    auto const particleEnergy = particle->getEnergy_safe();
+    float factor1 = particleEnergy / (particleEnergy + otherParticle->getEnergy_safe());
+    float factor2 = 1.0f - factor1;
+    particle->vel = particle->vel * factor1 + otherParticle->vel * factor2;
+    particle->changeEnergy(otherParticle->getEnergy_safe());
+    otherParticle->setEnergy_safe(0);
+    atomicExch(&otherParticle->alive, 0);
+}
+
 __inline__ __device__ void ParticleProcessor::processingTransformation_system()
 {
     for (int particleIndex = _particleBlock.startIndex; particleIndex <= _particleBlock.endIndex; ++particleIndex) {
+        auto& particle = _data->entities.particlePointers.getArrayForDevice()[particleIndex];
+        _data->numberGen.beginEntity(particle->id, _data->timestep, RandomPurpose::Transformation);
         if (_data->numberGen.random() < cudaSimulationParameters.cellTransformationProb) {
-            auto& particle = _data->entities.particlePointers.getArrayForDevice()[particleIndex];
             auto innerEnergy = particle->getEnergy_safe()- Physics::linearKineticEnergy(1.0f, particle->vel);
             if (innerEnergy >= cudaSimulationParameters.cellMinEnergy) {
                 EntityFactory factory;
                 factory.init(_data);
-                auto const cluster = factory.createClusterWithRandomCell(innerEnergy, particle->absPos, particle->vel);
-                cluster->cellPointers[0]->metadata.color = particle->metadata.color;
+                auto const cluster = factory.createClusterWithRandomCell(
+                    particle->id, innerEnergy, particle->absPos, particle->vel);
+                cluster->cellPointers[0]->coldData->metadata.color = particle->metadata.color;
                 atomicExch(&particle->alive, 0);
             }
         }
@@ -108,13 +126,15 @@ __inline__ __device__ void ParticleProcessor::processingDataCopy_system()
 	for (int particleIndex = _particleBlock.startIndex; particleIndex <= _particleBlock.endIndex; ++particleIndex) {
 		auto& particle = _data->entities.particlePointers.at(particleIndex);
 		if (0 == particle->alive) {
-            particle = nullptr;
+            _data->tileChanges.registerPixel(particle->drawnPixel);
+            _data->entities.clearParticlePointer(particle);
             continue;
 		}
         if (auto cell = _data->cellMap.get(particle->absPos)) {
 			if (1 == cell->alive) {
                 cell->changeEnergy_safe(particle->getEnergy_safe());
-                particle = nullptr;
+                _data->tileChanges.registerPixel(particle->drawnPixel);
+                _data->entities.clearParticlePointer(particle);
 			}
 		}
 	}
@@ -137,6 +137,7 @@ __global__ void cudaApplyForce(CudaApplyForceData applyData, SimulationData data
     KERNEL_CALL(applyForceToClusters, applyData, data.size, data.entities.clusterPointers);
     KERNEL_CALL(applyForceToClusters, applyData, data.size, data.entities.clusterFreezedPointers);
     KERNEL_CALL(applyForceToParticles, applyData, data.size, data.entities.particlePointers);
+    KERNEL_CALL_1_1(wakeUpRegionsByUserAction, data);
 }
 
 __global__ void cudaMoveSelection(float2 displacement, SimulationData data)
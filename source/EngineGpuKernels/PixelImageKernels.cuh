@@ -0,0 +1,496 @@
+#pragma once
+
+#include "EngineInterface/Colors.h"
+#include "EngineInterface/PixelImageConstants.h"
+
+#include "Base.cuh"
+#include "Map.cuh"
+#include "SimulationData.cuh"
+#include "TiledImageData.cuh"
+#include "cuda_runtime_api.h"
+#include "sm_60_atomic_functions.h"
+
+/************************************************************************/
+/* Helpers    															*/
+/************************************************************************/
+
+//same rules as in PixelImageRasterizer, integer arithmetic yields identical results on host and device
+__device__ __inline__ int isqrt(int value)
+{
+    auto result = static_cast<int>(sqrtf(static_cast<float>(value)));
+    while (result * result > value) {
+        --result;
+    }
+    while ((result + 1) * (result + 1) <= value) {
+        ++result;
+    }
+    return result;
+}
+
+__device__ __inline__ unsigned int calcPixelColor(Cell* cell, bool selected)
+{
+    unsigned int const cellColors[] = {
+        Const::IndividualCellColor1,
+        Const::IndividualCellColor2,
+        Const::IndividualCellColor3,
+        Const::IndividualCellColor4,
+        Const::IndividualCellColor5,
+        Const::IndividualCellColor6,
+        Const::IndividualCellColor7};
+    auto const cellColor = cellColors[cell->coldData->metadata.color % 7];
+
+    auto const factor = min(100, isqrt(max(0, toInt(cell->getEnergy()))) * 5 + 20) * (selected ? 4 : 3);
+    auto const red = ((cellColor >> 16) & 0xff) * factor * 255 / (256 * 100 * 4);
+    auto const green = ((cellColor >> 8) & 0xff) * factor * 255 / (256 * 100 * 4);
+    auto const blue = (cellColor & 0xff) * factor * 255 / (256 * 100 * 4);
+    return 0xff000000 | (red << 16) | (green << 8) | blue;
+}
+
+__device__ __inline__ unsigned int calcPixelColor(Particle* particle, bool selected)
+{
+    auto const intensity =
+        max(min((max(0, toInt(particle->getEnergy())) + 10) * 5, 150), 20) * (selected ? 4 : 3) * 255 / (256 * 4);
+    return 0xff000000 | (intensity << 16) | 20;
+}
+
+//saturating per channel, hence independent of the order of concurrent additions
+__device__ __inline__ void addPixelColor(unsigned int& pixel, unsigned int color)
+{
+    auto const address = &pixel;
+    auto oldPixel = *address;
+    unsigned int assumed;
+    do {
+        assumed = oldPixel;
+        auto const red = min(((assumed >> 16) & 0xff) + ((color >> 16) & 0xff), 0xffu);
+        auto const green = min(((assumed >> 8) & 0xff) + ((color >> 8) & 0xff), 0xffu);
+        auto const blue = min((assumed & 0xff) + (color & 0xff), 0xffu);
+        oldPixel = atomicCAS(address, assumed, 0xff000000 | (red << 16) | (green << 8) | blue);
+    } while (assumed != oldPixel);
+}
+
+//pixel of the coarser level from the pixels of the finer level it covers
+//since every pixel is the saturated sum of its entity colors over space, the result equals drawing the entities
+__device__ __inline__ unsigned int reducePixel(TiledImageLevel& finerLevel, int2 const& pixel)
+{
+    unsigned int const space = Const::PixelImageSpaceColor;
+    auto red = (space >> 16) & 0xff;
+    auto green = (space >> 8) & 0xff;
+    auto blue = space & 0xff;
+    for (int dy = 0; dy < 2; ++dy) {
+        for (int dx = 0; dx < 2; ++dx) {
+            int2 const finerPixel{pixel.x * 2 + dx, pixel.y * 2 + dy};
+            if (finerPixel.x < finerLevel.size.x && finerPixel.y < finerLevel.size.y) {
+                auto const color = finerLevel.getPixel(finerPixel);
+                red += ((color >> 16) & 0xff) - ((space >> 16) & 0xff);
+                green += ((color >> 8) & 0xff) - ((space >> 8) & 0xff);
+                blue += (color & 0xff) - (space & 0xff);
+            }
+        }
+    }
+    return 0xff000000 | (min(red, 0xffu) << 16) | (min(green, 0xffu) << 8) | min(blue, 0xffu);
+}
+
+__device__ __inline__ bool isInTileRect(int2 const& tile, int2 const& tileRectUpperLeft, int2 const& tileRectLowerRight)
+{
+    return tile.x >= tileRectUpperLeft.x && tile.x < tileRectLowerRight.x && tile.y >= tileRectUpperLeft.y
+        && tile.y < tileRectLowerRight.y;
+}
+
+__device__ __inline__ void drawEntityIntoTiles(
+    TiledImageLevel& level,
+    int2 const& tileRectUpperLeft,
+    int2 const& tileRectLowerRight,
+    float2 const& pos,
+    unsigned int color)
+{
+    auto const pixel = level.calcPixel(pos);
+    int2 const tile{pixel.x / Const::PixelImageTileSize, pixel.y / Const::PixelImageTileSize};
+    if (!isInTileRect(tile, tileRectUpperLeft, tileRectLowerRight)) {
+        return;
+    }
+    if (TiledImageLevel::Drawing == level.tileStates[level.calcTileIndex(pixel)]) {
+        addPixelColor(level.getPixel(pixel), color);
+    }
+}
+
+/************************************************************************/
+/* Kernels    															*/
+/************************************************************************/
+
+//registers the tiles of cells whose pixel or color has changed since the last drawing
+__global__ void registerChangedClusters(int2 universeSize, Array<Cluster*> clusters, TileChanges tileChanges)
+{
+    auto const clusterBlock = calcPartition(clusters.getNumEntries(), blockIdx.x, gridDim.x);
+
+    for (int clusterIndex = clusterBlock.startIndex; clusterIndex <= clusterBlock.endIndex; ++clusterIndex) {
+
+        auto const& cluster = clusters.at(clusterIndex);
+        if (nullptr == cluster) {
+            continue;
+        }
+
+        __shared__ MapInfo map;
+        __shared__ bool isSelected;
+        if (0 == threadIdx.x) {
+            map.init(universeSize);
+            isSelected = cluster->isSelected();
+        }
+        __syncthreads();
+
+        auto const cellBlock = calcPartition(cluster->numCellPointers, threadIdx.x, blockDim.x);
+        for (auto cellIndex = cellBlock.startIndex; cellIndex <= cellBlock.endIndex; ++cellIndex) {
+            auto const& cell = cluster->cellPointers[cellIndex];
+
+            auto cellPos = cell->absPos;
+            map.mapPosCorrection(cellPos);
+            tileChanges.registerEntity(
+                tileChanges.calcPixel(cellPos),
+                calcPixelColor(cell, isSelected),
+                cell->coldData->drawnPixel,
+                cell->coldData->drawnColor);
+        }
+        __syncthreads();
+    }
+}
+
+__global__ void registerChangedParticles(int2 universeSize, Array<Particle*> particles, TileChanges tileChanges)
+{
+    MapInfo map;
+    map.init(universeSize);
+
+    auto const particleBlock =
+        calcPartition(particles.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+    for (int index = particleBlock.startIndex; index <= particleBlock.endIndex; ++index) {
+        auto const& particle = particles.at(index);
+
+        auto particlePos = particle->absPos;
+        map.mapPosCorrection(particlePos);
+        tileChanges.registerEntity(
+            tileChanges.calcPixel(particlePos),
+            calcPixelColor(particle, particle->isSelected()),
+            particle->drawnPixel,
+            particle->drawnColor);
+    }
+}
+
+//up-to-date tiles of all acquired levels which cover a changed tile become outdated
+__global__ void outdateChangedTiles(TiledImageData tiledImageData, TileChanges tileChanges)
+{
+    auto const tileBlock = calcPartition(
+        tileChanges.getNumChangedTiles(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+    for (int index = tileBlock.startIndex; index <= tileBlock.endIndex; ++index) {
+        auto const tile = tileChanges.getChangedTile(index);
+        for (int level = 0; level <= Const::PixelImageMaxLevel; ++level) {
+            auto const& levelData = tiledImageData.getLevelData(level);
+            if (!levelData.tileSlots) {
+                continue;
+            }
+            auto const tileIndex = (tile.y >> level) * levelData.numTiles.x + (tile.x >> level);
+            if (levelData.isUpToDate(tileIndex)) {
+                levelData.tileStates[tileIndex] = TiledImageLevel::Outdated;
+            }
+        }
+        tileChanges.unregisterChangedTile(index);
+    }
+}
+
+//tiles which are not on the host are registered as dirty, outdated ones are cleared for drawing
+__global__ void markDirtyTiles(
+    TiledImageLevel level,
+    int2 tileRectUpperLeft,
+    int2 tileRectLowerRight,
+    TiledImageData tiledImageData)
+{
+    auto const tileRectWidth = tileRectLowerRight.x - tileRectUpperLeft.x;
+    auto const numTiles = tileRectWidth * (tileRectLowerRight.y - tileRectUpperLeft.y);
+    auto const tileBlock = calcPartition(numTiles, threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+    for (int index = tileBlock.startIndex; index <= tileBlock.endIndex; ++index) {
+        auto const tileX = tileRectUpperLeft.x + index % tileRectWidth;
+        auto const tileY = tileRectUpperLeft.y + index / tileRectWidth;
+        auto const tileIndex = tileY * level.numTiles.x + tileX;
+
+        auto& tileState = level.tileStates[tileIndex];
+        if (TiledImageLevel::Transferred == tileState) {
+            continue;
+        }
+        tiledImageData.dirtyTileIndices[atomicAdd(tiledImageData.numDirtyTiles, 1)] = tileIndex;
+        if (TiledImageLevel::Reduced == tileState) {
+            tileState = TiledImageLevel::Transferred;
+            continue;
+        }
+        tileState = TiledImageLevel::Drawing;
+        atomicAdd(tiledImageData.numTilesToDraw, 1);
+
+        //tiles drawn for the first time get their pixels from the tile pool
+        auto& tileSlot = level.tileSlots[tileIndex];
+        if (TiledImageLevel::NoSlot == tileSlot) {
+            tileSlot = atomicAdd(tiledImageData.numUsedTiles, 1);
+        }
+        int const tileSize = Const::PixelImageTileSize;
+        auto const tilePixels = level.getTilePixels(tileIndex);
+        for (int y = 0; y < tileSize; ++y) {
+            for (int x = 0; x < tileSize; ++x) {
+                auto const isInside = tileX * tileSize + x < level.size.x && tileY * tileSize + y < level.size.y;
+                tilePixels[y * tileSize + x] =
+                    isInside ? Const::PixelImageSpaceColor : Const::PixelImageNothingnessColor;
+            }
+        }
+    }
+}
+
+__global__ void drawClustersIntoTiles(
+    int2 universeSize,
+    Array<Cluster*> clusters,
+    TiledImageLevel level,
+    int2 tileRectUpperLeft,
+    int2 tileRectLowerRight)
+{
+    auto const clusterBlock = calcPartition(clusters.getNumEntries(), blockIdx.x, gridDim.x);
+
+    for (int clusterIndex = clusterBlock.startIndex; clusterIndex <= clusterBlock.endIndex; ++clusterIndex) {
+
+        auto const& cluster = clusters.at(clusterIndex);
+        if (nullptr == cluster) {
+            continue;
+        }
+
+        __shared__ MapInfo map;
+        __shared__ bool isSelected;
+        if (0 == threadIdx.x) {
+            map.init(universeSize);
+            isSelected = cluster->isSelected();
+        }
+        __syncthreads();
+
+        auto const cellBlock = calcPartition(cluster->numCellPointers, threadIdx.x, blockDim.x);
+        for (auto cellIndex = cellBlock.startIndex; cellIndex <= cellBlock.endIndex; ++cellIndex) {
+            auto const& cell = cluster->cellPointers[cellIndex];
+
+            auto cellPos = cell->absPos;
+            map.mapPosCorrection(cellPos);
+            drawEntityIntoTiles(level, tileRectUpperLeft, tileRectLowerRight, cellPos, calcPixelColor(cell, isSelected));
+        }
+        __syncthreads();
+    }
+}
+
+__global__ void drawParticlesIntoTiles(
+    int2 universeSize,
+    Array<Particle*> particles,
+    TiledImageLevel level,
+    int2 tileRectUpperLeft,
+    int2 tileRectLowerRight)
+{
+    MapInfo map;
+    map.init(universeSize);
+
+    auto const particleBlock =
+        calcPartition(particles.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+    for (int index = particleBlock.startIndex; index <= particleBlock.endIndex; ++index) {
+        auto const& particle = particles.at(index);
+
+        auto particlePos = particle->absPos;
+        map.mapPosCorrection(particlePos);
+        drawEntityIntoTiles(
+            level,
+            tileRectUpperLeft,
+            tileRectLowerRight,
+            particlePos,
+            calcPixelColor(particle, particle->isSelected()));
+    }
+}
+
+__global__ void finishDrawnTiles(TiledImageLevel level, int* dirtyTileIndices, int* numDirtyTiles)
+{
+    auto const tileBlock =
+        calcPartition(*numDirtyTiles, threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+    for (int index = tileBlock.startIndex; index <= tileBlock.endIndex; ++index) {
+        auto& tileState = level.tileStates[dirtyTileIndices[index]];
+        if (TiledImageLevel::Drawing == tileState) {
+            tileState = TiledImageLevel::Transferred;
+        }
+    }
+}
+
+//collects the tiles of the coarser level which cover the given tiles of the finer level and can be built from it,
+//i.e. they have been requested before, are not up to date and all the finer tiles they cover are up to date
+__global__ void claimCoarserTiles(
+    TiledImageLevel finerLevel,
+    TiledImageLevel coarserLevel,
+    int* finerTileIndices,
+    int numFinerTiles,
+    int* coarserTileIndices,
+    int* numCoarserTiles)
+{
+    auto const tileBlock = calcPartition(numFinerTiles, threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+    for (int index = tileBlock.startIndex; index <= tileBlock.endIndex; ++index) {
+        auto const finerTileIndex = finerTileIndices[index];
+        int2 const tile{(finerTileIndex % finerLevel.numTiles.x) / 2, (finerTileIndex / finerLevel.numTiles.x) / 2};
+        auto const tileIndex = tile.y * coarserLevel.numTiles.x + tile.x;
+        if (TiledImageLevel::NoSlot == coarserLevel.tileSlots[tileIndex]) {
+            continue;
+        }
+        auto& tileState = coarserLevel.tileStates[tileIndex];
+        auto const origTileState = tileState;
+        if (TiledImageLevel::Outdated != origTileState && TiledImageLevel::NotDrawn != origTileState) {
+            continue;
+        }
+        if (origTileState != atomicCAS(&tileState, origTileState, TiledImageLevel::Drawing)) {
+            continue;   //claimed by another finer tile
+        }
+
+        auto finerTilesUpToDate = true;
+        for (int dy = 0; dy < 2; ++dy) {
+            for (int dx = 0; dx < 2; ++dx) {
+                int2 const finerTile{tile.x * 2 + dx, tile.y * 2 + dy};
+                if (finerTile.x < finerLevel.numTiles.x && finerTile.y < finerLevel.numTiles.y
+                    && !finerLevel.isUpToDate(finerTile.y * finerLevel.numTiles.x + finerTile.x)) {
+                    finerTilesUpToDate = false;
+                }
+            }
+        }
+        if (finerTilesUpToDate) {
+            coarserTileIndices[atomicAdd(numCoarserTiles, 1)] = tileIndex;
+        } else {
+            atomicExch(&tileState, origTileState);
+        }
+    }
+}
+
+__global__ void
+reduceTiles(TiledImageLevel finerLevel, TiledImageLevel coarserLevel, int* coarserTileIndices, int* numCoarserTiles)
+{
+    int const tileSize = Const::PixelImageTileSize;
+    auto const tileBlock = calcPartition(*numCoarserTiles, blockIdx.x, gridDim.x);
+    for (int index = tileBlock.startIndex; index <= tileBlock.endIndex; ++index) {
+        auto const tileIndex = coarserTileIndices[index];
+        int2 const tile{tileIndex % coarserLevel.numTiles.x, tileIndex / coarserLevel.numTiles.x};
+        auto const tilePixels = coarserLevel.getTilePixels(tileIndex);
+
+        auto const pixelBlock = calcPartition(tileSize * tileSize, threadIdx.x, blockDim.x);
+        for (int pixelIndex = pixelBlock.startIndex; pixelIndex <= pixelBlock.endIndex; ++pixelIndex) {
+            int2 const pixel{tile.x * tileSize + pixelIndex % tileSize, tile.y * tileSize + pixelIndex / tileSize};
+            tilePixels[pixelIndex] = pixel.x < coarserLevel.size.x && pixel.y < coarserLevel.size.y
+                ? reducePixel(finerLevel, pixel)
+                : Const::PixelImageNothingnessColor;
+        }
+        __syncthreads();
+
+        if (0 == threadIdx.x) {
+            coarserLevel.tileStates[tileIndex] = TiledImageLevel::Reduced;
+        }
+        __syncthreads();
+    }
+}
+
+__global__ void gatherDirtyTiles(
+    TiledImageLevel level,
+    int* dirtyTileIndices,
+    int numDirtyTiles,
+    unsigned int* dirtyTilePixels)
+{
+    int const tileSize = Const::PixelImageTileSize;
+    auto const pixelBlock = calcPartition(
+        numDirtyTiles * tileSize * tileSize, threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+    for (int index = pixelBlock.startIndex; index <= pixelBlock.endIndex; ++index) {
+        auto const tilePixels = level.getTilePixels(dirtyTileIndices[index / (tileSize * tileSize)]);
+        dirtyTilePixels[index] = tilePixels[index % (tileSize * tileSize)];
+    }
+}
+
+/************************************************************************/
+/* Main      															*/
+/************************************************************************/
+
+//draws the outdated tiles of the level in the tile rect, the coarser levels are then built from the finer ones as
+//far as their tiles have been requested before
+__global__ void drawTiledImage(
+    TiledImageLevel level,
+    int2 tileRectUpperLeft,
+    int2 tileRectLowerRight,
+    SimulationData data,
+    TiledImageData tiledImageData)
+{
+    *tiledImageData.numDirtyTiles = 0;
+    *tiledImageData.numTilesToDraw = 0;
+    if (tileRectUpperLeft.x == tileRectLowerRight.x || tileRectUpperLeft.y == tileRectLowerRight.y) {
+        return;
+    }
+
+    KERNEL_CALL(registerChangedClusters, data.size, data.entities.clusterPointers, data.tileChanges);
+    if (data.entities.clusterFreezedPointers.getNumEntries() > 0) {
+        KERNEL_CALL(registerChangedClusters, data.size, data.entities.clusterFreezedPointers, data.tileChanges);
+    }
+    KERNEL_CALL(registerChangedParticles, data.size, data.entities.particlePointers, data.tileChanges);
+    KERNEL_CALL(outdateChangedTiles, tiledImageData, data.tileChanges);
+    data.tileChanges.reset();
+
+    KERNEL_CALL(markDirtyTiles, level, tileRectUpperLeft, tileRectLowerRight, tiledImageData);
+    if (*tiledImageData.numTilesToDraw > 0) {
+        KERNEL_CALL(
+            drawClustersIntoTiles,
+            data.size,
+            data.entities.clusterPointers,
+            level,
+            tileRectUpperLeft,
+            tileRectLowerRight);
+        if (data.entities.clusterFreezedPointers.getNumEntries() > 0) {
+            KERNEL_CALL(
+                drawClustersIntoTiles,
+                data.size,
+                data.entities.clusterFreezedPointers,
+                level,
+                tileRectUpperLeft,
+                tileRectLowerRight);
+        }
+        KERNEL_CALL(
+            drawParticlesIntoTiles,
+            data.size,
+            data.entities.particlePointers,
+            level,
+            tileRectUpperLeft,
+            tileRectLowerRight);
+        KERNEL_CALL(finishDrawnTiles, level, tiledImageData.dirtyTileIndices, tiledImageData.numDirtyTiles);
+    }
+
+    auto finerLevel = level;
+    auto finerTileIndices = tiledImageData.dirtyTileIndices;
+    auto numFinerTiles = *tiledImageData.numDirtyTiles;
+    for (int levelIndex = level.level + 1; levelIndex <= Const::PixelImageMaxLevel; ++levelIndex) {
+        auto coarserLevel = tiledImageData.getLevelData(levelIndex);
+        if (0 == numFinerTiles || !coarserLevel.tileSlots) {
+            break;
+        }
+        auto const coarserTileIndices = tiledImageData.reducedTileIndices[levelIndex % 2];
+        auto const numCoarserTiles = &tiledImageData.numReducedTiles[levelIndex % 2];
+        *numCoarserTiles = 0;
+        KERNEL_CALL(
+            claimCoarserTiles,
+            finerLevel,
+            coarserLevel,
+            finerTileIndices,
+            numFinerTiles,
+            coarserTileIndices,
+            numCoarserTiles);
+        KERNEL_CALL(reduceTiles, finerLevel, coarserLevel, coarserTileIndices, numCoarserTiles);
+
+        finerLevel = coarserLevel;
+        finerTileIndices = coarserTileIndices;
+        numFinerTiles = *numCoarserTiles;
+    }
+}
+
+//copies the dirty tiles [firstTile, firstTile + numTiles) to dirtyTilePixels
+__global__ void gatherDirtyTileBatch(
+    TiledImageLevel level,
+    TiledImageData tiledImageData,
+    int firstTile,
+    int numTiles)
+{
+    KERNEL_CALL(
+        gatherDirtyTiles,
+        level,
+        tiledImageData.dirtyTileIndices + firstTile,
+        numTiles,
+        tiledImageData.dirtyTilePixels);
+}
@@ -110,7 +110,7 @@ __inline__ __device__ void PropulsionFunction::processing(Token * token, EntityF
     Math::normalize(impulse);
     auto particlePos = cell->absPos - impulse;
     auto particleVel = tangVel - impulse / 4.0f;
-    factory.createParticle(abs(energyDiff), particlePos, particleVel, { cell->metadata.color });
+    factory.createParticle(abs(energyDiff), particlePos, particleVel, { cell->coldData->metadata.color });
 
     token->changeEnergy(-(energyDiff + abs(energyDiff)));
     tokenMem[Enums::Prop::OUTPUT] = Enums::PropOut::SUCCESS;
@@ -43,7 +43,7 @@ __device__ __inline__ float2 mapUniversePosToPixelImagePos(float2 const& rectUpp
 __device__ __inline__ float3 calcColor(Cell* cell, bool selected)
 {
     unsigned int cellColor;
-    switch (cell->metadata.color % 7) {
+    switch (cell->coldData->metadata.color % 7) {
     case 0: {
         cellColor = Const::IndividualCellColor1;
         break;
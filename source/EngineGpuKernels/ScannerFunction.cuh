@@ -91,18 +91,18 @@ __inline__ __device__ void ScannerFunction::processing(Token * token)
     tokenMem[Enums::Scanner::OUT_CELL_MAX_CONNECTIONS] = lookupResult.cell->maxConnections;
     tokenMem[Enums::Scanner::OUT_CELL_BRANCH_NO] = lookupResult.cell->branchNumber;
   
-    auto const& color = lookupResult.cell->metadata.color;
+    auto const& color = lookupResult.cell->coldData->metadata.color;
     tokenMem[Enums::Scanner::OUT_CELL_METADATA] = color;
 
     tokenMem[Enums::Scanner::OUT_CELL_FUNCTION] = lookupResult.cell->getCellFunctionType();
-    tokenMem[Enums::Scanner::OUT_CELL_FUNCTION_DATA] = lookupResult.cell->numStaticBytes;
-    for (int i = 0; i < lookupResult.cell->numStaticBytes; ++i) {
-        tokenMem[Enums::Scanner::OUT_CELL_FUNCTION_DATA + 1 + i] = lookupResult.cell->staticData[i];
+    tokenMem[Enums::Scanner::OUT_CELL_FUNCTION_DATA] = lookupResult.cell->coldData->numStaticBytes;
+    for (int i = 0; i < lookupResult.cell->coldData->numStaticBytes; ++i) {
+        tokenMem[Enums::Scanner::OUT_CELL_FUNCTION_DATA + 1 + i] = lookupResult.cell->coldData->staticData[i];
     }
-    int mutableDataIndex = lookupResult.cell->numStaticBytes + 1;
-    tokenMem[Enums::Scanner::OUT_CELL_FUNCTION_DATA + mutableDataIndex] = lookupResult.cell->numMutableBytes;
-    for (int i = 0; i < lookupResult.cell->numMutableBytes; ++i) {
-        tokenMem[Enums::Scanner::OUT_CELL_FUNCTION_DATA + mutableDataIndex + 1 + i] = lookupResult.cell->mutableData[i];
+    int mutableDataIndex = lookupResult.cell->coldData->numStaticBytes + 1;
+    tokenMem[Enums::Scanner::OUT_CELL_FUNCTION_DATA + mutableDataIndex] = lookupResult.cell->coldData->numMutableBytes;
+    for (int i = 0; i < lookupResult.cell->coldData->numMutableBytes; ++i) {
+        tokenMem[Enums::Scanner::OUT_CELL_FUNCTION_DATA + mutableDataIndex + 1 + i] = lookupResult.cell->coldData->mutableData[i];
     }
 
     //scan cluster
@@ -119,8 +119,10 @@ __device__ auto ScannerFunction::spiralLookupAlgorithm(int depth, Cell * cell, C
 {
     SpiralLookupResult result;
 
-    Cell * visitedCellData[256*2];
-    HashSet<Cell*, HashFunctor<Cell*>> visitedCell(depth * 2, visitedCellData);
+    HashSet<Cell*>::Slot visitedCellData[256 * 2];
+    HashSet<Cell*> visitedCell;
+    visitedCell.init(visitedCellData, HashSet<Cell*>::calcCapacity(depth));
+    visitedCell.reset();
 
     result.cell = cell;
     result.prevCell = sourceCell;
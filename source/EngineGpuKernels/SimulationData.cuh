@@ -4,6 +4,9 @@
 #include "Definitions.cuh"
 #include "Entities.cuh"
 #include "CellFunctionData.cuh"
+#include "ClusterSchedule.h"
+#include "SleepingRegions.h"
+#include "TiledImageData.cuh"
 
 struct SimulationData
 {
@@ -12,7 +15,11 @@ struct SimulationData
 
     CellMap cellMap;
     ParticleMap particleMap;
+    CellBins cellBins;
+    ClusterSchedule clusterSchedule;    //calculated for the clusters of the current timestep
     CellFunctionData cellFunctionData;
+    SleepingRegions sleepingRegions;
+    TileChanges tileChanges;    //for the pixel image
 
     Entities entities;
     Entities entitiesForCleanup;
@@ -23,28 +30,54 @@ struct SimulationData
     int numImageBytes;
     unsigned int* imageData;
 
-    void init(int2 const& universeSize, CudaConstants const& cudaConstants, int timestep_)
+    void init(int2 const& universeSize, CudaConstants const& cudaConstants, int timestep_, uint64_t randomSeed)
     {
         size = universeSize;
         timestep = timestep_;
 
         entities.init(cudaConstants);
         entitiesForCleanup.init(cudaConstants);
-        cellFunctionData.init(universeSize);
-        cellMap.init(size, cudaConstants.MAX_CELLPOINTERS, entities.cellPointers.getArrayForHost());
-        particleMap.init(size, cudaConstants.MAX_PARTICLEPOINTERS);
+        cellFunctionData.init(universeSize, cudaConstants.MAX_CLUSTERPOINTERS, cudaConstants.MAX_TOKENPOINTERS);
+        cellMap.init(
+            size, cudaConstants.MAX_CELLPOINTERS, cudaConstants.MAX_CELLS, entities.cellPointers.getArrayForHost());
+        particleMap.init(size, cudaConstants.MAX_PARTICLEPOINTERS, cudaConstants.MAX_PARTICLES);
+        cellBins.init(size, cudaConstants.MAX_CELLS);
+
+        int* clusterScheduleOffsets = nullptr;
+        CudaMemoryManager::getInstance().acquireMemory<int>(cudaConstants.MAX_CLUSTERPOINTERS + 1, clusterScheduleOffsets);
+        checkCudaErrors(cudaMemset(clusterScheduleOffsets, 0, sizeof(int) * (cudaConstants.MAX_CLUSTERPOINTERS + 1)));
+        clusterSchedule.init(clusterScheduleOffsets, 0);
+
+        auto const sleepingRegionsLayout = SleepingRegions::calcLayout(size.x, size.y);
+        auto const numRegions = sleepingRegionsLayout.getNumRegions();
+        SleepingRegions::Memory sleepingRegionsMemory;
+        CudaMemoryManager::getInstance().acquireMemory<int>(numRegions, sleepingRegionsMemory.activities);
+        CudaMemoryManager::getInstance().acquireMemory<int>(numRegions, sleepingRegionsMemory.idleTimesteps);
+        CudaMemoryManager::getInstance().acquireMemory<int>(numRegions, sleepingRegionsMemory.states);
+        CudaMemoryManager::getInstance().acquireMemory<int>(
+            SleepingRegions::NumCounters, sleepingRegionsMemory.counters);
+        checkCudaErrors(cudaMemset(sleepingRegionsMemory.activities, 0, sizeof(int) * numRegions));
+        checkCudaErrors(cudaMemset(sleepingRegionsMemory.idleTimesteps, 0, sizeof(int) * numRegions));
+        checkCudaErrors(cudaMemset(sleepingRegionsMemory.states, 0, sizeof(int) * numRegions));
+        checkCudaErrors(cudaMemset(sleepingRegionsMemory.counters, 0, sizeof(int) * SleepingRegions::NumCounters));
+        sleepingRegions.init(sleepingRegionsLayout, sleepingRegionsMemory);
+
+        tileChanges.init(size);
         dynamicMemory.init(cudaConstants.DYNAMIC_MEMORY_SIZE);
-        numberGen.init(40312357);
+        numberGen.init(cudaConstants.NUM_BLOCKS * cudaConstants.NUM_THREADS_PER_BLOCK, randomSeed);
 
-        numImageBytes = size.x * size.y;
-        CudaMemoryManager::getInstance().acquireMemory<unsigned int>(numImageBytes, imageData);
+        //image buffer is allocated on first rendering with the size of the requested image
+        numImageBytes = 0;
+        imageData = nullptr;
     }
 
     void resizeImage(int2 const& newSize)
     {
-        CudaMemoryManager::getInstance().freeMemory(imageData);
-        CudaMemoryManager::getInstance().acquireMemory<unsigned int>(max(newSize.x * newSize.y, size.x * size.y), imageData);
+        if (imageData) {
+            CudaMemoryManager::getInstance().freeMemory(imageData);
+        }
         numImageBytes = newSize.x * newSize.y;
+        CudaMemoryManager::getInstance().acquireMemory<unsigned int>(numImageBytes, imageData);
     }
 
     void free()
@@ -54,10 +87,21 @@ struct SimulationData
         cellFunctionData.free();
         cellMap.free();
         particleMap.free();
+        cellBins.free();
+        CudaMemoryManager::getInstance().freeMemory(clusterSchedule.getOffsets());
+
+        auto const& sleepingRegionsMemory = sleepingRegions.getMemory();
+        CudaMemoryManager::getInstance().freeMemory(sleepingRegionsMemory.activities);
+        CudaMemoryManager::getInstance().freeMemory(sleepingRegionsMemory.idleTimesteps);
+        CudaMemoryManager::getInstance().freeMemory(sleepingRegionsMemory.states);
+        CudaMemoryManager::getInstance().freeMemory(sleepingRegionsMemory.counters);
+        tileChanges.free();
         numberGen.free();
         dynamicMemory.free();
 
-        CudaMemoryManager::getInstance().freeMemory(imageData);
+        if (imageData) {
+            CudaMemoryManager::getInstance().freeMemory(imageData);
+        }
     }
 };
 
@@ -13,12 +13,35 @@
 #include "CleanupKernels.cuh"
 #include "FreezingKernels.cuh"
 
+/************************************************************************/
+/* Helpers for scheduling												*/
+/************************************************************************/
+__global__ void calcClusterSchedule(SimulationData data)
+{
+    auto const& clusterPointers = data.entities.clusterPointers;
+    scanExclusive_block(
+        data.clusterSchedule.getNumClusters(), data.clusterSchedule.getOffsets(), [&](int clusterIndex) {
+            auto const& cluster = clusterPointers.at(clusterIndex);
+            return ClusterSchedule::calcCosts(cluster ? cluster->numCellPointers : 0);
+        });
+}
+
+//clusters of the current block, balanced by their number of cells if a schedule for them has been calculated
+__device__ __inline__ PartitionData calcClusterPartition(SimulationData const& data, int numClusters)
+{
+    if (cudaExecutionParameters.clusterLoadBalancing && data.clusterSchedule.getNumClusters() == numClusters) {
+        auto const range = data.clusterSchedule.getRange(blockIdx.x, gridDim.x);
+        return {range.startIndex, range.endIndex};
+    }
+    return calcPartition(numClusters, blockIdx.x, gridDim.x);
+}
+
 /************************************************************************/
 /* Helpers for clusters													*/
 /************************************************************************/
 __global__ void clusterProcessingStep1(SimulationData data, int numClusters)
 {
-    PartitionData clusterBlock = calcPartition(numClusters, blockIdx.x, gridDim.x);
+    auto const clusterBlock = calcClusterPartition(data, numClusters);
     for (int clusterIndex = clusterBlock.startIndex; clusterIndex <= clusterBlock.endIndex; ++clusterIndex) {
         ClusterProcessor clusterProcessor;
         clusterProcessor.init_block(data, clusterIndex);
@@ -30,7 +53,7 @@ __global__ void clusterProcessingStep1(SimulationData data, int numClusters)
 
 __global__ void clusterProcessingStep2(SimulationData data, int numClusters)
 {
-    PartitionData clusterBlock = calcPartition(numClusters, blockIdx.x, gridDim.x);
+    auto const clusterBlock = calcClusterPartition(data, numClusters);
     for (int clusterIndex = clusterBlock.startIndex; clusterIndex <= clusterBlock.endIndex; ++clusterIndex) {
         ClusterProcessor clusterProcessor;
         clusterProcessor.init_block(data, clusterIndex);
@@ -40,7 +63,7 @@ __global__ void clusterProcessingStep2(SimulationData data, int numClusters)
 
 __global__ void clusterProcessingStep3(SimulationData data, int numClusters)
 {
-    PartitionData clusterBlock = calcPartition(numClusters, blockIdx.x, gridDim.x);
+    auto const clusterBlock = calcClusterPartition(data, numClusters);
     for (int clusterIndex = clusterBlock.startIndex; clusterIndex <= clusterBlock.endIndex; ++clusterIndex) {
         ClusterProcessor clusterProcessor;
         clusterProcessor.init_block(data, clusterIndex);
@@ -52,7 +75,7 @@ __global__ void clusterProcessingStep3(SimulationData data, int numClusters)
 
 __global__ void clusterProcessingStep4(SimulationData data, int numClusters)
 {
-    PartitionData clusterBlock = calcPartition(numClusters, blockIdx.x, gridDim.x);
+    auto const clusterBlock = calcClusterPartition(data, numClusters);
     for (int clusterIndex = clusterBlock.startIndex; clusterIndex <= clusterBlock.endIndex; ++clusterIndex) {
         ClusterProcessor clusterProcessor;
         clusterProcessor.init_block(data, clusterIndex);
@@ -62,16 +85,48 @@ __global__ void clusterProcessingStep4(SimulationData data, int numClusters)
     }
 }
 
+/************************************************************************/
+/* Helpers for spatial binning											*/
+/************************************************************************/
+__global__ void countCellsInBins(SimulationData data, int numClusters)
+{
+    auto const clusterBlock = calcClusterPartition(data, numClusters);
+    for (int clusterIndex = clusterBlock.startIndex; clusterIndex <= clusterBlock.endIndex; ++clusterIndex) {
+        auto const& cluster = data.entities.clusterPointers.at(clusterIndex);
+        data.cellBins.count_block(cluster->numCellPointers, cluster->cellPointers);
+    }
+}
+
+__global__ void calcCellBinOffsets(SimulationData data)
+{
+    data.cellBins.calcOffsets_block();
+}
+
+__global__ void insertCellsIntoBins(SimulationData data, int numClusters)
+{
+    auto const clusterBlock = calcClusterPartition(data, numClusters);
+    for (int clusterIndex = clusterBlock.startIndex; clusterIndex <= clusterBlock.endIndex; ++clusterIndex) {
+        auto const& cluster = data.entities.clusterPointers.at(clusterIndex);
+        data.cellBins.insert_block(cluster->numCellPointers, cluster->cellPointers);
+    }
+}
+
 /************************************************************************/
 /* Helpers for tokens													*/
 /************************************************************************/
-__global__ void resetCellFunctionData(SimulationData data)
+__global__ void calcMapSectionOffsets(SimulationData data)
+{
+    data.cellFunctionData.mapSectionCollector.calcOffsets_block();
+}
+
+__global__ void sortMapSections(SimulationData data)
 {
-    data.cellFunctionData.mapSectionCollector.reset_system();
+    data.cellFunctionData.mapSectionCollector.sort_system();
 }
+
 __global__ void tokenProcessingStep1(SimulationData data, int numClusters)
 {
-    auto const clusterPartition = calcPartition(numClusters, blockIdx.x, gridDim.x);
+    auto const clusterPartition = calcClusterPartition(data, numClusters);
     for (int clusterIndex = clusterPartition.startIndex; clusterIndex <= clusterPartition.endIndex; ++clusterIndex) {
         TokenProcessor tokenProcessor;
         tokenProcessor.init_block(data, clusterIndex);
@@ -82,9 +137,14 @@ __global__ void tokenProcessingStep1(SimulationData data, int numClusters)
     }
 }
 
+__global__ void processingCollectedWeaponStrikes(SimulationData data)
+{
+    WeaponFunction::processingCollectedStrikes(&data);
+}
+
 __global__ void tokenProcessingStep2(SimulationData data, int numClusters)
 {
-    auto const clusterPartition = calcPartition(numClusters, blockIdx.x, gridDim.x);
+    auto const clusterPartition = calcClusterPartition(data, numClusters);
     for (int clusterIndex = clusterPartition.startIndex; clusterIndex <= clusterPartition.endIndex; ++clusterIndex) {
         TokenProcessor tokenProcessor;
         tokenProcessor.init_block(data, clusterIndex);
@@ -94,7 +154,7 @@ __global__ void tokenProcessingStep2(SimulationData data, int numClusters)
 
 __global__ void tokenProcessingStep3(SimulationData data, int numClusters)
 {
-    PartitionData clusterBlock = calcPartition(numClusters, blockIdx.x, gridDim.x);
+    auto const clusterBlock = calcClusterPartition(data, numClusters);
     for (int clusterIndex = clusterBlock.startIndex; clusterIndex <= clusterBlock.endIndex; ++clusterIndex) {
         TokenProcessor tokenProcessor;
         tokenProcessor.init_block(data, clusterIndex);
@@ -104,7 +164,7 @@ __global__ void tokenProcessingStep3(SimulationData data, int numClusters)
 
 __global__ void tokenProcessingStep4(SimulationData data, int numClusters)
 {
-    PartitionData clusterBlock = calcPartition(numClusters, blockIdx.x, gridDim.x);
+    auto const clusterBlock = calcClusterPartition(data, numClusters);
     for (int clusterIndex = clusterBlock.startIndex; clusterIndex <= clusterBlock.endIndex; ++clusterIndex) {
         TokenProcessor tokenProcessor;
         tokenProcessor.init_block(data, clusterIndex);
@@ -147,19 +207,37 @@ __global__ void cudaCalcSimulationTimestep(SimulationData data)
     data.cellMap.reset();
     data.particleMap.reset();
     data.dynamicMemory.reset();
-    KERNEL_CALL(resetCellFunctionData, data);
+    data.cellFunctionData.mapSectionCollector.reset();
+    data.cellFunctionData.weaponTokens.reset();
+    if (cudaExecutionParameters.clusterLoadBalancing) {
+        data.clusterSchedule.init(data.clusterSchedule.getOffsets(), data.entities.clusterPointers.getNumEntries());
+        KERNEL_CALL_1_BLOCK(calcClusterSchedule, data);
+    }
     KERNEL_CALL(clusterProcessingStep1, data, data.entities.clusterPointers.getNumEntries());
     KERNEL_CALL(tokenProcessingStep1, data, data.entities.clusterPointers.getNumEntries());
+    if (cudaExecutionParameters.deterministic) {
+        KERNEL_CALL_1_1(processingCollectedWeaponStrikes, data);
+    }
     KERNEL_CALL(tokenProcessingStep2, data, data.entities.clusterPointers.getNumEntries());
+    KERNEL_CALL_1_BLOCK(calcMapSectionOffsets, data);
+    KERNEL_CALL(sortMapSections, data);
     KERNEL_CALL(tokenProcessingStep3, data, data.entities.clusterPointers.getNumEntries());
     KERNEL_CALL(tokenProcessingStep4, data, data.entities.clusterPointers.getNumEntries());
     KERNEL_CALL(clusterProcessingStep2, data, data.entities.clusterPointers.getNumEntries());
+    if (cudaExecutionParameters.spatialBinning) {
+        KERNEL_CALL(countCellsInBins, data, data.entities.clusterPointers.getNumEntries());
+        KERNEL_CALL_1_BLOCK(calcCellBinOffsets, data);
+        KERNEL_CALL(insertCellsIntoBins, data, data.entities.clusterPointers.getNumEntries());
+    }
     KERNEL_CALL(clusterProcessingStep3, data, data.entities.clusterPointers.getNumEntries());
     KERNEL_CALL(clusterProcessingStep4, data, data.entities.clusterPointers.getNumEntries());
     KERNEL_CALL(particleProcessingStep1, data);
     KERNEL_CALL(particleProcessingStep2, data);
     KERNEL_CALL(particleProcessingStep3, data);
 
+    if (cudaExecutionParameters.regionSleeping) {
+        KERNEL_CALL_1_1(sleepOrWakeUpRegions, data);
+    }
     KERNEL_CALL(freezeClustersIfAllowed, data);
 
     KERNEL_CALL_1_1(cleanupAfterSimulation, data);
@@ -0,0 +1,215 @@
+#pragma once
+
+#include "Base/HostDeviceFunctions.h"
+
+/**
+ * Square regions of the world which fall asleep as a unit if no activity (moving entities, tokens, pending fusions
+ * or decompositions) has been reported for them over TimestepsUntilSleep timesteps. Clusters whose cells only cover
+ * sleeping regions are frozen, i.e. neither processed nor written to the maps, until one of these regions is woken up
+ * by an entity approaching it or by a user action.
+ *
+ * Passes per timestep: markActive for every active entity (with a margin covering the distance the entity can
+ * interact with in the next timestep), then update for every region. A region woken up by update or wakeUp stays in
+ * state WokenUp until its next update so that its frozen clusters can be resumed in between.
+ *
+ * The memory is provided by the caller so that the regions work on the GPU as well as on the host.
+ */
+class SleepingRegions
+{
+public:
+    static constexpr int DefaultRegionSize = 64;
+    static constexpr int TimestepsUntilSleep = 30;
+
+    //entities slower than these velocities do not keep their regions awake
+    static constexpr float MaxIdleVelocity = 0.001f;
+    static constexpr float MaxIdleAngularVelocity = 0.01f;
+
+    enum State
+    {
+        Awake = 0,
+        Sleeping = 1,
+        WokenUp = 2
+    };
+
+    enum Counter
+    {
+        NumSleepingRegions = 0,
+        NumRegionsFallenAsleep,     //cumulative
+        NumRegionsWokenUp,          //cumulative
+        NumCounters
+    };
+
+    //regions are square grid cells with an edge length of at least regionSize, the last row and column absorb the
+    //remainder of the world size
+    struct Layout
+    {
+        int sizeX;
+        int sizeY;
+        int regionSize;
+        int numRegionsX;
+        int numRegionsY;
+
+        HOST_DEVICE_FUNCTION int getNumRegions() const { return numRegionsX * numRegionsY; }
+    };
+
+    //initial content: all elements 0
+    struct Memory
+    {
+        int* activities;    //Layout::getNumRegions() elements
+        int* idleTimesteps; //Layout::getNumRegions() elements
+        int* states;        //Layout::getNumRegions() elements
+        int* counters;      //NumCounters elements
+    };
+
+    HOST_DEVICE_FUNCTION static Layout calcLayout(int sizeX, int sizeY, int regionSize = DefaultRegionSize)
+    {
+        Layout result;
+        result.sizeX = sizeX;
+        result.sizeY = sizeY;
+        result.regionSize = regionSize;
+        result.numRegionsX = sizeX / regionSize > 0 ? sizeX / regionSize : 1;
+        result.numRegionsY = sizeY / regionSize > 0 ? sizeY / regionSize : 1;
+        return result;
+    }
+
+    HOST_DEVICE_FUNCTION void init(Layout const& layout, Memory const& memory)
+    {
+        _layout = layout;
+        _memory = memory;
+    }
+
+    HOST_DEVICE_FUNCTION Layout const& getLayout() const { return _layout; }
+    HOST_DEVICE_FUNCTION Memory const& getMemory() const { return _memory; }
+    HOST_DEVICE_FUNCTION int getCounter(Counter counter) const { return _memory.counters[counter]; }
+
+    //positions have to be inside the world
+    HOST_DEVICE_FUNCTION int getRegion(float x, float y) const
+    {
+        return getRegionIndex(y, _layout.numRegionsY) * _layout.numRegionsX + getRegionIndex(x, _layout.numRegionsX);
+    }
+
+    HOST_DEVICE_FUNCTION State getState(int region) const { return static_cast<State>(_memory.states[region]); }
+    HOST_DEVICE_FUNCTION bool isSleeping(float x, float y) const
+    {
+        return Sleeping == getState(getRegion(x, y));
+    }
+    HOST_DEVICE_FUNCTION bool isWokenUp(float x, float y) const
+    {
+        return WokenUp == getState(getRegion(x, y));
+    }
+
+    //for entities covering several regions, e.g. clusters within radius around their center
+    HOST_DEVICE_FUNCTION bool areAllSleeping(float x, float y, float radius) const
+    {
+        auto result = true;
+        forEachRegion(x, y, radius, [&](int region) { result = result && Sleeping == getState(region); });
+        return result;
+    }
+    HOST_DEVICE_FUNCTION bool isAnyWokenUp(float x, float y, float radius) const
+    {
+        auto result = false;
+        forEachRegion(x, y, radius, [&](int region) { result = result || WokenUp == getState(region); });
+        return result;
+    }
+
+    //pass 1: reports activity for all regions closer than margin (the world is a torus)
+    HOST_DEVICE_FUNCTION void markActive(float x, float y, float margin)
+    {
+        forEachRegion(x, y, margin, [&](int region) { _memory.activities[region] = 1; });
+    }
+
+    //pass 2: one thread per region
+    HOST_DEVICE_FUNCTION void update(int region)
+    {
+        auto& state = _memory.states[region];
+        if (1 == _memory.activities[region]) {
+            _memory.activities[region] = 0;
+            _memory.idleTimesteps[region] = 0;
+            if (Sleeping == state) {
+                wakeUp(region);
+            } else {
+                state = Awake;
+            }
+            return;
+        }
+        if (WokenUp == state) {
+            state = Awake;
+        }
+        if (Awake == state && ++_memory.idleTimesteps[region] >= TimestepsUntilSleep) {
+            state = Sleeping;
+            HostDeviceAtomics::add(&_memory.counters[NumSleepingRegions], 1);
+            HostDeviceAtomics::add(&_memory.counters[NumRegionsFallenAsleep], 1);
+        }
+    }
+
+    //may be called concurrently for the same region (e.g. by user actions)
+    HOST_DEVICE_FUNCTION void wakeUp(int region)
+    {
+        _memory.idleTimesteps[region] = 0;
+        if (Sleeping == HostDeviceAtomics::compareAndSwap(&_memory.states[region], Sleeping, WokenUp)) {
+            HostDeviceAtomics::add(&_memory.counters[NumSleepingRegions], -1);
+            HostDeviceAtomics::add(&_memory.counters[NumRegionsWokenUp], 1);
+        }
+    }
+
+    //sequential version of pass 2 for the host
+    HOST_DEVICE_FUNCTION void update()
+    {
+        for (int region = 0; region < _layout.getNumRegions(); ++region) {
+            update(region);
+        }
+    }
+
+private:
+    HOST_DEVICE_FUNCTION int getRegionIndex(float pos, int numRegions) const
+    {
+        auto const result = static_cast<int>(pos) / _layout.regionSize;
+        return result < numRegions ? result : numRegions - 1;
+    }
+
+    template <typename Func>
+    HOST_DEVICE_FUNCTION void forEachRegion(float x, float y, float margin, Func const& func) const
+    {
+        forEachRegionIndex(x, margin, _layout.sizeX, _layout.numRegionsX, [&](int regionX) {
+            forEachRegionIndex(y, margin, _layout.sizeY, _layout.numRegionsY, [&](int regionY) {
+                func(regionY * _layout.numRegionsX + regionX);
+            });
+        });
+    }
+
+    //calls func for the indices of all regions along one axis which intersect [pos - margin, pos + margin]
+    template <typename Func>
+    HOST_DEVICE_FUNCTION void
+    forEachRegionIndex(float pos, float margin, int size, int numRegions, Func const& func) const
+    {
+        if (2 * margin >= size) {
+            for (int index = 0; index < numRegions; ++index) {
+                func(index);
+            }
+            return;
+        }
+        auto lowerPos = pos - margin;
+        auto upperPos = pos + margin;
+        auto const wrapped = lowerPos < 0 || upperPos >= size;
+        lowerPos = lowerPos < 0 ? lowerPos + size : lowerPos;
+        upperPos = upperPos >= size ? upperPos - size : upperPos;
+
+        auto const lowerIndex = getRegionIndex(lowerPos, numRegions);
+        auto const upperIndex = getRegionIndex(upperPos, numRegions);
+        if (!wrapped) {
+            for (int index = lowerIndex; index <= upperIndex; ++index) {
+                func(index);
+            }
+        } else {
+            for (int index = lowerIndex; index < numRegions; ++index) {
+                func(index);
+            }
+            for (int index = 0; index <= upperIndex && index < lowerIndex; ++index) {
+                func(index);
+            }
+        }
+    }
+
+    Layout _layout;
+    Memory _memory;
+};
@@ -0,0 +1,197 @@
+#pragma once
+
+#include <cmath>
+
+#include "Base/HostDeviceFunctions.h"
+
+/**
+ * Cell list for neighbour queries, rebuilt by a counting sort: entries are counted per bucket (countEntry), the
+ * counts are turned into offsets by an exclusive scan (calcOffsets) and the entries are scattered to one contiguous
+ * array ordered by bucket (insertEntry). A query reads the contiguous ranges of the buckets around a position
+ * instead of probing single pixels.
+ *
+ * Buckets are square grid cells with an edge length of at least Layout::bucketSize (the last row and column absorb
+ * the remainder of the world size). If the grid has more cells than the bucket table, grid cells are hashed into the
+ * table so that memory depends on the number of entries and not on the world size. Buckets may contain entries
+ * beyond the query radius, callers have to check the distance.
+ *
+ * The memory is provided by the caller (see calcLayout and Memory) so that the bins work on the GPU as well as on
+ * the host. Device code may call countEntry and insertEntry concurrently. insertEntry counts down to zero again,
+ * hence the bins can be rebuilt as soon as all counted entries are inserted.
+ */
+template <typename T>
+class SpatialBins
+{
+public:
+    static constexpr int DefaultBucketSize = 2;
+
+    struct Layout
+    {
+        int bucketSize = DefaultBucketSize;
+        int numGridCellsX = 0;
+        int numGridCellsY = 0;
+        int numBuckets = 0;
+        int maxEntries = 0;
+
+        //hashed tables have a power of 2 as size
+        HOST_DEVICE_FUNCTION bool isHashed() const { return numBuckets < numGridCellsX * numGridCellsY; }
+    };
+
+    //initial content: counts = 0
+    struct Memory
+    {
+        int* counts = nullptr;      //Layout::numBuckets elements
+        int* offsets = nullptr;     //Layout::numBuckets + 1 elements
+        T* entries = nullptr;       //Layout::maxEntries elements
+    };
+
+    HOST_DEVICE_FUNCTION static Layout
+    calcLayout(int sizeX, int sizeY, int maxEntries, int bucketSize = DefaultBucketSize)
+    {
+        Layout result;
+        result.bucketSize = bucketSize;
+        result.numGridCellsX = sizeX / bucketSize > 0 ? sizeX / bucketSize : 1;
+        result.numGridCellsY = sizeY / bucketSize > 0 ? sizeY / bucketSize : 1;
+        result.maxEntries = maxEntries;
+
+        auto numHashedBuckets = 1;
+        while (numHashedBuckets < maxEntries) {
+            numHashedBuckets *= 2;
+        }
+        auto const numGridCells = result.numGridCellsX * result.numGridCellsY;
+        result.numBuckets = numGridCells <= numHashedBuckets ? numGridCells : numHashedBuckets;
+        return result;
+    }
+
+    HOST_DEVICE_FUNCTION void init(Layout const& layout, Memory const& memory)
+    {
+        _layout = layout;
+        _memory = memory;
+    }
+
+    HOST_DEVICE_FUNCTION Layout const& getLayout() const { return _layout; }
+    HOST_DEVICE_FUNCTION Memory const& getMemory() const { return _memory; }
+
+    //position has to be inside the world
+    HOST_DEVICE_FUNCTION int getBucket(float x, float y) const
+    {
+        return calcBucket(getGridCell(x, _layout.numGridCellsX), getGridCell(y, _layout.numGridCellsY));
+    }
+
+    //pass 1
+    HOST_DEVICE_FUNCTION void countEntry(int bucket) { HostDeviceAtomics::add(&_memory.counts[bucket], 1); }
+
+    //pass 2, sequential version for the host (the device uses a block-wide scan on getMemory())
+    HOST_DEVICE_FUNCTION void calcOffsets()
+    {
+        auto offset = 0;
+        for (int bucket = 0; bucket < _layout.numBuckets; ++bucket) {
+            _memory.offsets[bucket] = offset;
+            offset += _memory.counts[bucket];
+        }
+        _memory.offsets[_layout.numBuckets] = offset;
+    }
+
+    //pass 3, entries of the same bucket are stored in arbitrary order
+    HOST_DEVICE_FUNCTION void insertEntry(int bucket, T const& entry)
+    {
+        auto const index = _memory.offsets[bucket] + HostDeviceAtomics::add(&_memory.counts[bucket], -1) - 1;
+        if (index < _layout.maxEntries) {
+            _memory.entries[index] = entry;
+        }
+    }
+
+    //visits every entry within radius around the position exactly once (and further entries of the same buckets)
+    template <typename Func>
+    HOST_DEVICE_FUNCTION void forEachEntry(float x, float y, float radius, Func const& func) const
+    {
+        forEachRange(x, y, radius, [&](int startIndex, int endIndex) {
+            for (int index = startIndex; index < endIndex; ++index) {
+                func(_memory.entries[index]);
+            }
+        });
+    }
+
+    //visits the entries of forEachEntry as index ranges [startIndex, endIndex) of getMemory().entries, each range
+    //is contiguous and visited once
+    template <typename Func>
+    HOST_DEVICE_FUNCTION void forEachRange(float x, float y, float radius, Func const& func) const
+    {
+        auto const numRings = static_cast<int>(ceilf(radius / _layout.bucketSize));
+        auto const rangeX = calcRange(getGridCell(x, _layout.numGridCellsX), numRings, _layout.numGridCellsX);
+        auto const rangeY = calcRange(getGridCell(y, _layout.numGridCellsY), numRings, _layout.numGridCellsY);
+
+        for (int indexY = 0; indexY < rangeY.numGridCells; ++indexY) {
+            for (int indexX = 0; indexX < rangeX.numGridCells; ++indexX) {
+                auto const bucket = calcBucket(rangeX.getGridCell(indexX), rangeY.getGridCell(indexY));
+                if (_layout.isHashed() && isVisitedBefore(bucket, rangeX, rangeY, indexX, indexY)) {
+                    continue;
+                }
+                auto const endIndex =
+                    _memory.offsets[bucket + 1] < _layout.maxEntries ? _memory.offsets[bucket + 1] : _layout.maxEntries;
+                if (_memory.offsets[bucket] < endIndex) {
+                    func(_memory.offsets[bucket], endIndex);
+                }
+            }
+        }
+    }
+
+private:
+    //consecutive grid cells with wrap around, each grid cell occurs at most once
+    struct Range
+    {
+        int startGridCell;
+        int numGridCells;
+        int numAllGridCells;
+
+        HOST_DEVICE_FUNCTION int getGridCell(int index) const
+        {
+            return (startGridCell + index + numAllGridCells) % numAllGridCells;
+        }
+    };
+
+    HOST_DEVICE_FUNCTION static Range calcRange(int gridCell, int numRings, int numAllGridCells)
+    {
+        if (2 * numRings + 1 >= numAllGridCells) {
+            return {0, numAllGridCells, numAllGridCells};
+        }
+        return {gridCell - numRings, 2 * numRings + 1, numAllGridCells};
+    }
+
+    HOST_DEVICE_FUNCTION int getGridCell(float pos, int numGridCells) const
+    {
+        auto const result = static_cast<int>(pos) / _layout.bucketSize;
+        if (result < 0) {
+            return 0;
+        }
+        return result < numGridCells ? result : numGridCells - 1;
+    }
+
+    HOST_DEVICE_FUNCTION int calcBucket(int gridCellX, int gridCellY) const
+    {
+        if (!_layout.isHashed()) {
+            return gridCellX + gridCellY * _layout.numGridCellsX;
+        }
+        auto const hash =
+            static_cast<unsigned int>(gridCellX) * 73856093u ^ static_cast<unsigned int>(gridCellY) * 19349663u;
+        return static_cast<int>(hash & static_cast<unsigned int>(_layout.numBuckets - 1));
+    }
+
+    //different grid cells of a query may share a hashed bucket
+    HOST_DEVICE_FUNCTION bool
+    isVisitedBefore(int bucket, Range const& rangeX, Range const& rangeY, int indexX, int indexY) const
+    {
+        for (int otherIndexY = 0; otherIndexY <= indexY; ++otherIndexY) {
+            auto const endIndexX = otherIndexY < indexY ? rangeX.numGridCells : indexX;
+            for (int otherIndexX = 0; otherIndexX < endIndexX; ++otherIndexX) {
+                if (bucket == calcBucket(rangeX.getGridCell(otherIndexX), rangeY.getGridCell(otherIndexY))) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    Layout _layout;
+    Memory _memory;
+};
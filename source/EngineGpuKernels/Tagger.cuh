@@ -1,7 +1,7 @@
 #pragma once
 
 #include "Definitions.cuh"
-#include "HashMap.cuh"
+#include "HashMap.h"
 #include "Cell.cuh"
 
 class Tagger
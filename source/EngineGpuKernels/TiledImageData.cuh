@@ -0,0 +1,288 @@
+#pragma once
+
+#include <algorithm>
+
+#include "EngineInterface/PixelImageConstants.h"
+
+#include "Base.cuh"
+#include "CudaMemoryManager.cuh"
+#include "Definitions.cuh"
+
+struct TiledImageLevel
+{
+    static constexpr int NoSlot = -1;
+
+    //tile states
+    static constexpr int NotDrawn = 0;
+    static constexpr int Transferred = 1;   //up to date and transferred to the host
+    static constexpr int Outdated = 2;
+    static constexpr int Drawing = 3;
+    static constexpr int Reduced = 4;       //up to date, built from the finer level but not transferred yet
+
+    int level;
+    int2 size;      //in pixels of the level
+    int2 numTiles;
+    int* tileSlots;         //per tile: position of its pixels in the pool, NoSlot if never rendered
+    unsigned int* pixels;   //pool of tiles (see TiledImageData), each as in TiledPixelImage
+    int* tileStates;
+
+    __device__ __inline__ int2 calcPixel(float2 pos) const
+    {
+        return {floorInt(pos.x) >> level, floorInt(pos.y) >> level};
+    }
+
+    __device__ __inline__ int calcTileIndex(int2 const& pixel) const
+    {
+        return (pixel.y / Const::PixelImageTileSize) * numTiles.x + pixel.x / Const::PixelImageTileSize;
+    }
+
+    __device__ __inline__ unsigned int* getTilePixels(int tileIndex) const
+    {
+        return pixels + tileSlots[tileIndex] * Const::PixelImageTileSize * Const::PixelImageTileSize;
+    }
+
+    __device__ __inline__ unsigned int& getPixel(int2 const& pixel)
+    {
+        int const tileSize = Const::PixelImageTileSize;
+        return getTilePixels(calcTileIndex(pixel))[(pixel.y % tileSize) * tileSize + pixel.x % tileSize];
+    }
+
+    __device__ __inline__ bool isUpToDate(int tileIndex) const
+    {
+        auto const tileState = tileStates[tileIndex];
+        return Transferred == tileState || Reduced == tileState;
+    }
+};
+
+/**
+ * Tiles of level 0 whose content may have changed since they were drawn. Entities remember the pixel and color they
+ * were drawn with so that the tiles of changed entities can be registered before drawing, removed entities register
+ * their tile during the simulation.
+ */
+class TileChanges
+{
+public:
+    static constexpr int NoPixel = -1;
+
+    __host__ void init(int2 const& worldSize)
+    {
+        _worldSize = worldSize;
+        _numTiles = {
+            (worldSize.x + Const::PixelImageTileSize - 1) / Const::PixelImageTileSize,
+            (worldSize.y + Const::PixelImageTileSize - 1) / Const::PixelImageTileSize};
+        auto const numTiles = _numTiles.x * _numTiles.y;
+        CudaMemoryManager::getInstance().acquireMemory<int>(numTiles, _changed);
+        CudaMemoryManager::getInstance().acquireMemory<int>(numTiles, _changedTileIndices);
+        CudaMemoryManager::getInstance().acquireMemory<int>(1, _numChangedTiles);
+        checkCudaErrors(cudaMemset(_changed, 0, sizeof(int) * numTiles));
+        checkCudaErrors(cudaMemset(_numChangedTiles, 0, sizeof(int)));
+    }
+
+    __host__ void free()
+    {
+        CudaMemoryManager::getInstance().freeMemory(_changed);
+        CudaMemoryManager::getInstance().freeMemory(_changedTileIndices);
+        CudaMemoryManager::getInstance().freeMemory(_numChangedTiles);
+    }
+
+    //pixel of level 0 in the world
+    __device__ __inline__ int calcPixel(float2 const& pos) const
+    {
+        return floorInt(pos.y) * _worldSize.x + floorInt(pos.x);
+    }
+
+    //NoPixel is ignored
+    __device__ __inline__ void registerPixel(int pixel)
+    {
+        if (NoPixel == pixel) {
+            return;
+        }
+        auto const x = pixel % _worldSize.x;
+        auto const y = pixel / _worldSize.x;
+        auto const tileIndex = (y / Const::PixelImageTileSize) * _numTiles.x + x / Const::PixelImageTileSize;
+        if (0 == atomicExch(&_changed[tileIndex], 1)) {
+            _changedTileIndices[atomicAdd(_numChangedTiles, 1)] = tileIndex;
+        }
+    }
+
+    //registers the old and the new pixel if the entity has changed since drawing
+    __device__ __inline__ void registerEntity(int pixel, unsigned int color, int& drawnPixel, unsigned int& drawnColor)
+    {
+        if (pixel != drawnPixel || color != drawnColor) {
+            registerPixel(drawnPixel);
+            registerPixel(pixel);
+            drawnPixel = pixel;
+            drawnColor = color;
+        }
+    }
+
+    __device__ __inline__ int getNumChangedTiles() const { return *_numChangedTiles; }
+
+    __device__ __inline__ int2 getChangedTile(int index) const
+    {
+        auto const tileIndex = _changedTileIndices[index];
+        return {tileIndex % _numTiles.x, tileIndex / _numTiles.x};
+    }
+
+    //all changed tiles have to be unregistered before reset
+    __device__ __inline__ void unregisterChangedTile(int index) { _changed[_changedTileIndices[index]] = 0; }
+    __device__ __inline__ void reset() { *_numChangedTiles = 0; }
+
+private:
+    int2 _worldSize;
+    int2 _numTiles;
+    int* _changed;      //per tile: 1 if contained in _changedTileIndices
+    int* _changedTileIndices;
+    int* _numChangedTiles;
+};
+
+/**
+ * Pixel memory is only used for tiles which have been requested at least once: they take their pixels from a pool
+ * shared by all levels, which is enlarged on the host before drawing (see reserveTiles). Dirty tiles are transferred
+ * in batches of at most MaxTilesPerBatch tiles, hence no buffer scales with the world size except for a few bytes of
+ * bookkeeping per tile.
+ */
+class TiledImageData
+{
+public:
+    static constexpr int MaxTilesPerBatch = 256;
+
+    __host__ void init(int2 const& worldSize)
+    {
+        _worldSize = worldSize;
+        for (int level = 0; level <= Const::PixelImageMaxLevel; ++level) {
+            _levels[level].tileSlots = nullptr;
+        }
+        _tilePoolCapacity = 0;
+        _dirtyTileCapacity = 0;
+        tilePool = nullptr;
+        dirtyTileIndices = nullptr;
+        reducedTileIndices[0] = nullptr;
+        reducedTileIndices[1] = nullptr;
+        auto const tileSize = Const::PixelImageTileSize;
+        CudaMemoryManager::getInstance().acquireMemory<int>(1, numDirtyTiles);
+        CudaMemoryManager::getInstance().acquireMemory<int>(1, numTilesToDraw);
+        CudaMemoryManager::getInstance().acquireMemory<int>(2, numReducedTiles);
+        CudaMemoryManager::getInstance().acquireMemory<int>(1, numUsedTiles);
+        CudaMemoryManager::getInstance().acquireMemory<unsigned int>(
+            MaxTilesPerBatch * tileSize * tileSize, dirtyTilePixels);
+        checkCudaErrors(cudaMemset(numUsedTiles, 0, sizeof(int)));
+    }
+
+    __host__ void free()
+    {
+        for (int level = 0; level <= Const::PixelImageMaxLevel; ++level) {
+            auto& levelData = _levels[level];
+            if (levelData.tileSlots) {
+                CudaMemoryManager::getInstance().freeMemory(levelData.tileSlots);
+                CudaMemoryManager::getInstance().freeMemory(levelData.tileStates);
+            }
+        }
+        if (tilePool) {
+            CudaMemoryManager::getInstance().freeMemory(tilePool);
+        }
+        if (dirtyTileIndices) {
+            CudaMemoryManager::getInstance().freeMemory(dirtyTileIndices);
+            CudaMemoryManager::getInstance().freeMemory(reducedTileIndices[0]);
+            CudaMemoryManager::getInstance().freeMemory(reducedTileIndices[1]);
+        }
+        CudaMemoryManager::getInstance().freeMemory(numDirtyTiles);
+        CudaMemoryManager::getInstance().freeMemory(numTilesToDraw);
+        CudaMemoryManager::getInstance().freeMemory(numReducedTiles);
+        CudaMemoryManager::getInstance().freeMemory(numUsedTiles);
+        CudaMemoryManager::getInstance().freeMemory(dirtyTilePixels);
+    }
+
+    //levels are only acquired when an image of the corresponding resolution is requested
+    __host__ TiledImageLevel const& getLevel(int level)
+    {
+        auto& result = _levels[level];
+        if (!result.tileSlots) {
+            result.level = level;
+            result.size = {(_worldSize.x + (1 << level) - 1) >> level, (_worldSize.y + (1 << level) - 1) >> level};
+            result.numTiles = calcNumTiles(level);
+            result.pixels = tilePool;
+            auto const numTiles = result.numTiles.x * result.numTiles.y;
+            CudaMemoryManager::getInstance().acquireMemory<int>(numTiles, result.tileSlots);
+            CudaMemoryManager::getInstance().acquireMemory<int>(numTiles, result.tileStates);
+            checkCudaErrors(cudaMemset(result.tileSlots, 0xff, sizeof(int) * numTiles));   //NoSlot
+            checkCudaErrors(cudaMemset(result.tileStates, 0, sizeof(int) * numTiles));      //NotDrawn
+        }
+        return result;
+    }
+
+    //tileSlots is nullptr if the level has not been acquired
+    __device__ __inline__ TiledImageLevel const& getLevelData(int level) const { return _levels[level]; }
+
+    //all tiles are drawn again on the next request, e.g. after entities have been replaced
+    __host__ void invalidate()
+    {
+        for (int level = 0; level <= Const::PixelImageMaxLevel; ++level) {
+            auto const& levelData = _levels[level];
+            if (levelData.tileSlots) {
+                checkCudaErrors(cudaMemset(
+                    levelData.tileStates, 0, sizeof(int) * levelData.numTiles.x * levelData.numTiles.y));
+            }
+        }
+    }
+
+    //provides enough memory for drawing numTiles tiles which may not have been rendered so far
+    __host__ void reserveTiles(int numTiles)
+    {
+        auto const tileArea = Const::PixelImageTileSize * Const::PixelImageTileSize;
+        if (numTiles > _dirtyTileCapacity) {
+            if (dirtyTileIndices) {
+                CudaMemoryManager::getInstance().freeMemory(dirtyTileIndices);
+                CudaMemoryManager::getInstance().freeMemory(reducedTileIndices[0]);
+                CudaMemoryManager::getInstance().freeMemory(reducedTileIndices[1]);
+            }
+            CudaMemoryManager::getInstance().acquireMemory<int>(numTiles, dirtyTileIndices);
+            CudaMemoryManager::getInstance().acquireMemory<int>(numTiles, reducedTileIndices[0]);
+            CudaMemoryManager::getInstance().acquireMemory<int>(numTiles, reducedTileIndices[1]);
+            _dirtyTileCapacity = numTiles;
+        }
+
+        int numUsedTilesHost;
+        checkCudaErrors(cudaMemcpy(&numUsedTilesHost, numUsedTiles, sizeof(int), cudaMemcpyDeviceToHost));
+        if (numUsedTilesHost + numTiles <= _tilePoolCapacity) {
+            return;
+        }
+        auto const newCapacity = std::max(numUsedTilesHost + numTiles, _tilePoolCapacity * 2);
+        unsigned int* newTilePool;
+        CudaMemoryManager::getInstance().acquireMemory<unsigned int>(newCapacity * tileArea, newTilePool);
+        if (tilePool) {
+            checkCudaErrors(cudaMemcpy(
+                newTilePool,
+                tilePool,
+                sizeof(unsigned int) * numUsedTilesHost * tileArea,
+                cudaMemcpyDeviceToDevice));
+            CudaMemoryManager::getInstance().freeMemory(tilePool);
+        }
+        tilePool = newTilePool;
+        _tilePoolCapacity = newCapacity;
+        for (int level = 0; level <= Const::PixelImageMaxLevel; ++level) {
+            _levels[level].pixels = tilePool;
+        }
+    }
+
+    int* numDirtyTiles;
+    int* dirtyTileIndices;          //capacity given by reserveTiles
+    int* numTilesToDraw;            //dirty tiles which are drawn from the entities
+    int* numReducedTiles;
+    int* reducedTileIndices[2];     //coarser levels are built alternately in both arrays, capacity as dirtyTileIndices
+    int* numUsedTiles;              //of tilePool
+    unsigned int* tilePool;
+    unsigned int* dirtyTilePixels;  //batch of tiles of dirtyTileIndices in the same order
+
+private:
+    __host__ int2 calcNumTiles(int level) const
+    {
+        auto const tileWorldSize = Const::PixelImageTileSize << level;
+        return {(_worldSize.x + tileWorldSize - 1) / tileWorldSize, (_worldSize.y + tileWorldSize - 1) / tileWorldSize};
+    }
+
+    int2 _worldSize;
+    int _tilePoolCapacity;
+    int _dirtyTileCapacity;
+    TiledImageLevel _levels[Const::PixelImageMaxLevel + 1];
+};
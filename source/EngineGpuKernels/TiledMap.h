@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Base/HostDeviceFunctions.h"
+
+/**
+ * Sparse storage of a 2D map: memory is only used for tiles containing entries. A tile is taken from a fixed pool
+ * when the first entry in it is requested and returned to the pool by releaseTile, so memory scales with the
+ * populated area instead of the world size. Entries of unallocated tiles read as missing (nullptr).
+ *
+ * The memory is provided by the caller (see calcLayout and Memory) so that the map works on the GPU as well as on
+ * the host. Device code may call getOrCreateEntry concurrently, releaseTile has to run in a later pass (kernel)
+ * after all entries of the tile have been cleared.
+ */
+template <typename T>
+class TiledMap
+{
+public:
+    static constexpr int TileSize = 8;
+    static constexpr int TileArea = TileSize * TileSize;
+    static constexpr int NoTile = -1;
+    static constexpr int AllocatingTile = -2;
+
+    struct Layout
+    {
+        int numTilesX = 0;
+        int numTilesY = 0;
+        int maxTiles = 0;   //size of tile pool
+
+        HOST_DEVICE_FUNCTION int getNumTiles() const { return numTilesX * numTilesY; }
+    };
+
+    //initial content: tileIndices = NoTile, tiles = 0, freeTiles = 0, 1, ..., maxTiles - 1, numFreeTiles = maxTiles
+    struct Memory
+    {
+        int* tileIndices = nullptr;     //Layout::getNumTiles() elements
+        T* tiles = nullptr;             //Layout::maxTiles * TileArea elements
+        int* freeTiles = nullptr;       //Layout::maxTiles elements
+        int* numFreeTiles = nullptr;    //1 element
+    };
+
+    //maxEntries: upper bound of entries set between two releases, since every allocated tile holds at least one
+    //entry no more tiles are needed
+    HOST_DEVICE_FUNCTION static Layout calcLayout(int sizeX, int sizeY, int maxEntries)
+    {
+        Layout result;
+        result.numTilesX = (sizeX + TileSize - 1) / TileSize;
+        result.numTilesY = (sizeY + TileSize - 1) / TileSize;
+        result.maxTiles = result.getNumTiles() < maxEntries ? result.getNumTiles() : maxEntries;
+        return result;
+    }
+
+    HOST_DEVICE_FUNCTION void init(Layout const& layout, Memory const& memory)
+    {
+        _layout = layout;
+        _memory = memory;
+    }
+
+    HOST_DEVICE_FUNCTION Layout const& getLayout() const { return _layout; }
+    HOST_DEVICE_FUNCTION Memory const& getMemory() const { return _memory; }
+
+    //nullptr if tile is not allocated
+    HOST_DEVICE_FUNCTION T* getEntry(int x, int y) const
+    {
+        auto const tileIndex = loadVolatile(_memory.tileIndices[getDirectoryIndex(x, y)]);
+        if (tileIndex < 0) {
+            return nullptr;
+        }
+        return &_memory.tiles[tileIndex * TileArea + getIndexInTile(x, y)];
+    }
+
+    //nullptr if tile pool is exhausted
+    HOST_DEVICE_FUNCTION T* getOrCreateEntry(int x, int y)
+    {
+        auto const directoryIndex = getDirectoryIndex(x, y);
+        auto tileIndex = loadVolatile(_memory.tileIndices[directoryIndex]);
+        while (tileIndex < 0) {
+            auto& directoryEntry = _memory.tileIndices[directoryIndex];
+            if (NoTile == tileIndex
+                && NoTile == HostDeviceAtomics::compareAndSwap(&directoryEntry, NoTile, AllocatingTile)) {
+                tileIndex = allocateTile();
+                HostDeviceAtomics::exchange(&directoryEntry, tileIndex < 0 ? NoTile : tileIndex);
+                if (tileIndex < 0) {
+                    return nullptr;
+                }
+                break;
+            }
+
+            //another thread is allocating the tile
+            tileIndex = loadVolatile(_memory.tileIndices[directoryIndex]);
+        }
+        return &_memory.tiles[tileIndex * TileArea + getIndexInTile(x, y)];
+    }
+
+    HOST_DEVICE_FUNCTION void releaseTile(int x, int y)
+    {
+        auto const tileIndex = HostDeviceAtomics::exchange(&_memory.tileIndices[getDirectoryIndex(x, y)], NoTile);
+        if (tileIndex >= 0) {
+            auto const freeTileIndex = HostDeviceAtomics::add(_memory.numFreeTiles, 1);
+            _memory.freeTiles[freeTileIndex] = tileIndex;
+        }
+    }
+
+    HOST_DEVICE_FUNCTION int getNumAllocatedTiles() const { return _layout.maxTiles - *_memory.numFreeTiles; }
+
+private:
+    HOST_DEVICE_FUNCTION int getDirectoryIndex(int x, int y) const
+    {
+        return x / TileSize + (y / TileSize) * _layout.numTilesX;
+    }
+
+    HOST_DEVICE_FUNCTION static int getIndexInTile(int x, int y) { return x % TileSize + (y % TileSize) * TileSize; }
+
+    //tiles are only pushed back in a separate pass, hence concurrent pops need no further synchronization
+    HOST_DEVICE_FUNCTION int allocateTile()
+    {
+        auto const freeTileIndex = HostDeviceAtomics::add(_memory.numFreeTiles, -1) - 1;
+        if (freeTileIndex < 0) {
+            HostDeviceAtomics::add(_memory.numFreeTiles, 1);
+            return NoTile;
+        }
+        auto const result = _memory.freeTiles[freeTileIndex];
+        HostDeviceAtomics::threadFence();
+        return result;
+    }
+
+    HOST_DEVICE_FUNCTION static int loadVolatile(int const& value) { return *const_cast<int const volatile*>(&value); }
+
+    Layout _layout;
+    Memory _memory;
+};
@@ -17,6 +17,7 @@
 #include "WeaponFunction.cuh"
 #include "SensorFunction.cuh"
 #include "CommunicatorFunction.cuh"
+#include "CellFunctionGroups.h"
 
 class TokenProcessor
 {
@@ -42,6 +43,9 @@ private:
 
     __inline__ __device__ void resetTags_block();
 
+    //groups the first numTokens tokens of the cluster, the result is valid until the next call
+    __inline__ __device__ void groupTokensByCellFunction_block(int numTokens, CellFunctionGroups& result);
+
 private:
     SimulationData* _data;
     Cluster* _cluster;
@@ -268,10 +272,26 @@ __inline__ __device__ void TokenProcessor::processingLightWeigthedFeatures_block
     EntityFactory factory;
     factory.init(_data);
 
-    for (auto tokenIndex = _tokenPartition.startIndex; tokenIndex <= _tokenPartition.endIndex; ++tokenIndex) {
+    CellFunctionGroups groups;
+    groupTokensByCellFunction_block(_cluster->numTokenPointers, groups);
+
+    //every token passes this function once per timestep, constructors, sensors and communicators included
+    if (0 == threadIdx.x) {
+        for (int group = 0; group < CellFunctionGroups::NumGroups; ++group) {
+            if (auto const numTokens = groups.getNumTokens(group)) {
+                atomicAdd(
+                    &_data->cellFunctionData.numProcessedTokens[group], static_cast<unsigned long long>(numTokens));
+            }
+        }
+    }
+
+    //interleaved, so that the threads of a warp process consecutive tokens of the same group
+    for (int index = threadIdx.x; index < groups.getNumTokens(); index += blockDim.x) {
+        auto const tokenIndex = groups.getTokenIndex(index);
         auto& token = _cluster->tokenPointers[tokenIndex];
         auto cell = token->cell;
         cell->getLock();
+        _data->numberGen.beginEntity(cell->id, _data->timestep, RandomPurpose::CellFunction, tokenIndex);
         EnergyGuidance::processing(token);
         switch (cell->getCellFunctionType()) {
         case Enums::CellFunction::COMPUTER: {
@@ -305,17 +325,15 @@ __inline__ __device__ void TokenProcessor::processingConstructors_block()
     ConstructorFunction constructor;
     constructor.init_block(_cluster, _data);
 
-    __syncthreads();
+    CellFunctionGroups groups;
+    groupTokensByCellFunction_block(numTokenPointers, groups);
 
-    for (int tokenIndex = 0; tokenIndex < numTokenPointers; ++tokenIndex) {
-        auto const& token = _cluster->tokenPointers[tokenIndex];
-        auto const type = token->cell->getCellFunctionType();
+    //constructors may append tokens, the indices of the grouped tokens remain valid
+    auto const group = Enums::CellFunction::CONSTRUCTOR;
+    for (int index = 0; index < groups.getNumTokens(group); ++index) {
+        auto const& token = _cluster->tokenPointers[groups.getTokenIndex(group, index)];
         __syncthreads();
-        switch (type) {
-        case Enums::CellFunction::CONSTRUCTOR: {
-            constructor.processing_block(token);
-        } break;
-        }
+        constructor.processing_block(token);
         __syncthreads();
     }
 }
@@ -335,20 +353,21 @@ __inline__ __device__ void TokenProcessor::processingCommunicatorsAnsSensors_blo
 
     CommunicatorFunction communicator;
     communicator.init_block(_data);
-    __syncthreads();
 
-    for (int tokenIndex = 0; tokenIndex < numTokenPointers; ++tokenIndex) {
-        auto const& token = _cluster->tokenPointers[tokenIndex];
-        auto const type = token->cell->getCellFunctionType();
+    CellFunctionGroups groups;
+    groupTokensByCellFunction_block(numTokenPointers, groups);
+
+    //sensors and communicators do not access the tokens of each other, hence they are processed group by group
+    for (int index = 0; index < groups.getNumTokens(Enums::CellFunction::SENSOR); ++index) {
+        auto const& token = _cluster->tokenPointers[groups.getTokenIndex(Enums::CellFunction::SENSOR, index)];
         __syncthreads();
-        switch (type) {
-        case Enums::CellFunction::SENSOR: {
-            sensor.processing_block(token);
-        } break;
-        case Enums::CellFunction::COMMUNICATOR: {
-            communicator.processing_block(token);
-        } break;
-        }
+        sensor.processing_block(token);
+        __syncthreads();
+    }
+    for (int index = 0; index < groups.getNumTokens(Enums::CellFunction::COMMUNICATOR); ++index) {
+        auto const& token = _cluster->tokenPointers[groups.getTokenIndex(Enums::CellFunction::COMMUNICATOR, index)];
+        __syncthreads();
+        communicator.processing_block(token);
         __syncthreads();
     }
 }
@@ -383,7 +402,7 @@ __inline__ __device__ void TokenProcessor::createCellFunctionData_block()
 
     if (0 == threadIdx.x) {
         if (hasToken && hasCommunicator) {
-            _data->cellFunctionData.mapSectionCollector.insert(_cluster, &_data->dynamicMemory);
+            _data->cellFunctionData.mapSectionCollector.insert(_cluster);
         }
     }
 }
@@ -475,3 +494,77 @@ __inline__ __device__ void TokenProcessor::resetTags_block()
     }
     __syncthreads();
 }
+
+__inline__ __device__ void TokenProcessor::groupTokensByCellFunction_block(int numTokens, CellFunctionGroups& result)
+{
+    constexpr int MaxWarpsPerBlock = MaxThreadsPerBlock / 32;
+
+    __shared__ int counts[CellFunctionGroups::NumGroups];
+    __shared__ int offsets[CellFunctionGroups::NumGroups + 1];
+    __shared__ int* tokenIndices;
+    __shared__ int warpOffsets[CellFunctionGroups::NumGroups][MaxWarpsPerBlock];
+
+    if (0 == threadIdx.x) {
+        tokenIndices = _data->dynamicMemory.getArray<int>(numTokens);
+        for (int group = 0; group < CellFunctionGroups::NumGroups; ++group) {
+            counts[group] = 0;
+        }
+    }
+    __syncthreads();
+
+    CellFunctionGroups::Memory memory;
+    memory.counts = counts;
+    memory.offsets = offsets;
+    memory.tokenIndices = tokenIndices;
+    result.init(memory, numTokens);
+
+    auto const tokenBlock = calcPartition(numTokens, threadIdx.x, blockDim.x);
+    for (int tokenIndex = tokenBlock.startIndex; tokenIndex <= tokenBlock.endIndex; ++tokenIndex) {
+        result.countToken(_cluster->tokenPointers[tokenIndex]->cell->getCellFunctionType());
+    }
+    __syncthreads();
+
+    if (0 == threadIdx.x) {
+        result.calcOffsets();
+    }
+    __syncthreads();
+
+    //ranks in chunks of blockDim.x tokens: rank in warp by votes plus the tokens of the group in preceding warps
+    auto const warp = threadIdx.x / 32;
+    auto const lanesBefore = (1u << (threadIdx.x % 32)) - 1;
+    auto const numWarps = (blockDim.x + 31) / 32;
+    for (int chunkStart = 0; chunkStart < numTokens; chunkStart += blockDim.x) {
+        auto const tokenIndex = chunkStart + threadIdx.x;
+        auto const group =
+            tokenIndex < numTokens ? _cluster->tokenPointers[tokenIndex]->cell->getCellFunctionType() : -1;
+
+        auto rankInWarp = 0;
+        auto const activeLanes = __activemask();
+        for (int otherGroup = 0; otherGroup < CellFunctionGroups::NumGroups; ++otherGroup) {
+            auto const lanesInGroup = __ballot_sync(activeLanes, group == otherGroup);
+            if (group == otherGroup) {
+                rankInWarp = __popc(lanesInGroup & lanesBefore);
+            }
+            if (0 == threadIdx.x % 32) {
+                warpOffsets[otherGroup][warp] = __popc(lanesInGroup);
+            }
+        }
+        __syncthreads();
+
+        if (0 == threadIdx.x) {
+            for (int otherGroup = 0; otherGroup < CellFunctionGroups::NumGroups; ++otherGroup) {
+                for (int otherWarp = 0; otherWarp < numWarps; ++otherWarp) {
+                    auto const numTokensInWarp = warpOffsets[otherGroup][otherWarp];
+                    warpOffsets[otherGroup][otherWarp] = counts[otherGroup];
+                    counts[otherGroup] += numTokensInWarp;
+                }
+            }
+        }
+        __syncthreads();
+
+        if (group >= 0) {
+            result.insertToken(group, warpOffsets[group][warp] + rankInWarp, tokenIndex);
+        }
+        __syncthreads();
+    }
+}
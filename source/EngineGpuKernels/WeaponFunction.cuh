@@ -12,15 +12,63 @@ class WeaponFunction
 public:
     __inline__ __device__ static void processing(Token* token, SimulationData* data);
 
+    //deterministic mode: strikes of the tokens collected by processing are applied one after another in the order of
+    //the weapon cell ids, single thread
+    __inline__ __device__ static void processingCollectedStrikes(SimulationData* data);
+
 private:
+    __inline__ __device__ static void strike(Token* token, SimulationData* data);
+    __inline__ __device__ static void strike(Token* token, Cell* otherCell);
 
+    __inline__ __device__ static void sortByCellIds(Token** tokens, int numTokens);
 };
 
 __inline__ __device__ void WeaponFunction::processing(Token* token, SimulationData* data)
+{
+    auto const& cell = token->cell;
+    token->memory[Enums::Weapon::OUTPUT] = Enums::WeaponOut::NO_TARGET;
+
+    //deterministic mode: waiting for the lock of a struck cell while the own cell is locked would deadlock two weapons
+    //which strike each other, and skipping a strike under contention depends on the thread order
+    if (cudaExecutionParameters.deterministic) {
+        *data->cellFunctionData.weaponTokens.getNewElement() = token;
+    } else {
+        strike(token, data);
+    }
+
+    if (cudaSimulationParameters.cellFunctionWeaponEnergyCost > 0) {
+        auto const cellEnergy = cell->getEnergy_safe();
+        auto &pos = cell->absPos;
+        float2 particleVel = (cell->vel * cudaSimulationParameters.radiationVelocityMultiplier)
+            + float2{ (data->numberGen.random() - 0.5f) * cudaSimulationParameters.radiationVelocityPerturbation,
+            (data->numberGen.random() - 0.5f) * cudaSimulationParameters.radiationVelocityPerturbation };
+        float2 particlePos = pos + Math::normalized(particleVel) * 1.5f;
+        data->cellMap.mapPosCorrection(particlePos);
+
+        particlePos = particlePos - particleVel;	//because particle will still be moved in current time step
+        auto const radiationEnergy = min(cellEnergy, cudaSimulationParameters.cellFunctionWeaponEnergyCost);
+        cell->changeEnergy_safe(-radiationEnergy);
+        EntityFactory factory;
+        factory.init(data);
+        auto particle = factory.createParticle(radiationEnergy, particlePos, particleVel, { cell->coldData->metadata.color });
+    }
+}
+
+__inline__ __device__ void WeaponFunction::processingCollectedStrikes(SimulationData* data)
+{
+    auto& weaponTokens = data->cellFunctionData.weaponTokens;
+    auto const tokens = weaponTokens.getArrayForDevice();
+    auto const numTokens = weaponTokens.getNumEntries();
+    sortByCellIds(tokens, numTokens);
+    for (int index = 0; index < numTokens; ++index) {
+        strike(tokens[index], data);
+    }
+}
+
+__inline__ __device__ void WeaponFunction::strike(Token* token, SimulationData* data)
 {
     auto const& cell = token->cell;
     auto& tokenMem = token->memory;
-    tokenMem[Enums::Weapon::OUTPUT] = Enums::WeaponOut::NO_TARGET;
     int const minMass = static_cast<unsigned char>(tokenMem[Enums::Weapon::IN_MIN_MASS]);
     int maxMass = static_cast<unsigned char>(tokenMem[Enums::Weapon::IN_MAX_MASS]);
     if (0 == maxMass) {
@@ -41,40 +89,58 @@ __inline__ __device__ void WeaponFunction::processing(Token* token, SimulationDa
             if (otherCell->cluster->numCellPointers < minMass || otherCell->cluster->numCellPointers > maxMass) {
                 continue;
             }
-            if (otherCell->tryLock()) {
-/*
-                auto const mass = static_cast<float>(cell->cluster->numCellPointers);
-                auto const otherMass = static_cast<float>(otherCell->cluster->numCellPointers);
-                auto const energyToTransfer = / *sqrt* /(mass / otherMass)*(mass / otherMass)*cudaSimulationParameters.cellFunctionWeaponStrength;
-*/
-                auto const energyToTransfer =
-                    otherCell->getEnergy_safe() * cudaSimulationParameters.cellFunctionWeaponStrength + 1.0f;
-                if (otherCell->getEnergy_safe() > energyToTransfer) {
-                    otherCell->changeEnergy_safe(-energyToTransfer);
-                    token->changeEnergy(energyToTransfer / 2.0f);
-                    cell->changeEnergy_safe(energyToTransfer / 2.0f);
-                    token->memory[Enums::Weapon::OUTPUT] = Enums::WeaponOut::STRIKE_SUCCESSFUL;
-                }
-                otherCell->cluster->unfreeze(30);
+            //collected strikes are applied by a single thread
+            if (cudaExecutionParameters.deterministic) {
+                strike(token, otherCell);
+            } else if (otherCell->tryLock()) {
+                strike(token, otherCell);
                 otherCell->releaseLock();
             }
         }
     }
-    if (cudaSimulationParameters.cellFunctionWeaponEnergyCost > 0) {
-        auto const cellEnergy = cell->getEnergy_safe();
-        auto &pos = cell->absPos;
-        float2 particleVel = (cell->vel * cudaSimulationParameters.radiationVelocityMultiplier)
-            + float2{ (data->numberGen.random() - 0.5f) * cudaSimulationParameters.radiationVelocityPerturbation,
-            (data->numberGen.random() - 0.5f) * cudaSimulationParameters.radiationVelocityPerturbation };
-        float2 particlePos = pos + Math::normalized(particleVel) * 1.5f;
-        data->cellMap.mapPosCorrection(particlePos);
+}
 
-        particlePos = particlePos - particleVel;	//because particle will still be moved in current time step
-        auto const radiationEnergy = min(cellEnergy, cudaSimulationParameters.cellFunctionWeaponEnergyCost);
-        cell->changeEnergy_safe(-radiationEnergy);
-        EntityFactory factory;
-        factory.init(data);
-        auto particle = factory.createParticle(radiationEnergy, particlePos, particleVel, { cell->metadata.color });
+__inline__ __device__ void WeaponFunction::strike(Token* token, Cell* otherCell)
+{
+/*
+    auto const mass = static_cast<float>(cell->cluster->numCellPointers);
+    auto const otherMass = static_cast<float>(otherCell->cluster->numCellPointers);
+    auto const energyToTransfer = / *sqrt* /(mass / otherMass)*(mass / otherMass)*cudaSimulationParameters.cellFunctionWeaponStrength;
+*/
+    auto const energyToTransfer =
+        otherCell->getEnergy_safe() * cudaSimulationParameters.cellFunctionWeaponStrength + 1.0f;
+    if (otherCell->getEnergy_safe() > energyToTransfer) {
+        otherCell->changeEnergy_safe(-energyToTransfer);
+        token->changeEnergy(energyToTransfer / 2.0f);
+        token->cell->changeEnergy_safe(energyToTransfer / 2.0f);
+        token->memory[Enums::Weapon::OUTPUT] = Enums::WeaponOut::STRIKE_SUCCESSFUL;
     }
+    otherCell->cluster->unfreeze(30);
 }
 
+__inline__ __device__ void WeaponFunction::sortByCellIds(Token** tokens, int numTokens)
+{
+    //heap sort, since it needs no additional memory
+    auto const siftDown = [&](int index, int size) {
+        while (true) {
+            auto largest = index;
+            for (auto child = 2 * index + 1; child <= 2 * index + 2 && child < size; ++child) {
+                if (tokens[largest]->cell->id < tokens[child]->cell->id) {
+                    largest = child;
+                }
+            }
+            if (largest == index) {
+                return;
+            }
+            swap(tokens[index], tokens[largest]);
+            index = largest;
+        }
+    };
+    for (int index = numTokens / 2 - 1; index >= 0; --index) {
+        siftDown(index, numTokens);
+    }
+    for (int size = numTokens - 1; size > 0; --size) {
+        swap(tokens[0], tokens[size]);
+        siftDown(0, size);
+    }
+}
@@ -20,5 +20,9 @@ public:
 
 	virtual CompilationResult compileSourceCode(std::string const& code) const = 0;
 	virtual std::string decompileSourceCode(QByteArray const& data) const = 0;
+
+	//optional pass which shortens a compilation without changing its effect on token and cell memory
+	virtual QByteArray optimizeCompilation(QByteArray const& data) const = 0;
+	virtual bool checkEquivalence(QByteArray const& data1, QByteArray const& data2) const = 0;
 };
 
@@ -1,6 +1,12 @@
-﻿#include "SymbolTable.h"
+﻿#include <algorithm>
+#include <array>
+#include <climits>
+#include <string_view>
+
+#include "SymbolTable.h"
 #include "SimulationParameters.h"
 #include "CompilerHelper.h"
+#include "CellComputerOptimizer.h"
 #include "CellComputerCompilerImpl.h"
 
 namespace
@@ -16,245 +22,426 @@ namespace
 		LOOKING_FOR_OP2_END
 	};
 
+	//all parts of an instruction are contiguous ranges in the source code
 	struct InstructionUncoded {
 		bool readingFinished = false;
-		QString name;
-		QString operand1;
-		QString operand2;
-		QString comp;
+		std::string_view name;
+		std::string_view operand1;
+		std::string_view operand2;
+		std::string_view comp;
 	};
 
-	bool isNameChar(const QChar& c)
+	namespace CharClass
+	{
+		enum Type : uint8_t {
+			Letter = 1 << 0,
+			Name = 1 << 1,			//letter, number or ':'
+			OperandStart = 1 << 2,	//name character, '-', '_', '[' or '('
+			Operand = 1 << 3,		//operand start character, ']' or ')'
+			Comparator = 1 << 4,	//'<', '>', '=' or '!'
+			Space = 1 << 5
+		};
+	}
+
+	//source bytes are interpreted as Latin-1 characters
+	constexpr bool isLetter(unsigned int c)
+	{
+		return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == 0xaa || c == 0xb5 || c == 0xba
+			|| (c >= 0xc0 && c <= 0xff && c != 0xd7 && c != 0xf7);
+	}
+
+	constexpr bool isNumber(unsigned int c)
 	{
-		return c.isLetterOrNumber() || (c == ':');
+		return (c >= '0' && c <= '9') || c == 0xb2 || c == 0xb3 || c == 0xb9 || (c >= 0xbc && c <= 0xbe);
 	}
 
-	bool gotoNextStateAndReturnSuccess(CompilerState &state, QChar &currentSymbol, InstructionUncoded& instruction, int bytePos, int codeSize)
+	constexpr std::array<uint8_t, 256> createCharClassTable()
 	{
+		std::array<uint8_t, 256> result{};
+		for (unsigned int c = 0; c < 256; ++c) {
+			uint8_t charClass = 0;
+			if (isLetter(c)) {
+				charClass |= CharClass::Letter;
+			}
+			if (isLetter(c) || isNumber(c) || c == ':') {
+				charClass |= CharClass::Name;
+			}
+			if ((charClass & CharClass::Name) || c == '-' || c == '_' || c == '[' || c == '(') {
+				charClass |= CharClass::OperandStart | CharClass::Operand;
+			}
+			if (c == ']' || c == ')') {
+				charClass |= CharClass::Operand;
+			}
+			if (c == '<' || c == '>' || c == '=' || c == '!') {
+				charClass |= CharClass::Comparator;
+			}
+			if (c == ' ' || (c >= '\t' && c <= '\r')) {
+				charClass |= CharClass::Space;
+			}
+			result[c] = charClass;
+		}
+		return result;
+	}
+
+	constexpr auto CharClassTable = createCharClassTable();
+
+	inline bool isOfClass(char c, uint8_t charClass)
+	{
+		return (CharClassTable[static_cast<unsigned char>(c)] & charClass) != 0;
+	}
+
+	inline char toLowerAscii(char c)
+	{
+		return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+	}
+
+	bool equalsIgnoreCase(std::string_view const& s, std::string_view const& lowerCaseString)
+	{
+		if (s.size() != lowerCaseString.size()) {
+			return false;
+		}
+		for (std::size_t i = 0; i < s.size(); ++i) {
+			if (toLowerAscii(s[i]) != lowerCaseString[i]) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	inline void extend(std::string_view& part)
+	{
+		part = std::string_view(part.data(), part.size() + 1);
+	}
+
+	bool gotoNextStateAndReturnSuccess(CompilerState &state, std::string_view const& code, int bytePos, InstructionUncoded& instruction)
+	{
+		char const currentSymbol = code[bytePos];
 		switch (state) {
 		case CompilerState::LOOKING_FOR_INSTR_START: {
-			if (currentSymbol.isLetter()) {
+			if (isOfClass(currentSymbol, CharClass::Letter)) {
 				state = CompilerState::LOOKING_FOR_INSTR_END;
-				instruction.name = currentSymbol;
+				instruction.name = code.substr(bytePos, 1);
 			}
 		}
 		break;
 		case CompilerState::LOOKING_FOR_INSTR_END: {
-			if (!currentSymbol.isLetter()) {
-				if ((instruction.name.toLower() == "else") || (instruction.name.toLower() == "endif"))
+			if (!isOfClass(currentSymbol, CharClass::Letter)) {
+				if (equalsIgnoreCase(instruction.name, "else") || equalsIgnoreCase(instruction.name, "endif"))
 					instruction.readingFinished = true;
 				else
 					state = CompilerState::LOOKING_FOR_OP1_START;
 			}
-			else {
-				instruction.name += currentSymbol;
-				if ((bytePos + 1) == codeSize && ((instruction.name.toLower() == "else") || (instruction.name.toLower() == "endif")))
-					instruction.readingFinished = true;
-			}
+			else
+				extend(instruction.name);
 		}
 		break;
 		case CompilerState::LOOKING_FOR_OP1_START: {
-			if (isNameChar(currentSymbol) || (currentSymbol == '-') || (currentSymbol == '_') || (currentSymbol == '[') || (currentSymbol == '(')) {
+			if (isOfClass(currentSymbol, CharClass::OperandStart)) {
 				state = CompilerState::LOOKING_FOR_OP1_END;
-				instruction.operand1 = currentSymbol;
+				instruction.operand1 = code.substr(bytePos, 1);
 			}
 		}
 		break;
 		case CompilerState::LOOKING_FOR_OP1_END: {
-			if ((currentSymbol == '<') || (currentSymbol == '>') || (currentSymbol == '=') || (currentSymbol == '!')) {
+			if (isOfClass(currentSymbol, CharClass::Comparator)) {
 				state = CompilerState::LOOKING_FOR_COMPARATOR;
-				instruction.comp = currentSymbol;
+				instruction.comp = code.substr(bytePos, 1);
 			}
 			else if (currentSymbol == ',')
 				state = CompilerState::LOOKING_FOR_OP2_START;
-			else if (!isNameChar(currentSymbol) && (currentSymbol != '-') && (currentSymbol != '_') && (currentSymbol != '[') && (currentSymbol != ']') && (currentSymbol != '(') && (currentSymbol != ')'))
+			else if (!isOfClass(currentSymbol, CharClass::Operand))
 				state = CompilerState::LOOKING_FOR_SEPARATOR;
 			else
-				instruction.operand1 += currentSymbol;
+				extend(instruction.operand1);
 		}
 		break;
 		case CompilerState::LOOKING_FOR_SEPARATOR: {
 			if (currentSymbol == ',')
 				state = CompilerState::LOOKING_FOR_OP2_START;
-			else if ((currentSymbol == '<') || (currentSymbol == '>') || (currentSymbol == '=') || (currentSymbol == '!')) {
+			else if (isOfClass(currentSymbol, CharClass::Comparator)) {
 				state = CompilerState::LOOKING_FOR_COMPARATOR;
-				instruction.comp = currentSymbol;
+				instruction.comp = code.substr(bytePos, 1);
 			}
-			else if (isNameChar(currentSymbol) || (currentSymbol == '-') || (currentSymbol == '_') || (currentSymbol == '[') || (currentSymbol == ']') || (currentSymbol == '(') || (currentSymbol == ')'))
+			else if (isOfClass(currentSymbol, CharClass::Operand))
 				return false;
 		}
 		break;
 		case CompilerState::LOOKING_FOR_COMPARATOR: {
-			if ((currentSymbol == '<') || (currentSymbol == '>') || (currentSymbol == '=') || (currentSymbol == '!'))
-				instruction.comp += currentSymbol;
-			else if (!isNameChar(currentSymbol) && (currentSymbol != '-') && (currentSymbol != '_') && (currentSymbol != '[') && (currentSymbol != '('))
+			if (isOfClass(currentSymbol, CharClass::Comparator))
+				extend(instruction.comp);
+			else if (!isOfClass(currentSymbol, CharClass::OperandStart))
 				state = CompilerState::LOOKING_FOR_OP2_START;
 			else {
 				state = CompilerState::LOOKING_FOR_OP2_END;
-				instruction.operand2 = currentSymbol;
+				instruction.operand2 = code.substr(bytePos, 1);
 			}
 		}
 		break;
 		case CompilerState::LOOKING_FOR_OP2_START: {
-			if (isNameChar(currentSymbol) || (currentSymbol == '-') || (currentSymbol == '_') || (currentSymbol == '[') || (currentSymbol == '(')) {
+			if (isOfClass(currentSymbol, CharClass::OperandStart)) {
 				state = CompilerState::LOOKING_FOR_OP2_END;
-				instruction.operand2 = currentSymbol;
-				if (bytePos == (codeSize - 1))
-					instruction.readingFinished = true;
+				instruction.operand2 = code.substr(bytePos, 1);
 			}
 		}
 		break;
 		case CompilerState::LOOKING_FOR_OP2_END: {
-			if (!isNameChar(currentSymbol) && (currentSymbol != '-') && (currentSymbol != '_') && (currentSymbol != '[') && (currentSymbol != ']') && (currentSymbol != '(') && (currentSymbol != ')'))
+			if (!isOfClass(currentSymbol, CharClass::Operand))
 				instruction.readingFinished = true;
-			else {
-				instruction.operand2 += currentSymbol;
-				if ((bytePos + 1) == codeSize)
-					instruction.readingFinished = true;
-			}
+			else
+				extend(instruction.operand2);
 		}
 		break;
 		}
-		if ((currentSymbol == '\n') || ((bytePos + 1) == codeSize)) {
-			if (!instruction.name.isEmpty()) {
+		if ((currentSymbol == '\n') || ((bytePos + 1) == static_cast<int>(code.size()))) {
+			if (!instruction.name.empty()) {
 				instruction.readingFinished = true;
 			}
 		}
 		return true;
 	}
 
-	QString applyTableToCode(SymbolTable const* symbols, QString s)
+	struct OperationEntry {
+		std::string_view name;
+		Enums::ComputerOperation::Type operation;
+		bool conditional;
+	};
+
+	//perfect hash over length and first two characters of the lower case mnemonics
+	constexpr int calcOperationHash(std::size_t length, char c0, char c1)
+	{
+		return static_cast<int>((length + 13 * static_cast<unsigned char>(c0) + 7 * static_cast<unsigned char>(c1)) & 15);
+	}
+
+	constexpr std::array<OperationEntry, 16> createOperationTable()
 	{
-		QString prefix;
-		QString postfix;
-		for (int i = 0; i < 2; ++i) {
-			if (s.left(1) == "[" || s.left(1) == "(") {
-				prefix = prefix + s.left(1);
-				s = s.mid(1);
-			}
+		OperationEntry const entries[] = {
+			{ "mov", Enums::ComputerOperation::MOV, false },
+			{ "add", Enums::ComputerOperation::ADD, false },
+			{ "sub", Enums::ComputerOperation::SUB, false },
+			{ "mul", Enums::ComputerOperation::MUL, false },
+			{ "div", Enums::ComputerOperation::DIV, false },
+			{ "xor", Enums::ComputerOperation::XOR, false },
+			{ "or", Enums::ComputerOperation::OR, false },
+			{ "and", Enums::ComputerOperation::AND, false },
+			{ "if", Enums::ComputerOperation::IFG, true },
+			{ "else", Enums::ComputerOperation::ELSE, false },
+			{ "endif", Enums::ComputerOperation::ENDIF, false }
+		};
+		std::array<OperationEntry, 16> result{};
+		for (auto const& entry : entries) {
+			result[calcOperationHash(entry.name.size(), entry.name[0], entry.name[1])] = entry;
 		}
-		for (int i = 0; i < 2; ++i) {
-			if (s.right(1) == "]" || s.right(1) == ")") {
-				postfix = s.right(1) + postfix;
-				s.chop(1);
-			}
-		}
-		s = QString::fromStdString(symbols->getValue(s.toStdString()));
-		return prefix + s + postfix;
+		return result;
 	}
 
-	bool resolveInstructionAndReturnSuccess(SymbolTable const* symbols, InstructionCoded& instructionCoded, InstructionUncoded instructionUncoded)
+	constexpr auto OperationTable = createOperationTable();
+
+	OperationEntry const* findOperation(std::string_view const& name)
 	{
-		instructionUncoded.operand1 = applyTableToCode(symbols, instructionUncoded.operand1);
-		instructionUncoded.operand2 = applyTableToCode(symbols, instructionUncoded.operand2);
-
-		//prepare data for instruction coding
-		if (instructionUncoded.name.toLower() == "mov")
-			instructionCoded.operation = Enums::ComputerOperation::MOV;
-		else if (instructionUncoded.name.toLower() == "add")
-			instructionCoded.operation = Enums::ComputerOperation::ADD;
-		else if (instructionUncoded.name.toLower() == "sub")
-			instructionCoded.operation = Enums::ComputerOperation::SUB;
-		else if (instructionUncoded.name.toLower() == "mul")
-			instructionCoded.operation = Enums::ComputerOperation::MUL;
-		else if (instructionUncoded.name.toLower() == "div")
-			instructionCoded.operation = Enums::ComputerOperation::DIV;
-		else if (instructionUncoded.name.toLower() == "xor")
-			instructionCoded.operation = Enums::ComputerOperation::XOR;
-		else if (instructionUncoded.name.toLower() == "or")
-			instructionCoded.operation = Enums::ComputerOperation::OR;
-		else if (instructionUncoded.name.toLower() == "and")
-			instructionCoded.operation = Enums::ComputerOperation::AND;
-		else if (instructionUncoded.name.toLower() == "if") {
-			if (instructionUncoded.comp.toLower() == ">")
-				instructionCoded.operation = Enums::ComputerOperation::IFG;
-			else if ((instructionUncoded.comp.toLower() == ">=") || (instructionUncoded.comp.toLower() == "=>"))
-				instructionCoded.operation = Enums::ComputerOperation::IFGE;
-			else if ((instructionUncoded.comp.toLower() == "=") || (instructionUncoded.comp.toLower() == "=="))
-				instructionCoded.operation = Enums::ComputerOperation::IFE;
-			else if (instructionUncoded.comp.toLower() == "!=")
-				instructionCoded.operation = Enums::ComputerOperation::IFNE;
-			else if ((instructionUncoded.comp.toLower() == "<=") || (instructionUncoded.comp.toLower() == "=<"))
-				instructionCoded.operation = Enums::ComputerOperation::IFLE;
-			else if (instructionUncoded.comp.toLower() == "<")
-				instructionCoded.operation = Enums::ComputerOperation::IFL;
-			else {
-				return false;
-			}
+		if (name.size() < 2 || name.size() > 5) {
+			return nullptr;
 		}
-		else if (instructionUncoded.name.toLower() == "else")
-			instructionCoded.operation = Enums::ComputerOperation::ELSE;
-		else if (instructionUncoded.name.toLower() == "endif")
-			instructionCoded.operation = Enums::ComputerOperation::ENDIF;
-		else {
+		auto const& entry = OperationTable[calcOperationHash(name.size(), toLowerAscii(name[0]), toLowerAscii(name[1]))];
+		return equalsIgnoreCase(name, entry.name) ? &entry : nullptr;
+	}
+
+	bool resolveComparatorAndReturnSuccess(std::string_view const& comp, Enums::ComputerOperation::Type& operation)
+	{
+		if (comp == ">")
+			operation = Enums::ComputerOperation::IFG;
+		else if (comp == ">=" || comp == "=>")
+			operation = Enums::ComputerOperation::IFGE;
+		else if (comp == "=" || comp == "==")
+			operation = Enums::ComputerOperation::IFE;
+		else if (comp == "!=")
+			operation = Enums::ComputerOperation::IFNE;
+		else if (comp == "<=" || comp == "=<")
+			operation = Enums::ComputerOperation::IFLE;
+		else if (comp == "<")
+			operation = Enums::ComputerOperation::IFL;
+		else
 			return false;
+		return true;
+	}
+
+	//looks up symbols without allocating per operand, the entry views stay valid during one compilation
+	class SymbolResolver
+	{
+	public:
+		SymbolResolver(SymbolTable const* symbols)
+		{
+			auto const& entries = symbols->getEntries();
+			_entries.reserve(entries.size());
+			for (auto const& entry : entries) {
+				_entries.emplace_back(entry.first, entry.second);
+			}
 		}
 
-		if (instructionCoded.operation != Enums::ComputerOperation::ELSE && instructionCoded.operation != Enums::ComputerOperation::ENDIF) {
-			if ((instructionUncoded.operand1.left(2) == "[[") && (instructionUncoded.operand1.right(2) == "]]")) {
-				instructionCoded.opType1 = Enums::ComputerOptype::MEMMEM;
-				instructionUncoded.operand1 = instructionUncoded.operand1.remove(0, 2);
-				instructionUncoded.operand1.chop(2);
+		//writes prefix brackets, looked up symbol value and postfix brackets into resolvedOperand
+		void applyTableToCode(std::string_view s, std::string& resolvedOperand)
+		{
+			std::size_t prefixLength = 0;
+			while (prefixLength < 2 && prefixLength < s.size() && (s[prefixLength] == '[' || s[prefixLength] == '(')) {
+				++prefixLength;
 			}
-			else if ((instructionUncoded.operand1.left(1) == "[") && (instructionUncoded.operand1.right(1) == "]")) {
-				instructionCoded.opType1 = Enums::ComputerOptype::MEM;
-				instructionUncoded.operand1 = instructionUncoded.operand1.remove(0, 1);
-				instructionUncoded.operand1.chop(1);
+			std::size_t postfixLength = 0;
+			while (postfixLength < 2 && prefixLength + postfixLength < s.size()
+				&& (s[s.size() - postfixLength - 1] == ']' || s[s.size() - postfixLength - 1] == ')')) {
+				++postfixLength;
 			}
-			else if ((instructionUncoded.operand1.left(1) == "(") && (instructionUncoded.operand1.right(1) == ")")) {
-				instructionCoded.opType1 = Enums::ComputerOptype::CMEM;
-				instructionUncoded.operand1 = instructionUncoded.operand1.remove(0, 1);
-				instructionUncoded.operand1.chop(1);
+			resolvedOperand.assign(s.data(), prefixLength);
+			resolvedOperand.append(getValue(s.substr(prefixLength, s.size() - prefixLength - postfixLength)));
+			resolvedOperand.append(s.data() + s.size() - postfixLength, postfixLength);
+		}
+
+	private:
+		std::string_view getValue(std::string_view key)
+		{
+			//symbol keys are UTF-8 encoded whereas source bytes are read as Latin-1
+			for (char c : key) {
+				if (static_cast<unsigned char>(c) >= 0x80) {
+					_utf8Key.clear();
+					for (char latin1Char : key) {
+						auto const u = static_cast<unsigned char>(latin1Char);
+						if (u < 0x80) {
+							_utf8Key.push_back(latin1Char);
+						}
+						else {
+							_utf8Key.push_back(static_cast<char>(0xc0 | (u >> 6)));
+							_utf8Key.push_back(static_cast<char>(0x80 | (u & 0x3f)));
+						}
+					}
+					key = _utf8Key;
+					break;
+				}
 			}
-			else {
-				return false;
+			auto findResult = std::lower_bound(
+				_entries.begin(), _entries.end(), key, [](auto const& entry, std::string_view const& value) {
+				return entry.first < value;
+			});
+			if (findResult != _entries.end() && findResult->first == key) {
+				return findResult->second;
 			}
+			return key;
+		}
 
-			if ((instructionUncoded.operand2.left(2) == "[[") && (instructionUncoded.operand2.right(2) == "]]")) {
-				instructionCoded.opType2 = Enums::ComputerOptype::MEMMEM;
-				instructionUncoded.operand2 = instructionUncoded.operand2.remove(0, 2);
-				instructionUncoded.operand2.chop(2);
-			}
-			else if ((instructionUncoded.operand2.left(1) == "[") && (instructionUncoded.operand2.right(1) == "]")) {
-				instructionCoded.opType2 = Enums::ComputerOptype::MEM;
-				instructionUncoded.operand2 = instructionUncoded.operand2.remove(0, 1);
-				instructionUncoded.operand2.chop(1);
+		vector<pair<std::string_view, std::string_view>> _entries;
+		std::string _utf8Key;
+	};
+
+	inline bool startsWith(std::string_view const& s, std::string_view const& prefix)
+	{
+		return s.size() >= prefix.size() && s.compare(0, prefix.size(), prefix) == 0;
+	}
+
+	inline bool endsWith(std::string_view const& s, std::string_view const& postfix)
+	{
+		return s.size() >= postfix.size() && s.compare(s.size() - postfix.size(), postfix.size(), postfix) == 0;
+	}
+
+	inline int digitValue(char c)
+	{
+		if (c >= '0' && c <= '9')
+			return c - '0';
+		if (c >= 'a' && c <= 'z')
+			return c - 'a' + 10;
+		if (c >= 'A' && c <= 'Z')
+			return c - 'A' + 10;
+		return INT_MAX;
+	}
+
+	//same accepted syntax as QString::toInt: surrounding spaces, sign and in base 16 an optional "0x"
+	bool convertToIntegerAndReturnSuccess(std::string_view s, int base, uint8_t& result)
+	{
+		while (!s.empty() && isOfClass(s.front(), CharClass::Space)) {
+			s.remove_prefix(1);
+		}
+		while (!s.empty() && isOfClass(s.back(), CharClass::Space)) {
+			s.remove_suffix(1);
+		}
+		bool negative = false;
+		if (!s.empty() && (s.front() == '+' || s.front() == '-')) {
+			negative = s.front() == '-';
+			s.remove_prefix(1);
+		}
+		if (base == 16 && s.size() >= 2 && s[0] == '0' && (s[1] == 'x' || s[1] == 'X')) {
+			s.remove_prefix(2);
+		}
+		if (s.empty()) {
+			return false;
+		}
+		long long value = 0;
+		for (char c : s) {
+			auto const digit = digitValue(c);
+			if (digit >= base) {
+				return false;
 			}
-			else if ((instructionUncoded.operand2.left(1) == "(") && (instructionUncoded.operand2.right(1) == ")")) {
-				instructionCoded.opType2 = Enums::ComputerOptype::CMEM;
-				instructionUncoded.operand2 = instructionUncoded.operand2.remove(0, 1);
-				instructionUncoded.operand2.chop(1);
+			value = value * base + digit;
+			if (value > -static_cast<long long>(INT_MIN)) {
+				return false;
 			}
-			else
-				instructionCoded.opType2 = Enums::ComputerOptype::CONSTANT;
+		}
+		if (negative) {
+			value = -value;
+		}
+		if (value > INT_MAX) {
+			return false;
+		}
+		result = static_cast<uint8_t>(value);
+		return true;
+	}
 
+	bool resolveOperandAndReturnSuccess(std::string_view operand, Enums::ComputerOptype::Type& opType, uint8_t& result, bool constantAllowed)
+	{
+		if (startsWith(operand, "[[") && endsWith(operand, "]]")) {
+			opType = Enums::ComputerOptype::MEMMEM;
+			operand = operand.substr(2, operand.size() - 4);
+		}
+		else if (startsWith(operand, "[") && endsWith(operand, "]")) {
+			opType = Enums::ComputerOptype::MEM;
+			operand = operand.substr(1, operand.size() - 2);
+		}
+		else if (startsWith(operand, "(") && endsWith(operand, ")")) {
+			opType = Enums::ComputerOptype::CMEM;
+			operand = operand.substr(1, operand.size() - 2);
+		}
+		else if (constantAllowed)
+			opType = Enums::ComputerOptype::CONSTANT;
+		else
+			return false;
 
-			if (instructionUncoded.operand1.left(2) == "0x") {
-				bool ok(true);
-				instructionCoded.operand1 = instructionUncoded.operand1.remove(0, 2).toInt(&ok, 16);
-				if (!ok) {
-					return false;
-				}
-			}
-			else {
-				bool ok(true);
-				instructionCoded.operand1 = instructionUncoded.operand1.toInt(&ok, 10);
-				if (!ok)
-					return false;
+		if (startsWith(operand, "0x")) {
+			return convertToIntegerAndReturnSuccess(operand.substr(2), 16, result);
+		}
+		return convertToIntegerAndReturnSuccess(operand, 10, result);
+	}
+
+	bool resolveInstructionAndReturnSuccess(
+		SymbolResolver& resolver,
+		std::string& resolvedOperand,
+		InstructionCoded& instructionCoded,
+		InstructionUncoded const& instructionUncoded)
+	{
+		auto const operationEntry = findOperation(instructionUncoded.name);
+		if (!operationEntry) {
+			return false;
+		}
+		if (operationEntry->conditional) {
+			if (!resolveComparatorAndReturnSuccess(instructionUncoded.comp, instructionCoded.operation)) {
+				return false;
 			}
-			if (instructionUncoded.operand2.left(2) == "0x") {
-				bool ok(true);
-				instructionCoded.operand2 = instructionUncoded.operand2.remove(0, 2).toInt(&ok, 16);
-				if (!ok) {
-					return false;
-				}
+		}
+		else
+			instructionCoded.operation = operationEntry->operation;
+
+		if (instructionCoded.operation != Enums::ComputerOperation::ELSE && instructionCoded.operation != Enums::ComputerOperation::ENDIF) {
+			resolver.applyTableToCode(instructionUncoded.operand1, resolvedOperand);
+			if (!resolveOperandAndReturnSuccess(resolvedOperand, instructionCoded.opType1, instructionCoded.operand1, false)) {
+				return false;
 			}
-			else {
-				bool ok(true);
-				instructionCoded.operand2 = instructionUncoded.operand2.toInt(&ok, 10);
-				if (!ok) {
-					return false;
-				}
+			resolver.applyTableToCode(instructionUncoded.operand2, resolvedOperand);
+			if (!resolveOperandAndReturnSuccess(resolvedOperand, instructionCoded.opType2, instructionCoded.operand2, true)) {
+				return false;
 			}
 		}
 		else {
@@ -263,12 +450,46 @@ namespace
 		}
 		return true;
 	}
+
+	void writeAddress(std::string& text, uint8_t address)
+	{
+		static char const HexDigits[] = "0123456789abcdef";
+		text += "0x";
+		if (address >= 16) {
+			text += HexDigits[address >> 4];
+		}
+		text += HexDigits[address & 0xf];
+	}
+
+	void writeOperand(std::string& text, Enums::ComputerOptype::Type opType, uint8_t operand, SimulationParameters const& parameters)
+	{
+		switch (opType) {
+		case Enums::ComputerOptype::MEM:
+			text += '[';
+			writeAddress(text, CompilerHelper::convertToAddress(operand, parameters.tokenMemorySize));
+			text += ']';
+			break;
+		case Enums::ComputerOptype::MEMMEM:
+			text += "[[";
+			writeAddress(text, CompilerHelper::convertToAddress(operand, parameters.tokenMemorySize));
+			text += "]]";
+			break;
+		case Enums::ComputerOptype::CMEM:
+			text += '(';
+			writeAddress(text, CompilerHelper::convertToAddress(operand, parameters.cellFunctionComputerCellMemorySize));
+			text += ')';
+			break;
+		case Enums::ComputerOptype::CONSTANT:
+			writeAddress(text, CompilerHelper::convertToAddress(operand, parameters.tokenMemorySize));
+			break;
+		}
+	}
 }
 
 
 CellComputerCompilerImpl::CellComputerCompilerImpl(QObject * parent) : CellComputerCompiler(parent)
 {
-	
+
 }
 
 void CellComputerCompilerImpl::init(SymbolTable const* symbols, SimulationParameters const& parameters)
@@ -282,20 +503,21 @@ CompilationResult CellComputerCompilerImpl::compileSourceCode(std::string const
 	CompilerState state = CompilerState::LOOKING_FOR_INSTR_START;
 
 	CompilationResult result;
+	SymbolResolver resolver(_symbols);
+	std::string resolvedOperand;
+	std::string_view const source(code);
 	int linePos = 0;
 	InstructionUncoded instructionUncoded;
-	InstructionCoded instructionCoded;
-	for (int bytePos = 0; bytePos < code.length(); ++bytePos) {
-		QChar currentSymbol = code[bytePos];
-
-		if (!gotoNextStateAndReturnSuccess(state, currentSymbol, instructionUncoded, bytePos, code.length())) {
+	InstructionCoded instructionCoded{};
+	for (int bytePos = 0; bytePos < source.size(); ++bytePos) {
+		if (!gotoNextStateAndReturnSuccess(state, source, bytePos, instructionUncoded)) {
 			result.compilationOk = false;
 			result.lineOfFirstError = linePos;
 			return result;
 		}
 		if (instructionUncoded.readingFinished) {
 			linePos++;
-			if (!resolveInstructionAndReturnSuccess(_symbols, instructionCoded, instructionUncoded)) {
+			if (!resolveInstructionAndReturnSuccess(resolver, resolvedOperand, instructionCoded, instructionUncoded)) {
 				result.compilationOk = false;
 				result.lineOfFirstError = linePos;
 				return result;
@@ -316,10 +538,15 @@ CompilationResult CellComputerCompilerImpl::compileSourceCode(std::string const
 
 std::string CellComputerCompilerImpl::decompileSourceCode(QByteArray const & data) const
 {
-	QString text;
-	QString textOp1, textOp2;
+	static std::string_view const OperationNames[] = {
+		"mov", "add", "sub", "mul", "div", "xor", "or", "and", "if", "if", "if", "if", "if", "if", "else", "endif"};
+	static std::string_view const Separators[] = {
+		", ", ", ", ", ", ", ", ", ", ", ", ", ", ", ", " > ", " >= ", " = ", " != ", " <= ", " < "};
+
+	std::string text;
 	int conditionLevel = 0;
-    auto const dataSize = (data.size() / 3) * 3;
+	auto const dataSize = (data.size() / 3) * 3;
+	text.reserve(dataSize * 8);
 	for (int instructionPointer = 0; instructionPointer < dataSize; ) {
 
 		//decode instruction data
@@ -327,77 +554,41 @@ std::string CellComputerCompilerImpl::decompileSourceCode(QByteArray const & dat
 		CompilerHelper::readInstruction(data, instructionPointer, instruction);
 
 		//write spacing
-		for (int j = 0; j < conditionLevel; ++j)
-			text += "  ";
+		text.append(2 * conditionLevel, ' ');
 
 		//write operation
-		if (instruction.operation == Enums::ComputerOperation::MOV)
-			text += "mov";
-		if (instruction.operation == Enums::ComputerOperation::ADD)
-			text += "add";
-		if (instruction.operation == Enums::ComputerOperation::SUB)
-			text += "sub";
-		if (instruction.operation == Enums::ComputerOperation::MUL)
-			text += "mul";
-		if (instruction.operation == Enums::ComputerOperation::DIV)
-			text += "div";
-		if (instruction.operation == Enums::ComputerOperation::XOR)
-			text += "xor";
-		if (instruction.operation == Enums::ComputerOperation::OR)
-			text += "or";
-		if (instruction.operation == Enums::ComputerOperation::AND)
-			text += "and";
-		if ((instruction.operation >= Enums::ComputerOperation::IFG) && (instruction.operation <= Enums::ComputerOperation::IFL)) {
-			text += "if";
-			++conditionLevel;
-		}
-		if (instruction.operation == Enums::ComputerOperation::ELSE) {
-			if (conditionLevel > 0)
-				text.chop(2);
-			text += "else";
-		}
-		if (instruction.operation == Enums::ComputerOperation::ENDIF) {
+		if (instruction.operation == Enums::ComputerOperation::ELSE || instruction.operation == Enums::ComputerOperation::ENDIF) {
 			if (conditionLevel > 0) {
-				text.chop(2);
-				--conditionLevel;
+				text.resize(text.size() - 2);
+				if (instruction.operation == Enums::ComputerOperation::ENDIF) {
+					--conditionLevel;
+				}
+			}
+		}
+		text += OperationNames[instruction.operation];
+
+		//write operands with separation/comparator
+		if (instruction.operation <= Enums::ComputerOperation::IFL) {
+			if (instruction.operation >= Enums::ComputerOperation::IFG) {
+				++conditionLevel;
 			}
-			text += "endif";
-		}
-
-		//write operands
-		if (instruction.opType1 == Enums::ComputerOptype::MEM)
-			textOp1 = "[" + QString("0x%1").arg(CompilerHelper::convertToAddress(instruction.operand1, _parameters.tokenMemorySize), 0, 16) + "]";
-		if (instruction.opType1 == Enums::ComputerOptype::MEMMEM)
-			textOp1 = "[[" + QString("0x%1").arg(CompilerHelper::convertToAddress(instruction.operand1, _parameters.tokenMemorySize), 0, 16) + "]]";
-		if (instruction.opType1 == Enums::ComputerOptype::CMEM)
-			textOp1 = "(" + QString("0x%1").arg(CompilerHelper::convertToAddress(instruction.operand1, _parameters.cellFunctionComputerCellMemorySize), 0, 16) + ")";
-		if (instruction.opType2 == Enums::ComputerOptype::MEM)
-			textOp2 = "[" + QString("0x%1").arg(CompilerHelper::convertToAddress(instruction.operand2, _parameters.tokenMemorySize), 0, 16) + "]";
-		if (instruction.opType2 == Enums::ComputerOptype::MEMMEM)
-			textOp2 = "[[" + QString("0x%1").arg(CompilerHelper::convertToAddress(instruction.operand2, _parameters.tokenMemorySize), 0, 16) + "]]";
-		if (instruction.opType2 == Enums::ComputerOptype::CMEM)
-			textOp2 = "(" + QString("0x%1").arg(CompilerHelper::convertToAddress(instruction.operand2, _parameters.cellFunctionComputerCellMemorySize), 0, 16) + ")";
-		if (instruction.opType2 == Enums::ComputerOptype::CONSTANT)
-			textOp2 = QString("0x%1").arg(CompilerHelper::convertToAddress(instruction.operand2, _parameters.tokenMemorySize), 0, 16);
-
-		//write separation/comparator
-		if (instruction.operation <= Enums::ComputerOperation::AND) {
-			text += " " + textOp1 + ", " + textOp2;
-		}
-		if (instruction.operation == Enums::ComputerOperation::IFG)
-			text += " " + textOp1 + " > " + textOp2;
-		if (instruction.operation == Enums::ComputerOperation::IFGE)
-			text += " " + textOp1 + " >= " + textOp2;
-		if (instruction.operation == Enums::ComputerOperation::IFE)
-			text += " " + textOp1 + " = " + textOp2;
-		if (instruction.operation == Enums::ComputerOperation::IFNE)
-			text += " " + textOp1 + " != " + textOp2;
-		if (instruction.operation == Enums::ComputerOperation::IFLE)
-			text += " " + textOp1 + " <= " + textOp2;
-		if (instruction.operation == Enums::ComputerOperation::IFL)
-			text += " " + textOp1 + " < " + textOp2;
+			text += ' ';
+			writeOperand(text, instruction.opType1, instruction.operand1, _parameters);
+			text += Separators[instruction.operation];
+			writeOperand(text, instruction.opType2, instruction.operand2, _parameters);
+		}
 		if (instructionPointer < dataSize)
-			text += "\n";
+			text += '\n';
 	}
-	return text.toStdString();
+	return text;
+}
+
+QByteArray CellComputerCompilerImpl::optimizeCompilation(QByteArray const& data) const
+{
+	return CellComputerOptimizer(_parameters).optimize(data);
+}
+
+bool CellComputerCompilerImpl::checkEquivalence(QByteArray const& data1, QByteArray const& data2) const
+{
+	return CellComputerOptimizer(_parameters).checkEquivalence(data1, data2);
 }
@@ -16,6 +16,9 @@ public:
 	virtual CompilationResult compileSourceCode(std::string const& code) const override;
 	virtual std::string decompileSourceCode(QByteArray const& data) const override;
 
+	virtual QByteArray optimizeCompilation(QByteArray const& data) const override;
+	virtual bool checkEquivalence(QByteArray const& data1, QByteArray const& data2) const override;
+
 private:
 	SymbolTable const* _symbols = nullptr;
 	SimulationParameters _parameters;
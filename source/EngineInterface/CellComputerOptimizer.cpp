@@ -0,0 +1,538 @@
+﻿#include <algorithm>
+#include <climits>
+#include <random>
+
+#include "CellComputerVirtualMachine.h"
+#include "CompilerHelper.h"
+#include "CellComputerOptimizer.h"
+
+namespace
+{
+	using Program = vector<InstructionCoded>;
+
+	int const Unknown = -1;
+
+	bool isCondition(Enums::ComputerOperation::Type operation)
+	{
+		return operation >= Enums::ComputerOperation::IFG && operation <= Enums::ComputerOperation::IFL;
+	}
+
+	Enums::ComputerOperation::Type negateCondition(Enums::ComputerOperation::Type operation)
+	{
+		switch (operation) {
+		case Enums::ComputerOperation::IFG:
+			return Enums::ComputerOperation::IFLE;
+		case Enums::ComputerOperation::IFGE:
+			return Enums::ComputerOperation::IFL;
+		case Enums::ComputerOperation::IFE:
+			return Enums::ComputerOperation::IFNE;
+		case Enums::ComputerOperation::IFNE:
+			return Enums::ComputerOperation::IFE;
+		case Enums::ComputerOperation::IFLE:
+			return Enums::ComputerOperation::IFG;
+		case Enums::ComputerOperation::IFL:
+			return Enums::ComputerOperation::IFGE;
+		default:
+			return operation;
+		}
+	}
+
+	//same arithmetic as in CellComputerFunction, values are bytes in the range [0, 255]
+	int calcArithmetic(Enums::ComputerOperation::Type operation, int memoryValue, int operand)
+	{
+		auto const memory = static_cast<int8_t>(memoryValue);
+		auto const value = static_cast<uint8_t>(operand);
+		int result = 0;
+		switch (operation) {
+		case Enums::ComputerOperation::MOV:
+			result = value;
+			break;
+		case Enums::ComputerOperation::ADD:
+			result = memory + value;
+			break;
+		case Enums::ComputerOperation::SUB:
+			result = memory - value;
+			break;
+		case Enums::ComputerOperation::MUL:
+			result = memory * value;
+			break;
+		case Enums::ComputerOperation::DIV:
+			result = value > 0 ? memory / value : 0;
+			break;
+		case Enums::ComputerOperation::XOR:
+			result = memory ^ value;
+			break;
+		case Enums::ComputerOperation::OR:
+			result = memory | value;
+			break;
+		case Enums::ComputerOperation::AND:
+			result = memory & value;
+			break;
+		default:
+			break;
+		}
+		return static_cast<uint8_t>(result);
+	}
+
+	//comparisons are unsigned as in CellComputerFunction
+	bool calcCondition(Enums::ComputerOperation::Type operation, int memoryValue, int operand)
+	{
+		switch (operation) {
+		case Enums::ComputerOperation::IFG:
+			return memoryValue > operand;
+		case Enums::ComputerOperation::IFGE:
+			return memoryValue >= operand;
+		case Enums::ComputerOperation::IFE:
+			return memoryValue == operand;
+		case Enums::ComputerOperation::IFNE:
+			return memoryValue != operand;
+		case Enums::ComputerOperation::IFLE:
+			return memoryValue <= operand;
+		case Enums::ComputerOperation::IFL:
+			return memoryValue < operand;
+		default:
+			return false;
+		}
+	}
+
+	//result of arithmetic operations which do not depend on the memory value
+	int calcAbsorbingResult(Enums::ComputerOperation::Type operation, int operand)
+	{
+		if ((operation == Enums::ComputerOperation::MUL || operation == Enums::ComputerOperation::DIV
+			|| operation == Enums::ComputerOperation::AND) && operand == 0) {
+			return 0;
+		}
+		if (operation == Enums::ComputerOperation::OR && operand == 0xff) {
+			return 0xff;
+		}
+		return Unknown;
+	}
+
+	bool isNeutralOperand(Enums::ComputerOperation::Type operation, int operand)
+	{
+		switch (operation) {
+		case Enums::ComputerOperation::ADD:
+		case Enums::ComputerOperation::SUB:
+		case Enums::ComputerOperation::XOR:
+		case Enums::ComputerOperation::OR:
+			return operand == 0;
+		case Enums::ComputerOperation::MUL:
+		case Enums::ComputerOperation::DIV:
+			return operand == 1;
+		case Enums::ComputerOperation::AND:
+			return operand == 0xff;
+		default:
+			return false;
+		}
+	}
+
+	//condition pointer before each instruction, it does not depend on memory contents
+	vector<int> calcCondPointers(Program const& program)
+	{
+		vector<int> result;
+		result.reserve(program.size());
+		int condPointer = 0;
+		for (auto const& instruction : program) {
+			result.emplace_back(condPointer);
+			if (isCondition(instruction.operation)) {
+				++condPointer;
+			}
+			else if (instruction.operation == Enums::ComputerOperation::ENDIF && condPointer > 0) {
+				--condPointer;
+			}
+		}
+		return result;
+	}
+
+	//replaces a condition with statically known result by the instructions of its active branches
+	void foldCondition(Program& program, vector<int> const& condPointers, int index, bool value)
+	{
+		auto const condPointer = condPointers[index] + 1;
+		Program result(program.begin(), program.begin() + index);
+		int i = index + 1;
+		for (; i < program.size(); ++i) {
+			auto const& instruction = program[i];
+			if (condPointers[i] == condPointer) {
+				if (instruction.operation == Enums::ComputerOperation::ELSE) {
+					value = !value;
+					continue;
+				}
+				if (instruction.operation == Enums::ComputerOperation::ENDIF) {
+					++i;
+					break;
+				}
+			}
+			if (value) {
+				result.emplace_back(instruction);
+			}
+		}
+		result.insert(result.end(), program.begin() + i, program.end());
+		program = result;
+	}
+
+	struct Location
+	{
+		bool known = false;
+		bool cell = false;
+		int address = 0;
+
+		bool operator==(Location const& other) const
+		{
+			return known && other.known && cell == other.cell && address == other.address;
+		}
+	};
+
+	class Passes
+	{
+	public:
+		Passes(SimulationParameters const& parameters)
+			: _tokenMemorySize(parameters.tokenMemorySize)
+			, _cellMemorySize(parameters.cellFunctionComputerCellMemorySize)
+		{}
+
+		//each pass returns true if the program has been changed
+		bool propagateConstants(Program& program) const;
+		bool removeNoOps(Program& program) const;
+		bool removeEmptyConditions(Program& program) const;
+		bool removeDeadStores(Program& program) const;
+
+	private:
+		int toTokenAddress(uint8_t operand) const { return CompilerHelper::convertToAddress(operand, _tokenMemorySize); }
+		int toCellAddress(uint8_t operand) const { return CompilerHelper::convertToAddress(operand, _cellMemorySize); }
+
+		Location getTargetLocation(InstructionCoded const& instruction) const;
+		Location getOperand2Location(InstructionCoded const& instruction) const;
+		bool mayRead(InstructionCoded const& instruction, Location const& location) const;
+
+		int _tokenMemorySize = 0;
+		int _cellMemorySize = 0;
+	};
+
+	Location Passes::getTargetLocation(InstructionCoded const& instruction) const
+	{
+		if (instruction.opType1 == Enums::ComputerOptype::MEM) {
+			return {true, false, toTokenAddress(instruction.operand1)};
+		}
+		if (instruction.opType1 == Enums::ComputerOptype::CMEM) {
+			return {true, true, toCellAddress(instruction.operand1)};
+		}
+		return {};
+	}
+
+	Location Passes::getOperand2Location(InstructionCoded const& instruction) const
+	{
+		if (instruction.opType2 == Enums::ComputerOptype::MEM) {
+			return {true, false, toTokenAddress(instruction.operand2)};
+		}
+		if (instruction.opType2 == Enums::ComputerOptype::CMEM) {
+			return {true, true, toCellAddress(instruction.operand2)};
+		}
+		return {};
+	}
+
+	bool Passes::mayRead(InstructionCoded const& instruction, Location const& location) const
+	{
+		if (instruction.operation == Enums::ComputerOperation::ELSE
+			|| instruction.operation == Enums::ComputerOperation::ENDIF) {
+			return false;
+		}
+		auto const isTokenLocation = !location.cell;
+		if (instruction.opType1 == Enums::ComputerOptype::MEMMEM && isTokenLocation
+			&& toTokenAddress(instruction.operand1) == location.address) {
+			return true;
+		}
+		if (instruction.opType2 == Enums::ComputerOptype::MEMMEM && isTokenLocation) {
+			return true;
+		}
+		if (getOperand2Location(instruction) == location) {
+			return true;
+		}
+		if (instruction.operation != Enums::ComputerOperation::MOV) {
+			auto const target = getTargetLocation(instruction);
+			return target == location || (!target.known && isTokenLocation);
+		}
+		return false;
+	}
+
+	bool Passes::propagateConstants(Program& program) const
+	{
+		//values which are equal in all executions at the current instruction
+		vector<int> tokenValues(_tokenMemorySize, Unknown);
+		vector<int> cellValues(_cellMemorySize, Unknown);
+		auto getValue = [&](Location const& location) {
+			if (!location.known) {
+				return Unknown;
+			}
+			return location.cell ? cellValues[location.address] : tokenValues[location.address];
+		};
+
+		auto const condPointers = calcCondPointers(program);
+		bool changed = false;
+		for (int i = 0; i < program.size(); ++i) {
+			auto& instruction = program[i];
+			if (instruction.operation == Enums::ComputerOperation::ELSE
+				|| instruction.operation == Enums::ComputerOperation::ENDIF) {
+				continue;
+			}
+
+			//resolve operands
+			if (instruction.opType1 == Enums::ComputerOptype::MEMMEM) {
+				auto const pointer = tokenValues[toTokenAddress(instruction.operand1)];
+				if (pointer != Unknown) {
+					instruction.opType1 = Enums::ComputerOptype::MEM;
+					instruction.operand1 = pointer;
+					changed = true;
+				}
+			}
+			if (instruction.opType2 == Enums::ComputerOptype::MEMMEM) {
+				auto const pointer = tokenValues[toTokenAddress(instruction.operand2)];
+				if (pointer != Unknown) {
+					instruction.opType2 = Enums::ComputerOptype::MEM;
+					instruction.operand2 = pointer;
+					changed = true;
+				}
+			}
+			auto const operand2Value = getValue(getOperand2Location(instruction));
+			if (operand2Value != Unknown) {
+				instruction.opType2 = Enums::ComputerOptype::CONSTANT;
+				instruction.operand2 = operand2Value;
+				changed = true;
+			}
+			auto const target = getTargetLocation(instruction);
+			auto const targetValue = getValue(target);
+
+			if (isCondition(instruction.operation)) {
+				if (targetValue != Unknown && instruction.opType2 == Enums::ComputerOptype::CONSTANT) {
+					foldCondition(
+						program,
+						condPointers,
+						i,
+						calcCondition(instruction.operation, targetValue, instruction.operand2));
+					return true;
+				}
+				continue;
+			}
+
+			//fold arithmetic into constant assignments
+			if (instruction.operation != Enums::ComputerOperation::MOV
+				&& instruction.opType2 == Enums::ComputerOptype::CONSTANT) {
+				auto const result = targetValue != Unknown
+					? calcArithmetic(instruction.operation, targetValue, instruction.operand2)
+					: calcAbsorbingResult(instruction.operation, instruction.operand2);
+				if (result != Unknown) {
+					instruction.operation = Enums::ComputerOperation::MOV;
+					instruction.operand2 = result;
+					changed = true;
+				}
+			}
+			auto const result = instruction.operation == Enums::ComputerOperation::MOV
+					&& instruction.opType2 == Enums::ComputerOptype::CONSTANT
+				? static_cast<int>(instruction.operand2)
+				: Unknown;
+			if (result != Unknown && result == targetValue) {
+				program.erase(program.begin() + i);
+				return true;
+			}
+
+			//conditional stores make the target unknown unless the value does not change
+			if (!target.known) {
+				std::fill(tokenValues.begin(), tokenValues.end(), Unknown);
+			}
+			else {
+				auto& value = target.cell ? cellValues[target.address] : tokenValues[target.address];
+				value = condPointers[i] > 0 && value != result ? Unknown : result;
+			}
+		}
+		return changed;
+	}
+
+	bool Passes::removeNoOps(Program& program) const
+	{
+		auto const isNoOp = [&](InstructionCoded const& instruction) {
+			if (instruction.operation == Enums::ComputerOperation::MOV) {
+				if (instruction.opType1 != instruction.opType2) {
+					return false;
+				}
+				return instruction.opType1 == Enums::ComputerOptype::CMEM
+					? toCellAddress(instruction.operand1) == toCellAddress(instruction.operand2)
+					: toTokenAddress(instruction.operand1) == toTokenAddress(instruction.operand2);
+			}
+			return instruction.operation <= Enums::ComputerOperation::AND
+				&& instruction.opType2 == Enums::ComputerOptype::CONSTANT
+				&& isNeutralOperand(instruction.operation, instruction.operand2);
+		};
+		auto const size = program.size();
+		program.erase(std::remove_if(program.begin(), program.end(), isNoOp), program.end());
+		return program.size() != size;
+	}
+
+	bool Passes::removeEmptyConditions(Program& program) const
+	{
+		auto const condPointers = calcCondPointers(program);
+		for (int i = 0; i < program.size(); ++i) {
+			auto& instruction = program[i];
+			auto const operation = instruction.operation;
+			auto const isElse = operation == Enums::ComputerOperation::ELSE;
+			auto const isEndif = operation == Enums::ComputerOperation::ENDIF;
+
+			//else and endif without open condition have no effect
+			if ((isElse || isEndif) && condPointers[i] == 0) {
+				program.erase(program.begin() + i);
+				return true;
+			}
+
+			//the condition state is discarded at the end
+			if (i + 1 == program.size()) {
+				if (isCondition(operation) || isElse || isEndif) {
+					program.erase(program.begin() + i);
+					return true;
+				}
+				break;
+			}
+
+			auto const nextOperation = program[i + 1].operation;
+			if (isCondition(operation) && nextOperation == Enums::ComputerOperation::ENDIF) {
+				program.erase(program.begin() + i, program.begin() + i + 2);
+				return true;
+			}
+			if (isCondition(operation) && nextOperation == Enums::ComputerOperation::ELSE) {
+				instruction.operation = negateCondition(operation);
+				program.erase(program.begin() + i + 1);
+				return true;
+			}
+			if (isElse && nextOperation == Enums::ComputerOperation::ELSE) {
+				program.erase(program.begin() + i, program.begin() + i + 2);
+				return true;
+			}
+			if (isElse && nextOperation == Enums::ComputerOperation::ENDIF) {
+				program.erase(program.begin() + i);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool Passes::removeDeadStores(Program& program) const
+	{
+		auto const condPointers = calcCondPointers(program);
+		for (int i = 0; i < program.size(); ++i) {
+			auto const& instruction = program[i];
+			if (instruction.operation > Enums::ComputerOperation::AND) {
+				continue;
+			}
+			auto const target = getTargetLocation(instruction);
+			if (!target.known) {
+				continue;
+			}
+
+			//a store is dead if it is overwritten before being read by an assignment which is executed
+			//whenever the store is executed, i.e. whose conditions are a prefix of the store's conditions
+			//and are not changed in between
+			auto minCondPointer = condPointers[i];
+			auto minElseCondPointer = INT_MAX;
+			for (int j = i + 1; j < program.size(); ++j) {
+				auto const& other = program[j];
+				if (mayRead(other, target)) {
+					break;
+				}
+				minCondPointer = std::min(minCondPointer, condPointers[j]);
+				if (other.operation == Enums::ComputerOperation::MOV && getTargetLocation(other) == target
+					&& condPointers[j] == minCondPointer && condPointers[j] < minElseCondPointer) {
+					program.erase(program.begin() + i);
+					return true;
+				}
+				if (other.operation == Enums::ComputerOperation::ELSE) {
+					minElseCondPointer = std::min(minElseCondPointer, condPointers[j]);
+				}
+			}
+		}
+		return false;
+	}
+}
+
+CellComputerOptimizer::CellComputerOptimizer(SimulationParameters const& parameters)
+	: _parameters(parameters)
+{}
+
+QByteArray CellComputerOptimizer::optimize(QByteArray const& data) const
+{
+	//decode the instructions which are actually executed, missing bytes are zero
+	auto const numStaticBytes = std::min(
+		{data.size(), CellComputerVirtualMachine::MaxProgramBytes, _parameters.cellFunctionComputerMaxInstructions * 3});
+	QByteArray paddedData = data.left(numStaticBytes);
+	paddedData.append((3 - numStaticBytes % 3) % 3, 0);
+
+	Program program;
+	for (int instructionPointer = 0; instructionPointer < paddedData.size();) {
+		InstructionCoded instruction;
+		CompilerHelper::readInstruction(paddedData, instructionPointer, instruction);
+		program.emplace_back(instruction);
+	}
+
+	Passes passes(_parameters);
+	while (passes.propagateConstants(program) || passes.removeNoOps(program) || passes.removeEmptyConditions(program)
+		|| passes.removeDeadStores(program)) {
+	}
+
+	QByteArray result;
+	for (auto const& instruction : program) {
+		CompilerHelper::writeInstruction(result, instruction);
+	}
+	if (result.size() >= data.size() || !checkEquivalence(data, result)) {
+		return data;
+	}
+	return result;
+}
+
+bool CellComputerOptimizer::checkEquivalence(QByteArray const& data1, QByteArray const& data2) const
+{
+	int const NumInstances = 1024;
+	static uint8_t const BoundaryValues[] = {0, 1, 2, 0x7f, 0x80, 0x81, 0xfe, 0xff};
+
+	//small values let pointers alias and comparisons hit equality more often
+	std::mt19937 randomEngine(0);
+	auto const createMemory = [&](int size, int kind) {
+		QByteArray result(size, 0);
+		for (int i = 0; i < size; ++i) {
+			auto const value = randomEngine();
+			switch (kind) {
+			case 0:
+				result[i] = static_cast<char>(value % 4);
+				break;
+			case 1:
+				result[i] = static_cast<char>(value % 16);
+				break;
+			case 2:
+				result[i] = static_cast<char>(BoundaryValues[value % 8]);
+				break;
+			default:
+				result[i] = static_cast<char>(value);
+				break;
+			}
+		}
+		return result;
+	};
+
+	CellComputerVirtualMachine vm1(_parameters);
+	CellComputerVirtualMachine vm2(_parameters);
+	vm1.setProgram(data1);
+	vm2.setProgram(data2);
+	vm1.resize(NumInstances);
+	vm2.resize(NumInstances);
+	for (int i = 0; i < NumInstances; ++i) {
+		auto const tokenMemory = createMemory(_parameters.tokenMemorySize, i % 4);
+		auto const cellMemory = createMemory(_parameters.cellFunctionComputerCellMemorySize, (i / 4) % 4);
+		vm1.setTokenMemory(i, tokenMemory);
+		vm2.setTokenMemory(i, tokenMemory);
+		vm1.setCellMemory(i, cellMemory);
+		vm2.setCellMemory(i, cellMemory);
+	}
+	vm1.execute();
+	vm2.execute();
+	for (int i = 0; i < NumInstances; ++i) {
+		if (vm1.getTokenMemory(i) != vm2.getTokenMemory(i) || vm1.getCellMemory(i) != vm2.getCellMemory(i)) {
+			return false;
+		}
+	}
+	return true;
+}
@@ -0,0 +1,24 @@
+﻿#pragma once
+
+#include "Definitions.h"
+#include "SimulationParameters.h"
+
+/**
+ * Shortens compiled cell computer programs without changing their effect on token and cell memory.
+ * Passes: constant propagation and folding (including statically decidable conditions), removal of no-ops,
+ * empty condition blocks and dead stores. The analysis assumes the memory sizes of the given parameters.
+ */
+class CellComputerOptimizer
+{
+public:
+	CellComputerOptimizer(SimulationParameters const& parameters);
+
+	//returns the input if no shorter equivalent program has been found
+	QByteArray optimize(QByteArray const& data) const;
+
+	//randomized comparison of both programs on the host, a positive result is no proof of equivalence
+	bool checkEquivalence(QByteArray const& data1, QByteArray const& data2) const;
+
+private:
+	SimulationParameters _parameters;
+};
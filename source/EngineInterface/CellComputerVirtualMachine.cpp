@@ -0,0 +1,325 @@
+#include "CellComputerVirtualMachine.h"
+
+#include <algorithm>
+
+#include "CompilerHelper.h"
+#include "SimulationParameters.h"
+
+CellComputerVirtualMachine::CellComputerVirtualMachine(SimulationParameters const& parameters)
+    : _tokenMemorySize(parameters.tokenMemorySize)
+    , _cellMemorySize(parameters.cellFunctionComputerCellMemorySize)
+    , _maxInstructions(parameters.cellFunctionComputerMaxInstructions)
+{}
+
+void CellComputerVirtualMachine::setProgram(QByteArray const& staticData)
+{
+    //same truncation as in DataConverter and CellComputerFunction, missing bytes are zero
+    auto const numStaticBytes = std::min({staticData.size(), MaxProgramBytes, _maxInstructions * 3});
+    QByteArray data = staticData.left(numStaticBytes);
+    data.append((3 - numStaticBytes % 3) % 3, 0);
+
+    _program.clear();
+    for (int instructionPointer = 0; instructionPointer < data.size();) {
+        InstructionCoded instructionCoded;
+        CompilerHelper::readInstruction(data, instructionPointer, instructionCoded);
+
+        Instruction instruction;
+        instruction.operation = instructionCoded.operation;
+        instruction.opType1 = instructionCoded.opType1;
+        instruction.opType2 = instructionCoded.opType2;
+        instruction.address1 = instruction.opType1 == Enums::ComputerOptype::CMEM
+            ? CompilerHelper::convertToAddress(instructionCoded.operand1, _cellMemorySize)
+            : CompilerHelper::convertToAddress(instructionCoded.operand1, _tokenMemorySize);
+        instruction.address2 = instruction.opType2 == Enums::ComputerOptype::CMEM
+            ? CompilerHelper::convertToAddress(instructionCoded.operand2, _cellMemorySize)
+            : CompilerHelper::convertToAddress(instructionCoded.operand2, _tokenMemorySize);
+        instruction.operand2 = instructionCoded.operand2;
+        _program.emplace_back(instruction);
+    }
+}
+
+void CellComputerVirtualMachine::resize(int numInstances)
+{
+    _numInstances = numInstances;
+    _tokenMemory.assign(_tokenMemorySize * numInstances, 0);
+    _cellMemory.assign(_cellMemorySize * numInstances, 0);
+    _conditions.resize(numInstances);
+    _operand2.resize(numInstances);
+    _targetAddresses.resize(numInstances);
+}
+
+int CellComputerVirtualMachine::getNumInstances() const
+{
+    return _numInstances;
+}
+
+void CellComputerVirtualMachine::setTokenMemory(int instance, QByteArray const& memory)
+{
+    for (int address = 0; address < _tokenMemorySize; ++address) {
+        _tokenMemory[address * _numInstances + instance] = address < memory.size() ? memory.at(address) : 0;
+    }
+}
+
+QByteArray CellComputerVirtualMachine::getTokenMemory(int instance) const
+{
+    QByteArray result(_tokenMemorySize, 0);
+    for (int address = 0; address < _tokenMemorySize; ++address) {
+        result[address] = _tokenMemory[address * _numInstances + instance];
+    }
+    return result;
+}
+
+void CellComputerVirtualMachine::setCellMemory(int instance, QByteArray const& memory)
+{
+    for (int address = 0; address < _cellMemorySize; ++address) {
+        _cellMemory[address * _numInstances + instance] = address < memory.size() ? memory.at(address) : 0;
+    }
+}
+
+QByteArray CellComputerVirtualMachine::getCellMemory(int instance) const
+{
+    QByteArray result(_cellMemorySize, 0);
+    for (int address = 0; address < _cellMemorySize; ++address) {
+        result[address] = _cellMemory[address * _numInstances + instance];
+    }
+    return result;
+}
+
+void CellComputerVirtualMachine::execute()
+{
+    //the condition pointer only depends on the program and is therefore equal for all instances
+    std::fill(_conditions.begin(), _conditions.end(), 0);
+    int condPointer = 0;
+    for (auto const& instruction : _program) {
+        loadOperand2(instruction);
+        if (instruction.opType1 == Enums::ComputerOptype::MEMMEM) {
+            calcTargetAddresses(instruction);
+        }
+
+        if (instruction.operation <= Enums::ComputerOperation::AND) {
+            processArithmetic(instruction, (1u << condPointer) - 1);
+        }
+        else if (instruction.operation <= Enums::ComputerOperation::IFL) {
+            processCondition(instruction, condPointer);
+            ++condPointer;
+        }
+        else if (instruction.operation == Enums::ComputerOperation::ELSE) {
+            if (condPointer > 0) {
+                auto const bit = 1u << (condPointer - 1);
+                for (int i = 0; i < _numInstances; ++i) {
+                    _conditions[i] ^= bit;
+                }
+            }
+        }
+        else if (instruction.operation == Enums::ComputerOperation::ENDIF) {
+            if (condPointer > 0) {
+                --condPointer;
+            }
+        }
+    }
+}
+
+void CellComputerVirtualMachine::loadOperand2(Instruction const& instruction)
+{
+    auto const numInstances = _numInstances;
+    switch (instruction.opType2) {
+    case Enums::ComputerOptype::MEM: {
+        auto const row = getTokenMemoryRow(instruction.address2);
+        for (int i = 0; i < numInstances; ++i) {
+            _operand2[i] = row[i];
+        }
+    } break;
+    case Enums::ComputerOptype::MEMMEM: {
+        auto const row = getTokenMemoryRow(instruction.address2);
+        for (int i = 0; i < numInstances; ++i) {
+            auto const address = static_cast<uint8_t>(row[i]) % _tokenMemorySize;
+            _operand2[i] = _tokenMemory[address * numInstances + i];
+        }
+    } break;
+    case Enums::ComputerOptype::CMEM: {
+        auto const row = getCellMemoryRow(instruction.address2);
+        for (int i = 0; i < numInstances; ++i) {
+            _operand2[i] = row[i];
+        }
+    } break;
+    case Enums::ComputerOptype::CONSTANT: {
+        std::fill(_operand2.begin(), _operand2.end(), instruction.operand2);
+    } break;
+    }
+}
+
+void CellComputerVirtualMachine::calcTargetAddresses(Instruction const& instruction)
+{
+    auto const row = getTokenMemoryRow(instruction.address1);
+    for (int i = 0; i < _numInstances; ++i) {
+        _targetAddresses[i] = (static_cast<uint8_t>(row[i]) % _tokenMemorySize) * _numInstances + i;
+    }
+}
+
+namespace
+{
+    struct Mov
+    {
+        int8_t operator()(int8_t, uint8_t value) const { return static_cast<int8_t>(value); }
+    };
+    struct Add
+    {
+        int8_t operator()(int8_t memory, uint8_t value) const { return static_cast<int8_t>(memory + value); }
+    };
+    struct Sub
+    {
+        int8_t operator()(int8_t memory, uint8_t value) const { return static_cast<int8_t>(memory - value); }
+    };
+    struct Mul
+    {
+        int8_t operator()(int8_t memory, uint8_t value) const { return static_cast<int8_t>(memory * value); }
+    };
+    struct Div
+    {
+        int8_t operator()(int8_t memory, uint8_t value) const
+        {
+            return value > 0 ? static_cast<int8_t>(memory / value) : 0;
+        }
+    };
+    struct Xor
+    {
+        int8_t operator()(int8_t memory, uint8_t value) const { return static_cast<int8_t>(memory ^ value); }
+    };
+    struct Or
+    {
+        int8_t operator()(int8_t memory, uint8_t value) const { return static_cast<int8_t>(memory | value); }
+    };
+    struct And
+    {
+        int8_t operator()(int8_t memory, uint8_t value) const { return static_cast<int8_t>(memory & value); }
+    };
+
+    template <typename Operation>
+    void processOnRow(
+        int8_t* row,
+        uint8_t const* operand2,
+        uint32_t const* conditions,
+        uint32_t executeMask,
+        int numInstances)
+    {
+        Operation operation;
+        for (int i = 0; i < numInstances; ++i) {
+            auto const result = operation(row[i], operand2[i]);
+            row[i] = (conditions[i] & executeMask) == executeMask ? result : row[i];
+        }
+    }
+
+    template <typename Operation>
+    void processOnAddresses(
+        int8_t* memory,
+        int const* addresses,
+        uint8_t const* operand2,
+        uint32_t const* conditions,
+        uint32_t executeMask,
+        int numInstances)
+    {
+        Operation operation;
+        for (int i = 0; i < numInstances; ++i) {
+            if ((conditions[i] & executeMask) == executeMask) {
+                memory[addresses[i]] = operation(memory[addresses[i]], operand2[i]);
+            }
+        }
+    }
+
+    template <typename Operation>
+    void process(
+        Enums::ComputerOptype::Type opType1,
+        int8_t* memory,
+        int8_t* row,
+        int const* addresses,
+        uint8_t const* operand2,
+        uint32_t const* conditions,
+        uint32_t executeMask,
+        int numInstances)
+    {
+        if (opType1 == Enums::ComputerOptype::MEMMEM) {
+            processOnAddresses<Operation>(memory, addresses, operand2, conditions, executeMask, numInstances);
+        }
+        else {
+            processOnRow<Operation>(row, operand2, conditions, executeMask, numInstances);
+        }
+    }
+}
+
+void CellComputerVirtualMachine::processArithmetic(Instruction const& instruction, uint32_t executeMask)
+{
+    auto const row = instruction.opType1 == Enums::ComputerOptype::CMEM ? getCellMemoryRow(instruction.address1)
+                                                                         : getTokenMemoryRow(instruction.address1);
+    auto const memory = _tokenMemory.data();
+    auto const addresses = _targetAddresses.data();
+    auto const operand2 = _operand2.data();
+    auto const conditions = _conditions.data();
+    auto const opType1 = instruction.opType1;
+
+    switch (instruction.operation) {
+    case Enums::ComputerOperation::MOV:
+        process<Mov>(opType1, memory, row, addresses, operand2, conditions, executeMask, _numInstances);
+        break;
+    case Enums::ComputerOperation::ADD:
+        process<Add>(opType1, memory, row, addresses, operand2, conditions, executeMask, _numInstances);
+        break;
+    case Enums::ComputerOperation::SUB:
+        process<Sub>(opType1, memory, row, addresses, operand2, conditions, executeMask, _numInstances);
+        break;
+    case Enums::ComputerOperation::MUL:
+        process<Mul>(opType1, memory, row, addresses, operand2, conditions, executeMask, _numInstances);
+        break;
+    case Enums::ComputerOperation::DIV:
+        process<Div>(opType1, memory, row, addresses, operand2, conditions, executeMask, _numInstances);
+        break;
+    case Enums::ComputerOperation::XOR:
+        process<Xor>(opType1, memory, row, addresses, operand2, conditions, executeMask, _numInstances);
+        break;
+    case Enums::ComputerOperation::OR:
+        process<Or>(opType1, memory, row, addresses, operand2, conditions, executeMask, _numInstances);
+        break;
+    case Enums::ComputerOperation::AND:
+        process<And>(opType1, memory, row, addresses, operand2, conditions, executeMask, _numInstances);
+        break;
+    default:
+        break;
+    }
+}
+
+void CellComputerVirtualMachine::processCondition(Instruction const& instruction, int condPointer)
+{
+    auto const bit = 1u << condPointer;
+    auto const row = instruction.opType1 == Enums::ComputerOptype::CMEM ? getCellMemoryRow(instruction.address1)
+                                                                         : getTokenMemoryRow(instruction.address1);
+    for (int i = 0; i < _numInstances; ++i) {
+
+        //operands are compared as unsigned bytes as in the kernel
+        auto const operand1 = static_cast<uint8_t>(
+            instruction.opType1 == Enums::ComputerOptype::MEMMEM ? _tokenMemory[_targetAddresses[i]] : row[i]);
+        auto const operand2 = _operand2[i];
+        bool result = false;
+        switch (instruction.operation) {
+        case Enums::ComputerOperation::IFG:
+            result = operand1 > operand2;
+            break;
+        case Enums::ComputerOperation::IFGE:
+            result = operand1 >= operand2;
+            break;
+        case Enums::ComputerOperation::IFE:
+            result = operand1 == operand2;
+            break;
+        case Enums::ComputerOperation::IFNE:
+            result = operand1 != operand2;
+            break;
+        case Enums::ComputerOperation::IFLE:
+            result = operand1 <= operand2;
+            break;
+        case Enums::ComputerOperation::IFL:
+            result = operand1 < operand2;
+            break;
+        default:
+            break;
+        }
+        _conditions[i] = result ? (_conditions[i] | bit) : (_conditions[i] & ~bit);
+    }
+}
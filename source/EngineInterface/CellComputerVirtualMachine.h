@@ -0,0 +1,64 @@
+#pragma once
+
+#include "Definitions.h"
+
+/**
+ * Executes cell computer programs on the host with the same semantics as CellComputerFunction on the GPU.
+ * A batch of token/cell memory pairs runs one program in lockstep. Memories are stored as structure of arrays,
+ * i.e. all instances of one memory address are contiguous.
+ */
+class ENGINEINTERFACE_EXPORT CellComputerVirtualMachine
+{
+public:
+    //corresponds to MAX_CELL_STATIC_BYTES in the GPU kernels, longer programs are cut off when they enter a cell
+    static int const MaxProgramBytes = 48;
+
+    CellComputerVirtualMachine(SimulationParameters const& parameters);
+
+    void setProgram(QByteArray const& staticData);
+
+    //all memories are zeroed
+    void resize(int numInstances);
+    int getNumInstances() const;
+
+    void setTokenMemory(int instance, QByteArray const& memory);
+    QByteArray getTokenMemory(int instance) const;
+    void setCellMemory(int instance, QByteArray const& memory);
+    QByteArray getCellMemory(int instance) const;
+
+    //processes the program once for every instance
+    void execute();
+
+private:
+    struct Instruction
+    {
+        Enums::ComputerOperation::Type operation;
+        Enums::ComputerOptype::Type opType1;
+        Enums::ComputerOptype::Type opType2;
+        int address1;   //already reduced to the size of the addressed memory
+        int address2;
+        uint8_t operand2;
+    };
+
+    void loadOperand2(Instruction const& instruction);
+    void calcTargetAddresses(Instruction const& instruction);
+    void processArithmetic(Instruction const& instruction, uint32_t executeMask);
+    void processCondition(Instruction const& instruction, int condPointer);
+
+    int8_t* getTokenMemoryRow(int address) { return _tokenMemory.data() + address * _numInstances; }
+    int8_t* getCellMemoryRow(int address) { return _cellMemory.data() + address * _numInstances; }
+
+    int _tokenMemorySize = 0;
+    int _cellMemorySize = 0;
+    int _maxInstructions = 0;
+    vector<Instruction> _program;
+
+    int _numInstances = 0;
+    vector<int8_t> _tokenMemory;    //[address * _numInstances + instance]
+    vector<int8_t> _cellMemory;     //[address * _numInstances + instance]
+
+    //per instance working data
+    vector<uint32_t> _conditions;   //bit k corresponds to condTable[k] in the kernel
+    vector<uint8_t> _operand2;
+    vector<int> _targetAddresses;   //only used for MEMMEM targets
+};
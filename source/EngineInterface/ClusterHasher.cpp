@@ -0,0 +1,91 @@
+#include <algorithm>
+#include <unordered_map>
+
+#include "Base/Hashing.h"
+
+#include "ClusterHasher.h"
+
+namespace
+{
+    //bounds the cost for long uniform chains, the hash remains invariant but gets coarser for them
+    int const MaxRefinementIterations = 32;
+
+    uint64_t hashSorted(vector<uint64_t>& values, uint64_t seed)
+    {
+        std::sort(values.begin(), values.end());
+        for (auto const& value : values) {
+            seed = Hashing::combine(seed, value);
+        }
+        return seed;
+    }
+}
+
+uint64_t ClusterHasher::calcStructureHash(ClusterDescription const& cluster)
+{
+    if (!cluster.cells) {
+        return 0;
+    }
+    auto const& cells = *cluster.cells;
+    auto labels = calcCellLabels(cluster);
+
+    std::unordered_map<uint64_t, int> indexById;
+    for (int index = 0; index < cells.size(); ++index) {
+        indexById.emplace(cells[index].id, index);
+    }
+    vector<vector<int>> adjacentIndices(cells.size());
+    for (int index = 0; index < cells.size(); ++index) {
+        if (auto const& connectingCells = cells[index].connectingCells) {
+            for (auto const& connectingCellId : *connectingCells) {
+                auto const findResult = indexById.find(connectingCellId);
+                if (findResult != indexById.end()) {
+                    adjacentIndices[index].emplace_back(findResult->second);
+                }
+            }
+        }
+    }
+
+    //refine labels by the multisets of neighbor labels until the induced partition is stable
+    auto countDistinct = [](vector<uint64_t> values) {
+        std::sort(values.begin(), values.end());
+        return std::unique(values.begin(), values.end()) - values.begin();
+    };
+    auto numDistinctLabels = countDistinct(labels);
+    vector<uint64_t> newLabels(cells.size());
+    vector<uint64_t> adjacentLabels;
+    for (int iteration = 0; iteration < MaxRefinementIterations; ++iteration) {
+        for (int index = 0; index < cells.size(); ++index) {
+            adjacentLabels.clear();
+            for (auto const& adjacentIndex : adjacentIndices[index]) {
+                adjacentLabels.emplace_back(labels[adjacentIndex]);
+            }
+            newLabels[index] = hashSorted(adjacentLabels, labels[index]);
+        }
+        labels.swap(newLabels);
+        auto const newNumDistinctLabels = countDistinct(labels);
+        if (newNumDistinctLabels == numDistinctLabels) {
+            break;
+        }
+        numDistinctLabels = newNumDistinctLabels;
+    }
+
+    return hashSorted(labels, cells.size());
+}
+
+vector<uint64_t> ClusterHasher::calcCellLabels(ClusterDescription const& cluster)
+{
+    vector<uint64_t> result;
+    if (!cluster.cells) {
+        return result;
+    }
+    result.reserve(cluster.cells->size());
+    for (auto const& cell : *cluster.cells) {
+        auto const& constData = cell.cellFeature->constData;
+        auto label = Hashing::mix(*cell.maxConnections);
+        label = Hashing::combine(label, *cell.tokenBlocked ? 1 : 0);
+        label = Hashing::combine(label, *cell.tokenBranchNumber);
+        label = Hashing::combine(label, cell.cellFeature->getType());
+        label = Hashing::combine(label, Hashing::addFnv1a(Hashing::FnvOffset, constData.constData(), constData.size()));
+        result.emplace_back(label);
+    }
+    return result;
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "Descriptions.h"
+
+/**
+ * Structural hashes of clusters which do not depend on the order or ids of the cells.
+ */
+class ENGINEINTERFACE_EXPORT ClusterHasher
+{
+public:
+    //Weisfeiler-Lehman hash of the cell connection graph labeled by cell properties
+    static uint64_t calcStructureHash(ClusterDescription const& cluster);
+
+    //hashes of the cell properties without connection information, one entry per cell
+    static vector<uint64_t> calcCellLabels(ClusterDescription const& cluster);
+};
@@ -35,6 +35,10 @@ class SymbolTable;
 class SpaceProperties;
 class SimulationController;
 class SimulationChanger;
+class TiledPixelImage;
+class PixelImageRasterizer;
+class SoftwareRasterizer;
+class FrameRecorder;
 
 using QImagePtr = shared_ptr<QImage>;
 
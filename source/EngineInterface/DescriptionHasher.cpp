@@ -0,0 +1,136 @@
+#include <unordered_map>
+
+#include "Base/Hashing.h"
+
+#include "DescriptionHasher.h"
+
+namespace
+{
+    class Fnv1a
+    {
+    public:
+        void add(void const* data, size_t size) { _hash = Hashing::addFnv1a(_hash, data, size); }
+
+        template <typename T>
+        void add(boost::optional<T> const& value)
+        {
+            auto const isSet = static_cast<bool>(value);
+            add(&isSet, sizeof(isSet));
+            if (value) {
+                add(*value);
+            }
+        }
+
+        void add(double value) { add(&value, sizeof(value)); }
+        void add(int value) { add(&value, sizeof(value)); }
+        void add(bool value) { add(&value, sizeof(value)); }
+        void add(uint64_t value) { add(&value, sizeof(value)); }
+        void add(QVector2D const& value)
+        {
+            add(static_cast<double>(value.x()));
+            add(static_cast<double>(value.y()));
+        }
+        void add(QByteArray const& value) { add(value.constData(), value.size()); }
+
+        uint64_t get() const { return _hash; }
+
+    private:
+        uint64_t _hash = Hashing::FnvOffset;
+    };
+
+    //without bonds, they are added by calcCellHash
+    uint64_t calcCellContentHash(CellDescription const& cell)
+    {
+        Fnv1a hash;
+        hash.add(cell.pos);
+        hash.add(cell.energy);
+        hash.add(cell.maxConnections);
+        hash.add(cell.tokenBlocked);
+        hash.add(cell.tokenBranchNumber);
+        hash.add(cell.tokenUsages);
+        if (cell.cellFeature) {
+            hash.add(static_cast<int>(cell.cellFeature->getType()));
+            hash.add(cell.cellFeature->constData);
+            hash.add(cell.cellFeature->volatileData);
+        }
+        if (cell.tokens) {
+            for (auto const& token : *cell.tokens) {
+                hash.add(token.energy);
+                hash.add(token.data);
+            }
+        }
+        return hash.get();
+    }
+
+    //bonds enter by the contents of the connected cells, since ids are not hashed
+    uint64_t calcCellHash(
+        CellDescription const& cell,
+        uint64_t contentHash,
+        std::unordered_map<uint64_t, uint64_t> const& contentHashById)
+    {
+        Fnv1a hash;
+        hash.add(contentHash);
+        hash.add(static_cast<int>(cell.connectingCells ? cell.connectingCells->size() : 0));
+
+        uint64_t connectionsHash = 0;
+        if (cell.connectingCells) {
+            for (auto const& connectingCellId : *cell.connectingCells) {
+                auto const findResult = contentHashById.find(connectingCellId);
+                if (findResult != contentHashById.end()) {
+                    connectionsHash += Hashing::mix(findResult->second);
+                }
+            }
+        }
+        hash.add(connectionsHash);
+        return hash.get();
+    }
+}
+
+uint64_t DescriptionHasher::calcHash(DataDescription const& data)
+{
+    uint64_t result = 0;
+    if (data.clusters) {
+        for (auto const& cluster : *data.clusters) {
+            result += Hashing::mix(calcHash(cluster));
+        }
+    }
+    if (data.particles) {
+        for (auto const& particle : *data.particles) {
+            result += Hashing::mix(calcHash(particle));
+        }
+    }
+    return result;
+}
+
+uint64_t DescriptionHasher::calcHash(ClusterDescription const& cluster)
+{
+    Fnv1a hash;
+    hash.add(cluster.pos);
+    hash.add(cluster.vel);
+    hash.add(cluster.angle);
+    hash.add(cluster.angularVel);
+
+    uint64_t cellsHash = 0;
+    if (cluster.cells) {
+        vector<uint64_t> contentHashes;
+        std::unordered_map<uint64_t, uint64_t> contentHashById;
+        for (auto const& cell : *cluster.cells) {
+            contentHashes.emplace_back(calcCellContentHash(cell));
+            contentHashById.emplace(cell.id, contentHashes.back());
+        }
+        for (int index = 0; index < static_cast<int>(cluster.cells->size()); ++index) {
+            cellsHash += Hashing::mix(calcCellHash(cluster.cells->at(index), contentHashes.at(index), contentHashById));
+        }
+    }
+    hash.add(cellsHash);
+    return hash.get();
+}
+
+uint64_t DescriptionHasher::calcHash(ParticleDescription const& particle)
+{
+    Fnv1a hash;
+    hash.add(particle.pos);
+    hash.add(particle.vel);
+    hash.add(particle.energy);
+    return hash.get();
+}
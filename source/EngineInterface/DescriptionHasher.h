@@ -0,0 +1,17 @@
+#pragma once
+
+#include "Descriptions.h"
+
+/**
+ * Fingerprint of a world state for replay checks in the deterministic simulation mode. Entities are combined
+ * order-independently, since their order depends on the order in which GPU threads allocate them. Ids are not
+ * included, so that the same world inserted twice with ids from the host number generator has the same fingerprint;
+ * bonds enter by the contents of the connected cells instead. All floating point values enter bitwise.
+ */
+class ENGINEINTERFACE_EXPORT DescriptionHasher
+{
+public:
+    static uint64_t calcHash(DataDescription const& data);
+    static uint64_t calcHash(ClusterDescription const& cluster);
+    static uint64_t calcHash(ParticleDescription const& particle);
+};
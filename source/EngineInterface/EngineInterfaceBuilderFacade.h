@@ -13,6 +13,7 @@ public:
 	virtual DescriptionHelper* buildDescriptionHelper() const = 0;
 	virtual CellComputerCompiler* buildCellComputerCompiler(SymbolTable* symbolTable, SimulationParameters const& parameters) const = 0;
     virtual SimulationChanger* buildSimulationChanger(SimulationMonitor* monitor, NumberGenerator* numberGenerator) const = 0;
+    virtual FrameRecorder* buildFrameRecorder(SimulationAccess* access, SimulationContext* context) const = 0;
 
 	virtual SymbolTable* getDefaultSymbolTable() const = 0;
 	virtual SimulationParameters getDefaultSimulationParameters() const = 0;
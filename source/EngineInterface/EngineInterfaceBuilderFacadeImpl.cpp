@@ -3,6 +3,7 @@
 #include "CellComputerCompilerImpl.h"
 #include "DescriptionHelperImpl.h"
 #include "EngineInterfaceSettings.h"
+#include "FrameRecorderImpl.h"
 #include "SerializerImpl.h"
 #include "SimulationChangerImpl.h"
 
@@ -29,6 +30,13 @@ SimulationChanger* EngineInterfaceBuilderFacadeImpl::buildSimulationChanger(
     return result;
 }
 
+FrameRecorder* EngineInterfaceBuilderFacadeImpl::buildFrameRecorder(SimulationAccess* access, SimulationContext* context) const
+{
+    auto result = new FrameRecorderImpl();
+    result->init(access, context);
+    return result;
+}
+
 Serializer* EngineInterfaceBuilderFacadeImpl::buildSerializer() const
 {
     return new SerializerImpl();
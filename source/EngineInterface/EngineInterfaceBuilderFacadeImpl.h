@@ -11,6 +11,7 @@ public:
     DescriptionHelper* buildDescriptionHelper() const override;
 	CellComputerCompiler* buildCellComputerCompiler(SymbolTable* symbolTable, SimulationParameters const& parameters) const override;
     SimulationChanger* buildSimulationChanger(SimulationMonitor* monitor, NumberGenerator* numberGenerator) const override;
+    FrameRecorder* buildFrameRecorder(SimulationAccess* access, SimulationContext* context) const override;
 
 	SymbolTable* getDefaultSymbolTable() const override;
 	SimulationParameters getDefaultSimulationParameters() const override;
@@ -196,5 +196,9 @@ ExecutionParameters EngineInterfaceSettings::getDefaultExecutionParameters()
     ExecutionParameters result;
     result.activateFreezing = false;
     result.freezingTimesteps = 5;
+    result.deterministic = false;
+    result.spatialBinning = false;
+    result.clusterLoadBalancing = false;
+    result.regionSleeping = false;
     return result;
 }
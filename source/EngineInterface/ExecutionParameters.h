@@ -4,4 +4,16 @@ struct ExecutionParameters
 {
     bool activateFreezing = false;
     int freezingTimesteps = 5;
+
+    //reproducible results for equal random seeds at the expense of speed
+    bool deterministic = false;
+
+    //collision detection by cells sorted into buckets instead of the cell map
+    bool spatialBinning = false;
+
+    //blocks process clusters with about the same total number of cells instead of the same number of clusters
+    bool clusterLoadBalancing = false;
+
+    //map regions without activity are frozen as a unit until an entity approaches them or the user interacts
+    bool regionSleeping = false;
 };
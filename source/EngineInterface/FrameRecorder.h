@@ -0,0 +1,45 @@
+#pragma once
+
+#include <QObject>
+
+#include "Definitions.h"
+
+struct FrameRecorderSettings
+{
+    enum class Format
+    {
+        PngSequence,    //frame_<index>.png
+        Raw             //frames.raw with RGB32 pixels and frames.idx with "index timestep offset width height"
+    };
+    string directory;
+    Format format = Format::PngSequence;
+    IntRect rect;
+    IntVector2D imageSize;
+    int timestepInterval = 100;
+    int numBuffers = 8;
+    int numEncoderThreads = 2;
+};
+
+/**
+ * Records pixel images of the simulation every n-th timestep. Images are requested asynchronously and
+ * encoded in background threads. If all buffers are occupied by pending encodings the frame is dropped
+ * and the interval is increased, so that the simulation is never stalled.
+ * Frames are tagged with the simulation timestep at which they were requested.
+ * The simulation access should be dedicated to the recorder since imageReady is not request-specific.
+ */
+class ENGINEINTERFACE_EXPORT FrameRecorder : public QObject
+{
+    Q_OBJECT
+public:
+    virtual ~FrameRecorder() = default;
+
+    virtual void start(FrameRecorderSettings const& settings) = 0;
+    virtual void stop() = 0;    //waits until all recorded frames are encoded
+    virtual bool isRecording() const = 0;
+
+    Q_SLOT virtual void notifyNextTimestep() = 0;
+
+    virtual int getNumRecordedFrames() const = 0;
+    virtual int getNumDroppedFrames() const = 0;
+    virtual int getCurrentTimestepInterval() const = 0;
+};
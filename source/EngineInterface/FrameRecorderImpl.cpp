@@ -0,0 +1,207 @@
+#include "FrameRecorderImpl.h"
+
+#include <iomanip>
+#include <sstream>
+
+#include <QDir>
+#include <QImage>
+
+#include "SimulationAccess.h"
+#include "SimulationContext.h"
+
+namespace
+{
+    auto const MaxIntervalFactor = 64;
+}
+
+FrameRecorderImpl::~FrameRecorderImpl()
+{
+    stop();
+}
+
+void FrameRecorderImpl::init(SimulationAccess* access, SimulationContext* context)
+{
+    _access = access;
+    _context = context;
+    for (auto const& connection : _accessConnections) {
+        disconnect(connection);
+    }
+    _accessConnections.clear();
+    _accessConnections.emplace_back(
+        connect(_access, &SimulationAccess::imageReady, this, &FrameRecorderImpl::imageReady));
+}
+
+void FrameRecorderImpl::start(FrameRecorderSettings const& settings)
+{
+    stop();
+
+    _settings = settings;
+    _settings.timestepInterval = std::max(1, settings.timestepInterval);
+    _settings.numBuffers = std::max(1, settings.numBuffers);
+    _settings.numEncoderThreads = std::max(1, settings.numEncoderThreads);
+
+    ++_sessionId;
+    _timestepsSinceLastFrame = 0;
+    _timestepInterval = _settings.timestepInterval;
+    _numRecordedFrames = 0;
+    _numDroppedFrames = 0;
+
+    QDir().mkpath(QString::fromStdString(_settings.directory));
+    if (FrameRecorderSettings::Format::Raw == _settings.format) {
+        _rawFile.open(_settings.directory + "/frames.raw", std::ios::out | std::ios::binary | std::ios::trunc);
+        _indexFile.open(_settings.directory + "/frames.idx", std::ios::out | std::ios::trunc);
+        _rawFileOffset = 0;
+    }
+
+    for (int i = 0; i < _settings.numBuffers; ++i) {
+        _freeBuffers.emplace_back(
+            boost::make_shared<QImage>(_settings.imageSize.x, _settings.imageSize.y, QImage::Format_RGB32));
+    }
+    for (int i = 0; i < _settings.numEncoderThreads; ++i) {
+        _encoderThreads.emplace_back(&FrameRecorderImpl::processFrames, this);
+    }
+    _recording = true;
+}
+
+void FrameRecorderImpl::stop()
+{
+    if (!_recording) {
+        return;
+    }
+    _recording = false;
+
+    //images of pending requests are still drawn by the simulation and will be ignored when they arrive
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _finishEncoding = true;
+    }
+    _condition.notify_all();
+    for (auto& thread : _encoderThreads) {
+        thread.join();
+    }
+    _encoderThreads.clear();
+    _finishEncoding = false;
+    _freeBuffers.clear();
+
+    if (_rawFile.is_open()) {
+        _rawFile.close();
+        _indexFile.close();
+    }
+}
+
+bool FrameRecorderImpl::isRecording() const
+{
+    return _recording;
+}
+
+void FrameRecorderImpl::notifyNextTimestep()
+{
+    if (!_recording) {
+        return;
+    }
+    ++_timestepsSinceLastFrame;
+    auto const isFramePending = !_requestedFrames.empty() && _requestedFrames.back().sessionId == _sessionId;
+    if (_timestepsSinceLastFrame < _timestepInterval || isFramePending) {
+        return;
+    }
+    _timestepsSinceLastFrame = 0;
+
+    QImagePtr buffer;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_freeBuffers.empty()) {
+            buffer = _freeBuffers.back();
+            _freeBuffers.pop_back();
+        }
+    }
+
+    //encoders are behind => drop frame and record less frequently
+    if (!buffer) {
+        ++_numDroppedFrames;
+        _timestepInterval = std::min(_timestepInterval * 2, _settings.timestepInterval * MaxIntervalFactor);
+        return;
+    }
+
+    _requestedFrames.emplace_back(Frame{_sessionId, 0, _context->getTimestep(), buffer});
+    _access->requirePixelImage(_settings.rect, buffer, _imageMutex);
+}
+
+int FrameRecorderImpl::getNumRecordedFrames() const
+{
+    return _numRecordedFrames;
+}
+
+int FrameRecorderImpl::getNumDroppedFrames() const
+{
+    return _numDroppedFrames;
+}
+
+int FrameRecorderImpl::getCurrentTimestepInterval() const
+{
+    return _timestepInterval;
+}
+
+void FrameRecorderImpl::imageReady()
+{
+    if (_requestedFrames.empty()) {
+        return;
+    }
+    auto frame = _requestedFrames.front();
+    _requestedFrames.pop_front();
+    if (!_recording || frame.sessionId != _sessionId) {
+        return;
+    }
+    frame.index = _numRecordedFrames++;
+
+    int numFreeBuffers;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _framesToEncode.emplace_back(frame);
+        numFreeBuffers = static_cast<int>(_freeBuffers.size());
+    }
+    _condition.notify_one();
+
+    //encoders have caught up => return to the original interval step by step
+    if (numFreeBuffers > _settings.numBuffers / 2 && _timestepInterval > _settings.timestepInterval) {
+        _timestepInterval = std::max(_timestepInterval / 2, _settings.timestepInterval);
+    }
+}
+
+void FrameRecorderImpl::processFrames()
+{
+    while (true) {
+        boost::optional<Frame> frame;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _condition.wait(lock, [this] { return _finishEncoding || !_framesToEncode.empty(); });
+            if (_framesToEncode.empty()) {
+                return;
+            }
+            frame = _framesToEncode.front();
+            _framesToEncode.pop_front();
+        }
+
+        encodeFrame(*frame);
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        _freeBuffers.emplace_back(frame->image);
+    }
+}
+
+void FrameRecorderImpl::encodeFrame(Frame const& frame)
+{
+    auto const& image = *frame.image;
+    if (FrameRecorderSettings::Format::PngSequence == _settings.format) {
+        std::stringstream stream;
+        stream << _settings.directory << "/frame_" << std::setw(6) << std::setfill('0') << frame.index << ".png";
+        image.save(QString::fromStdString(stream.str()), "PNG");
+        return;
+    }
+
+    auto const numBytes = static_cast<uint64_t>(image.bytesPerLine()) * image.height();
+    std::lock_guard<std::mutex> lock(_rawFileMutex);
+    _rawFile.write(reinterpret_cast<char const*>(image.constBits()), numBytes);
+    _indexFile << frame.index << " " << frame.timestep << " " << _rawFileOffset << " " << image.width() << " "
+               << image.height() << std::endl;
+    _rawFileOffset += numBytes;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+#include "FrameRecorder.h"
+
+class FrameRecorderImpl : public FrameRecorder
+{
+    Q_OBJECT
+public:
+    ~FrameRecorderImpl();
+
+    void init(SimulationAccess* access, SimulationContext* context);
+
+    void start(FrameRecorderSettings const& settings) override;
+    void stop() override;
+    bool isRecording() const override;
+
+    Q_SLOT void notifyNextTimestep() override;
+
+    int getNumRecordedFrames() const override;
+    int getNumDroppedFrames() const override;
+    int getCurrentTimestepInterval() const override;
+
+private:
+    Q_SLOT void imageReady();
+
+    struct Frame
+    {
+        int sessionId;
+        int index;
+        int timestep;
+        QImagePtr image;
+    };
+    void processFrames();
+    void encodeFrame(Frame const& frame);
+
+    SimulationAccess* _access = nullptr;
+    SimulationContext* _context = nullptr;
+    list<QMetaObject::Connection> _accessConnections;
+
+    FrameRecorderSettings _settings;
+    bool _recording = false;
+    int _sessionId = 0;     //incremented on each start, images requested in former sessions are ignored
+    int _timestepsSinceLastFrame = 0;
+    int _timestepInterval = 0;
+    int _numRecordedFrames = 0;
+    int _numDroppedFrames = 0;
+
+    //images requested from the simulation in order of request, may contain frames of former sessions
+    std::deque<Frame> _requestedFrames;
+    std::mutex _imageMutex;
+
+    //shared with encoder threads
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    vector<QImagePtr> _freeBuffers;
+    std::deque<Frame> _framesToEncode;
+    bool _finishEncoding = false;
+    vector<std::thread> _encoderThreads;
+
+    std::mutex _rawFileMutex;
+    std::ofstream _rawFile;
+    std::ofstream _indexFile;
+    uint64_t _rawFileOffset = 0;
+};
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "ElementaryTypes.h"
+
 struct MonitorData
 {
     int timeStep = 0;
@@ -8,6 +10,13 @@ struct MonitorData
     int numCells = 0;
     int numParticles = 0;
     int numTokens = 0;
+    int numTokensByCellFunction[Enums::CellFunction::_COUNTER] = {};    //tokens processed in the next timestep
+
+    //since simulation start, the difference of two samples divided by their time distance yields the throughput
+    unsigned long long numProcessedTokensByCellFunction[Enums::CellFunction::_COUNTER] = {};
+    int numSleepingRegions = 0;
+    int numRegionsFallenAsleep = 0;     //since simulation start
+    int numRegionsWokenUp = 0;          //since simulation start
     double totalInternalEnergy = 0.0;
     double totalLinearKineticEnergy = 0.0;
     double totalRotationalKineticEnergy = 0.0;
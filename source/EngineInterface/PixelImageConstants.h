@@ -0,0 +1,13 @@
+#pragma once
+
+namespace Const
+{
+    //pixel image pyramid, one pixel of level L covers 2^L x 2^L world units
+    int const PixelImageTileSize = 32;
+    int const PixelImageMaxLevel = 6;
+
+    //pixel images are in QImage::Format_RGB32 layout (0xffRRGGBB)
+    //i.e. SpaceColor and NothingnessColor from Colors.h with red and blue swapped
+    unsigned int const PixelImageSpaceColor = 0xff00001b;
+    unsigned int const PixelImageNothingnessColor = 0xff000000;
+}
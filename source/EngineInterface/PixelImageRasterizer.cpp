@@ -0,0 +1,179 @@
+#include "PixelImageRasterizer.h"
+
+#include "Colors.h"
+#include "Descriptions.h"
+
+namespace
+{
+    int isqrt(int value)
+    {
+        auto result = static_cast<int>(std::sqrt(static_cast<double>(value)));
+        while (result * result > value) {
+            --result;
+        }
+        while ((result + 1) * (result + 1) <= value) {
+            ++result;
+        }
+        return result;
+    }
+
+    int toEnergyInt(double energy)
+    {
+        return std::max(0, static_cast<int>(static_cast<float>(energy)));
+    }
+
+    IntVector2D calcLevelPixel(QVector2D const& pos, IntVector2D const& worldSize, int level)
+    {
+        auto x = static_cast<int>(std::floor(pos.x())) % worldSize.x;
+        auto y = static_cast<int>(std::floor(pos.y())) % worldSize.y;
+        x = x < 0 ? x + worldSize.x : x;
+        y = y < 0 ? y + worldSize.y : y;
+        return {x >> level, y >> level};
+    }
+}
+
+PixelImageRasterizer::PixelImageRasterizer(IntVector2D const& worldSize)
+    : _image(worldSize)
+    , _tileHashesByLevel(TiledPixelImage::MaxLevel + 1)
+    , _renderedTilesByLevel(TiledPixelImage::MaxLevel + 1)
+{}
+
+vector<int> PixelImageRasterizer::update(DataDescription const& data, IntRect const& rect, int level)
+{
+    auto const tileSize = Const::PixelImageTileSize;
+    auto const levelSize = _image.getLevelSize(level);
+    auto const numTiles = _image.getNumTiles(level);
+    auto const tileRect = _image.getTileRect(rect, level);
+    auto const isInTileRect = [&](IntVector2D const& tile) {
+        return tile.x >= tileRect.p1.x && tile.x < tileRect.p2.x && tile.y >= tileRect.p1.y && tile.y < tileRect.p2.y;
+    };
+
+    auto& tileHashes = _tileHashesByLevel[level];
+    auto& renderedTiles = _renderedTilesByLevel[level];
+    if (tileHashes.empty()) {
+        tileHashes.resize(numTiles.x * numTiles.y, 0);
+        renderedTiles.resize(numTiles.x * numTiles.y, false);
+    }
+
+    vector<Entity> entities;
+    collectEntities(data, level, entities);
+
+    vector<uint64_t> newTileHashes(numTiles.x * numTiles.y, 0);
+    for (auto const& entity : entities) {
+        IntVector2D const tile{entity.pixel.x / tileSize, entity.pixel.y / tileSize};
+        if (isInTileRect(tile)) {
+            newTileHashes[tile.y * numTiles.x + tile.x] +=
+                calcEntityHash(entity.pixel.y * levelSize.x + entity.pixel.x, entity.color);
+        }
+    }
+
+    vector<int> result;
+    vector<bool> dirtyTiles(numTiles.x * numTiles.y, false);
+    for (int tileY = tileRect.p1.y; tileY < tileRect.p2.y; ++tileY) {
+        for (int tileX = tileRect.p1.x; tileX < tileRect.p2.x; ++tileX) {
+            auto const tileIndex = tileY * numTiles.x + tileX;
+            if (renderedTiles[tileIndex] && tileHashes[tileIndex] == newTileHashes[tileIndex]) {
+                continue;
+            }
+            renderedTiles[tileIndex] = true;
+            tileHashes[tileIndex] = newTileHashes[tileIndex];
+            dirtyTiles[tileIndex] = true;
+            result.emplace_back(tileIndex);
+
+            auto const tilePixels = _image.getTile(level, tileIndex);
+            for (int y = 0; y < tileSize; ++y) {
+                for (int x = 0; x < tileSize; ++x) {
+                    auto const isInside = tileX * tileSize + x < levelSize.x && tileY * tileSize + y < levelSize.y;
+                    tilePixels[y * tileSize + x] =
+                        isInside ? Const::PixelImageSpaceColor : Const::PixelImageNothingnessColor;
+                }
+            }
+        }
+    }
+
+    for (auto const& entity : entities) {
+        IntVector2D const tile{entity.pixel.x / tileSize, entity.pixel.y / tileSize};
+        auto const tileIndex = tile.y * numTiles.x + tile.x;
+        if (dirtyTiles[tileIndex]) {
+            auto const tilePixels = _image.getTile(level, tileIndex);
+            auto& pixel = tilePixels[(entity.pixel.y % tileSize) * tileSize + entity.pixel.x % tileSize];
+            pixel = addColors(pixel, entity.color);
+        }
+    }
+    return result;
+}
+
+TiledPixelImage const& PixelImageRasterizer::getImage() const
+{
+    return _image;
+}
+
+unsigned int PixelImageRasterizer::calcCellColor(int colorCode, double energy, bool selected)
+{
+    unsigned int const cellColors[] = {
+        Const::IndividualCellColor1,
+        Const::IndividualCellColor2,
+        Const::IndividualCellColor3,
+        Const::IndividualCellColor4,
+        Const::IndividualCellColor5,
+        Const::IndividualCellColor6,
+        Const::IndividualCellColor7};
+    auto const cellColor = cellColors[colorCode % 7];
+
+    //same brightness as in the vector image but in integer arithmetic to be exact on host and device
+    auto const factor = std::min(100, isqrt(toEnergyInt(energy)) * 5 + 20) * (selected ? 4 : 3);
+    auto const scale = [&](unsigned int component) {
+        return component * factor * 255 / (256 * 100 * 4);
+    };
+    return 0xff000000 | (scale((cellColor >> 16) & 0xff) << 16) | (scale((cellColor >> 8) & 0xff) << 8)
+        | scale(cellColor & 0xff);
+}
+
+unsigned int PixelImageRasterizer::calcParticleColor(double energy, bool selected)
+{
+    auto const intensity =
+        std::max(std::min((toEnergyInt(energy) + 10) * 5, 150), 20) * (selected ? 4 : 3) * 255 / (256 * 4);
+    return 0xff000000 | (intensity << 16) | 20;
+}
+
+unsigned int PixelImageRasterizer::addColors(unsigned int pixel, unsigned int color)
+{
+    auto const red = std::min(((pixel >> 16) & 0xff) + ((color >> 16) & 0xff), 0xffu);
+    auto const green = std::min(((pixel >> 8) & 0xff) + ((color >> 8) & 0xff), 0xffu);
+    auto const blue = std::min((pixel & 0xff) + (color & 0xff), 0xffu);
+    return 0xff000000 | (red << 16) | (green << 8) | blue;
+}
+
+uint64_t PixelImageRasterizer::calcEntityHash(int pixelIndex, unsigned int color)
+{
+    //splitmix64 finalizer
+    auto result = (static_cast<uint64_t>(pixelIndex) << 32) | color;
+    result = (result ^ (result >> 30)) * 0xbf58476d1ce4e5b9ull;
+    result = (result ^ (result >> 27)) * 0x94d049bb133111ebull;
+    return result ^ (result >> 31);
+}
+
+void PixelImageRasterizer::collectEntities(DataDescription const& data, int level, vector<Entity>& result) const
+{
+    auto const worldSize = _image.getWorldSize();
+    if (data.clusters) {
+        for (auto const& cluster : *data.clusters) {
+            if (!cluster.cells) {
+                continue;
+            }
+            for (auto const& cell : *cluster.cells) {
+                auto const colorCode = cell.metadata ? cell.metadata->color : 0;
+                result.emplace_back(Entity{
+                    calcLevelPixel(*cell.pos, worldSize, level),
+                    calcCellColor(colorCode, cell.energy.get_value_or(0), false)});
+            }
+        }
+    }
+    if (data.particles) {
+        for (auto const& particle : *data.particles) {
+            result.emplace_back(Entity{
+                calcLevelPixel(*particle.pos, worldSize, level),
+                calcParticleColor(particle.energy.get_value_or(0), false)});
+        }
+    }
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Definitions.h"
+#include "TiledPixelImage.h"
+
+/**
+ * Host reference of the tiled pixel image rendering in PixelImageKernels.cuh.
+ * Each cell and particle adds its color to the level pixel containing its position (saturating per channel),
+ * so the result does not depend on the processing order. A tile is only rendered again if the sum of hashes
+ * over its entities (pixel and color) has changed.
+ */
+class ENGINEINTERFACE_EXPORT PixelImageRasterizer
+{
+public:
+    PixelImageRasterizer(IntVector2D const& worldSize);
+
+    //renders the changed tiles of the level within the rect and returns their indices
+    vector<int> update(DataDescription const& data, IntRect const& rect, int level);
+
+    TiledPixelImage const& getImage() const;
+
+    static unsigned int calcCellColor(int colorCode, double energy, bool selected);
+    static unsigned int calcParticleColor(double energy, bool selected);
+    static unsigned int addColors(unsigned int pixel, unsigned int color);
+    static uint64_t calcEntityHash(int pixelIndex, unsigned int color);
+
+private:
+    struct Entity
+    {
+        IntVector2D pixel;  //in level coordinates
+        unsigned int color;
+    };
+    void collectEntities(DataDescription const& data, int level, vector<Entity>& result) const;
+
+    TiledPixelImage _image;
+    vector<vector<uint64_t>> _tileHashesByLevel;
+    vector<vector<bool>> _renderedTilesByLevel;
+};
@@ -0,0 +1,331 @@
+#include "SoftwareRasterizer.h"
+
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+#include <QImage>
+
+#include "Colors.h"
+#include "Descriptions.h"
+
+namespace
+{
+    int const BandHeight = 32;
+    float const FpPrecision = 0.00001f;
+
+    QVector2D correctPos(QVector2D const& pos, IntVector2D const& worldSize)
+    {
+        auto const intX = static_cast<int>(std::floor(pos.x()));
+        auto const intY = static_cast<int>(std::floor(pos.y()));
+        auto const fracX = pos.x() - intX;
+        auto const fracY = pos.y() - intY;
+        return QVector2D(
+            static_cast<float>(((intX % worldSize.x) + worldSize.x) % worldSize.x) + fracX,
+            static_cast<float>(((intY % worldSize.y) + worldSize.y) % worldSize.y) + fracY);
+    }
+
+    bool isContainedInRect(QVector2D const& upperLeft, QVector2D const& lowerRight, QVector2D const& pos)
+    {
+        return pos.x() >= upperLeft.x() && pos.x() <= lowerRight.x() && pos.y() >= upperLeft.y()
+            && pos.y() <= lowerRight.y();
+    }
+
+    //packed addition of all channels at once, overflows of a channel saturate it
+    void addingColor(unsigned int& pixel, float r, float g, float b)
+    {
+        unsigned int const colorFlat = static_cast<int>(b * 255.0f) << 16 | static_cast<int>(g * 255.0f) << 8
+            | static_cast<int>(r * 255.0f);
+
+        auto newColor = (pixel & 0xfefefe) + (colorFlat & 0xfefefe);
+        if ((newColor & 0x1000000) != 0) {
+            newColor |= 0xff0000;
+        }
+        if ((newColor & 0x10000) != 0) {
+            newColor |= 0xff00;
+        }
+        if ((newColor & 0x100) != 0) {
+            newColor |= 0xff;
+        }
+        pixel = newColor | 0xff000000;
+    }
+}
+
+SoftwareRasterizer::SoftwareRasterizer(IntVector2D const& worldSize, int numThreads)
+    : _worldSize(worldSize)
+    , _numThreads(numThreads > 0 ? numThreads : std::max(1, static_cast<int>(std::thread::hardware_concurrency())))
+{}
+
+void SoftwareRasterizer::drawVectorImage(
+    DataDescription const& data,
+    RealRect const& worldRect,
+    double zoom,
+    IntVector2D const& imageSize,
+    unsigned int* imageData) const
+{
+    auto const zoomFloat = static_cast<float>(zoom);
+    auto const primitives = createPrimitives(data, worldRect, zoomFloat, imageSize);
+
+    auto const numBands = (imageSize.y + BandHeight - 1) / BandHeight;
+    vector<vector<int>> primitiveIndicesByBand(numBands);
+    for (int index = 0; index < static_cast<int>(primitives.size()); ++index) {
+        auto const& primitive = primitives[index];
+        auto const firstBand = std::max(0, primitive.minY / BandHeight);
+        auto const lastBand = std::min(numBands - 1, primitive.maxY / BandHeight);
+        for (int band = firstBand; band <= lastBand; ++band) {
+            primitiveIndicesByBand[band].emplace_back(index);
+        }
+    }
+
+    std::atomic<int> nextBand{0};
+    auto drawBands = [&] {
+        for (int band = nextBand++; band < numBands; band = nextBand++) {
+            Band const bandRows{band * BandHeight, std::min(imageSize.y, (band + 1) * BandHeight)};
+            drawBand(bandRows, primitives, primitiveIndicesByBand[band], worldRect, zoomFloat, imageSize, imageData);
+        }
+    };
+    vector<std::thread> threads;
+    for (int i = 1; i < std::min(_numThreads, numBands); ++i) {
+        threads.emplace_back(drawBands);
+    }
+    drawBands();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+void SoftwareRasterizer::drawImage(DataDescription const& data, IntRect const& rect, QImage& target) const
+{
+    IntVector2D const imageSize{target.width(), target.height()};
+    RealRect const worldRect{
+        {static_cast<float>(rect.p1.x), static_cast<float>(rect.p1.y)},
+        {static_cast<float>(rect.p2.x), static_cast<float>(rect.p2.y)}};
+    auto const zoom = static_cast<double>(imageSize.x) / (rect.p2.x - rect.p1.x);
+
+    vector<unsigned int> imageData(imageSize.x * imageSize.y);
+    drawVectorImage(data, worldRect, zoom, imageSize, imageData.data());
+
+    for (int y = 0; y < imageSize.y; ++y) {
+        auto const targetRow = reinterpret_cast<unsigned int*>(target.scanLine(y));
+        for (int x = 0; x < imageSize.x; ++x) {
+            auto const pixel = imageData[y * imageSize.x + x];
+            targetRow[x] = (pixel & 0xff00ff00) | ((pixel >> 16) & 0xff) | ((pixel & 0xff) << 16);
+        }
+    }
+}
+
+auto SoftwareRasterizer::createPrimitives(
+    DataDescription const& data,
+    RealRect const& worldRect,
+    float zoom,
+    IntVector2D const& imageSize) const -> vector<Primitive>
+{
+    QVector2D const rectUpperLeft(worldRect.p1.x, worldRect.p1.y);
+    QVector2D const rectLowerRight(worldRect.p2.x, worldRect.p2.y);
+    auto const mapToImage = [&](QVector2D const& pos) { return (pos - rectUpperLeft) * zoom; };
+    auto const addCircle = [](vector<Primitive>& primitives,
+                              Primitive::Type type,
+                              QVector2D const& pos,
+                              Color const& color,
+                              float radius) {
+        primitives.emplace_back(Primitive{
+            type,
+            pos,
+            pos,
+            color,
+            radius,
+            static_cast<int>(std::floor(pos.y() - radius)) - 2,
+            static_cast<int>(std::ceil(pos.y() + radius)) + 2});
+    };
+
+    unordered_map<uint64_t, QVector2D> cellPosById;
+    if (data.clusters) {
+        for (auto const& cluster : *data.clusters) {
+            if (cluster.cells) {
+                for (auto const& cell : *cluster.cells) {
+                    cellPosById.insert_or_assign(cell.id, *cell.pos);
+                }
+            }
+        }
+    }
+
+    vector<Primitive> result;
+    if (data.clusters) {
+        for (auto const& cluster : *data.clusters) {
+            if (!cluster.cells) {
+                continue;
+            }
+
+            //cells and connections
+            for (auto const& cell : *cluster.cells) {
+                auto const cellPos = correctPos(*cell.pos, _worldSize);
+                if (!isContainedInRect(rectUpperLeft, rectLowerRight, cellPos)) {
+                    continue;
+                }
+                auto const cellImagePos = mapToImage(cellPos);
+
+                unsigned int const cellColors[] = {
+                    Const::IndividualCellColor1,
+                    Const::IndividualCellColor2,
+                    Const::IndividualCellColor3,
+                    Const::IndividualCellColor4,
+                    Const::IndividualCellColor5,
+                    Const::IndividualCellColor6,
+                    Const::IndividualCellColor7};
+                auto const cellColor = cellColors[(cell.metadata ? cell.metadata->color : 0) % 7];
+                auto const factor =
+                    std::min(100.0f, std::sqrt(static_cast<float>(cell.energy.get_value_or(0))) * 5 + 20.0f) / 100.0f
+                    * 0.75f;
+                Color color{
+                    static_cast<float>((cellColor >> 16) & 0xff) / 256.0f * factor,
+                    static_cast<float>((cellColor >> 8) & 0xff) / 256.0f * factor,
+                    static_cast<float>(cellColor & 0xff) / 256.0f * factor};
+                addCircle(result, Primitive::Type::InvertedCircle, cellImagePos, color, zoom / 3);
+
+                if (zoom > 1 - FpPrecision && cell.connectingCells) {
+                    auto const connectionFactor = std::min((zoom - 1.0f) / 3, 1.0f);
+                    Color const connectionColor{
+                        color.r * connectionFactor, color.g * connectionFactor, color.b * connectionFactor};
+                    auto const posCorrection = cellPos - *cell.pos;
+                    for (auto const& connectingCellId : *cell.connectingCells) {
+                        auto const otherCellPosIt = cellPosById.find(connectingCellId);
+                        if (otherCellPosIt == cellPosById.end()) {
+                            continue;
+                        }
+                        auto const otherCellImagePos = mapToImage(otherCellPosIt->second + posCorrection);
+                        result.emplace_back(Primitive{
+                            Primitive::Type::Line,
+                            cellImagePos,
+                            otherCellImagePos,
+                            connectionColor,
+                            0,
+                            static_cast<int>(std::floor(std::min(cellImagePos.y(), otherCellImagePos.y()))) - 2,
+                            static_cast<int>(std::ceil(std::max(cellImagePos.y(), otherCellImagePos.y()))) + 2});
+                    }
+                }
+            }
+
+            //tokens
+            for (auto const& cell : *cluster.cells) {
+                if (!cell.tokens) {
+                    continue;
+                }
+                auto const cellImagePos = mapToImage(correctPos(*cell.pos, _worldSize));
+                if (!isContainedInRect(QVector2D(0, 0), QVector2D(imageSize.x, imageSize.y), cellImagePos)) {
+                    continue;
+                }
+                for (int i = 0; i < static_cast<int>(cell.tokens->size()); ++i) {
+                    addCircle(result, Primitive::Type::Circle, cellImagePos, Color{0.75f, 0.75f, 0.75f}, zoom / 2);
+                }
+            }
+        }
+    }
+
+    if (data.particles) {
+        for (auto const& particle : *data.particles) {
+            auto const particleImagePos = mapToImage(*particle.pos);
+            if (!isContainedInRect(QVector2D(0, 0), QVector2D(imageSize.x, imageSize.y), particleImagePos)) {
+                continue;
+            }
+            auto const energy = static_cast<int>(static_cast<float>(particle.energy.get_value_or(0)));
+            auto const intensity = std::max(std::min((energy + 10) * 5, 150), 20) / 256.0f * 0.75f;
+            addCircle(result, Primitive::Type::Circle, particleImagePos, Color{intensity, 0, 0.08f}, zoom / 3);
+        }
+    }
+    return result;
+}
+
+void SoftwareRasterizer::drawBand(
+    Band const& band,
+    vector<Primitive> const& primitives,
+    vector<int> const& primitiveIndices,
+    RealRect const& worldRect,
+    float zoom,
+    IntVector2D const& imageSize,
+    unsigned int* imageData) const
+{
+    //background
+    auto const outsideUpperLeftX = -std::min(static_cast<int>(worldRect.p1.x * zoom), 0);
+    auto const outsideUpperLeftY = -std::min(static_cast<int>(worldRect.p1.y * zoom), 0);
+    auto const outsideLowerRightX = imageSize.x - std::max(static_cast<int>((worldRect.p2.x - _worldSize.x) * zoom), 0);
+    auto const outsideLowerRightY = imageSize.y - std::max(static_cast<int>((worldRect.p2.y - _worldSize.y) * zoom), 0);
+    for (int y = band.startY; y < band.endY; ++y) {
+        auto const row = imageData + y * imageSize.x;
+        if (y < outsideUpperLeftY || y >= outsideLowerRightY) {
+            std::fill(row, row + imageSize.x, Const::NothingnessColor);
+            continue;
+        }
+        auto const spaceStartX = std::max(0, std::min(imageSize.x, outsideUpperLeftX));
+        auto const spaceEndX = std::max(spaceStartX, std::min(imageSize.x, outsideLowerRightX));
+        std::fill(row, row + spaceStartX, Const::NothingnessColor);
+        std::fill(row + spaceStartX, row + spaceEndX, Const::SpaceColor);
+        std::fill(row + spaceEndX, row + imageSize.x, Const::NothingnessColor);
+    }
+
+    auto const drawDot = [&](QVector2D const& pos, Color const& color) {
+        if (!(pos.x() >= 1 && pos.x() < imageSize.x - 1 && pos.y() >= 1 && pos.y() < imageSize.y - 1)) {
+            return;
+        }
+        auto const intPosX = static_cast<int>(pos.x());
+        auto const intPosY = static_cast<int>(pos.y());
+        auto const fracX = pos.x() - intPosX;
+        auto const fracY = pos.y() - intPosY;
+        auto const addWeighted = [&](int x, int y, float weight) {
+            if (y >= band.startY && y < band.endY) {
+                addingColor(imageData[x + y * imageSize.x], color.r * weight, color.g * weight, color.b * weight);
+            }
+        };
+        addWeighted(intPosX, intPosY, (1.0f - fracX) * (1.0f - fracY));
+        addWeighted(intPosX + 1, intPosY, fracX * (1.0f - fracY));
+        addWeighted(intPosX, intPosY + 1, (1.0f - fracX) * fracY);
+        addWeighted(intPosX + 1, intPosY + 1, fracX * fracY);
+    };
+
+    for (auto const& index : primitiveIndices) {
+        auto const& primitive = primitives[index];
+        auto const& pos = primitive.pos;
+        auto color = primitive.color;
+        switch (primitive.type) {
+        case Primitive::Type::Circle:
+        case Primitive::Type::InvertedCircle: {
+            auto const radius = primitive.radius;
+            auto const inverted = primitive.type == Primitive::Type::InvertedCircle;
+            if (radius > 1.0f - FpPrecision) {
+                auto const radiusSquared = radius * radius;
+                for (float x = -radius; x <= radius; x += 1.0f) {
+                    for (float y = -radius; y <= radius; y += 1.0f) {
+                        auto const rSquared = x * x + y * y;
+                        if (rSquared <= radiusSquared) {
+                            auto const unclampedFactor =
+                                inverted ? (rSquared / radiusSquared) * 2 : (1.0f - rSquared / radiusSquared) * 2;
+                            auto const factor = std::min(unclampedFactor, 1.0f);
+                            drawDot(pos + QVector2D(x, y), Color{color.r * factor, color.g * factor, color.b * factor});
+                        }
+                    }
+                }
+            } else {
+                color = Color{color.r * radius * 2, color.g * radius * 2, color.b * radius * 2};
+                drawDot(pos, color);
+                color = Color{color.r * 0.3f, color.g * 0.3f, color.b * 0.3f};
+                drawDot(pos + QVector2D(1, 0), color);
+                drawDot(pos + QVector2D(-1, 0), color);
+                drawDot(pos + QVector2D(0, 1), color);
+                drawDot(pos + QVector2D(0, -1), color);
+            }
+        } break;
+        case Primitive::Type::Line: {
+            auto const dist = (primitive.endPos - pos).length();
+            if (dist < FpPrecision) {
+                drawDot(pos, color);
+                break;
+            }
+            auto const step = (primitive.endPos - pos) / dist * 1.8f;
+            auto linePos = pos;
+            for (float d = 0; d <= dist; d += 1.8f) {
+                drawDot(linePos, color);
+                linePos += step;
+            }
+        } break;
+        }
+    }
+}
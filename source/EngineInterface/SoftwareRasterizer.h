@@ -0,0 +1,73 @@
+#pragma once
+
+#include "Definitions.h"
+
+/**
+ * Renders descriptions on the CPU with the same rules as the vector image in RenderingKernels.cuh
+ * (calcColor, drawCircle, addingColor). Does not require a GPU or an OpenGL context.
+ * The image is divided into bands of rows which are rendered in parallel. Every band draws the primitives
+ * overlapping it in the order of the description, hence the result does not depend on the number of threads.
+ */
+class ENGINEINTERFACE_EXPORT SoftwareRasterizer
+{
+public:
+    //numThreads == 0: number of hardware threads
+    SoftwareRasterizer(IntVector2D const& worldSize, int numThreads = 0);
+
+    //pixels are RGBA bytes (0xffBBGGRR) as in the vector image texture
+    void drawVectorImage(
+        DataDescription const& data,
+        RealRect const& worldRect,
+        double zoom,
+        IntVector2D const& imageSize,
+        unsigned int* imageData) const;
+
+    //draws the rect into the whole target image (QImage::Format_RGB32)
+    void drawImage(DataDescription const& data, IntRect const& rect, QImage& target) const;
+
+private:
+    struct Color
+    {
+        float r;
+        float g;
+        float b;
+    };
+    struct Primitive
+    {
+        enum class Type
+        {
+            Circle,
+            InvertedCircle,
+            Line
+        };
+        Type type;
+        QVector2D pos;
+        QVector2D endPos;   //only for lines
+        Color color;
+        float radius;
+        int minY;   //rows which may be affected
+        int maxY;
+    };
+    struct Band
+    {
+        int startY;
+        int endY;
+    };
+
+    vector<Primitive> createPrimitives(
+        DataDescription const& data,
+        RealRect const& worldRect,
+        float zoom,
+        IntVector2D const& imageSize) const;
+    void drawBand(
+        Band const& band,
+        vector<Primitive> const& primitives,
+        vector<int> const& primitiveIndices,
+        RealRect const& worldRect,
+        float zoom,
+        IntVector2D const& imageSize,
+        unsigned int* imageData) const;
+
+    IntVector2D _worldSize;
+    int _numThreads = 1;
+};
@@ -0,0 +1,150 @@
+#include <algorithm>
+#include <fstream>
+
+#include "ClusterHasher.h"
+#include "SpeciesTracker.h"
+
+namespace
+{
+    int const MinCellsPerSpecies = 2;
+    int const SketchSize = 8;
+}
+
+void SpeciesTracker::clear()
+{
+    _cachedClusterById.clear();
+    _speciesIdByHash.clear();
+    _speciesIdsBySketchElement.clear();
+    _species.clear();
+    _sampleTimesteps.clear();
+}
+
+int SpeciesTracker::addSample(int timestep, DataDescription const& data)
+{
+    auto const sample = static_cast<int>(_sampleTimesteps.size());
+    _sampleTimesteps.emplace_back(timestep);
+
+    std::unordered_map<uint64_t, CachedCluster> cachedClusterById;
+    std::unordered_map<int, int> populationBySpeciesId;
+    int numHashedClusters = 0;
+    if (auto const& clusters = data.clusters) {
+        for (auto const& cluster : *clusters) {
+            auto const numCells = cluster.cells ? static_cast<int>(cluster.cells->size()) : 0;
+            if (numCells < MinCellsPerSpecies) {
+                continue;
+            }
+
+            //clusters keep their ids when they change, hence the cell count is checked as well
+            auto findResult = _cachedClusterById.find(cluster.id);
+            int speciesId;
+            if (findResult != _cachedClusterById.end() && findResult->second.numCells == numCells) {
+                speciesId = findResult->second.speciesId;
+            }
+            else {
+                auto const structureHash = ClusterHasher::calcStructureHash(cluster);
+                auto const speciesFindResult = _speciesIdByHash.find(structureHash);
+                speciesId = speciesFindResult != _speciesIdByHash.end() ? speciesFindResult->second
+                                                                        : registerSpecies(structureHash, cluster);
+                ++numHashedClusters;
+            }
+            cachedClusterById.emplace(cluster.id, CachedCluster{numCells, speciesId});
+            ++populationBySpeciesId[speciesId];
+        }
+    }
+    _cachedClusterById.swap(cachedClusterById);
+
+    for (auto const& speciesIdAndPopulation : populationBySpeciesId) {
+        auto& species = _species[speciesIdAndPopulation.first];
+        species.populations.resize(sample - species.firstSample, 0);
+        species.populations.emplace_back(speciesIdAndPopulation.second);
+        species.lastSample = sample;
+    }
+    return numHashedClusters;
+}
+
+auto SpeciesTracker::getSpecies() const -> vector<Species> const&
+{
+    return _species;
+}
+
+vector<int> const& SpeciesTracker::getSampleTimesteps() const
+{
+    return _sampleTimesteps;
+}
+
+bool SpeciesTracker::saveToFile(string const& filename) const
+{
+    std::ofstream stream(filename, std::ios::out | std::ios::trunc);
+    if (!stream) {
+        return false;
+    }
+    stream << "species,ancestor,cells,timestep,population" << std::endl;
+    for (auto const& species : _species) {
+        for (int index = 0; index < species.populations.size(); ++index) {
+            if (species.populations[index] == 0) {
+                continue;
+            }
+            stream << species.id << "," << (species.ancestorId ? std::to_string(*species.ancestorId) : string()) << ","
+                   << species.numCells << "," << _sampleTimesteps[species.firstSample + index] << ","
+                   << species.populations[index] << std::endl;
+        }
+    }
+    return stream.good();
+}
+
+int SpeciesTracker::registerSpecies(uint64_t structureHash, ClusterDescription const& cluster)
+{
+    auto sketch = ClusterHasher::calcCellLabels(cluster);
+    std::sort(sketch.begin(), sketch.end());
+    sketch.erase(std::unique(sketch.begin(), sketch.end()), sketch.end());
+    if (sketch.size() > SketchSize) {
+        sketch.resize(SketchSize);
+    }
+
+    Species species;
+    species.id = static_cast<int>(_species.size());
+    species.ancestorId = findAncestor(sketch);
+    species.numCells = static_cast<int>(cluster.cells->size());
+    species.firstSample = static_cast<int>(_sampleTimesteps.size()) - 1;
+    species.lastSample = species.firstSample;
+    for (auto const& element : sketch) {
+        _speciesIdsBySketchElement[element].emplace_back(species.id);
+    }
+    species.sketch = std::move(sketch);
+
+    _speciesIdByHash.emplace(structureHash, species.id);
+    _species.emplace_back(std::move(species));
+    return _species.back().id;
+}
+
+boost::optional<int> SpeciesTracker::findAncestor(vector<uint64_t> const& sketch) const
+{
+    //candidates share at least one sketch element, the best one shares at least half of them
+    std::unordered_map<int, int> numSharedElementsBySpeciesId;
+    for (auto const& element : sketch) {
+        auto const findResult = _speciesIdsBySketchElement.find(element);
+        if (findResult != _speciesIdsBySketchElement.end()) {
+            for (auto const& speciesId : findResult->second) {
+                ++numSharedElementsBySpeciesId[speciesId];
+            }
+        }
+    }
+
+    boost::optional<int> result;
+    int maxNumSharedElements = 0;
+    for (auto const& speciesIdAndNumSharedElements : numSharedElementsBySpeciesId) {
+        auto const& speciesId = speciesIdAndNumSharedElements.first;
+        auto const& numSharedElements = speciesIdAndNumSharedElements.second;
+        auto const& candidate = _species[speciesId];
+        auto const minSketchSize = static_cast<int>(std::min(candidate.sketch.size(), sketch.size()));
+        if (numSharedElements * 2 < minSketchSize) {
+            continue;
+        }
+        if (numSharedElements > maxNumSharedElements
+            || (numSharedElements == maxNumSharedElements && speciesId < *result)) {
+            maxNumSharedElements = numSharedElements;
+            result = speciesId;
+        }
+    }
+    return result;
+}
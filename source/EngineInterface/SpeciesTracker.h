@@ -0,0 +1,52 @@
+#pragma once
+
+#include <unordered_map>
+
+#include "Descriptions.h"
+
+/**
+ * Population counts per species over samples of the world. Species are identified by structural cluster hashes
+ * (see ClusterHasher). Hashes are cached per cluster id, so only new or changed clusters are hashed in each sample.
+ * A new species is linked to the known species with the most similar cell composition as its likely ancestor.
+ */
+class ENGINEINTERFACE_EXPORT SpeciesTracker
+{
+public:
+    struct Species
+    {
+        int id = 0;
+        boost::optional<int> ancestorId;
+        int numCells = 0;
+        int firstSample = 0;
+        int lastSample = 0;
+        vector<int> populations;  //[sample - firstSample], absent samples are 0
+        vector<uint64_t> sketch;  //smallest distinct cell labels, used to find ancestors
+    };
+
+    void clear();
+
+    //returns the number of hashed clusters
+    int addSample(int timestep, DataDescription const& data);
+
+    vector<Species> const& getSpecies() const;
+    vector<int> const& getSampleTimesteps() const;
+
+    //csv table with one row per species and sample in which it is present
+    bool saveToFile(string const& filename) const;
+
+private:
+    int registerSpecies(uint64_t structureHash, ClusterDescription const& cluster);
+    boost::optional<int> findAncestor(vector<uint64_t> const& sketch) const;
+
+    struct CachedCluster
+    {
+        int numCells;
+        int speciesId;
+    };
+    std::unordered_map<uint64_t, CachedCluster> _cachedClusterById;
+    std::unordered_map<uint64_t, int> _speciesIdByHash;
+    std::unordered_map<uint64_t, vector<int>> _speciesIdsBySketchElement;
+
+    vector<Species> _species;   //[id]
+    vector<int> _sampleTimesteps;
+};
@@ -0,0 +1,120 @@
+#include "TiledPixelImage.h"
+
+namespace
+{
+    int floorDiv(int64_t value, int64_t divisor)
+    {
+        auto result = value / divisor;
+        if (value % divisor != 0 && (value < 0) != (divisor < 0)) {
+            --result;
+        }
+        return static_cast<int>(result);
+    }
+
+    int ceilDiv(int value, int divisor)
+    {
+        return (value + divisor - 1) / divisor;
+    }
+}
+
+int TiledPixelImage::calcLevel(IntVector2D const& rectSize, IntVector2D const& imageSize)
+{
+    int result = 0;
+    while (result < MaxLevel
+           && (rectSize.x > (imageSize.x << result) || rectSize.y > (imageSize.y << result))) {
+        ++result;
+    }
+    return result;
+}
+
+TiledPixelImage::TiledPixelImage(IntVector2D const& worldSize)
+    : _worldSize(worldSize)
+    , _tileSlotsByLevel(MaxLevel + 1)
+    , _pixelsByLevel(MaxLevel + 1)
+{}
+
+IntVector2D TiledPixelImage::getWorldSize() const
+{
+    return _worldSize;
+}
+
+IntVector2D TiledPixelImage::getLevelSize(int level) const
+{
+    return {ceilDiv(_worldSize.x, 1 << level), ceilDiv(_worldSize.y, 1 << level)};
+}
+
+IntVector2D TiledPixelImage::getNumTiles(int level) const
+{
+    auto const levelSize = getLevelSize(level);
+    return {ceilDiv(levelSize.x, TileSize), ceilDiv(levelSize.y, TileSize)};
+}
+
+IntRect TiledPixelImage::getTileRect(IntRect const& rect, int level) const
+{
+    auto const numTiles = getNumTiles(level);
+    auto const tileWorldSize = TileSize << level;
+    IntRect result;
+    result.p1.x = std::max(0, floorDiv(rect.p1.x, tileWorldSize));
+    result.p1.y = std::max(0, floorDiv(rect.p1.y, tileWorldSize));
+    result.p2.x = std::min(numTiles.x, floorDiv(rect.p2.x - 1, tileWorldSize) + 1);
+    result.p2.y = std::min(numTiles.y, floorDiv(rect.p2.y - 1, tileWorldSize) + 1);
+    result.p2.x = std::max(result.p1.x, result.p2.x);
+    result.p2.y = std::max(result.p1.y, result.p2.y);
+    return result;
+}
+
+unsigned int* TiledPixelImage::getTile(int level, int tileIndex)
+{
+    auto& tileSlots = _tileSlotsByLevel[level];
+    auto& pixels = _pixelsByLevel[level];
+    if (tileSlots.empty()) {
+        auto const numTiles = getNumTiles(level);
+        tileSlots.assign(numTiles.x * numTiles.y, NoSlot);
+    }
+    auto& tileSlot = tileSlots[tileIndex];
+    if (NoSlot == tileSlot) {
+        tileSlot = static_cast<int>(pixels.size()) / (TileSize * TileSize);
+        pixels.resize(pixels.size() + TileSize * TileSize, Const::PixelImageNothingnessColor);
+    }
+    return pixels.data() + tileSlot * TileSize * TileSize;
+}
+
+unsigned int TiledPixelImage::getPixel(int level, IntVector2D const& pos) const
+{
+    auto const pixelIndex = calcPixelIndex(level, pos);
+    return NoSlot != pixelIndex ? _pixelsByLevel[level][pixelIndex] : Const::PixelImageNothingnessColor;
+}
+
+void TiledPixelImage::drawImage(IntRect const& rect, IntVector2D const& imageSize, unsigned int* imageData) const
+{
+    IntVector2D const rectSize{rect.p2.x - rect.p1.x, rect.p2.y - rect.p1.y};
+    auto const level = calcLevel(rectSize, imageSize);
+
+    for (int y = 0; y < imageSize.y; ++y) {
+        auto const worldY = rect.p1.y + floorDiv(static_cast<int64_t>(y) * rectSize.y, imageSize.y);
+        auto const row = imageData + y * imageSize.x;
+        if (worldY < 0 || worldY >= _worldSize.y) {
+            std::fill(row, row + imageSize.x, Const::PixelImageNothingnessColor);
+            continue;
+        }
+        for (int x = 0; x < imageSize.x; ++x) {
+            auto const worldX = rect.p1.x + floorDiv(static_cast<int64_t>(x) * rectSize.x, imageSize.x);
+            row[x] = worldX >= 0 && worldX < _worldSize.x ? getPixel(level, {worldX >> level, worldY >> level})
+                                                          : Const::PixelImageNothingnessColor;
+        }
+    }
+}
+
+int TiledPixelImage::calcPixelIndex(int level, IntVector2D const& pos) const
+{
+    auto const& tileSlots = _tileSlotsByLevel[level];
+    if (tileSlots.empty()) {
+        return NoSlot;
+    }
+    auto const numTiles = getNumTiles(level);
+    auto const tileSlot = tileSlots[(pos.y / TileSize) * numTiles.x + pos.x / TileSize];
+    if (NoSlot == tileSlot) {
+        return NoSlot;
+    }
+    return tileSlot * TileSize * TileSize + (pos.y % TileSize) * TileSize + pos.x % TileSize;
+}
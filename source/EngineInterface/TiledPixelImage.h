@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Definitions.h"
+#include "PixelImageConstants.h"
+
+/**
+ * Pixel image of the whole world as a pyramid of levels. One pixel of level L covers 2^L x 2^L world units.
+ * Every level is divided into square tiles whose pixels are stored contiguously so that changed tiles can be
+ * transferred as blocks. Pixel memory is only used for tiles which have been written, other tiles show nothingness.
+ */
+class ENGINEINTERFACE_EXPORT TiledPixelImage
+{
+public:
+    static int const TileSize = Const::PixelImageTileSize;
+    static int const MaxLevel = Const::PixelImageMaxLevel;
+
+    //finest level at which the rect does not need more pixels than the image provides
+    static int calcLevel(IntVector2D const& rectSize, IntVector2D const& imageSize);
+
+    TiledPixelImage(IntVector2D const& worldSize);
+
+    IntVector2D getWorldSize() const;
+    IntVector2D getLevelSize(int level) const;
+    IntVector2D getNumTiles(int level) const;
+
+    //tiles of the level which overlap the rect, p2 is exclusive
+    IntRect getTileRect(IntRect const& rect, int level) const;
+
+    //TileSize * TileSize pixels, row by row, tiles are allocated on first access
+    //the pointer is valid until the next allocation
+    unsigned int* getTile(int level, int tileIndex);
+    unsigned int getPixel(int level, IntVector2D const& pos) const;
+
+    //samples the rect (p2 exclusive) from the level selected by calcLevel, outside of the world is nothingness
+    void drawImage(IntRect const& rect, IntVector2D const& imageSize, unsigned int* imageData) const;
+
+private:
+    static constexpr int NoSlot = -1;
+
+    //NoSlot if tile of the pixel is not allocated
+    int calcPixelIndex(int level, IntVector2D const& pos) const;
+
+    IntVector2D _worldSize;
+    vector<vector<int>> _tileSlotsByLevel;          //per tile: position of its pixels in _pixelsByLevel
+    vector<vector<unsigned int>> _pixelsByLevel;    //allocated tiles one after another
+};
+
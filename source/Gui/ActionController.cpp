@@ -178,6 +178,8 @@ void ActionController::init(
 	connect(actions->actionGridMultiplier, &QAction::triggered, this, &ActionController::onGridMultiplier);
 
     connect(actions->actionMostFrequentCluster, &QAction::triggered, this, &ActionController::onMostFrequentCluster);
+    connect(actions->actionSpeciesCensus, &QAction::triggered, this, &ActionController::onSpeciesCensus);
+    connect(actions->actionRecordFrames, &QAction::triggered, this, &ActionController::onRecordFrames);
 
 	connect(actions->actionAbout, &QAction::triggered, this, &ActionController::onShowAbout);
     connect(actions->actionGettingStarted, &QAction::triggered, this, &ActionController::onToggleGettingStarted);
@@ -847,6 +849,48 @@ void ActionController::onMostFrequentCluster()
 	loggingService->logMessage(Priority::Unimportant, "find most frequent active cluster finished");
 }
 
+void ActionController::onSpeciesCensus(bool toggled)
+{
+    auto loggingService = ServiceLocator::getInstance().getService<LoggingService>();
+    if (toggled) {
+        loggingService->logMessage(Priority::Important, "activate species census");
+        _mainController->onSpeciesCensus(true);
+    }
+    else {
+        loggingService->logMessage(Priority::Important, "deactivate species census");
+        _mainController->onSpeciesCensus(false);
+
+        QString filename = QFileDialog::getSaveFileName(_mainView, "Save Species Census", "", "Species Census (*.csv)");
+        if (!filename.isEmpty()) {
+            if (!_mainController->onSaveSpeciesCensus(filename.toStdString())) {
+                QMessageBox msgBox(QMessageBox::Critical, "Error", Const::ErrorSaveSpeciesCensus);
+                msgBox.exec();
+            }
+        }
+    }
+    loggingService->logMessage(Priority::Unimportant, "toggle species census finished");
+}
+
+void ActionController::onRecordFrames(bool toggled)
+{
+    auto loggingService = ServiceLocator::getInstance().getService<LoggingService>();
+    if (toggled) {
+        QString directory = QFileDialog::getExistingDirectory(_mainView, "Record Frames");
+        if (directory.isEmpty()) {
+            auto actions = _model->getActionHolder();
+            actions->actionRecordFrames->setChecked(false);
+            return;
+        }
+        loggingService->logMessage(Priority::Important, "start frame recording");
+        _mainController->onRecordFrames(true, directory.toStdString());
+    }
+    else {
+        loggingService->logMessage(Priority::Important, "stop frame recording");
+        _mainController->onRecordFrames(false);
+    }
+    loggingService->logMessage(Priority::Unimportant, "toggle frame recording finished");
+}
+
 void ActionController::onDeleteEntity()
 {
     onDeleteSelection();
@@ -1328,6 +1372,8 @@ void ActionController::settingUpNewSimulation(SimulationConfig const& config)
     actions->actionDisplayLink->setChecked(true);
     actions->actionGlowEffect->setEnabled(true);
     actions->actionSimulationChanger->setChecked(false);
+    actions->actionSpeciesCensus->setChecked(false);
+    actions->actionRecordFrames->setChecked(false);
     actions->actionWebSimulation->setChecked(false);
     onRunClicked(false);
     onToggleCellInfo(true);
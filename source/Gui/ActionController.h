@@ -89,6 +89,8 @@ private:
 	Q_SLOT void onGridMultiplier();
 
     Q_SLOT void onMostFrequentCluster();
+    Q_SLOT void onSpeciesCensus(bool toggled);
+    Q_SLOT void onRecordFrames(bool toggled);
 
 	Q_SLOT void onShowAbout();
     Q_SLOT void onToggleGettingStarted(bool toggled);
@@ -320,6 +320,18 @@ ActionHolder::ActionHolder(QObject* parent) : QObject(parent)
     actionMostFrequentCluster = new QAction("Most frequent active cluster", this);
     actionMostFrequentCluster->setEnabled(true);
 
+    actionSpeciesCensus = new QAction("Species census", this);
+    actionSpeciesCensus->setEnabled(true);
+    actionSpeciesCensus->setCheckable(true);
+    actionSpeciesCensus->setChecked(false);
+    actionSpeciesCensus->setToolTip("Count cluster species in the background");
+
+    actionRecordFrames = new QAction("Record frames", this);
+    actionRecordFrames->setEnabled(true);
+    actionRecordFrames->setCheckable(true);
+    actionRecordFrames->setChecked(false);
+    actionRecordFrames->setToolTip("Save an image of the world every 100 time steps");
+
 	actionAbout = new QAction("About", this);
 	actionAbout->setEnabled(true);
     
@@ -76,6 +76,8 @@ public:
 	QAction* actionGridMultiplier = nullptr;
 
     QAction* actionMostFrequentCluster = nullptr;
+    QAction* actionSpeciesCensus = nullptr;
+    QAction* actionRecordFrames = nullptr;
 
 	QAction* actionAbout = nullptr;
     QAction* actionGettingStarted = nullptr;
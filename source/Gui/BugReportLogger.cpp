@@ -17,10 +17,15 @@ BugReportLogger::~BugReportLogger()
 
 void BugReportLogger::newLogMessage(Priority priority, std::string const& message)
 {
+    std::lock_guard<std::mutex> lock(_mutex);
     _stream << message << std::endl;
 }
 
 std::string BugReportLogger::getFullProtocol() const
 {
+    auto loggingService = ServiceLocator::getInstance().getService<LoggingService>();
+    loggingService->flush();
+
+    std::lock_guard<std::mutex> lock(_mutex);
     return _stream.str();
 }
@@ -19,8 +19,15 @@ void CellConnectionItem::update(CellDescription const & cell1, CellDescription c
 {
 	auto pos1 = CoordinateSystem::modelToScene(*cell1.pos);
 	auto pos2 = CoordinateSystem::modelToScene(*cell2.pos);
-	_dx = (pos2.x() - pos1.x());
-	_dy = (pos2.y() - pos1.y());
+	auto dx = pos2.x() - pos1.x();
+	auto dy = pos2.y() - pos1.y();
+
+	//the bounding rect depends on _dx and _dy, the scene index is invalid if they change unannounced
+	if (dx != _dx || dy != _dy) {
+		prepareGeometryChange();
+		_dx = dx;
+		_dy = dy;
+	}
 
 	QGraphicsItem::setPos(QPointF(pos1.x(), pos1.y()));
 
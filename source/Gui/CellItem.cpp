@@ -42,7 +42,12 @@ CellItem::CellItem (ItemConfig* config, CellDescription const& desc, QGraphicsIt
 
 void CellItem::update(CellDescription const &desc)
 {
+	//the description is always kept up to date since it is read back, e.g. for selections
+	auto const sameAppearance = hasSameAppearance(desc);
 	_desc = desc;
+	if (sameAppearance) {
+		return;
+	}
 	auto pos = CoordinateSystem::modelToScene(*desc.pos);
 	QGraphicsItem::setPos(QPointF(pos.x(), pos.y()));
 	_displayString = getTypeString(_desc.cellFeature->getType());
@@ -206,6 +211,27 @@ bool CellItem::isConnectable() const
 	return (numConnections < maxConnections);
 }
 
+bool CellItem::hasSameAppearance(CellDescription const& desc) const
+{
+	auto getNumTokens = [](CellDescription const& desc) {
+		return desc.tokens ? desc.tokens->size() : 0;
+	};
+	auto getType = [](CellDescription const& desc) {
+		return desc.cellFeature ? desc.cellFeature->getType() : Enums::CellFunction::_COUNTER;
+	};
+	auto getColor = [](CellDescription const& desc) {
+		return desc.metadata ? desc.metadata->color : CellMetadata().color;
+	};
+	return _desc.id == desc.id
+		&& _desc.pos == desc.pos
+		&& _desc.tokenBranchNumber == desc.tokenBranchNumber
+		&& _desc.maxConnections == desc.maxConnections
+		&& _desc.connectingCells == desc.connectingCells
+		&& getNumTokens(_desc) == getNumTokens(desc)
+		&& getType(_desc) == getType(desc)
+		&& getColor(_desc) == getColor(desc);
+}
+
 uint8_t CellItem::getColorCode() const
 {
 	return _desc.metadata.get_value_or(CellMetadata()).color;
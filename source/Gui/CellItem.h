@@ -39,6 +39,7 @@ private:
 	int getNumToken() const;
 	bool isConnectable() const;
 	uint8_t getColorCode() const;
+	bool hasSameAppearance(CellDescription const& desc) const;
 
 	ItemConfig *_config = nullptr;
     FocusState _focusState = FocusState::NO_FOCUS;
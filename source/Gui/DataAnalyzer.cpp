@@ -1,6 +1,12 @@
+#include <algorithm>
+#include <future>
+
 #include <boost/range/adaptors.hpp>
 #include <QMessageBox>
 
+#include "Base/JobExecutor.h"
+
+#include "EngineInterface/ClusterHasher.h"
 #include "EngineInterface/SimulationAccess.h"
 #include "EngineInterface/Descriptions.h"
 
@@ -71,11 +77,30 @@ auto DataAnalyzer::calcPartitionData(DataDescription const& data) const
     std::map<ClusterAnalysisDescription, PartitionData> result;
 
     if (auto const& clusters = data.clusters) {
-        for (auto const& cluster : *clusters) {
-            auto const clusterAnalysisData = getAnalysisDescription(cluster);
-            auto& partitionData = result[clusterAnalysisData];
+
+        //clusters are distributed interleaved since large ones tend to be adjacent
+        vector<ClusterAnalysisDescription> descriptions(clusters->size());
+        auto& executor = JobExecutor::getInstance();
+        auto const numClusters = static_cast<int>(clusters->size());
+        auto const numTasks = executor.getNumThreads();
+        vector<std::future<void>> tasks;
+        for (int taskIndex = 0; taskIndex < numTasks; ++taskIndex) {
+            tasks.emplace_back(executor
+                                   .submit([&, taskIndex] {
+                                       for (int index = taskIndex; index < numClusters; index += numTasks) {
+                                           descriptions[index] = getAnalysisDescription(clusters->at(index));
+                                       }
+                                   })
+                                   .second);
+        }
+        for (auto& task : tasks) {
+            task.get();
+        }
+
+        for (int index = 0; index < clusters->size(); ++index) {
+            auto& partitionData = result[descriptions[index]];
             if (1 == ++partitionData.numberOfElements) {
-                partitionData.representant = cluster;
+                partitionData.representant = clusters->at(index);
             }
         }
     }
@@ -86,24 +111,21 @@ auto DataAnalyzer::getAnalysisDescription(ClusterDescription const& cluster) con
 {
     ClusterAnalysisDescription result;
     result.hasToken = false;
+    result.numCells = 0;
+    result.numBonds = 0;
     if (auto const& cells = cluster.cells) {
+        result.numCells = static_cast<int>(cells->size());
         for (auto const& cell : *cells) {
-            CellAnalysisDescription cellAnalysisData;
-            cellAnalysisData.maxConnections = *cell.maxConnections;
-            cellAnalysisData.numConnections = cell.connectingCells->size();
-            cellAnalysisData.tokenBlocked = *cell.tokenBlocked;
-            cellAnalysisData.tokenBranchNumber = *cell.tokenBranchNumber;
-
-            CellFeatureAnalysisDescription featureAnalysisData;
-            featureAnalysisData.cellFunction = cell.cellFeature->getType();
-            featureAnalysisData.constData = cell.cellFeature->constData;
-            cellAnalysisData.feature = featureAnalysisData;
-            
-            result.cells.emplace_back(cellAnalysisData);
             if (cell.tokens && cell.tokens->size() > 0) {
                 result.hasToken = true;
             }
+            auto const numConnections = cell.connectingCells ? static_cast<int>(cell.connectingCells->size()) : 0;
+            result.sortedNumConnections.emplace_back(numConnections);
+            result.numBonds += numConnections;
         }
     }
+    result.numBonds /= 2;
+    std::sort(result.sortedNumConnections.begin(), result.sortedNumConnections.end());
+    result.structureHash = ClusterHasher::calcStructureHash(cluster);
     return result;
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <tuple>
+
 #include <QObject>
 
 #include "EngineInterface/Descriptions.h"
@@ -20,84 +22,25 @@ public:
 private:
     Q_SLOT void dataFromAccessAvailable();
 
-    struct CellFeatureAnalysisDescription
-    {
-        int cellFunction;
-        QByteArray constData;
-
-        bool operator<(CellFeatureAnalysisDescription const& other) const {
-            if (cellFunction != other.cellFunction) {
-                return cellFunction < other.cellFunction;
-            }
-            if (constData != other.constData) {
-                return constData < other.constData;
-            }
-            return false;
-        }
-        bool operator==(CellFeatureAnalysisDescription const& other) const
-        {
-            return cellFunction == other.cellFunction && constData == other.constData;
-        }
-        bool operator!=(CellFeatureAnalysisDescription const& other) const
-        {
-            return !operator==(other);
-        }
-    };
-    struct CellAnalysisDescription
-    {
-        int maxConnections;
-        int numConnections;
-        bool tokenBlocked;
-        int tokenBranchNumber;
-        CellFeatureAnalysisDescription feature;
-
-        bool operator==(CellAnalysisDescription const& other) const
-        {
-            return maxConnections == other.maxConnections
-                && numConnections == other.numConnections
-                && tokenBlocked == other.tokenBlocked
-                && tokenBranchNumber == other.tokenBranchNumber
-                && feature == other.feature;
-        }
-
-        bool operator!=(CellAnalysisDescription const& other) const
-        {
-            return !operator==(other);
-        }
-
-        bool operator<(CellAnalysisDescription const& other) const
-        {
-            if (maxConnections != other.maxConnections) {
-                return maxConnections < other.maxConnections;
-            }
-            if (numConnections != other.numConnections) {
-                return numConnections < other.numConnections;
-            }
-            if (tokenBlocked != other.tokenBlocked) {
-                return tokenBlocked < other.tokenBlocked;
-            }
-            if (tokenBranchNumber != other.tokenBranchNumber) {
-                return tokenBranchNumber < other.tokenBranchNumber;
-            }
-            if (feature != other.feature) {
-                return feature < other.feature;
-            }
-            return false;
-        }
-    };
     struct ClusterAnalysisDescription
     {
         bool hasToken;
-        std::vector<CellAnalysisDescription> cells;
+        uint64_t structureHash;    //does not depend on the order of the cells
 
-        bool operator<(ClusterAnalysisDescription const& other) const {
-            if (hasToken != other.hasToken) {
-                return hasToken < other.hasToken;
-            }
-            if (cells != other.cells) {
-                return cells < other.cells;
-            }
-            return false;
+        //exact properties which separate clusters with colliding hashes
+        int numCells;
+        int numBonds;
+        vector<int> sortedNumConnections;
+
+        bool operator<(ClusterAnalysisDescription const& other) const
+        {
+            return std::tie(hasToken, structureHash, numCells, numBonds, sortedNumConnections)
+                < std::tie(
+                       other.hasToken,
+                       other.structureHash,
+                       other.numCells,
+                       other.numBonds,
+                       other.sortedNumConnections);
         }
     };
     struct PartitionData
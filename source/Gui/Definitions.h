@@ -89,6 +89,7 @@ class WebSimulationSelectionController;
 class WebSimulationTableModel;
 
 class WebSimulationController;
+class SendStatisticsJob;
 
 enum class ModelComputationType
 {
@@ -96,6 +97,7 @@ enum class ModelComputationType
 };
 
 class DataAnalyzer;
+class SpeciesCensus;
 class Queue;
 class GettingStartedWindow;
 
@@ -19,9 +19,14 @@ GuiLogger::~GuiLogger()
     loggingService->unregisterCallBack(this);
 }
 
+//called on the logging thread, the view is updated in the GUI thread
 void GuiLogger::newLogMessage(Priority priority, std::string const& message)
 {
-    if (Priority::Important == priority) {
-        _view->setNewLogMessage(message);
-    }
+    auto const view = _view;
+    QMetaObject::invokeMethod(_view, [view, message] { view->setNewLogMessage(message); }, Qt::QueuedConnection);
+}
+
+Priority GuiLogger::getMinPriority() const
+{
+    return Priority::Important;
 }
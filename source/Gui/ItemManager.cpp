@@ -26,6 +26,15 @@ void ItemManager::init(QGraphicsScene * scene, ViewportInterface* viewport, Simu
 	_config->init(parameters);
 }
 
+namespace
+{
+	//entities slightly outside the viewport are kept to avoid churn at the borders while scrolling
+	qreal const VisibleRectMargin = 10.0;
+
+	//hidden items kept for reuse, further released items are deleted
+	int const MaxPoolSize = 10000;
+}
+
 void ItemManager::activate(IntVector2D size)
 {
     TRY;
@@ -34,144 +43,183 @@ void ItemManager::activate(IntVector2D size)
 	_cellsByIds.clear();
 	_particlesByIds.clear();
 	_connectionsByIds.clear();
+
+	//items have already been deleted by the scene
+	_cellPool.clear();
+	_particlePool.clear();
+	_connectionPool.clear();
     CATCH;
 }
 
-void ItemManager::updateCells(DataRepository* dataController)
+QRectF ItemManager::calcVisibleRect() const
+{
+	auto const rect = _viewport->getRect();
+	return rect.adjusted(-VisibleRectMargin, -VisibleRectMargin, VisibleRectMargin, VisibleRectMargin);
+}
+
+template<typename Item>
+Item* ItemManager::takeFromPool(vector<Item*>& pool)
+{
+	if (pool.empty()) {
+		return nullptr;
+	}
+	auto item = pool.back();
+	pool.pop_back();
+	item->setVisible(true);
+	return item;
+}
+
+template<typename Item, typename Key, typename Hash>
+void ItemManager::removeUnvisitedItems(unordered_map<Key, ItemEntry<Item>, Hash>& itemsByKeys, vector<Item*>& pool)
+{
+	for (auto it = itemsByKeys.begin(); it != itemsByKeys.end();) {
+		if (it->second.generation == _generation) {
+			++it;
+			continue;
+		}
+		auto item = it->second.item;
+		if (static_cast<int>(pool.size()) < MaxPoolSize) {
+			item->setVisible(false);
+			pool.emplace_back(item);
+		}
+		else {
+			delete item;
+		}
+		it = itemsByKeys.erase(it);
+	}
+}
+
+void ItemManager::updateCells(DataRepository* dataController, QRectF const& visibleRect)
 {
     TRY;
 	auto const &data = dataController->getDataRef();
 
-	map<uint64_t, CellItem*> newCellsByIds;
 	if (data.clusters) {
 		for (auto const &cluster : *data.clusters) {
 			for (auto const &cell : *cluster.cells) {
-				auto it = _cellsByIds.find(cell.id);
-				CellItem* item;
-				if (it != _cellsByIds.end()) {
-					item = it->second;
+				if (!visibleRect.contains(cell.pos->x(), cell.pos->y())) {
+					continue;
+				}
+				auto& entry = _cellsByIds[cell.id];
+				if (entry.item) {
+					entry.item->update(cell);
+				}
+				else if (auto item = takeFromPool(_cellPool)) {
 					item->update(cell);
-					newCellsByIds.insert_or_assign(cell.id, item);
-					_cellsByIds.erase(it);
+					entry.item = item;
 				}
 				else {
-					item = new CellItem(_config, cell);
-					_scene->addItem(item);
-					newCellsByIds[cell.id] = item;
+					entry.item = new CellItem(_config, cell);
+					_scene->addItem(entry.item);
 				}
+				entry.generation = _generation;
+
 				if (dataController->isInSelection(cell.id)) {
-					item->setFocusState(CellItem::FOCUS_CELL);
+					entry.item->setFocusState(CellItem::FOCUS_CELL);
 				}
 				else if (dataController->isInExtendedSelection(cell.id)) {
-					item->setFocusState(CellItem::FOCUS_CLUSTER);
+					entry.item->setFocusState(CellItem::FOCUS_CLUSTER);
 				}
 				else {
-					item->setFocusState(CellItem::NO_FOCUS);
+					entry.item->setFocusState(CellItem::NO_FOCUS);
 				}
 			}
 		}
 	}
-	for (auto const& cellById : _cellsByIds) {
-		delete cellById.second;
-	}
-	_cellsByIds = newCellsByIds;
+	removeUnvisitedItems(_cellsByIds, _cellPool);
     CATCH;
 }
 
-void ItemManager::updateParticles(DataRepository* manipulator)
+void ItemManager::updateParticles(DataRepository* manipulator, QRectF const& visibleRect)
 {
     TRY;
     auto const& data = manipulator->getDataRef();
 
-	map<uint64_t, ParticleItem*> newParticlesByIds;
 	if (data.particles) {
 		for (auto const &particle : *data.particles) {
-			auto it = _particlesByIds.find(particle.id);
-			ParticleItem* item;
-			if (it != _particlesByIds.end()) {
-				item = it->second;
+			if (!visibleRect.contains(particle.pos->x(), particle.pos->y())) {
+				continue;
+			}
+			auto& entry = _particlesByIds[particle.id];
+			if (entry.item) {
+				entry.item->update(particle);
+			}
+			else if (auto item = takeFromPool(_particlePool)) {
 				item->update(particle);
-				newParticlesByIds.insert_or_assign(particle.id, item);
-				_particlesByIds.erase(it);
+				entry.item = item;
 			}
 			else {
-				item = new ParticleItem(_config, particle);
-				_scene->addItem(item);
-				newParticlesByIds.insert_or_assign(particle.id, item);
+				entry.item = new ParticleItem(_config, particle);
+				_scene->addItem(entry.item);
 			}
+			entry.generation = _generation;
+
 			if (manipulator->isInSelection(particle.id)) {
-				item->setFocusState(ParticleItem::FOCUS);
+				entry.item->setFocusState(ParticleItem::FOCUS);
 			}
 			else {
-				item->setFocusState(ParticleItem::NO_FOCUS);
+				entry.item->setFocusState(ParticleItem::NO_FOCUS);
 			}
 		}
 	}
-	for (auto const& particleById : _particlesByIds) {
-		delete particleById.second;
-	}
-	_particlesByIds = newParticlesByIds;
+	removeUnvisitedItems(_particlesByIds, _particlePool);
     CATCH;
 }
 
-void ItemManager::updateConnections(DataRepository* repository)
+void ItemManager::updateConnections(DataRepository* repository, QRectF const& visibleRect)
 {
     TRY;
     auto const& data = repository->getDataRef();
-	if (!data.clusters) {
-		return;
-	}
 
-	map<set<uint64_t>, CellConnectionItem*> newConnectionsByIds;
-	for (auto const &cluster : *data.clusters) {
-		for (auto const &cell : *cluster.cells) {
-			if (!cell.connectingCells) {
-				continue;
-			}
-			for (uint64_t connectingCellId : *cell.connectingCells) {
-				if (!repository->isCellPresent(connectingCellId)) {
-					continue;
-				}
-				auto &connectingCellD = repository->getCellDescRef(connectingCellId);
-				set<uint64_t> connectionId;
-				connectionId.insert(cell.id);
-				connectionId.insert(connectingCellId);
-				if (newConnectionsByIds.find(connectionId) != newConnectionsByIds.end()) {
+	if (data.clusters) {
+		for (auto const &cluster : *data.clusters) {
+			for (auto const &cell : *cluster.cells) {
+				if (!cell.connectingCells) {
 					continue;
 				}
-				//update may lead to exception in rare cases (Qt bug?)
-/*
-				auto connectionIt = _connectionsByIds.find(connectionId);
-				if (connectionIt != _connectionsByIds.end()) {
-					CellConnectionItem* connection = connectionIt->second;
-					connection->update(cell, connectingCellD);
-					newConnectionsByIds[connectionId] = connection;
-					_connectionsByIds.erase(connectionIt);
-				}
-				else {
-*/
-					CellConnectionItem* newConnection = new CellConnectionItem(_config, cell, connectingCellD);
-					_scene->addItem(newConnection);
-					newConnectionsByIds[connectionId] = newConnection;
-/*
+				auto const isCellVisible = visibleRect.contains(cell.pos->x(), cell.pos->y());
+				for (uint64_t connectingCellId : *cell.connectingCells) {
+					if (!repository->isCellPresent(connectingCellId)) {
+						continue;
+					}
+
+					//connections are shown if at least one end is visible
+					auto &connectingCellD = repository->getCellDescRef(connectingCellId);
+					if (!isCellVisible && !visibleRect.contains(connectingCellD.pos->x(), connectingCellD.pos->y())) {
+						continue;
+					}
+					auto& entry = _connectionsByIds[ConnectionKey(cell.id, connectingCellId)];
+					if (entry.generation == _generation) {
+						continue;
+					}
+					if (entry.item) {
+						entry.item->update(cell, connectingCellD);
+					}
+					else if (auto item = takeFromPool(_connectionPool)) {
+						item->update(cell, connectingCellD);
+						entry.item = item;
+					}
+					else {
+						entry.item = new CellConnectionItem(_config, cell, connectingCellD);
+						_scene->addItem(entry.item);
+					}
+					entry.generation = _generation;
 				}
-*/
 			}
 		}
 	}
-	for (auto const& connectionById : _connectionsByIds) {
-		delete connectionById.second;
-	}
-	_connectionsByIds = newConnectionsByIds;
+	removeUnvisitedItems(_connectionsByIds, _connectionPool);
     CATCH;
 }
 
 void ItemManager::update(DataRepository* repository)
 {
     TRY;
-    updateCells(repository);
-	updateConnections(repository);
-	updateParticles(repository);
+	++_generation;
+	auto const visibleRect = calcVisibleRect();
+    updateCells(repository, visibleRect);
+	updateConnections(repository, visibleRect);
+	updateParticles(repository, visibleRect);
     CATCH;
 }
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <QRectF>
+
 #include "EngineInterface/Definitions.h"
 #include "Gui/Definitions.h"
 
@@ -27,18 +29,60 @@ public:
 	virtual void toggleCellInfo(bool showInfo);
 
 private:
-	void updateCells(DataRepository* visualDesc);
-	void updateConnections(DataRepository* visualDesc);
-	void updateParticles(DataRepository* visualDesc);
-		
+	//both cell ids packed into one key, the lower id comes first
+	struct ConnectionKey
+	{
+		uint64_t lowerId;
+		uint64_t higherId;
+
+		ConnectionKey(uint64_t id1, uint64_t id2) : lowerId(std::min(id1, id2)), higherId(std::max(id1, id2)) {}
+		bool operator==(ConnectionKey const& other) const
+		{
+			return lowerId == other.lowerId && higherId == other.higherId;
+		}
+	};
+	struct ConnectionKeyHash
+	{
+		std::size_t operator()(ConnectionKey const& key) const
+		{
+			return std::hash<uint64_t>()(key.lowerId * 0x9e3779b97f4a7c15ull ^ key.higherId);
+		}
+	};
+
+	//items which have not been visited in the current generation are removed after an update
+	template<typename Item>
+	struct ItemEntry
+	{
+		Item* item = nullptr;
+		uint32_t generation = 0;
+	};
+
+	void updateCells(DataRepository* visualDesc, QRectF const& visibleRect);
+	void updateConnections(DataRepository* visualDesc, QRectF const& visibleRect);
+	void updateParticles(DataRepository* visualDesc, QRectF const& visibleRect);
+
+	QRectF calcVisibleRect() const;
+
+	template<typename Item, typename Key, typename Hash>
+	void removeUnvisitedItems(unordered_map<Key, ItemEntry<Item>, Hash>& itemsByKeys, vector<Item*>& pool);
+	template<typename Item>
+	Item* takeFromPool(vector<Item*>& pool);
+
+
 	QGraphicsScene* _scene = nullptr;
 	ViewportInterface* _viewport = nullptr;
 	SimulationParameters _parameters;
 	ItemConfig* _config = nullptr;
 
-	map<uint64_t, CellItem*> _cellsByIds;
-	map<uint64_t, ParticleItem*> _particlesByIds;
-	map<set<uint64_t>, CellConnectionItem*> _connectionsByIds;
+	uint32_t _generation = 0;
+	unordered_map<uint64_t, ItemEntry<CellItem>> _cellsByIds;
+	unordered_map<uint64_t, ItemEntry<ParticleItem>> _particlesByIds;
+	unordered_map<ConnectionKey, ItemEntry<CellConnectionItem>, ConnectionKeyHash> _connectionsByIds;
+
+	//hidden items for reuse when entities enter the visible region
+	vector<CellItem*> _cellPool;
+	vector<ParticleItem*> _particlePool;
+	vector<CellConnectionItem*> _connectionPool;
 	MarkerItem* _marker = nullptr;
 };
 
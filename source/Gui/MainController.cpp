@@ -24,6 +24,7 @@
 #include "EngineInterface/SimulationMonitor.h"
 #include "EngineInterface/SerializationHelper.h"
 #include "EngineInterface/SimulationChanger.h"
+#include "EngineInterface/FrameRecorder.h"
 
 #include "EngineGpu/SimulationAccessGpu.h"
 #include "EngineGpu/SimulationControllerGpu.h"
@@ -43,6 +44,7 @@
 #include "Notifier.h"
 #include "SimulationConfig.h"
 #include "DataAnalyzer.h"
+#include "SpeciesCensus.h"
 #include "QApplicationHelper.h"
 #include "Queue.h"
 #include "WebSimulationController.h"
@@ -121,6 +123,7 @@ void MainController::init()
     _repository = new DataRepository(this);
     _notifier = new Notifier(this);
     _dataAnalyzer = new DataAnalyzer(this);
+    _speciesCensus = new SpeciesCensus(this);
     auto worker = new Queue(this);
     SET_CHILD(_worker, worker);
 
@@ -289,6 +292,20 @@ void MainController::initSimulation(SymbolTable* symbolTable, SimulationParamete
 	_snapshotController->init(_simController->getContext(), _accessBuildFunc(_simController));
 	_repository->init(_notifier, _accessBuildFunc(_simController), _descHelper, context);
     _dataAnalyzer->init(_accessBuildFunc(_simController), _repository, _notifier);
+    _speciesCensus->init(_accessBuildFunc(_simController), context);
+
+    if (_frameRecorder) {
+        _frameRecorder->stop();
+    }
+    auto recorderAccess = _accessBuildFunc(_simController);
+    auto frameRecorder = EngineInterfaceFacade->buildFrameRecorder(recorderAccess, context);
+    recorderAccess->setParent(frameRecorder);
+    SET_CHILD(_frameRecorder, frameRecorder);
+    connect(
+        _simController,
+        &SimulationController::nextTimestepCalculated,
+        _frameRecorder,
+        &FrameRecorder::notifyNextTimestep);
 
 	auto simMonitor = _monitorBuildFunc(_simController);
 	SET_CHILD(_simMonitor, simMonitor);
@@ -447,6 +464,36 @@ void MainController::onAddMostFrequentClusterToSimulation()
     _dataAnalyzer->addMostFrequenceClusterRepresentantToSimulation();
 }
 
+void MainController::onSpeciesCensus(bool toggled)
+{
+    if (toggled) {
+        _speciesCensus->activate();
+    }
+    else {
+        _speciesCensus->deactivate();
+    }
+}
+
+bool MainController::onSaveSpeciesCensus(string const& filename) const
+{
+    return _speciesCensus->saveToFile(filename);
+}
+
+void MainController::onRecordFrames(bool toggled, string const& directory)
+{
+    if (toggled) {
+        auto const universeSize = _simController->getContext()->getSpaceProperties()->getSize();
+        FrameRecorderSettings settings;
+        settings.directory = directory;
+        settings.rect = {{0, 0}, universeSize};
+        settings.imageSize = universeSize;
+        _frameRecorder->start(settings);
+    }
+    else {
+        _frameRecorder->stop();
+    }
+}
+
 int MainController::getTimestep() const
 {
     if (_simController) {
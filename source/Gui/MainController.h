@@ -37,6 +37,9 @@ public:
     void onUpdateExecutionParameters(ExecutionParameters const& parameters);
     void onRestrictTPS(boost::optional<int> const& tps);
     void onAddMostFrequentClusterToSimulation();
+    void onSpeciesCensus(bool toggled);
+    bool onSaveSpeciesCensus(string const& filename) const;
+    void onRecordFrames(bool toggled, string const& directory = string());
 
 	int getTimestep() const;
 	SimulationConfig getSimulationConfig() const;
@@ -74,6 +77,8 @@ private:
 	Serializer* _serializer = nullptr;
 	DescriptionHelper* _descHelper = nullptr;
     DataAnalyzer* _dataAnalyzer = nullptr;
+    SpeciesCensus* _speciesCensus = nullptr;
+    FrameRecorder* _frameRecorder = nullptr;
     WebAccess* _webAccess = nullptr;
     WebSimulationController* _webSimController = nullptr;
 
@@ -281,6 +281,8 @@ void MainView::setupMenuAndToolbar()
     ui->menuCollection->addAction(actions->actionGridMultiplier);
 
     ui->menuTools->addAction(actions->actionMostFrequentCluster);
+    ui->menuTools->addAction(actions->actionSpeciesCensus);
+    ui->menuTools->addAction(actions->actionRecordFrames);
     ui->menuTools->addAction(actions->actionSimulationChanger);
 
     ui->menuHelp->addAction(actions->actionAbout);
@@ -30,6 +30,7 @@ SendLastImageJob::SendLastImageJob(
 {
     connect(_simAccess, &SimulationAccess::imageReady, this, &SendLastImageJob::imageFromGpuReceived);
     connect(_webAccess, &WebAccess::sendLastImageReceived, this, &SendLastImageJob::serverReceivedImage);
+    connect(_webAccess, &WebAccess::sendLastImageFailed, this, &SendLastImageJob::serverFailedToReceiveImage);
 }
 
 void SendLastImageJob::process()
@@ -44,7 +45,12 @@ void SendLastImageJob::process()
         requestImage();
         break;
     case State::ImageFromGpuRequested:
-        sendImageToServer();
+        encodeImage();
+        break;
+    case State::ImageEncoding:
+        if (isReady(_encoding)) {
+            sendImageToServer();
+        }
         break;
     case State::ImageToServerSent:
         finish();
@@ -80,13 +86,28 @@ void SendLastImageJob::requestImage()
     _isReady = false;
 }
 
+//png encoding of large worlds takes a while, hence it runs in background
+void SendLastImageJob::encodeImage()
+{
+    _encoding = runInBackground([image = _image] {
+                    QByteArray result;
+                    QBuffer buffer(&result);
+                    buffer.open(QIODevice::WriteOnly);
+                    image->save(&buffer, "PNG");
+                    return result;
+                }).second;
+
+    _state = State::ImageEncoding;
+}
+
 void SendLastImageJob::sendImageToServer()
 {
+    _encodedImageData = _encoding.get();
+    _image.reset();
+
     delete _buffer;
     _buffer = new QBuffer(&_encodedImageData);
-    _buffer->open(QIODevice::ReadWrite);
-    _image->save(_buffer, "PNG");
-    _buffer->seek(0);
+    _buffer->open(QIODevice::ReadOnly);
 
     auto loggingService = ServiceLocator::getInstance().getService<LoggingService>();
 
@@ -133,3 +154,16 @@ void SendLastImageJob::serverReceivedImage()
     delete _buffer;
     _buffer = nullptr;
 }
+
+void SendLastImageJob::serverFailedToReceiveImage()
+{
+    if (State::ImageToServerSent != _state) {
+        return;
+    }
+    auto loggingService = ServiceLocator::getInstance().getService<LoggingService>();
+    loggingService->logMessage(Priority::Important, "Web: last image could not be sent");
+    _isReady = true;
+
+    delete _buffer;
+    _buffer = nullptr;
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <QByteArray>
+
 #include "Base/Job.h"
 
 #include "Web/Definitions.h"
@@ -26,16 +28,19 @@ public:
 
 private:
     void requestImage();
+    void encodeImage();
     void sendImageToServer();
     void finish();
 
     Q_SLOT void imageFromGpuReceived();
     Q_SLOT void serverReceivedImage();
+    Q_SLOT void serverFailedToReceiveImage();
 
     enum class State
     {
         Init,
         ImageFromGpuRequested,
+        ImageEncoding,
         ImageToServerSent,
         Finished
     };
@@ -49,6 +54,7 @@ private:
     string _currentToken;
 
     QImagePtr _image;
+    std::future<QByteArray> _encoding;
     QBuffer* _buffer = nullptr;
     QByteArray _encodedImageData;
 
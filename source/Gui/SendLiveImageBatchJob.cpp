@@ -0,0 +1,180 @@
+#include "SendLiveImageBatchJob.h"
+
+#include <sstream>
+#include <QBuffer>
+#include <QImage>
+
+#include "Base/ServiceLocator.h"
+#include "Base/LoggingService.h"
+
+#include "EngineInterface/SimulationAccess.h"
+
+#include "Web/WebAccess.h"
+
+#include "SendStatisticsJob.h"
+
+SendLiveImageBatchJob::SendLiveImageBatchJob(
+    string const& currentSimulationId,
+    string const& currentToken,
+    vector<TaskBatch> const& batches,
+    unordered_map<string, TileDeltaEncoderPtr> const& encoderByTaskId,
+    SimulationAccess* simAccess,
+    WebAccess* webAccess,
+    SendStatisticsJob* statisticsJob,
+    QObject* parent)
+    : Job(Id, parent)
+    , _currentSimulationId(currentSimulationId)
+    , _currentToken(currentToken)
+    , _batches(batches)
+    , _encoderByTaskId(encoderByTaskId)
+    , _statisticsJob(statisticsJob)
+    , _simAccess(simAccess)
+    , _webAccess(webAccess)
+{
+    if (_statisticsJob) {
+        _statisticsJob->setParent(this);
+    }
+    connect(_simAccess, &SimulationAccess::imageReady, this, &SendLiveImageBatchJob::imageFromGpuReceived);
+    connect(_webAccess, &WebAccess::sendProcessedTaskReceived, this, &SendLiveImageBatchJob::serverReceivedImage);
+    connect(
+        _webAccess, &WebAccess::sendProcessedTaskFailed, this, &SendLiveImageBatchJob::serverFailedToReceiveImage);
+}
+
+void SendLiveImageBatchJob::process()
+{
+    if (_statisticsJob && !_statisticsJob->isFinished()) {
+        _statisticsJob->process();
+    }
+    if (_imageReceived) {
+        processReceivedImage();
+    }
+    if (!_imageRequested && _numRequestedImages < static_cast<int>(_batches.size())) {
+        requestNextImage();
+    }
+    sendUploads();
+}
+
+bool SendLiveImageBatchJob::isFinished() const
+{
+    return _numRequestedImages == static_cast<int>(_batches.size()) && !_imageRequested && _pendingUploads.empty()
+        && _uploadByTaskId.empty() && (!_statisticsJob || _statisticsJob->isFinished());
+}
+
+bool SendLiveImageBatchJob::isBlocking() const
+{
+    return true;
+}
+
+void SendLiveImageBatchJob::requestNextImage()
+{
+    auto const& batch = _batches.at(_numRequestedImages);
+    IntVector2D const size{batch.rect.p2.x - batch.rect.p1.x, batch.rect.p2.y - batch.rect.p1.y};
+    _image = boost::make_shared<QImage>(size.x, size.y, QImage::Format_RGB32);
+
+    auto loggingService = ServiceLocator::getInstance().getService<LoggingService>();
+
+    std::stringstream stream;
+    stream << "Web: processing " << batch.tasks.size() << " task(s): request image with size " << size.x << " x "
+           << size.y;
+    loggingService->logMessage(Priority::Important, stream.str());
+
+    _simAccess->requirePixelImage(batch.rect, _image, _mutex);
+
+    ++_numRequestedImages;
+    _imageRequested = true;
+}
+
+void SendLiveImageBatchJob::processReceivedImage()
+{
+    _imageRequested = false;
+    _imageReceived = false;
+
+    //cropping and encoding run in background, tasks sharing an encoder are encoded one after another
+    auto const& batch = _batches.at(_numRequestedImages - 1);
+    for (auto const& task : batch.tasks) {
+        auto const encoder = _encoderByTaskId.at(task.id);
+        auto const cropRect =
+            QRect(task.pos.x - batch.rect.p1.x, task.pos.y - batch.rect.p1.y, task.size.x, task.size.y);
+
+        vector<TaskId> dependencies;
+        auto const findResult = _lastEncodingByEncoder.find(encoder.get());
+        if (findResult != _lastEncodingByEncoder.end()) {
+            dependencies.emplace_back(findResult->second);
+        }
+        auto [encodingId, encoding] = runInBackground(
+            [image = _image, cropRect, encoder] { return encoder->encode(image->copy(cropRect)); }, dependencies);
+        _lastEncodingByEncoder.insert_or_assign(encoder.get(), encodingId);
+
+        Upload upload;
+        upload.taskId = task.id;
+        upload.encoder = encoder;
+        upload.encoding = std::move(encoding);
+        _pendingUploads.emplace_back(std::move(upload));
+    }
+}
+
+void SendLiveImageBatchJob::sendUploads()
+{
+    for (auto it = _pendingUploads.begin();
+         it != _pendingUploads.end() && static_cast<int>(_uploadByTaskId.size()) < MaxConcurrentUploads;) {
+        if (!isReady(it->encoding)) {
+            ++it;
+            continue;
+        }
+        auto const taskId = it->taskId;
+        auto& upload = _uploadByTaskId.insert_or_assign(taskId, std::move(*it)).first->second;
+        it = _pendingUploads.erase(it);
+
+        auto frame = upload.encoding.get();
+        upload.frameId = frame.id;
+        upload.encodedImageData = std::move(frame.data);
+        upload.buffer = new QBuffer(&upload.encodedImageData, this);
+        upload.buffer->open(QIODevice::ReadOnly);
+        _webAccess->sendProcessedTaskDelta(_currentSimulationId, _currentToken, taskId, upload.buffer);
+    }
+}
+
+void SendLiveImageBatchJob::imageFromGpuReceived()
+{
+    if (!_imageRequested) {
+        return;
+    }
+    _imageReceived = true;
+}
+
+void SendLiveImageBatchJob::serverReceivedImage(string taskId)
+{
+    auto const findResult = _uploadByTaskId.find(taskId);
+    if (findResult == _uploadByTaskId.end()) {
+        return;
+    }
+
+    auto loggingService = ServiceLocator::getInstance().getService<LoggingService>();
+
+    std::stringstream stream;
+    stream << "Web: task " << taskId << " processed";
+    loggingService->logMessage(Priority::Important, stream.str());
+
+    auto const& upload = findResult->second;
+    upload.encoder->commit(upload.frameId);
+    delete upload.buffer;
+    _uploadByTaskId.erase(findResult);
+}
+
+void SendLiveImageBatchJob::serverFailedToReceiveImage(string taskId)
+{
+    auto const findResult = _uploadByTaskId.find(taskId);
+    if (findResult == _uploadByTaskId.end()) {
+        return;
+    }
+
+    auto loggingService = ServiceLocator::getInstance().getService<LoggingService>();
+
+    std::stringstream stream;
+    stream << "Web: task " << taskId << " could not be sent";
+    loggingService->logMessage(Priority::Important, stream.str());
+
+    //frame is not committed, hence the next image of the viewer refers to the last received one
+    delete findResult->second.buffer;
+    _uploadByTaskId.erase(findResult);
+}
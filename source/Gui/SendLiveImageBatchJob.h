@@ -0,0 +1,79 @@
+#pragma once
+
+#include <QByteArray>
+
+#include "Base/Job.h"
+
+#include "Web/Definitions.h"
+#include "Web/TaskBatcher.h"
+#include "Web/TileDeltaEncoder.h"
+
+#include "Definitions.h"
+
+/**
+ * Processes all tasks of a polling round: one image is requested per batch of overlapping tasks and cropped
+ * per task in background. While the next image is requested, the tasks of the previous one are already
+ * encoded and uploaded with a bounded number of concurrent requests. Failed uploads are given up, the server delivers
+ * their tasks again. Statistics are optionally requested and sent in the same round.
+ */
+class SendLiveImageBatchJob
+    : public Job
+{
+    Q_OBJECT
+public:
+    static constexpr char const* Id = "LiveImageBatchJob";
+    static constexpr int MaxConcurrentUploads = 4;
+
+    SendLiveImageBatchJob(
+        string const& currentSimulationId,
+        string const& currentToken,
+        vector<TaskBatch> const& batches,
+        unordered_map<string, TileDeltaEncoderPtr> const& encoderByTaskId,
+        SimulationAccess* simAccess,
+        WebAccess* webAccess,
+        SendStatisticsJob* statisticsJob,   //optional, will be owned
+        QObject* parent);
+
+    void process() override;
+    bool isFinished() const override;
+    bool isBlocking() const override;
+
+private:
+    void requestNextImage();
+    void processReceivedImage();
+    void sendUploads();
+
+    Q_SLOT void imageFromGpuReceived();
+    Q_SLOT void serverReceivedImage(string taskId);
+    Q_SLOT void serverFailedToReceiveImage(string taskId);
+
+    struct Upload
+    {
+        string taskId;
+        TileDeltaEncoderPtr encoder;
+        std::future<TileDeltaEncoder::Frame> encoding;
+        int frameId = TileDeltaEncoder::NoFrame;    //committed to the encoder when the upload has succeeded
+        QByteArray encodedImageData;
+        QBuffer* buffer = nullptr;
+    };
+
+    string _currentSimulationId;
+    string _currentToken;
+    vector<TaskBatch> _batches;
+    unordered_map<string, TileDeltaEncoderPtr> _encoderByTaskId;
+
+    int _numRequestedImages = 0;
+    bool _imageRequested = false;
+    bool _imageReceived = false;
+    QImagePtr _image;
+    std::mutex _mutex;
+
+    unordered_map<TileDeltaEncoder*, TaskId> _lastEncodingByEncoder;
+    list<Upload> _pendingUploads;   //encoding or waiting for a free upload slot
+    unordered_map<string, Upload> _uploadByTaskId;  //in-flight
+
+    SendStatisticsJob* _statisticsJob = nullptr;
+
+    SimulationAccess* _simAccess = nullptr;
+    WebAccess* _webAccess = nullptr;
+};
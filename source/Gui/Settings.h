@@ -212,6 +212,7 @@ namespace Const
     QString const ErrorLoadSimulation = "Specified simulation could not be loaded.";
     QString const ErrorLoadCollection = "Specified collection could not be loaded.";
     QString const ErrorSaveCollection = "Collection could not be saved.";
+    QString const ErrorSaveSpeciesCensus = "Species census could not be saved.";
     QString const ErrorPasteFromClipboard = "The clipboard memory does not match the token memory pattern.";
     QString const ErrorInvalidValues = "The values you entered are not valid.";
     QString const ErrorLoadSimulationParameters = "The specified simulation parameter file could not be loaded.";
@@ -0,0 +1,127 @@
+#include <algorithm>
+
+#include <QTimer>
+
+#include "Base/JobExecutor.h"
+#include "Base/ServiceLocator.h"
+#include "Base/LoggingService.h"
+
+#include "EngineInterface/SimulationAccess.h"
+#include "EngineInterface/SimulationContext.h"
+
+#include "SpeciesCensus.h"
+
+namespace
+{
+    int const SamplingInterval = 5000;  //in milliseconds
+}
+
+SpeciesCensus::SpeciesCensus(QObject* parent /*= nullptr*/)
+    : QObject(parent)
+{
+    _timer = new QTimer(this);
+    connect(_timer, &QTimer::timeout, this, &SpeciesCensus::timerTimeout);
+}
+
+SpeciesCensus::~SpeciesCensus()
+{
+    waitForSample();
+}
+
+void SpeciesCensus::init(SimulationAccess* access, SimulationContext* context)
+{
+    deactivate();
+    waitForSample();
+
+    SET_CHILD(_access, access);
+    _context = context;
+    _dataRequired = false;
+
+    for (auto const& connection : _connections) {
+        disconnect(connection);
+    }
+    _connections.clear();
+    _connections.push_back(connect(
+        _access, &SimulationAccess::dataReadyToRetrieve, this, &SpeciesCensus::dataFromAccessAvailable, Qt::QueuedConnection));
+
+    _tracker.clear();
+}
+
+void SpeciesCensus::activate()
+{
+    _timer->start(SamplingInterval);
+}
+
+void SpeciesCensus::deactivate()
+{
+    _timer->stop();
+}
+
+bool SpeciesCensus::isActive() const
+{
+    return _timer->isActive();
+}
+
+auto SpeciesCensus::getSpecies() -> vector<Species> const&
+{
+    waitForSample();
+    return _tracker.getSpecies();
+}
+
+vector<int> const& SpeciesCensus::getSampleTimesteps()
+{
+    waitForSample();
+    return _tracker.getSampleTimesteps();
+}
+
+bool SpeciesCensus::saveToFile(string const& filename)
+{
+    waitForSample();
+    return _tracker.saveToFile(filename);
+}
+
+void SpeciesCensus::timerTimeout()
+{
+    //skip sampling while the previous sample is not processed yet
+    auto const sampleRunning =
+        _sample.valid() && _sample.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+    if (!_dataRequired && !sampleRunning) {
+        _dataRequired = true;
+        _access->requireData(ResolveDescription());
+    }
+}
+
+void SpeciesCensus::dataFromAccessAvailable()
+{
+    if (!_dataRequired) {
+        return;
+    }
+    _dataRequired = false;
+
+    waitForSample();
+    _sample = JobExecutor::getInstance()
+                  .submit(
+                      [this, timestep = _context->getTimestep(), data = _access->retrieveData()] {
+                          auto const numHashedClusters = _tracker.addSample(timestep, data);
+
+                          auto const& species = _tracker.getSpecies();
+                          auto const sample = static_cast<int>(_tracker.getSampleTimesteps().size()) - 1;
+                          auto const numSpecies = std::count_if(species.begin(), species.end(), [&](auto const& s) {
+                              return s.lastSample == sample;
+                          });
+                          auto loggingService = ServiceLocator::getInstance().getService<LoggingService>();
+                          loggingService->logDeferredMessage(Priority::Unimportant, [numSpecies, numHashedClusters] {
+                              return "species census: " + std::to_string(numSpecies) + " species present, "
+                                  + std::to_string(numHashedClusters) + " clusters hashed";
+                          });
+                      },
+                      TaskPriority::Low)
+                  .second;
+}
+
+void SpeciesCensus::waitForSample()
+{
+    if (_sample.valid()) {
+        _sample.get();
+    }
+}
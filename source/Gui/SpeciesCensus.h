@@ -0,0 +1,52 @@
+#pragma once
+
+#include <future>
+
+#include <QObject>
+#include <QTimer>
+
+#include "EngineInterface/SpeciesTracker.h"
+
+#include "Definitions.h"
+
+/**
+ * Samples the world periodically and keeps population counts per species over time (see SpeciesTracker). The
+ * samples are processed on the shared job executor, only the copy of the retrieved data is made on the GUI thread.
+ */
+class SpeciesCensus : public QObject
+{
+    Q_OBJECT
+public:
+    SpeciesCensus(QObject* parent = nullptr);
+    virtual ~SpeciesCensus();
+
+    //resets all collected data
+    void init(SimulationAccess* access, SimulationContext* context);
+
+    void activate();
+    void deactivate();
+    bool isActive() const;
+
+    using Species = SpeciesTracker::Species;
+    vector<Species> const& getSpecies();
+    vector<int> const& getSampleTimesteps();
+
+    //csv table with one row per species and sample in which it is present
+    bool saveToFile(string const& filename);
+
+private:
+    Q_SLOT void timerTimeout();
+    Q_SLOT void dataFromAccessAvailable();
+
+    void waitForSample();
+
+    list<QMetaObject::Connection> _connections;
+    QTimer* _timer = nullptr;
+    bool _dataRequired = false;
+
+    SimulationAccess* _access = nullptr;
+    SimulationContext* _context = nullptr;
+
+    SpeciesTracker _tracker;
+    std::future<void> _sample;  //pending sample processed in the background
+};
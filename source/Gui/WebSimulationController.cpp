@@ -15,9 +15,11 @@
 #include "EngineInterface/SimulationMonitor.h"
 #include "EngineInterface/SimulationAccess.h"
 #include "EngineInterface/SpaceProperties.h"
+#include "Web/TaskBatcher.h"
+#include "Web/TileDeltaEncoder.h"
 #include "Web/WebAccess.h"
 
-#include "SendLiveImageJob.h"
+#include "SendLiveImageBatchJob.h"
 #include "SendLastImageJob.h"
 #include "SendStatisticsJob.h"
 #include "SimulationConfig.h"
@@ -29,6 +31,9 @@ namespace
     auto const POLLING_INTERVAL = 300;
     auto const PROCESS_JOBS_INTERVAL = 50;
     auto const UPDATE_STATISTICS_INTERVAL = 1000;
+
+    //encoders of viewers without tasks in this many rounds are removed
+    auto const MAX_UNUSED_ENCODER_ROUNDS = 100;
 }
 
 WebSimulationController::WebSimulationController(WebAccess * webAccess, QWidget* parent /*= nullptr*/)
@@ -110,6 +115,7 @@ bool WebSimulationController::onConnectToSimulation()
         QMessageBox msgBox(QMessageBox::Information, "Connection successful",
             QString(Const::InfoConnectedTo).arg(QString::fromStdString(simulationInfo.simulationName)));
         msgBox.exec();
+        _encoderByViewerId.clear();
         _pollingTimer->start(POLLING_INTERVAL);
         _updateStatisticsTimer->start(UPDATE_STATISTICS_INTERVAL);
 
@@ -128,6 +134,7 @@ bool WebSimulationController::onConnectToSimulation()
 bool WebSimulationController::onDisconnectToSimulation(string const& simulationId, string const & token)
 {
     _pollingTimer->stop();
+    _encoderByViewerId.clear();
     _updateStatisticsTimer->stop();
 
     auto newJob = new SendLastImageJob(
@@ -160,39 +167,76 @@ void WebSimulationController::requestUnprocessedTasks() const
 
 void WebSimulationController::unprocessedTasksReceived(vector<Task> tasks)
 {
-    if (tasks.empty() || !_currentSimulationId) {
+    if (!_currentSimulationId) {
+        return;
+    }
+
+    //tasks which are currently processed are delivered again until they are finished
+    if (tasks.empty() || _worker->contains(SendLiveImageBatchJob::Id)) {
         return;
     }
 
-    auto numNewJobs = 0;
+    ++_round;
+    vector<Task> validTasks;
+    unordered_map<string, TileDeltaEncoderPtr> encoderByTaskId;
     for (auto const& task : tasks) {
-        if (!_worker->contains(task.id)) {
-            auto worldSize = _config->universeSize;
-            if (task.pos.x >= worldSize.x || task.pos.y >= worldSize.y) {
-                return;
-            }
-
-            auto taskSize = task.size;
-            if (taskSize.x + task.pos.x >= worldSize.x) {
-                taskSize.x = worldSize.x - task.pos.x;
-            }
-            if (taskSize.y + task.pos.y >= worldSize.y) {
-                taskSize.y = worldSize.y - task.pos.y;
-            }
-            auto newJob = new SendLiveImageJob(
-                *_currentSimulationId, *_currentToken, task.id, task.pos, taskSize, _simAccess, _webAccess, this);
-            _worker->add(newJob);
-
-            ++numNewJobs;
+        auto worldSize = _config->universeSize;
+        if (task.pos.x >= worldSize.x || task.pos.y >= worldSize.y) {
+            continue;
+        }
+
+        auto taskSize = task.size;
+        if (taskSize.x + task.pos.x >= worldSize.x) {
+            taskSize.x = worldSize.x - task.pos.x;
+        }
+        if (taskSize.y + task.pos.y >= worldSize.y) {
+            taskSize.y = worldSize.y - task.pos.y;
+        }
+        auto& encoder = _encoderByViewerId[task.viewerId];
+        if (!encoder.encoder) {
+            encoder.encoder = boost::make_shared<TileDeltaEncoder>();
         }
+        encoder.lastUsedRound = _round;
+        encoderByTaskId.insert_or_assign(task.id, encoder.encoder);
+        validTasks.emplace_back(Task{task.id, task.pos, taskSize, task.viewerId});
+    }
+    for (auto it = _encoderByViewerId.begin(); it != _encoderByViewerId.end();) {
+        if (_round - it->second.lastUsedRound > MAX_UNUSED_ENCODER_ROUNDS) {
+            it = _encoderByViewerId.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+    if (validTasks.empty()) {
+        return;
     }
-    if (numNewJobs > 0) {
-        auto loggingService = ServiceLocator::getInstance().getService<LoggingService>();
 
-        std::stringstream stream;
-        stream << "Web: " << numNewJobs << " new task(s) received";
-        loggingService->logMessage(Priority::Important, stream.str().c_str());
+    //statistics are sent in the same round if they are due
+    SendStatisticsJob* statisticsJob = nullptr;
+    if (_statisticsDue) {
+        statisticsJob = new SendStatisticsJob(
+            *_currentSimulationId, *_currentToken, _monitor, _webAccess, _config, nullptr);
+        _statisticsDue = false;
     }
+
+    auto const batches = TaskBatcher::createBatches(validTasks);
+    auto newJob = new SendLiveImageBatchJob(
+        *_currentSimulationId,
+        *_currentToken,
+        batches,
+        encoderByTaskId,
+        _simAccess,
+        _webAccess,
+        statisticsJob,
+        this);
+    _worker->add(newJob);
+
+    auto loggingService = ServiceLocator::getInstance().getService<LoggingService>();
+
+    std::stringstream stream;
+    stream << "Web: " << validTasks.size() << " new task(s) received, " << batches.size() << " image(s) required";
+    loggingService->logMessage(Priority::Important, stream.str().c_str());
 }
 
 void WebSimulationController::processJobs()
@@ -206,6 +250,13 @@ void WebSimulationController::sendStatistics()
         return;
     }
 
+    //statistics are preferably sent together with live images, otherwise in the next interval
+    if (!_statisticsDue) {
+        _statisticsDue = true;
+        return;
+    }
+    _statisticsDue = false;
+
     auto const newJob = new SendStatisticsJob(
         *_currentSimulationId, *_currentToken, _monitor, _webAccess, _config, this);
     _worker->add(newJob);
@@ -37,6 +37,16 @@ private:
 
     Worker _worker;
 
+    //one encoder per viewer since deltas refer to the last image the viewer has received
+    struct Encoder
+    {
+        TileDeltaEncoderPtr encoder;
+        int lastUsedRound = 0;
+    };
+    unordered_map<string, Encoder> _encoderByViewerId;
+    int _round = 0;
+    bool _statisticsDue = false;
+
     QByteArray _encodedImageData;
     QBuffer* _buffer = nullptr;
 
@@ -0,0 +1,121 @@
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "EngineGpuKernels/AccessTOLayout.h"
+
+class AccessTOLayoutTest : public ::testing::Test
+{
+public:
+	AccessTOLayoutTest() = default;
+	~AccessTOLayoutTest() = default;
+
+protected:
+	AccessTOLayout createLayout(std::vector<int> const& numElements) const;
+
+	//array contents which identify array and index
+	unsigned char getByte(AccessTOLayout::Array array, uint64_t byteIndex) const;
+	void fillArrays(std::vector<unsigned char>& buffer, AccessTOLayout const& layout, std::vector<int> const& numElements) const;
+	void checkArrays(std::vector<unsigned char>& buffer, AccessTOLayout const& layout, std::vector<int> const& numElements) const;
+
+	//element sizes of unaligned size
+	uint64_t const _elementSizes[AccessTOLayout::NumArrays] = {20, 52, 36, 9, 1};
+};
+
+AccessTOLayout AccessTOLayoutTest::createLayout(std::vector<int> const& numElements) const
+{
+	AccessTOLayout::Header header;
+	for (int array = 0; array < AccessTOLayout::NumArrays; ++array) {
+		header.numElements[array] = numElements.at(array);
+	}
+	AccessTOLayout result;
+	result.init(_elementSizes, header);
+	return result;
+}
+
+unsigned char AccessTOLayoutTest::getByte(AccessTOLayout::Array array, uint64_t byteIndex) const
+{
+	return static_cast<unsigned char>(array * 50 + byteIndex % 47 + 1);
+}
+
+void AccessTOLayoutTest::fillArrays(
+	std::vector<unsigned char>& buffer,
+	AccessTOLayout const& layout,
+	std::vector<int> const& numElements) const
+{
+	for (int array = 0; array < AccessTOLayout::NumArrays; ++array) {
+		auto const type = static_cast<AccessTOLayout::Array>(array);
+		*AccessTOLayout::getNumElements(buffer.data(), type) = numElements.at(array);
+		auto const bytes = layout.getArray<unsigned char>(buffer.data(), type);
+		for (uint64_t byteIndex = 0; byteIndex < numElements.at(array) * _elementSizes[array]; ++byteIndex) {
+			bytes[byteIndex] = getByte(type, byteIndex);
+		}
+	}
+}
+
+void AccessTOLayoutTest::checkArrays(
+	std::vector<unsigned char>& buffer,
+	AccessTOLayout const& layout,
+	std::vector<int> const& numElements) const
+{
+	for (int array = 0; array < AccessTOLayout::NumArrays; ++array) {
+		auto const type = static_cast<AccessTOLayout::Array>(array);
+		ASSERT_EQ(numElements.at(array), *AccessTOLayout::getNumElements(buffer.data(), type));
+		auto const bytes = layout.getArray<unsigned char>(buffer.data(), type);
+		for (uint64_t byteIndex = 0; byteIndex < numElements.at(array) * _elementSizes[array]; ++byteIndex) {
+			ASSERT_EQ(getByte(type, byteIndex), bytes[byteIndex]);
+		}
+	}
+}
+
+TEST_F(AccessTOLayoutTest, testLayout)
+{
+	auto const layout = createLayout({3, 0, 2, 5, 7});
+	EXPECT_EQ(32, layout.getOffset(AccessTOLayout::Clusters));
+	EXPECT_EQ(96, layout.getOffset(AccessTOLayout::Cells));
+	EXPECT_EQ(96, layout.getOffset(AccessTOLayout::Particles));
+	EXPECT_EQ(176, layout.getOffset(AccessTOLayout::Tokens));
+	EXPECT_EQ(224, layout.getOffset(AccessTOLayout::StringBytes));
+	EXPECT_EQ(240, layout.getSize());
+	for (int array = 0; array < AccessTOLayout::NumArrays; ++array) {
+		EXPECT_EQ(0, layout.getOffset(static_cast<AccessTOLayout::Array>(array)) % AccessTOLayout::Alignment);
+	}
+}
+
+/**
+* Situation: buffer with layout for maximum numbers of elements is partially filled
+* Expected result: packed layout has the size of the used bytes and the arrays are moved to their packed positions
+*/
+TEST_F(AccessTOLayoutTest, testPack)
+{
+	auto const maxLayout = createLayout({100, 100, 100, 100, 1000});
+	std::vector<int> const numElements = {40, 100, 0, 77, 333};
+	std::vector<unsigned char> buffer(maxLayout.getSize(), 0);
+	fillArrays(buffer, maxLayout, numElements);
+
+	auto const packedLayout = maxLayout.getPackedLayout(AccessTOLayout::getHeader(buffer.data()));
+	EXPECT_EQ(createLayout(numElements).getSize(), packedLayout.getSize());
+	EXPECT_LT(packedLayout.getSize(), maxLayout.getSize());
+
+	maxLayout.pack(buffer.data(), packedLayout);
+	checkArrays(buffer, packedLayout, numElements);
+}
+
+/**
+* Situation: packed buffer is transferred and unpacked into a buffer with layout for maximum numbers of elements
+* Expected result: arrays are at their original positions
+*/
+TEST_F(AccessTOLayoutTest, testTransferAndUnpack)
+{
+	auto const maxLayout = createLayout({100, 100, 100, 100, 1000});
+	std::vector<int> const numElements = {100, 3, 99, 1, 1000};
+	std::vector<unsigned char> buffer(maxLayout.getSize(), 0);
+	fillArrays(buffer, maxLayout, numElements);
+
+	auto const packedLayout = maxLayout.getPackedLayout(AccessTOLayout::getHeader(buffer.data()));
+	maxLayout.pack(buffer.data(), packedLayout);
+
+	std::vector<unsigned char> targetBuffer(maxLayout.getSize(), 0);
+	std::copy(buffer.begin(), buffer.begin() + packedLayout.getSize(), targetBuffer.begin());
+	maxLayout.unpack(targetBuffer.data(), packedLayout);
+	checkArrays(targetBuffer, maxLayout, numElements);
+}
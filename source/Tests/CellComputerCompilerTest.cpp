@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+
+#include "Base/ServiceLocator.h"
+#include "EngineInterface/CellComputerCompiler.h"
+#include "EngineInterface/EngineInterfaceBuilderFacade.h"
+#include "EngineInterface/SymbolTable.h"
+
+class CellComputerCompilerTest : public ::testing::Test
+{
+public:
+	CellComputerCompilerTest();
+	~CellComputerCompilerTest();
+
+protected:
+	QByteArray compile(string const& code) const;
+
+	SymbolTable* _symbols = nullptr;
+	CellComputerCompiler* _compiler = nullptr;
+};
+
+CellComputerCompilerTest::CellComputerCompilerTest()
+{
+	auto facade = ServiceLocator::getInstance().getService<EngineInterfaceBuilderFacade>();
+	_symbols = facade->getDefaultSymbolTable();
+	_compiler = facade->buildCellComputerCompiler(_symbols, facade->getDefaultSimulationParameters());
+}
+
+CellComputerCompilerTest::~CellComputerCompilerTest()
+{
+	delete _compiler;
+	delete _symbols;
+}
+
+QByteArray CellComputerCompilerTest::compile(string const& code) const
+{
+	auto const result = _compiler->compileSourceCode(code);
+	EXPECT_TRUE(result.compilationOk);
+	return result.compilation;
+}
+
+TEST_F(CellComputerCompilerTest, testOperandTypes)
+{
+	auto const data = compile("mov [1], 3\nadd [[0x2]], (5)\nsub (1), [[4]]");
+	QByteArray expected;
+	expected.push_back((Enums::ComputerOperation::MOV << 4) | (Enums::ComputerOptype::MEM << 2) | Enums::ComputerOptype::CONSTANT);
+	expected.push_back(1);
+	expected.push_back(3);
+	expected.push_back((Enums::ComputerOperation::ADD << 4) | (Enums::ComputerOptype::MEMMEM << 2) | Enums::ComputerOptype::CMEM);
+	expected.push_back(2);
+	expected.push_back(5);
+	expected.push_back((Enums::ComputerOperation::SUB << 4) | (Enums::ComputerOptype::CMEM << 2) | Enums::ComputerOptype::MEMMEM);
+	expected.push_back(1);
+	expected.push_back(4);
+	EXPECT_EQ(expected, data);
+}
+
+TEST_F(CellComputerCompilerTest, testComparatorsAndCase)
+{
+	auto const data = compile("IF [1] > 2\nif [1]>=2\nIf [1] => 2\nif [1] == 2\nif [1] != 2\nif [1] =< 2\nif [1]<2\nElse\nENDIF");
+	ASSERT_EQ(9 * 3, data.size());
+	Enums::ComputerOperation::Type const expectedOperations[] = {
+		Enums::ComputerOperation::IFG,
+		Enums::ComputerOperation::IFGE,
+		Enums::ComputerOperation::IFGE,
+		Enums::ComputerOperation::IFE,
+		Enums::ComputerOperation::IFNE,
+		Enums::ComputerOperation::IFLE,
+		Enums::ComputerOperation::IFL,
+		Enums::ComputerOperation::ELSE,
+		Enums::ComputerOperation::ENDIF};
+	for (int i = 0; i < 9; ++i) {
+		EXPECT_EQ(expectedOperations[i], (data.at(i * 3) >> 4) & 0xf);
+	}
+}
+
+TEST_F(CellComputerCompilerTest, testSymbolsAndNumberFormats)
+{
+	_symbols->addEntry("VALUE", "0x10");
+	auto const data = compile("mov i, VALUE\nmov BRANCH_NUMBER, -1");
+	ASSERT_EQ(6, data.size());
+	EXPECT_EQ(static_cast<char>(255), data.at(1));
+	EXPECT_EQ(16, data.at(2));
+	EXPECT_EQ(0, data.at(4));
+	EXPECT_EQ(static_cast<char>(255), data.at(5));
+}
+
+TEST_F(CellComputerCompilerTest, testErrorLine)
+{
+	auto result = _compiler->compileSourceCode("mov [1], 3\nmov [2], 4\nfoo [1], 2\nmov [3], 1");
+	EXPECT_FALSE(result.compilationOk);
+	EXPECT_EQ(3, result.lineOfFirstError);
+
+	result = _compiler->compileSourceCode("mov [1], 3\nmov [2] 4, 1");
+	EXPECT_FALSE(result.compilationOk);
+	EXPECT_EQ(1, result.lineOfFirstError);
+
+	result = _compiler->compileSourceCode("mov 1, 3");
+	EXPECT_FALSE(result.compilationOk);
+	EXPECT_EQ(1, result.lineOfFirstError);
+}
+
+TEST_F(CellComputerCompilerTest, testDecompile)
+{
+	auto const data = compile("if [1] > 2\nmov [[2]], (3)\nelse\nxor [4], 0xff\nendif");
+	EXPECT_EQ(
+		string("if [0x1] > 0x2\n  mov [[0x2]], (0x3)\nelse\n  xor [0x4], 0xff\nendif"),
+		_compiler->decompileSourceCode(data));
+	EXPECT_EQ(data, compile(_compiler->decompileSourceCode(data)));
+}
+
+TEST_F(CellComputerCompilerTest, testLargeProgram)
+{
+	string const lines[] = {
+		"mov [1], 3\n",
+		"add [[0x2]], (1)\n",
+		"if i >= BRANCH_NUMBER\n",
+		"  xor [0x10], [[4]]\n",
+		"else\n",
+		"endif\n",
+		"sub j, 0x1f\n"};
+	string code;
+	for (int i = 0; i < 700000; ++i) {
+		code += lines[i % 7];
+	}
+
+	auto const result = _compiler->compileSourceCode(code);
+	ASSERT_TRUE(result.compilationOk);
+	EXPECT_EQ(700000 * 3, result.compilation.size());
+	EXPECT_EQ(result.compilation, compile(_compiler->decompileSourceCode(result.compilation)));
+}
+
+TEST_F(CellComputerCompilerTest, testOptimizeConstantFolding)
+{
+	auto const data = compile("mov [1], 3\nadd [1], 4\nmul [1], 2\nmov [[1]], [1]\nand [2], 0");
+	auto const optimizedData = _compiler->optimizeCompilation(data);
+	EXPECT_EQ(compile("mov [1], 14\nmov [14], 14\nmov [2], 0"), optimizedData);
+	EXPECT_TRUE(_compiler->checkEquivalence(data, optimizedData));
+}
+
+TEST_F(CellComputerCompilerTest, testOptimizeConditions)
+{
+	auto const data = compile(
+		"mov [1], 5\nif [1] > 3\nmov [2], 1\nelse\nmov [2], 2\nendif\n"
+		"if [3] = 0\nendif\nif [4] = 0\nelse\nmov [5], 1\nendif\nif [6] < 1");
+	auto const optimizedData = _compiler->optimizeCompilation(data);
+	EXPECT_EQ(compile("mov [1], 5\nmov [2], 1\nif [4] != 0\nmov [5], 1"), optimizedData);
+	EXPECT_TRUE(_compiler->checkEquivalence(data, optimizedData));
+}
+
+TEST_F(CellComputerCompilerTest, testOptimizeDeadStores)
+{
+	auto const data = compile(
+		"mov [1], [7]\nadd [2], (1)\nmov [1], 3\nif [3] = 0\nmov [2], [8]\nendif\nmov [2], [9]\nadd [4], 0\nmov (1), (1)");
+	auto const optimizedData = _compiler->optimizeCompilation(data);
+	EXPECT_EQ(compile("mov [1], 3\nmov [2], [9]"), optimizedData);
+	EXPECT_TRUE(_compiler->checkEquivalence(data, optimizedData));
+}
+
+TEST_F(CellComputerCompilerTest, testOptimizeKeepsAliasedStores)
+{
+	auto const data = compile("mov [1], 3\nmov [[2]], 1\nmov [1], 4");
+	auto const optimizedData = _compiler->optimizeCompilation(data);
+	EXPECT_EQ(compile("mov [[2]], 1\nmov [1], 4"), optimizedData);
+
+	auto const readingData = compile("mov [1], 3\nadd [2], [[2]]\nmov [1], 4");
+	EXPECT_EQ(readingData, _compiler->optimizeCompilation(readingData));
+}
+
+TEST_F(CellComputerCompilerTest, testCheckEquivalence)
+{
+	EXPECT_FALSE(_compiler->checkEquivalence(compile("if [1] > 3\nmov [2], 1"), compile("if [1] >= 3\nmov [2], 1")));
+	EXPECT_FALSE(_compiler->checkEquivalence(compile("div (1), [[3]]"), compile("div (1), [3]")));
+	EXPECT_TRUE(_compiler->checkEquivalence(compile("xor [1], [1]"), compile("mov [1], 0")));
+}
@@ -2,6 +2,7 @@
 
 #include "Base/ServiceLocator.h"
 #include "EngineInterface/CellComputerCompiler.h"
+#include "EngineInterface/CellComputerVirtualMachine.h"
 
 #include "IntegrationGpuTestFramework.h"
 
@@ -489,3 +490,44 @@ TEST_F(CellComputerGpuTests, testDivisionByZero)
     auto data = runSimpleCellComputer(program);
     EXPECT_EQ(0, data.at(1));  
 }
+
+TEST_F(CellComputerGpuTests, testRandomProgramsAgainstVirtualMachine)
+{
+    CellComputerVirtualMachine vm(_parameters);
+    vm.resize(1);
+    for (int i = 0; i < 20; ++i) {
+        auto const program = _numberGen->getRandomArray(CellComputerVirtualMachine::MaxProgramBytes);
+        auto tokenMemory = _numberGen->getRandomArray(_parameters.tokenMemorySize);
+        auto const cellMemory = _numberGen->getRandomArray(_parameters.cellFunctionComputerCellMemorySize);
+
+        DataDescription origData;
+        auto cluster = createHorizontalCluster(2, QVector2D{}, QVector2D{}, 0);
+        auto& firstCell = cluster.cells->at(0);
+        firstCell.tokenBranchNumber = 0;
+        auto& secondCell = cluster.cells->at(1);
+        secondCell.tokenBranchNumber = 1;
+        secondCell.cellFeature = CellFeatureDescription()
+                                     .setType(Enums::CellFunction::COMPUTER)
+                                     .setConstData(program)
+                                     .setVolatileData(cellMemory);
+        firstCell.addToken(createSimpleToken().setData(tokenMemory));
+        origData.addCluster(cluster);
+
+        _access->clear();
+        IntegrationTestHelper::updateData(_access, _context, origData);
+        IntegrationTestHelper::runSimulation(1, _controller);
+
+        DataDescription newData = IntegrationTestHelper::getContent(_access, {{0, 0}, {_universeSize.x, _universeSize.y}});
+        auto const& newCell = IntegrationTestHelper::getCellByCellId(newData).at(secondCell.id);
+
+        //token spreading writes the branch number of the target cell before the program runs
+        tokenMemory[0] = 1;
+        vm.setProgram(program);
+        vm.setTokenMemory(0, tokenMemory);
+        vm.setCellMemory(0, cellMemory);
+        vm.execute();
+
+        EXPECT_EQ(vm.getTokenMemory(0), *newCell.tokens->at(0).data);
+        EXPECT_EQ(vm.getCellMemory(0), newCell.cellFeature->volatileData.left(_parameters.cellFunctionComputerCellMemorySize));
+    }
+}
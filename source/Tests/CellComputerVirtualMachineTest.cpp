@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+
+#include <QElapsedTimer>
+
+#include "Base/ServiceLocator.h"
+#include "EngineInterface/CellComputerCompiler.h"
+#include "EngineInterface/CellComputerVirtualMachine.h"
+#include "EngineInterface/EngineInterfaceBuilderFacade.h"
+#include "EngineInterface/SimulationParameters.h"
+#include "EngineInterface/SymbolTable.h"
+
+class CellComputerVirtualMachineTest : public ::testing::Test
+{
+public:
+	CellComputerVirtualMachineTest();
+	~CellComputerVirtualMachineTest();
+
+protected:
+	QByteArray compile(string const& code) const;
+
+	SimulationParameters _parameters;
+	SymbolTable* _symbols = nullptr;
+	CellComputerCompiler* _compiler = nullptr;
+};
+
+CellComputerVirtualMachineTest::CellComputerVirtualMachineTest()
+{
+	auto facade = ServiceLocator::getInstance().getService<EngineInterfaceBuilderFacade>();
+	_parameters = facade->getDefaultSimulationParameters();
+	_symbols = facade->getDefaultSymbolTable();
+	_compiler = facade->buildCellComputerCompiler(_symbols, _parameters);
+}
+
+CellComputerVirtualMachineTest::~CellComputerVirtualMachineTest()
+{
+	delete _compiler;
+	delete _symbols;
+}
+
+QByteArray CellComputerVirtualMachineTest::compile(string const& code) const
+{
+	auto const result = _compiler->compileSourceCode(code);
+	EXPECT_TRUE(result.compilationOk);
+	return result.compilation;
+}
+
+TEST_F(CellComputerVirtualMachineTest, testArithmeticAndDereferencing)
+{
+	CellComputerVirtualMachine vm(_parameters);
+	vm.setProgram(compile("mov [1], 3\nmov [[1]], 5\nadd [3], [[1]]\nmul [3], 55\ndiv (2), 0"));
+	vm.resize(1);
+	vm.setCellMemory(0, QByteArray(_parameters.cellFunctionComputerCellMemorySize, 7));
+	vm.execute();
+
+	auto const tokenMemory = vm.getTokenMemory(0);
+	EXPECT_EQ(3, tokenMemory.at(1));
+	EXPECT_EQ(38, tokenMemory.at(3));  //10 * 55 = 550 = 38 (mod 256)
+	EXPECT_EQ(0, vm.getCellMemory(0).at(2));
+	EXPECT_EQ(7, vm.getCellMemory(0).at(1));
+}
+
+TEST_F(CellComputerVirtualMachineTest, testConditionsPerInstance)
+{
+	CellComputerVirtualMachine vm(_parameters);
+	vm.setProgram(compile("if [1] < 3\nmov [2], 1\nelse\nmov [2], 2\nif [1] > 200\nmov [3], 1\nendif\nendif"));
+	vm.resize(3);
+	vm.setTokenMemory(0, QByteArray("\0\2", 2));
+	vm.setTokenMemory(1, QByteArray("\0\3", 2));
+	vm.setTokenMemory(2, QByteArray("\0\xff", 2));
+	vm.execute();
+
+	EXPECT_EQ(1, vm.getTokenMemory(0).at(2));
+	EXPECT_EQ(0, vm.getTokenMemory(0).at(3));
+	EXPECT_EQ(2, vm.getTokenMemory(1).at(2));
+	EXPECT_EQ(0, vm.getTokenMemory(1).at(3));
+	EXPECT_EQ(2, vm.getTokenMemory(2).at(2));
+	EXPECT_EQ(1, vm.getTokenMemory(2).at(3));  //comparisons are unsigned
+}
+
+TEST_F(CellComputerVirtualMachineTest, testProgramTruncation)
+{
+	string code;
+	for (int i = 0; i < 20; ++i) {
+		code += "add [1], 1\n";
+	}
+	CellComputerVirtualMachine vm(_parameters);
+	vm.setProgram(compile(code));
+	vm.resize(1);
+	vm.execute();
+	EXPECT_EQ(_parameters.cellFunctionComputerMaxInstructions, vm.getTokenMemory(0).at(1));
+}
+
+TEST_F(CellComputerVirtualMachineTest, testThroughput)
+{
+	auto const numInstances = 100000;
+	CellComputerVirtualMachine vm(_parameters);
+	vm.setProgram(compile(
+		"mov [1], [0]\nadd [1], [[2]]\nif [1] >= 0x40\nxor [3], (1)\nelse\nmul (2), [1]\nendif\nsub [[4]], 3\ndiv [5], [1]"));
+	vm.resize(numInstances);
+	for (int i = 0; i < numInstances; ++i) {
+		QByteArray memory(_parameters.tokenMemorySize, 0);
+		for (int address = 0; address < memory.size(); ++address) {
+			memory[address] = static_cast<char>(i * 31 + address * 7);
+		}
+		vm.setTokenMemory(i, memory);
+	}
+
+	QElapsedTimer timer;
+	timer.start();
+	for (int i = 0; i < 100; ++i) {
+		vm.execute();
+	}
+	std::cerr << "Time elapsed during execution: " << timer.elapsed() << " ms" << std::endl;
+}
@@ -0,0 +1,81 @@
+#include <random>
+#include <gtest/gtest.h>
+
+#include "EngineGpuKernels/CellFunctionGroups.h"
+
+#include "HostMemory.h"
+
+class CellFunctionGroupsTest : public ::testing::Test
+{
+public:
+	CellFunctionGroupsTest() = default;
+	~CellFunctionGroupsTest() = default;
+
+protected:
+	CellFunctionGroups createGroups(vector<int> const& cellFunctionByToken, HostMemory& hostMemory) const;
+};
+
+CellFunctionGroups CellFunctionGroupsTest::createGroups(
+	vector<int> const& cellFunctionByToken,
+	HostMemory& hostMemory) const
+{
+	auto const numTokens = static_cast<int>(cellFunctionByToken.size());
+	CellFunctionGroups::Memory memory;
+	memory.counts = hostMemory.getArray<int>(CellFunctionGroups::NumGroups, 0);
+	memory.offsets = hostMemory.getArray<int>(CellFunctionGroups::NumGroups + 1, -1);
+	memory.tokenIndices = hostMemory.getArray<int>(numTokens, -1);
+
+	CellFunctionGroups result;
+	result.init(memory, numTokens);
+	result.sort([&](int tokenIndex) { return cellFunctionByToken.at(tokenIndex); });
+	return result;
+}
+
+/**
+* Situation: five tokens whose cells have three different cell functions
+* Expected result: token indices are ordered by cell function, groups without tokens are empty
+*/
+TEST_F(CellFunctionGroupsTest, testSort)
+{
+	vector<int> const cellFunctionByToken = { Enums::CellFunction::SENSOR,
+											  Enums::CellFunction::COMPUTER,
+											  Enums::CellFunction::SENSOR,
+											  Enums::CellFunction::COMMUNICATOR,
+											  Enums::CellFunction::COMPUTER };
+	HostMemory hostMemory;
+	auto const groups = createGroups(cellFunctionByToken, hostMemory);
+
+	auto const tokenIndices = groups.getMemory().tokenIndices;
+	EXPECT_EQ((vector<int>{ 1, 4, 0, 2, 3 }), vector<int>(tokenIndices, tokenIndices + 5));
+	EXPECT_EQ(2, groups.getNumTokens(Enums::CellFunction::COMPUTER));
+	EXPECT_EQ(0, groups.getNumTokens(Enums::CellFunction::CONSTRUCTOR));
+	EXPECT_EQ(2, groups.getTokenIndex(Enums::CellFunction::SENSOR, 1));
+	EXPECT_EQ(3, groups.getTokenIndex(Enums::CellFunction::COMMUNICATOR, 0));
+}
+
+/**
+* Situation: many tokens with random cell functions
+* Expected result: every token occurs once in the group of its cell function, in the original order
+*/
+TEST_F(CellFunctionGroupsTest, testSortIsStable)
+{
+	std::mt19937 engine(1);
+	std::uniform_int_distribution<int> distribution(0, CellFunctionGroups::NumGroups - 1);
+	vector<int> cellFunctionByToken(5000);
+	for (auto& cellFunction : cellFunctionByToken) {
+		cellFunction = distribution(engine);
+	}
+	HostMemory hostMemory;
+	auto const groups = createGroups(cellFunctionByToken, hostMemory);
+
+	ASSERT_EQ(5000, groups.getMemory().offsets[CellFunctionGroups::NumGroups]);
+	for (int group = 0; group < CellFunctionGroups::NumGroups; ++group) {
+		auto prevTokenIndex = -1;
+		for (int index = 0; index < groups.getNumTokens(group); ++index) {
+			auto const tokenIndex = groups.getTokenIndex(group, index);
+			EXPECT_EQ(group, cellFunctionByToken.at(tokenIndex));
+			EXPECT_LT(prevTokenIndex, tokenIndex);
+			prevTokenIndex = tokenIndex;
+		}
+	}
+}
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+
+#include "EngineInterface/ClusterHasher.h"
+
+class ClusterHasherTest : public ::testing::Test
+{
+public:
+	ClusterHasherTest() = default;
+	~ClusterHasherTest() = default;
+
+protected:
+	struct Bond
+	{
+		int index1;
+		int index2;
+	};
+	//cell at index i gets id idOffset + i, cells are listed in the given order, rotated by 90 degrees if requested
+	ClusterDescription createCluster(
+		vector<Enums::CellFunction::Type> const& types,
+		vector<Bond> const& bonds,
+		uint64_t idOffset,
+		vector<int> const& order,
+		bool rotated) const;
+};
+
+ClusterDescription ClusterHasherTest::createCluster(
+	vector<Enums::CellFunction::Type> const& types,
+	vector<Bond> const& bonds,
+	uint64_t idOffset,
+	vector<int> const& order,
+	bool rotated) const
+{
+	auto const numCells = static_cast<int>(types.size());
+	vector<list<uint64_t>> connectingCells(numCells);
+	for (auto const& bond : bonds) {
+		connectingCells[bond.index1].emplace_back(idOffset + bond.index2);
+		connectingCells[bond.index2].emplace_back(idOffset + bond.index1);
+	}
+
+	ClusterDescription result;
+	result.setId(idOffset).setPos(QVector2D(0, 0)).setVel(QVector2D(0, 0)).setAngle(rotated ? 90 : 0).setAngularVel(0);
+	for (auto const& index : order) {
+		result.addCell(CellDescription()
+			.setId(idOffset + index)
+			.setPos(rotated ? QVector2D(0, index) : QVector2D(index, 0))
+			.setEnergy(100)
+			.setMaxConnections(3)
+			.setConnectingCells(connectingCells[index])
+			.setFlagTokenBlocked(false)
+			.setTokenBranchNumber(0)
+			.setCellFeature(CellFeatureDescription().setType(types.at(index))));
+	}
+	return result;
+}
+
+/**
+* Situation: copy of a branched cluster with other cell ids, other cell order and rotated cell positions
+* Expected result: structure hashes are equal
+*/
+TEST_F(ClusterHasherTest, testRenumberedAndRotatedCopy)
+{
+	using Enums::CellFunction;
+	vector<CellFunction::Type> const types = {
+		CellFunction::COMPUTER, CellFunction::SCANNER, CellFunction::WEAPON, CellFunction::COMPUTER, CellFunction::SENSOR};
+	vector<Bond> const bonds = {{0, 1}, {1, 2}, {2, 3}, {1, 4}};
+
+	auto const cluster = createCluster(types, bonds, 100, {0, 1, 2, 3, 4}, false);
+	auto const copy = createCluster(types, bonds, 5000, {3, 1, 4, 0, 2}, true);
+
+	EXPECT_EQ(ClusterHasher::calcStructureHash(cluster), ClusterHasher::calcStructureHash(copy));
+}
+
+/**
+* Situation: copy of a branched cluster where one bond is attached to another cell
+* Expected result: structure hashes differ
+*/
+TEST_F(ClusterHasherTest, testChangedBond)
+{
+	using Enums::CellFunction;
+	vector<CellFunction::Type> const types = {
+		CellFunction::COMPUTER, CellFunction::SCANNER, CellFunction::WEAPON, CellFunction::COMPUTER, CellFunction::SENSOR};
+
+	auto const cluster = createCluster(types, {{0, 1}, {1, 2}, {2, 3}, {1, 4}}, 100, {0, 1, 2, 3, 4}, false);
+	auto const changedCluster = createCluster(types, {{0, 1}, {1, 2}, {2, 3}, {2, 4}}, 100, {0, 1, 2, 3, 4}, false);
+
+	EXPECT_NE(ClusterHasher::calcStructureHash(cluster), ClusterHasher::calcStructureHash(changedCluster));
+}
@@ -0,0 +1,138 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "EngineGpuKernels/ClusterSchedule.h"
+
+class ClusterScheduleTest : public ::testing::Test
+{
+public:
+	ClusterScheduleTest() = default;
+	~ClusterScheduleTest() = default;
+
+protected:
+	ClusterSchedule createSchedule(std::vector<int> const& numCellsByCluster, std::vector<int>& offsets) const;
+
+	//host simulation of the GPU: costs of the block with the most costs
+	int calcMaxBlockCosts(ClusterSchedule const& schedule, std::vector<int> const& numCellsByCluster, int numBlocks) const;
+
+	//partition by number of clusters as calculated by calcPartition
+	int calcMaxBlockCostsWithoutSchedule(std::vector<int> const& numCellsByCluster, int numBlocks) const;
+
+	//one large cluster in front of many small clusters
+	std::vector<int> createHeterogeneousClusters() const;
+};
+
+ClusterSchedule ClusterScheduleTest::createSchedule(std::vector<int> const& numCellsByCluster, std::vector<int>& offsets) const
+{
+	offsets = std::vector<int>(numCellsByCluster.size() + 1, -1);
+	ClusterSchedule result;
+	result.init(offsets.data(), static_cast<int>(numCellsByCluster.size()));
+	result.calcOffsets([&](int clusterIndex) { return numCellsByCluster.at(clusterIndex); });
+	return result;
+}
+
+int ClusterScheduleTest::calcMaxBlockCosts(
+	ClusterSchedule const& schedule,
+	std::vector<int> const& numCellsByCluster,
+	int numBlocks) const
+{
+	int result = 0;
+	std::vector<int> numVisits(numCellsByCluster.size(), 0);
+	for (int block = 0; block < numBlocks; ++block) {
+		auto const range = schedule.getRange(block, numBlocks);
+		int blockCosts = 0;
+		for (int clusterIndex = range.startIndex; clusterIndex <= range.endIndex; ++clusterIndex) {
+			blockCosts += ClusterSchedule::calcCosts(numCellsByCluster.at(clusterIndex));
+			++numVisits.at(clusterIndex);
+		}
+		result = std::max(result, blockCosts);
+	}
+	EXPECT_EQ(std::vector<int>(numCellsByCluster.size(), 1), numVisits);
+	return result;
+}
+
+int ClusterScheduleTest::calcMaxBlockCostsWithoutSchedule(std::vector<int> const& numCellsByCluster, int numBlocks) const
+{
+	int result = 0;
+	auto const numClusters = static_cast<int>(numCellsByCluster.size());
+	for (int block = 0; block < numBlocks; ++block) {
+		auto const startIndex = numClusters * block / numBlocks;
+		auto const endIndex = numClusters * (block + 1) / numBlocks;
+		int blockCosts = 0;
+		for (int clusterIndex = startIndex; clusterIndex < endIndex; ++clusterIndex) {
+			blockCosts += ClusterSchedule::calcCosts(numCellsByCluster.at(clusterIndex));
+		}
+		result = std::max(result, blockCosts);
+	}
+	return result;
+}
+
+std::vector<int> ClusterScheduleTest::createHeterogeneousClusters() const
+{
+	std::vector<int> result(100000, 2);
+	result.at(0) = 50000;
+	return result;
+}
+
+TEST_F(ClusterScheduleTest, testOffsets)
+{
+	std::vector<int> offsets;
+	auto const schedule = createSchedule({ 1, 0, 5 }, offsets);
+	auto const costs = ClusterSchedule::ClusterCosts;
+	EXPECT_EQ((std::vector<int>{ 0, costs + 1, 2 * costs + 1, 3 * costs + 6 }), offsets);
+	EXPECT_EQ(3 * costs + 6, schedule.getTotalCosts());
+}
+
+/**
+* Situation: clusters of random sizes, more blocks than clusters
+* Expected result: every cluster is processed by exactly one block
+*/
+TEST_F(ClusterScheduleTest, testEveryClusterOnce)
+{
+	std::mt19937 engine(1);
+	std::uniform_int_distribution<int> distribution(1, 300);
+	for (int numClusters : { 0, 1, 7, 1000 }) {
+		std::vector<int> numCellsByCluster(numClusters);
+		for (auto& numCells : numCellsByCluster) {
+			numCells = distribution(engine);
+		}
+		std::vector<int> offsets;
+		auto const schedule = createSchedule(numCellsByCluster, offsets);
+		for (int numBlocks : { 1, 5, 64, 2000 }) {
+			calcMaxBlockCosts(schedule, numCellsByCluster, numBlocks);
+		}
+	}
+}
+
+/**
+* Situation: one cluster with 50000 cells followed by 100000 clusters with 2 cells
+* Expected result: the block of the large cluster gets less small clusters and the costs of no block exceed the
+* average costs by more than one cluster
+*/
+TEST_F(ClusterScheduleTest, testHeterogeneousClusters)
+{
+	auto const numCellsByCluster = createHeterogeneousClusters();
+	std::vector<int> offsets;
+	auto const schedule = createSchedule(numCellsByCluster, offsets);
+	auto const numBlocks = 64;
+	auto const numClusters = static_cast<int>(numCellsByCluster.size());
+
+	auto const firstRange = schedule.getRange(0, numBlocks);
+	EXPECT_EQ(0, firstRange.startIndex);
+	EXPECT_GT(numClusters / numBlocks / 4, firstRange.endIndex);
+	EXPECT_LT(numClusters / numBlocks, schedule.getRange(1, numBlocks).numElements());
+
+	auto const costsPerBlock = schedule.getTotalCosts() / numBlocks;
+	auto const maxBlockCosts = calcMaxBlockCosts(schedule, numCellsByCluster, numBlocks);
+	EXPECT_GE(costsPerBlock + ClusterSchedule::calcCosts(50000), maxBlockCosts);
+	EXPECT_LT(maxBlockCosts * 3 / 2, calcMaxBlockCostsWithoutSchedule(numCellsByCluster, numBlocks));
+
+	//without the large cluster all blocks get about the same costs
+	std::vector<int> const smallClusters(numCellsByCluster.begin() + 1, numCellsByCluster.end());
+	auto const smallSchedule = createSchedule(smallClusters, offsets);
+	EXPECT_GE(
+		smallSchedule.getTotalCosts() / numBlocks + ClusterSchedule::calcCosts(2),
+		calcMaxBlockCosts(smallSchedule, smallClusters, numBlocks));
+}
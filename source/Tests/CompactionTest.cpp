@@ -0,0 +1,124 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "EngineGpuKernels/Compaction.h"
+
+class CompactionTest : public ::testing::Test
+{
+public:
+	CompactionTest() = default;
+	~CompactionTest() = default;
+
+protected:
+	//entries are 1, 2, ..., numEntries (0 = cleared), returns the cleared indices in random order
+	std::vector<int> clearRandomEntries(std::vector<int>& entries, int numClearedEntries, unsigned int seed) const;
+
+	//host version of the passes, returns new number of entries
+	int compact(std::vector<int>& entries, std::vector<int> const& clearedIndices) const;
+};
+
+std::vector<int> CompactionTest::clearRandomEntries(std::vector<int>& entries, int numClearedEntries, unsigned int seed) const
+{
+	std::vector<int> indices(entries.size());
+	for (int index = 0; index < static_cast<int>(indices.size()); ++index) {
+		indices.at(index) = index;
+	}
+	std::mt19937 engine(seed);
+	std::shuffle(indices.begin(), indices.end(), engine);
+	indices.resize(numClearedEntries);
+
+	for (auto const& index : indices) {
+		entries.at(index) = 0;
+	}
+	return indices;
+}
+
+int CompactionTest::compact(std::vector<int>& entries, std::vector<int> const& clearedIndices) const
+{
+	std::vector<int> movedIndices(clearedIndices.size(), -1);
+	int numMovedIndices = 0;
+	int numFilledGaps = 0;
+
+	IncrementalCompaction<int>::Memory memory;
+	memory.entries = entries.data();
+	memory.clearedIndices = clearedIndices.data();
+	memory.movedIndices = movedIndices.data();
+	memory.numMovedIndices = &numMovedIndices;
+	memory.numFilledGaps = &numFilledGaps;
+
+	IncrementalCompaction<int> compaction;
+	compaction.init(memory, static_cast<int>(entries.size()), static_cast<int>(clearedIndices.size()));
+	compaction.compact();
+	EXPECT_EQ(numMovedIndices, numFilledGaps);
+	return compaction.getNewNumEntries();
+}
+
+/**
+* Situation: random entries of an array are cleared, also entries at the end
+* Expected result: the new array consists of exactly the remaining entries
+*/
+TEST_F(CompactionTest, testCompactRandomEntries)
+{
+	for (int numClearedEntries : {0, 1, 17, 500, 999, 1000}) {
+		std::vector<int> entries(1000);
+		for (int index = 0; index < static_cast<int>(entries.size()); ++index) {
+			entries.at(index) = index + 1;
+		}
+		auto const clearedIndices = clearRandomEntries(entries, numClearedEntries, numClearedEntries);
+		auto expectedEntries = entries;
+		expectedEntries.erase(std::remove(expectedEntries.begin(), expectedEntries.end(), 0), expectedEntries.end());
+
+		auto const numEntries = compact(entries, clearedIndices);
+		ASSERT_EQ(static_cast<int>(expectedEntries.size()), numEntries);
+
+		entries.resize(numEntries);
+		std::sort(entries.begin(), entries.end());
+		EXPECT_EQ(expectedEntries, entries);
+	}
+}
+
+/**
+* Situation: few entries of a large array are cleared
+* Expected result: only entries behind the new end are moved, the entries in front keep their position
+*/
+TEST_F(CompactionTest, testCompactKeepsPositions)
+{
+	std::vector<int> entries(100000);
+	for (int index = 0; index < static_cast<int>(entries.size()); ++index) {
+		entries.at(index) = index + 1;
+	}
+	auto const originalEntries = entries;
+	auto const clearedIndices = clearRandomEntries(entries, 10, 1);
+
+	auto const numEntries = compact(entries, clearedIndices);
+	ASSERT_EQ(99990, numEntries);
+
+	int numChangedEntries = 0;
+	for (int index = 0; index < numEntries; ++index) {
+		if (entries.at(index) != originalEntries.at(index)) {
+			EXPECT_NE(clearedIndices.end(), std::find(clearedIndices.begin(), clearedIndices.end(), index));
+			EXPECT_LT(numEntries, entries.at(index));
+			++numChangedEntries;
+		}
+	}
+	EXPECT_GE(10, numChangedEntries);
+}
+
+TEST_F(CompactionTest, testPolicy)
+{
+	CompactionPolicy const policy(66, 50);
+
+	EXPECT_FALSE(policy.isCompactionRequired(0, 0, 1000));
+	EXPECT_FALSE(policy.isCompactionRequired(660, 660, 1000));
+	EXPECT_TRUE(policy.isCompactionRequired(661, 661, 1000));
+
+	EXPECT_FALSE(policy.isCompactionRequired(100, 50, 1000));
+	EXPECT_TRUE(policy.isCompactionRequired(100, 49, 1000));
+	EXPECT_FALSE(policy.isFillLevelExceeded(660, 1000));
+	EXPECT_TRUE(policy.isFillLevelExceeded(661, 1000));
+
+	//no overflow for large arrays
+	EXPECT_FALSE(policy.isCompactionRequired(100000000, 100000000, 200000000));
+}
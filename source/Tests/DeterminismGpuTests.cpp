@@ -0,0 +1,114 @@
+#include "EngineInterface/DescriptionHasher.h"
+#include "EngineInterface/EngineInterfaceSettings.h"
+#include "EngineInterface/ExecutionParameters.h"
+
+#include "IntegrationGpuTestFramework.h"
+
+class DeterminismGpuTests
+	: public IntegrationGpuTestFramework
+{
+public:
+	DeterminismGpuTests() : IntegrationGpuTestFramework({ 600, 300 })
+	{
+		auto executionParameters = EngineInterfaceSettings::getDefaultExecutionParameters();
+		executionParameters.deterministic = true;
+		_context->setExecutionParameters(executionParameters);
+	}
+
+	virtual ~DeterminismGpuTests() = default;
+
+protected:
+	DataDescription createWorld() const;
+
+	//2x2 clusters crowded in a corner of the world with a token running through weapon cells
+	DataDescription createWorldWithWeapons() const;
+
+	//replay check: hash of the world state after every time step
+	vector<uint64_t> runAndCalcHashes(DataDescription const& world, int timesteps) const;
+};
+
+DataDescription DeterminismGpuTests::createWorld() const
+{
+	DataDescription result;
+	for (int i = 0; i < 100; ++i) {
+		result.addCluster(createRectangularCluster({ 3, 3 }));
+	}
+	for (int i = 0; i < 1000; ++i) {
+		result.addParticle(createParticle());
+	}
+	return result;
+}
+
+DataDescription DeterminismGpuTests::createWorldWithWeapons() const
+{
+	DataDescription result;
+	for (int i = 0; i < 300; ++i) {
+		auto cluster = createRectangularCluster(
+			{ 2, 2 },
+			QVector2D(_numberGen->getRandomReal(0, 60), _numberGen->getRandomReal(0, 60)),
+			QVector2D(_numberGen->getRandomReal(-0.3, 0.3), _numberGen->getRandomReal(-0.3, 0.3)));
+		auto& cells = *cluster.cells;
+		cells[0].tokenBranchNumber = 0;
+		cells[1].tokenBranchNumber = 1;
+		cells[3].tokenBranchNumber = 2;
+		cells[2].tokenBranchNumber = 3;
+		for (auto& cell : cells) {
+			cell.cellFeature = CellFeatureDescription().setType(Enums::CellFunction::WEAPON);
+		}
+		cells[0].addToken(createSimpleToken());
+		result.addCluster(cluster);
+	}
+	return result;
+}
+
+vector<uint64_t> DeterminismGpuTests::runAndCalcHashes(DataDescription const& world, int timesteps) const
+{
+	_access->clear();
+	_context->setTimestep(0);
+	IntegrationTestHelper::updateData(_access, _context, world);
+
+	vector<uint64_t> result;
+	for (int t = 0; t < timesteps; ++t) {
+		IntegrationTestHelper::runSimulation(1, _controller);
+		auto const data = IntegrationTestHelper::getContent(_access, { { 0, 0 }, { _universeSize.x, _universeSize.y } });
+		result.emplace_back(DescriptionHasher::calcHash(data));
+	}
+	return result;
+}
+
+/**
+* Situation: colliding clusters and particles with radiation, simulated twice from the same state and seed
+* Expected result: world states are bitwise identical after every time step
+*/
+TEST_F(DeterminismGpuTests, testReplay)
+{
+	_parameters.radiationProb = 0.3f;
+	_context->setSimulationParameters(_parameters);
+
+	auto const world = createWorld();
+	auto const hashes = runAndCalcHashes(world, 50);
+	auto const replayedHashes = runAndCalcHashes(world, 50);
+
+	for (int t = 0; t < hashes.size(); ++t) {
+		ASSERT_EQ(hashes.at(t), replayedHashes.at(t)) << "replay diverges in time step " << t;
+	}
+}
+
+/**
+* Situation: crowded weapon clusters striking each other, simulated twice from the same state and seed
+* Expected result: no deadlock and world states are bitwise identical after every time step
+*/
+TEST_F(DeterminismGpuTests, testReplayWithWeapons)
+{
+	_parameters.radiationProb = 0;
+	_parameters.cellMaxTokenBranchNumber = 4;
+	_context->setSimulationParameters(_parameters);
+
+	auto const world = createWorldWithWeapons();
+	auto const hashes = runAndCalcHashes(world, 50);
+	auto const replayedHashes = runAndCalcHashes(world, 50);
+
+	for (int t = 0; t < hashes.size(); ++t) {
+		ASSERT_EQ(hashes.at(t), replayedHashes.at(t)) << "replay diverges in time step " << t;
+	}
+}
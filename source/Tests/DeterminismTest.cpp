@@ -0,0 +1,151 @@
+#include <algorithm>
+#include <random>
+#include <gtest/gtest.h>
+
+#include "Base/DeterministicMath.h"
+#include "Base/Philox.h"
+#include "EngineInterface/DescriptionHasher.h"
+#include "EngineInterface/Descriptions.h"
+
+/**
+* Host reference of the deterministic simulation mode: checks the primitives the GPU kernels rely on without
+* requiring a GPU.
+*/
+class DeterminismTest : public ::testing::Test
+{
+public:
+	DeterminismTest() = default;
+	~DeterminismTest() = default;
+
+protected:
+	DataDescription createWorld(uint64_t firstId) const;
+};
+
+DataDescription DeterminismTest::createWorld(uint64_t firstId) const
+{
+	DataDescription result;
+	auto id = firstId;
+	for (int i = 0; i < 10; ++i) {
+		ClusterDescription cluster;
+		cluster.setId(id++).setPos({ i * 10.0f, 5.0f }).setVel({ 0.5f, -0.25f }).setAngle(i).setAngularVel(0.1);
+		auto const firstCellId = id;
+		for (int j = 0; j < 4; ++j) {
+			list<uint64_t> connectingCells;
+			if (j > 0) {
+				connectingCells.emplace_back(firstCellId + j - 1);
+			}
+			if (j < 3) {
+				connectingCells.emplace_back(firstCellId + j + 1);
+			}
+			cluster.addCell(CellDescription()
+				.setId(id++)
+				.setPos({ i * 10.0f + j, 5.0f })
+				.setEnergy(100.0 + j)
+				.setMaxConnections(2)
+				.setConnectingCells(connectingCells)
+				.setTokenBranchNumber(j));
+		}
+		result.addCluster(cluster);
+	}
+	for (int i = 0; i < 10; ++i) {
+		result.addParticle(ParticleDescription().setId(id++).setPos({ i * 3.0f, 20.0f }).setVel({ 1, 0 }).setEnergy(i));
+	}
+	return result;
+}
+
+/**
+* Situation: energy changes snapped to the grid are summed up in different orders as done by atomics
+* Expected result: all sums are bitwise identical
+*/
+TEST_F(DeterminismTest, testSnappedSumsAreOrderIndependent)
+{
+	std::mt19937 engine(42);
+	std::uniform_real_distribution<float> distribution(-5.0f, 5.0f);
+	vector<float> changes;
+	for (int i = 0; i < 1000; ++i) {
+		changes.emplace_back(DeterministicMath::snapToGrid(distribution(engine), DeterministicMath::EnergyFractionBits));
+	}
+
+	auto const sum = [&changes] {
+		auto result = DeterministicMath::snapToGrid(100.3f, DeterministicMath::EnergyFractionBits);
+		for (auto const& change : changes) {
+			result += change;
+		}
+		return result;
+	};
+	auto const referenceSum = sum();
+	for (int i = 0; i < 10; ++i) {
+		std::shuffle(changes.begin(), changes.end(), engine);
+		EXPECT_EQ(referenceSum, sum());
+	}
+}
+
+/**
+* Situation: numbers of an entity are drawn in different timesteps and sub-streams (as by the GPU threads in
+* deterministic mode)
+* Expected result: numbers only depend on seed, entity, timestep and sub-stream
+*/
+TEST_F(DeterminismTest, testEntityStreams)
+{
+	auto const seed = 0x1234ull;
+	auto const entityId = 77ull;
+	auto const subStream = (3u << 24) | (5u << 8);
+
+	auto const block1 = Philox::generateForEntity(seed, entityId, 10, subStream);
+	auto const block2 = Philox::generateForEntity(seed, entityId, 10, subStream);
+	EXPECT_TRUE(std::equal(std::begin(block1.values), std::end(block1.values), std::begin(block2.values)));
+
+	for (auto const& other : { Philox::generateForEntity(seed, entityId, 11, subStream),
+							   Philox::generateForEntity(seed, entityId, 10, subStream + (1 << 8)),
+							   Philox::generateForEntity(seed, entityId + 1, 10, subStream),
+							   Philox::generateForEntity(seed + 1, entityId, 10, subStream) }) {
+		EXPECT_NE(block1.values[0], other.values[0]);
+	}
+}
+
+/**
+* Situation: same world with entities in different order and with different ids
+* Expected result: hashes are equal
+*/
+TEST_F(DeterminismTest, testHashIgnoresOrderAndIds)
+{
+	auto const world = createWorld(1);
+	auto permutedWorld = createWorld(1000);
+	std::reverse(permutedWorld.clusters->begin(), permutedWorld.clusters->end());
+	std::reverse(permutedWorld.particles->begin(), permutedWorld.particles->end());
+	std::reverse(permutedWorld.clusters->front().cells->begin(), permutedWorld.clusters->front().cells->end());
+
+	EXPECT_EQ(DescriptionHasher::calcHash(world), DescriptionHasher::calcHash(permutedWorld));
+}
+
+/**
+* Situation: worlds differing in the last bit of a cell energy, a particle position, a token or a bond
+* Expected result: hashes differ
+*/
+TEST_F(DeterminismTest, testHashDetectsChanges)
+{
+	auto const world = createWorld(1);
+	auto const hash = DescriptionHasher::calcHash(world);
+
+	auto changedWorld = world;
+	auto& energy = *changedWorld.clusters->at(3).cells->at(1).energy;
+	energy = std::nextafter(energy, 200.0);
+	EXPECT_NE(hash, DescriptionHasher::calcHash(changedWorld));
+
+	changedWorld = world;
+	changedWorld.particles->at(5).pos->setX(changedWorld.particles->at(5).pos->x() + 0.001f);
+	EXPECT_NE(hash, DescriptionHasher::calcHash(changedWorld));
+
+	changedWorld = world;
+	changedWorld.clusters->at(0).cells->at(0).addToken(TokenDescription().setEnergy(10).setData(QByteArray(8, 1)));
+	EXPECT_NE(hash, DescriptionHasher::calcHash(changedWorld));
+
+	//chain 0-1-2-3 becomes 0-2-1-3, the number of bonds of each cell is unchanged
+	changedWorld = world;
+	auto& cells = *changedWorld.clusters->at(2).cells;
+	cells.at(0).setConnectingCells({ cells.at(2).id });
+	cells.at(1).setConnectingCells({ cells.at(2).id, cells.at(3).id });
+	cells.at(2).setConnectingCells({ cells.at(0).id, cells.at(1).id });
+	cells.at(3).setConnectingCells({ cells.at(1).id });
+	EXPECT_NE(hash, DescriptionHasher::calcHash(changedWorld));
+}
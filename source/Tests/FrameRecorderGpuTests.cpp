@@ -0,0 +1,143 @@
+#include <fstream>
+
+#include <QDir>
+
+#include "EngineInterface/FrameRecorder.h"
+
+#include "IntegrationGpuTestFramework.h"
+
+class FrameRecorderGpuTests
+	: public IntegrationGpuTestFramework
+{
+public:
+	FrameRecorderGpuTests()
+		: IntegrationGpuTestFramework({ 600, 300 })
+	{
+		_recorderAccess = _gpuFacade->buildSimulationAccess();
+		_recorderAccess->init(_controller);
+		_recorder = _basicFacade->buildFrameRecorder(_recorderAccess, _context);
+		QObject::connect(
+			_controller, &SimulationController::nextTimestepCalculated, _recorder, &FrameRecorder::notifyNextTimestep);
+
+		_directory = QDir::tempPath().toStdString() + "/FrameRecorderGpuTests";
+		QDir(QString::fromStdString(_directory)).removeRecursively();
+
+		DataDescription origData;
+		for (int i = 0; i < 20; ++i) {
+			origData.addCluster(createRectangularCluster({ 5, 5 }, boost::none, QVector2D(0.5f, 0.2f)));
+		}
+		IntegrationTestHelper::updateData(_access, _context, origData);
+	}
+
+	virtual ~FrameRecorderGpuTests()
+	{
+		delete _recorder;
+		delete _recorderAccess;
+		QDir(QString::fromStdString(_directory)).removeRecursively();
+	}
+
+protected:
+	FrameRecorderSettings createSettings(FrameRecorderSettings::Format format) const;
+	vector<int> readTimestepsFromIndexFile() const;
+
+	SimulationAccessGpu* _recorderAccess = nullptr;
+	FrameRecorder* _recorder = nullptr;
+	string _directory;
+};
+
+FrameRecorderSettings FrameRecorderGpuTests::createSettings(FrameRecorderSettings::Format format) const
+{
+	FrameRecorderSettings result;
+	result.directory = _directory;
+	result.format = format;
+	result.rect = { { 0, 0 }, { _universeSize.x, _universeSize.y } };
+	result.imageSize = { _universeSize.x / 2, _universeSize.y / 2 };
+	result.timestepInterval = 2;
+	return result;
+}
+
+vector<int> FrameRecorderGpuTests::readTimestepsFromIndexFile() const
+{
+	vector<int> result;
+	std::ifstream indexFile(_directory + "/frames.idx");
+	int index, timestep, width, height;
+	uint64_t offset;
+	while (indexFile >> index >> timestep >> offset >> width >> height) {
+		result.emplace_back(timestep);
+	}
+	return result;
+}
+
+/**
+* Situation: recording of a png sequence while simulating
+* Expected result: every recorded frame is written to a png file
+*/
+TEST_F(FrameRecorderGpuTests, testPngSequence)
+{
+	_recorder->start(createSettings(FrameRecorderSettings::Format::PngSequence));
+	IntegrationTestHelper::runSimulation(40, _controller);
+	_recorder->stop();
+
+	auto const numFrames = _recorder->getNumRecordedFrames();
+	EXPECT_GT(numFrames, 0);
+	EXPECT_LE(numFrames + _recorder->getNumDroppedFrames(), 20);
+
+	auto const files = QDir(QString::fromStdString(_directory)).entryList({ "frame_*.png" }, QDir::Files);
+	EXPECT_EQ(numFrames, files.size());
+	EXPECT_TRUE(files.contains("frame_000000.png"));
+}
+
+/**
+* Situation: raw recording while simulating
+* Expected result: raw file contains all recorded frames at the offsets of the index file
+*/
+TEST_F(FrameRecorderGpuTests, testRawWithIndex)
+{
+	auto const settings = createSettings(FrameRecorderSettings::Format::Raw);
+	_recorder->start(settings);
+	IntegrationTestHelper::runSimulation(40, _controller);
+	_recorder->stop();
+
+	auto const frameSize = static_cast<uint64_t>(settings.imageSize.x) * settings.imageSize.y * 4;
+	std::ifstream indexFile(_directory + "/frames.idx");
+	int numFrames = 0;
+	int index, timestep, width, height;
+	uint64_t offset;
+	while (indexFile >> index >> timestep >> offset >> width >> height) {
+		EXPECT_EQ(settings.imageSize.x, width);
+		EXPECT_EQ(settings.imageSize.y, height);
+		EXPECT_EQ(0, static_cast<int>(offset % frameSize));
+		EXPECT_GT(timestep, 0);
+		++numFrames;
+	}
+	EXPECT_GT(numFrames, 0);
+	EXPECT_EQ(_recorder->getNumRecordedFrames(), numFrames);
+
+	std::ifstream rawFile(_directory + "/frames.raw", std::ios::binary | std::ios::ate);
+	EXPECT_EQ(numFrames * frameSize, static_cast<uint64_t>(rawFile.tellg()));
+}
+
+/**
+* Situation: raw recording is stopped and started again immediately while images of the first recording may still be
+*			requested
+* Expected result: index file of the second recording contains only its own frames, tagged with simulation timesteps
+*/
+TEST_F(FrameRecorderGpuTests, testRestart)
+{
+	auto const settings = createSettings(FrameRecorderSettings::Format::Raw);
+	_recorder->start(settings);
+	IntegrationTestHelper::runSimulation(40, _controller);
+	_recorder->stop();
+	auto const timestepAfterFirstRecording = _context->getTimestep();
+
+	_recorder->start(settings);
+	IntegrationTestHelper::runSimulation(40, _controller);
+	_recorder->stop();
+
+	auto const timesteps = readTimestepsFromIndexFile();
+	ASSERT_FALSE(timesteps.empty());
+	EXPECT_EQ(_recorder->getNumRecordedFrames(), timesteps.size());
+	for (auto const& timestep : timesteps) {
+		EXPECT_GT(timestep, timestepAfterFirstRecording);
+	}
+}
@@ -1,5 +1,8 @@
 #include <QElapsedTimer>
 
+#include "EngineInterface/EngineInterfaceSettings.h"
+#include "EngineInterface/ExecutionParameters.h"
+
 #include "IntegrationGpuTestFramework.h"
 
 class GpuBenchmark
@@ -62,6 +65,159 @@ TEST_F(GpuBenchmark, testOnlyClusterMovement)
     std::cerr << "Time elapsed during simulation: " << timer.elapsed() << " ms" << std::endl;
 }
 
+TEST_F(GpuBenchmark, testDeterministicMode)
+{
+    DataDescription origData;
+    for (int i = 0; i < 250; ++i) {
+        origData.addCluster(createRectangularCluster({ 7, 40 },
+            QVector2D{
+            static_cast<float>(_numberGen->getRandomReal(0, _universeSize.x)),
+            static_cast<float>(_numberGen->getRandomReal(0, _universeSize.y)) },
+            QVector2D{
+            static_cast<float>(_numberGen->getRandomReal(-1, 1)),
+            static_cast<float>(_numberGen->getRandomReal(-1, 1)) }
+        ));
+    }
+
+    auto executionParameters = EngineInterfaceSettings::getDefaultExecutionParameters();
+    for (auto const deterministic : { false, true }) {
+        executionParameters.deterministic = deterministic;
+        _context->setExecutionParameters(executionParameters);
+        _access->clear();
+        IntegrationTestHelper::updateData(_access, _context, origData);
+        IntegrationTestHelper::runSimulation(400, _controller);
+
+        QElapsedTimer timer;
+        timer.start();
+        IntegrationTestHelper::runSimulation(200, _controller);
+        std::cerr << "Time elapsed during simulation (deterministic: " << deterministic << "): " << timer.elapsed()
+                  << " ms" << std::endl;
+    }
+}
+
+TEST_F(GpuBenchmark, testSpatialBinning)
+{
+    DataDescription sparseData;
+    for (int i = 0; i < 250; ++i) {
+        sparseData.addCluster(createRectangularCluster({ 7, 40 },
+            QVector2D{
+            static_cast<float>(_numberGen->getRandomReal(0, _universeSize.x)),
+            static_cast<float>(_numberGen->getRandomReal(0, _universeSize.y)) },
+            QVector2D{
+            static_cast<float>(_numberGen->getRandomReal(-1, 1)),
+            static_cast<float>(_numberGen->getRandomReal(-1, 1)) }
+        ));
+    }
+
+    //many small clusters crowded in a region of a quarter of the world
+    DataDescription denseData;
+    for (int i = 0; i < 3000; ++i) {
+        denseData.addCluster(createRectangularCluster({ 4, 4 },
+            QVector2D{
+            static_cast<float>(_numberGen->getRandomReal(0, _universeSize.x / 2)),
+            static_cast<float>(_numberGen->getRandomReal(0, _universeSize.y / 2)) },
+            QVector2D{
+            static_cast<float>(_numberGen->getRandomReal(-0.5, 0.5)),
+            static_cast<float>(_numberGen->getRandomReal(-0.5, 0.5)) }
+        ));
+    }
+
+    auto executionParameters = EngineInterfaceSettings::getDefaultExecutionParameters();
+    for (auto const& [scenario, origData] : { pair<string, DataDescription>{ "sparse", sparseData },
+                                              pair<string, DataDescription>{ "dense", denseData } }) {
+        for (auto const spatialBinning : { false, true }) {
+            executionParameters.spatialBinning = spatialBinning;
+            _context->setExecutionParameters(executionParameters);
+            _access->clear();
+            IntegrationTestHelper::updateData(_access, _context, origData);
+            IntegrationTestHelper::runSimulation(100, _controller);
+
+            QElapsedTimer timer;
+            timer.start();
+            IntegrationTestHelper::runSimulation(200, _controller);
+            std::cerr << "Time elapsed during simulation (" << scenario << ", spatial binning: " << spatialBinning
+                      << "): " << timer.elapsed() << " ms" << std::endl;
+        }
+    }
+}
+
+TEST_F(GpuBenchmark, testClusterLoadBalancing)
+{
+    _parameters.radiationProb = 0;
+    _context->setSimulationParameters(_parameters);
+
+    //one large cluster in front of many small clusters
+    DataDescription origData;
+    origData.addCluster(createRectangularCluster({ 200, 100 },
+        QVector2D{ static_cast<float>(_universeSize.x / 2), static_cast<float>(_universeSize.y / 2) },
+        QVector2D{ 0, 0 }));
+    for (int i = 0; i < 5000; ++i) {
+        origData.addCluster(createRectangularCluster({ 2, 1 },
+            QVector2D{
+            static_cast<float>(_numberGen->getRandomReal(0, _universeSize.x)),
+            static_cast<float>(_numberGen->getRandomReal(0, _universeSize.y)) },
+            QVector2D{
+            static_cast<float>(_numberGen->getRandomReal(-0.5, 0.5)),
+            static_cast<float>(_numberGen->getRandomReal(-0.5, 0.5)) }
+        ));
+    }
+
+    auto executionParameters = EngineInterfaceSettings::getDefaultExecutionParameters();
+    for (auto const clusterLoadBalancing : { false, true }) {
+        executionParameters.clusterLoadBalancing = clusterLoadBalancing;
+        _context->setExecutionParameters(executionParameters);
+        _access->clear();
+        IntegrationTestHelper::updateData(_access, _context, origData);
+        IntegrationTestHelper::runSimulation(100, _controller);
+
+        QElapsedTimer timer;
+        timer.start();
+        IntegrationTestHelper::runSimulation(200, _controller);
+        std::cerr << "Time elapsed during simulation (cluster load balancing: " << clusterLoadBalancing
+                  << "): " << timer.elapsed() << " ms" << std::endl;
+    }
+}
+
+TEST_F(GpuBenchmark, testTokenProcessingWithMixedCellFunctions)
+{
+    _parameters.radiationProb = 0;
+    _context->setSimulationParameters(_parameters);
+
+    //neighboring cells with different functions, tokens move along the rows
+    vector<Enums::CellFunction::Type> const cellFunctions = { Enums::CellFunction::COMPUTER,
+                                                              Enums::CellFunction::PROPULSION,
+                                                              Enums::CellFunction::SCANNER,
+                                                              Enums::CellFunction::WEAPON,
+                                                              Enums::CellFunction::SENSOR,
+                                                              Enums::CellFunction::COMMUNICATOR };
+    DataDescription origData;
+    for (int i = 0; i < 250; ++i) {
+        auto cluster = createRectangularCluster({ 40, 7 },
+            QVector2D{
+            static_cast<float>(_numberGen->getRandomReal(0, _universeSize.x)),
+            static_cast<float>(_numberGen->getRandomReal(0, _universeSize.y)) },
+            QVector2D{});
+        for (int cellIndex = 0; cellIndex < cluster.cells->size(); ++cellIndex) {
+            auto& cell = cluster.cells->at(cellIndex);
+            cell.tokenBranchNumber = (cellIndex % 40) % _parameters.cellMaxTokenBranchNumber;
+            cell.cellFeature = CellFeatureDescription().setType(
+                cellFunctions.at(_numberGen->getRandomInt(static_cast<int>(cellFunctions.size()))));
+            if (0 == cellIndex % 40) {
+                cell.addToken(createSimpleToken());
+            }
+        }
+        origData.addCluster(cluster);
+    }
+
+    IntegrationTestHelper::updateData(_access, _context, origData);
+    IntegrationTestHelper::runSimulation(100, _controller);
+
+    QElapsedTimer timer;
+    timer.start();
+    IntegrationTestHelper::runSimulation(200, _controller);
+    std::cerr << "Time elapsed during simulation: " << timer.elapsed() << " ms" << std::endl;
+}
+
 namespace
 {
     EngineGpuData getEngineGpuDataWithOneBlock()
@@ -0,0 +1,117 @@
+#include <map>
+#include <random>
+#include <gtest/gtest.h>
+
+#include "EngineGpuKernels/HashMap.h"
+
+#include "HostMemory.h"
+
+class HashMapTest : public ::testing::Test
+{
+public:
+	HashMapTest() = default;
+	~HashMapTest() = default;
+
+protected:
+	using IntMap = HashMap<int, int>;
+
+	IntMap createMap(int capacity, HostMemory& hostMemory) const;
+};
+
+HashMapTest::IntMap HashMapTest::createMap(int capacity, HostMemory& hostMemory) const
+{
+	IntMap::Memory memory;
+	memory.slots = hostMemory.getArray<IntMap::Slot>(capacity, 0);
+	memory.values = hostMemory.getArray<int>(capacity, -1);
+
+	IntMap result;
+	result.init(memory, capacity);
+	result.reset();
+	return result;
+}
+
+TEST_F(HashMapTest, testCalcCapacity)
+{
+	EXPECT_EQ(1, IntMap::calcCapacity(0));
+	EXPECT_EQ(2, IntMap::calcCapacity(1));
+	EXPECT_EQ(512, IntMap::calcCapacity(256));
+	EXPECT_EQ(1024, IntMap::calcCapacity(257));
+}
+
+TEST_F(HashMapTest, testInsertOrAssign)
+{
+	HostMemory hostMemory;
+	auto map = createMap(IntMap::calcCapacity(3), hostMemory);
+
+	EXPECT_TRUE(map.insertOrAssign(0, 10));
+	EXPECT_TRUE(map.insertOrAssign(-1, 20));
+	EXPECT_TRUE(map.insertOrAssign(0, 30));
+
+	EXPECT_TRUE(map.contains(0));
+	EXPECT_TRUE(map.contains(-1));
+	EXPECT_FALSE(map.contains(1));
+	EXPECT_EQ(30, map.at(0));
+	EXPECT_EQ(20, map.at(-1));
+	EXPECT_EQ(0, map.at(1));
+
+	auto value = 5;
+	EXPECT_FALSE(map.find(1, value));
+	EXPECT_EQ(5, value);
+}
+
+/**
+* Situation: map completely filled, i.e. every lookup of an absent key has to visit all slots
+* Expected result: all keys are found, absent keys are not found and further keys are rejected
+*/
+TEST_F(HashMapTest, testFullMap)
+{
+	HostMemory hostMemory;
+	auto const capacity = 64;
+	auto map = createMap(capacity, hostMemory);
+	for (int key = 0; key < capacity; ++key) {
+		EXPECT_TRUE(map.insertOrAssign(key * capacity, key));
+	}
+	EXPECT_FALSE(map.insertOrAssign(capacity * capacity, 0));
+	EXPECT_TRUE(map.insertOrAssign(0, 100));
+
+	for (int key = 0; key < capacity; ++key) {
+		auto value = -1;
+		EXPECT_TRUE(map.find(key * capacity, value));
+		EXPECT_EQ(0 == key ? 100 : key, value);
+	}
+	EXPECT_FALSE(map.contains(1));
+	EXPECT_FALSE(map.contains(capacity * capacity));
+}
+
+/**
+* Situation: many rounds of random inserts of clustered keys up to the maximum load, map is reset after each round
+* Expected result: map contains exactly the inserted keys with their last assigned values
+*/
+TEST_F(HashMapTest, testStress)
+{
+	std::mt19937 engine(1);
+	std::uniform_int_distribution<int> keyDistribution(-2000, 2000);
+	std::uniform_int_distribution<int> numEntriesDistribution(0, 2000);
+
+	auto const maxEntries = 2000;
+	HostMemory hostMemory;
+	auto map = createMap(IntMap::calcCapacity(maxEntries), hostMemory);
+	for (int round = 0; round < 50; ++round) {
+		map.reset();
+		std::map<int, int> reference;
+		auto const numInserts = numEntriesDistribution(engine);
+		for (int i = 0; i < numInserts && reference.size() < maxEntries; ++i) {
+			auto const key = keyDistribution(engine);
+			ASSERT_TRUE(map.insertOrAssign(key, i));
+			reference[key] = i;
+		}
+		for (int key = -2100; key <= 2100; ++key) {
+			auto const findResult = reference.find(key);
+			auto value = -1;
+			ASSERT_EQ(findResult != reference.end(), map.find(key, value));
+			if (findResult != reference.end()) {
+				EXPECT_EQ(findResult->second, value);
+			}
+		}
+	}
+}
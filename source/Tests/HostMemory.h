@@ -0,0 +1,24 @@
+#pragma once
+
+#include <memory>
+
+#include "Base/Definitions.h"
+
+/**
+ * Host counterpart of DynamicMemory for testing EngineGpuKernels data structures on the host: owns the arrays of their
+ * Memory structs, which stay valid as long as the HostMemory exists.
+ */
+class HostMemory
+{
+public:
+	template <typename T>
+	T* getArray(int numElements, T const& initialValue = T())
+	{
+		auto array = std::make_shared<vector<T>>(numElements, initialValue);
+		_arrays.emplace_back(array);
+		return array->data();
+	}
+
+private:
+	vector<std::shared_ptr<void>> _arrays;
+};
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <QPointer>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+
+#include "Base/Definitions.h"
+
+/**
+ * Local stand-in for the world explorer server: records requests and answers them with recorded responses.
+ * Requests to failing paths are answered with 404. Answers can be delayed to let requests overlap.
+ */
+class HttpStandInServer : public QObject
+{
+public:
+	struct Request
+	{
+		QByteArray path;
+		QByteArray body;
+	};
+
+	HttpStandInServer()
+	{
+		_server.listen(QHostAddress::LocalHost);
+		connect(&_server, &QTcpServer::newConnection, [this] {
+			while (auto socket = _server.nextPendingConnection()) {
+				connect(socket, &QTcpSocket::readyRead, [this, socket] { readRequest(socket); });
+				connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+			}
+		});
+	}
+
+	string getServerAddress() const
+	{
+		return "http://127.0.0.1:" + std::to_string(_server.serverPort()) + "/api/";
+	}
+
+	vector<Request> const& getRequests() const { return _requests; }
+	int getMaxNumOpenRequests(QByteArray const& path) const
+	{
+		auto const findResult = _maxNumOpenRequestsByPath.find(path);
+		return findResult != _maxNumOpenRequestsByPath.end() ? findResult->second : 0;
+	}
+
+	void setResponse(QByteArray const& path, QByteArray const& body) { _responseByPath[path] = body; }
+	void setFailing(QByteArray const& path) { _failingPaths.insert(path); }
+	void setResponseDelay(int milliseconds) { _responseDelay = milliseconds; }
+
+private:
+	void readRequest(QTcpSocket* socket)
+	{
+		auto& data = _dataBySocket[socket];
+		data += socket->readAll();
+		auto const headerEnd = data.indexOf("\r\n\r\n");
+		if (headerEnd < 0) {
+			return;
+		}
+		int contentLength = 0;
+		for (auto const& line : data.left(headerEnd).split('\n')) {
+			if (line.toLower().startsWith("content-length:")) {
+				contentLength = line.mid(15).trimmed().toInt();
+			}
+		}
+		if (data.size() < headerEnd + 4 + contentLength) {
+			return;
+		}
+		auto const path = data.left(data.indexOf('\n')).split(' ').at(1);
+		_requests.emplace_back(Request{ path, data.mid(headerEnd + 4) });
+		_dataBySocket.erase(socket);
+
+		auto& numOpenRequests = _numOpenRequestsByPath[path];
+		++numOpenRequests;
+		auto& maxNumOpenRequests = _maxNumOpenRequestsByPath[path];
+		maxNumOpenRequests = std::max(maxNumOpenRequests, numOpenRequests);
+
+		QTimer::singleShot(_responseDelay, this, [this, path, socket = QPointer<QTcpSocket>(socket)] {
+			--_numOpenRequestsByPath[path];
+			if (!socket) {
+				return;
+			}
+			auto const body = _responseByPath[path];
+			auto const status = _failingPaths.count(path) > 0 ? QByteArray("404 Not Found") : QByteArray("200 OK");
+			socket->write("HTTP/1.1 " + status + "\r\nContent-Length: " + QByteArray::number(body.size())
+				+ "\r\nConnection: close\r\n\r\n" + body);
+			socket->disconnectFromHost();
+		});
+	}
+
+	QTcpServer _server;
+	std::map<QTcpSocket*, QByteArray> _dataBySocket;
+	vector<Request> _requests;
+	std::map<QByteArray, QByteArray> _responseByPath;
+	std::set<QByteArray> _failingPaths;
+	int _responseDelay = 0;
+	std::map<QByteArray, int> _numOpenRequestsByPath;
+	std::map<QByteArray, int> _maxNumOpenRequestsByPath;
+};
@@ -0,0 +1,243 @@
+#include <numeric>
+#include <gtest/gtest.h>
+
+#include "Base/Job.h"
+#include "Base/JobExecutor.h"
+#include "Base/Worker.h"
+
+class JobExecutorTest : public ::testing::Test
+{
+public:
+	JobExecutorTest() = default;
+	~JobExecutorTest() = default;
+
+protected:
+	//blocks all threads of executor until gate is opened
+	vector<std::future<void>> blockThreads(JobExecutor& executor, std::shared_future<void> const& gate) const;
+};
+
+vector<std::future<void>> JobExecutorTest::blockThreads(
+	JobExecutor& executor,
+	std::shared_future<void> const& gate) const
+{
+	vector<std::future<void>> result;
+	for (int i = 0; i < executor.getNumThreads(); ++i) {
+		result.emplace_back(executor.submit([gate] { gate.wait(); }, TaskPriority::High).second);
+	}
+	return result;
+}
+
+TEST_F(JobExecutorTest, testResults)
+{
+	JobExecutor executor(4);
+
+	vector<std::future<int>> results;
+	for (int i = 0; i < 100; ++i) {
+		results.emplace_back(executor.submit([i] { return i * i; }).second);
+	}
+	for (int i = 0; i < 100; ++i) {
+		EXPECT_EQ(i * i, results.at(i).get());
+	}
+}
+
+TEST_F(JobExecutorTest, testExceptionIsForwardedToFuture)
+{
+	JobExecutor executor(2);
+
+	auto result = executor.submit([]() -> int { throw std::runtime_error("error"); }).second;
+	EXPECT_THROW(result.get(), std::runtime_error);
+}
+
+/**
+* Situation: chain of tasks where every task depends on its predecessor
+* Expected result: tasks are executed in order although several threads are available
+*/
+TEST_F(JobExecutorTest, testDependencies)
+{
+	JobExecutor executor(4);
+
+	std::mutex mutex;
+	vector<int> order;
+	vector<TaskId> previousTask;
+	vector<std::future<void>> results;
+	for (int i = 0; i < 20; ++i) {
+		auto [id, result] = executor.submit(
+			[&, i] {
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				std::lock_guard<std::mutex> lock(mutex);
+				order.emplace_back(i);
+			},
+			TaskPriority::Normal,
+			previousTask);
+		previousTask = { id };
+		results.emplace_back(std::move(result));
+	}
+	for (auto& result : results) {
+		result.get();
+	}
+
+	vector<int> expectedOrder(20);
+	std::iota(expectedOrder.begin(), expectedOrder.end(), 0);
+	EXPECT_EQ(expectedOrder, order);
+}
+
+/**
+* Situation: all threads are busy while tasks with different priorities are submitted
+* Expected result: tasks with higher priority are executed first
+*/
+TEST_F(JobExecutorTest, testPriorities)
+{
+	JobExecutor executor(1);
+
+	std::promise<void> gate;
+	auto blockingTasks = blockThreads(executor, gate.get_future().share());
+
+	std::mutex mutex;
+	vector<TaskPriority> order;
+	vector<std::future<void>> results;
+	for (auto const& priority : { TaskPriority::Low, TaskPriority::Normal, TaskPriority::High, TaskPriority::Low }) {
+		auto task = [&, priority] {
+			std::lock_guard<std::mutex> lock(mutex);
+			order.emplace_back(priority);
+		};
+		results.emplace_back(executor.submit(task, priority).second);
+	}
+	gate.set_value();
+	for (auto& result : results) {
+		result.get();
+	}
+
+	EXPECT_EQ(
+		(vector<TaskPriority>{ TaskPriority::High, TaskPriority::Normal, TaskPriority::Low, TaskPriority::Low }),
+		order);
+}
+
+/**
+* Situation: task is cancelled before it has been started
+* Expected result: task and all tasks depending on it are not executed, also if they are submitted afterwards while
+* other tasks are open
+*/
+TEST_F(JobExecutorTest, testCancellation)
+{
+	JobExecutor executor(2);
+
+	std::promise<void> gate;
+	auto blockingTasks = blockThreads(executor, gate.get_future().share());
+
+	std::atomic<int> numExecutions{ 0 };
+	auto [cancelledId, cancelledResult] = executor.submit([&] { ++numExecutions; });
+	auto [dependentId, dependentResult] =
+		executor.submit([&] { ++numExecutions; }, TaskPriority::Normal, { cancelledId });
+	auto independentResult = executor.submit([&] { ++numExecutions; }).second;
+
+	EXPECT_TRUE(executor.cancel(cancelledId));
+	EXPECT_FALSE(executor.cancel(cancelledId));
+	auto laterResult = executor.submit([&] { ++numExecutions; }, TaskPriority::Normal, { dependentId }).second;
+
+	gate.set_value();
+	independentResult.get();
+	EXPECT_THROW(cancelledResult.get(), std::future_error);
+	EXPECT_THROW(dependentResult.get(), std::future_error);
+	EXPECT_THROW(laterResult.get(), std::future_error);
+	EXPECT_EQ(1, numExecutions.load());
+}
+
+/**
+* Situation: one task spawns many tasks which are queued on its own thread
+* Expected result: idle threads steal tasks
+*/
+TEST_F(JobExecutorTest, testWorkStealing)
+{
+	JobExecutor executor(4);
+
+	std::mutex mutex;
+	set<std::thread::id> threadIds;
+	auto subTask = [&] {
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+		std::lock_guard<std::mutex> lock(mutex);
+		threadIds.insert(std::this_thread::get_id());
+	};
+	auto task = [&] {
+		vector<std::future<void>> results;
+		for (int i = 0; i < 64; ++i) {
+			results.emplace_back(executor.submit(subTask).second);
+		}
+		return results;
+	};
+	auto subResults = executor.submit(task).second.get();
+	for (auto& subResult : subResults) {
+		subResult.get();
+	}
+	EXPECT_LT(1, threadIds.size());
+}
+
+namespace
+{
+	class TestJob : public Job
+	{
+	public:
+		TestJob(string const& id, bool blocking, int numSteps, vector<string>& log)
+			: Job(id, nullptr), _blocking(blocking), _numSteps(numSteps), _log(log)
+		{}
+
+		void process() override
+		{
+			_log.emplace_back(getId());
+			if (!_result.valid()) {
+				_result = runInBackground([] { return 42; }).second;
+			}
+			--_numSteps;
+		}
+		bool isFinished() const override { return _numSteps <= 0 && isReady(_result); }
+		bool isBlocking() const override { return _blocking; }
+
+	private:
+		bool _blocking = false;
+		int _numSteps = 0;
+		vector<string>& _log;
+		std::future<int> _result;
+	};
+
+	void processUntilEmpty(_Worker& worker, vector<string> const& ids)
+	{
+		auto const containsAny = [&] {
+			return std::any_of(ids.begin(), ids.end(), [&](auto const& id) { return worker.contains(id); });
+		};
+		for (int i = 0; i < 1000 && containsAny(); ++i) {
+			worker.process();
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}
+}
+
+/**
+* Situation: worker with a blocking job, a non-blocking job and a job with an explicit dependency
+* Expected result: blocking job delays later jobs, dependency delays dependent job
+*/
+TEST_F(JobExecutorTest, testWorkerDependencies)
+{
+	JobExecutor executor(2);
+	_Worker worker(&executor);
+	vector<string> log;
+	EXPECT_TRUE(worker.add(new TestJob("A", false, 3, log)));
+	EXPECT_TRUE(worker.add(new TestJob("B", true, 2, log)));
+	EXPECT_TRUE(worker.add(new TestJob("C", false, 1, log)));
+	EXPECT_TRUE(worker.add(new TestJob("D", false, 1, log), { "A" }));
+	auto const duplicateJob = new TestJob("A", false, 1, log);
+	EXPECT_FALSE(worker.add(duplicateJob));
+	delete duplicateJob;
+
+	processUntilEmpty(worker, { "A", "B", "C", "D" });
+
+	auto const firstIndexOf = [&](string const& id) {
+		return std::find(log.begin(), log.end(), id) - log.begin();
+	};
+	auto const lastIndexOf = [&](string const& id) {
+		return log.rend() - std::find(log.rbegin(), log.rend(), id) - 1;
+	};
+	ASSERT_TRUE(std::find(log.begin(), log.end(), "D") != log.end());
+	EXPECT_LT(lastIndexOf("B"), firstIndexOf("C"));
+	EXPECT_LT(lastIndexOf("B"), firstIndexOf("D"));
+	EXPECT_LT(lastIndexOf("A"), firstIndexOf("D"));
+	EXPECT_LT(firstIndexOf("A"), firstIndexOf("B"));
+}
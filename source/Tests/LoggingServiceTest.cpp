@@ -0,0 +1,172 @@
+#include <mutex>
+#include <thread>
+#include <gtest/gtest.h>
+
+#include "Base/ServiceLocator.h"
+#include "Base/LoggingService.h"
+
+namespace
+{
+	class TestLogger : public LoggingCallBack
+	{
+	public:
+		TestLogger(Priority minPriority) : _minPriority(minPriority) {}
+
+		void newLogMessage(Priority priority, std::string const& message) override
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_threadId = std::this_thread::get_id();
+			_messages.emplace_back(message.substr(message.find(": ") + 2));
+		}
+		Priority getMinPriority() const override { return _minPriority; }
+
+		vector<string> getMessages() const
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			return _messages;
+		}
+		std::thread::id getThreadId() const
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			return _threadId;
+		}
+
+	private:
+		Priority _minPriority;
+		mutable std::mutex _mutex;
+		vector<string> _messages;
+		std::thread::id _threadId;
+	};
+}
+
+class LoggingServiceTest : public ::testing::Test
+{
+public:
+	LoggingServiceTest()
+	{
+		_loggingService = ServiceLocator::getInstance().getService<LoggingService>();
+		_loggingService->flush();
+	}
+	~LoggingServiceTest() = default;
+
+protected:
+	LoggingService* _loggingService = nullptr;
+};
+
+/**
+* Situation: several threads log messages concurrently
+* Expected result: all messages are passed to the callback, order per thread is preserved
+*/
+TEST_F(LoggingServiceTest, testConcurrentMessages)
+{
+	TestLogger logger(Priority::Unimportant);
+	_loggingService->registerCallBack(&logger);
+
+	auto const numThreads = 4;
+	auto const numMessagesPerThread = 500;
+	vector<std::thread> threads;
+	for (int t = 0; t < numThreads; ++t) {
+		threads.emplace_back([&, t] {
+			for (int i = 0; i < numMessagesPerThread; ++i) {
+				_loggingService->logMessage(Priority::Unimportant, std::to_string(t) + " " + std::to_string(i));
+			}
+		});
+	}
+	for (auto& thread : threads) {
+		thread.join();
+	}
+	_loggingService->unregisterCallBack(&logger);
+
+	vector<int> lastIndexByThread(numThreads, -1);
+	auto numMessages = 0;
+	for (auto const& message : logger.getMessages()) {
+		int t, i;
+		if (2 != sscanf(message.c_str(), "%d %d", &t, &i)) {
+			continue;
+		}
+		++numMessages;
+		EXPECT_EQ(lastIndexByThread.at(t) + 1, i);
+		lastIndexByThread.at(t) = i;
+	}
+	EXPECT_EQ(numThreads * numMessagesPerThread, numMessages);
+}
+
+/**
+* Situation: only important messages are of interest
+* Expected result: unimportant messages are discarded at the call site and deferred messages are not built
+*/
+TEST_F(LoggingServiceTest, testPriorityFiltering)
+{
+	TestLogger logger(Priority::Important);
+	_loggingService->registerCallBack(&logger);
+
+	EXPECT_TRUE(_loggingService->isLogged(Priority::Important));
+	EXPECT_FALSE(_loggingService->isLogged(Priority::Unimportant));
+
+	std::atomic<bool> builderCalled{ false };
+	_loggingService->logDeferredMessage(Priority::Unimportant, [&builderCalled] {
+		builderCalled = true;
+		return string("unimportant");
+	});
+	_loggingService->logMessage(Priority::Unimportant, "unimportant");
+	_loggingService->logMessage(Priority::Important, "important");
+	_loggingService->unregisterCallBack(&logger);
+
+	EXPECT_FALSE(builderCalled.load());
+	EXPECT_EQ(vector<string>{ "important" }, logger.getMessages());
+}
+
+/**
+* Situation: message is logged with deferred formatting
+* Expected result: message is built and passed to the callback on the logging thread
+*/
+TEST_F(LoggingServiceTest, testDeferredMessage)
+{
+	TestLogger logger(Priority::Unimportant);
+	_loggingService->registerCallBack(&logger);
+
+	std::thread::id builderThreadId;
+	_loggingService->logDeferredMessage(Priority::Unimportant, [&builderThreadId, value = 42] {
+		builderThreadId = std::this_thread::get_id();
+		return "value " + std::to_string(value);
+	});
+	_loggingService->flush();
+	_loggingService->unregisterCallBack(&logger);
+
+	EXPECT_EQ(vector<string>{ "value 42" }, logger.getMessages());
+	EXPECT_NE(std::this_thread::get_id(), builderThreadId);
+	EXPECT_EQ(builderThreadId, logger.getThreadId());
+}
+
+/**
+* Situation: callback unregisters itself when it receives a message
+* Expected result: no deadlock, later messages are not passed to the callback anymore
+*/
+TEST_F(LoggingServiceTest, testUnregisterFromCallback)
+{
+	class SelfUnregisteringLogger : public LoggingCallBack
+	{
+	public:
+		SelfUnregisteringLogger(LoggingService* loggingService) : _loggingService(loggingService) {}
+
+		void newLogMessage(Priority priority, std::string const& message) override
+		{
+			++_numMessages;
+			_loggingService->unregisterCallBack(this);
+		}
+		int getNumMessages() const { return _numMessages.load(); }
+
+	private:
+		LoggingService* _loggingService;
+		std::atomic<int> _numMessages{ 0 };
+	};
+
+	SelfUnregisteringLogger logger(_loggingService);
+	_loggingService->registerCallBack(&logger);
+	_loggingService->logMessage(Priority::Important, "first");
+	_loggingService->flush();
+	_loggingService->logMessage(Priority::Important, "second");
+	_loggingService->flush();
+
+	EXPECT_EQ(1, logger.getNumMessages());
+}
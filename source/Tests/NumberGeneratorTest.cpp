@@ -3,6 +3,7 @@
 #include "Base/ServiceLocator.h"
 #include "Base/GlobalFactory.h"
 #include "Base/NumberGenerator.h"
+#include "Base/Philox.h"
 
 class NumberGeneratorTest : public ::testing::Test
 {
@@ -11,6 +12,8 @@ public:
 	~NumberGeneratorTest();
 
 protected:
+	NumberGenerator* buildNumberGenerator(uint64_t seed, uint16_t threadId) const;
+
 	NumberGenerator* _numberGen = nullptr;
 };
 
@@ -25,10 +28,21 @@ NumberGeneratorTest::~NumberGeneratorTest()
 	delete _numberGen;
 }
 
+NumberGenerator* NumberGeneratorTest::buildNumberGenerator(uint64_t seed, uint16_t threadId) const
+{
+	GlobalFactory* factory = ServiceLocator::getInstance().getService<GlobalFactory>();
+	auto const origSeed = factory->getRandomSeed();
+	factory->setRandomSeed(seed);
+	auto result = factory->buildRandomNumberGenerator();
+	result->init(threadId);
+	factory->setRandomSeed(origSeed);
+	return result;
+}
+
 
 TEST_F(NumberGeneratorTest, testTags)
 {
-	_numberGen->init(123, 1);
+	_numberGen->init(1);
 	quint64 tag = _numberGen->getId();
 	EXPECT_EQ(1, tag >> 48);
 	EXPECT_EQ(1, tag & 0xffffffffffff);
@@ -39,7 +53,7 @@ TEST_F(NumberGeneratorTest, testTags)
 	EXPECT_EQ(1, tag >> 48);
 	EXPECT_EQ(3, tag & 0xffffffffffff);
 
-	_numberGen->init(123, 23);
+	_numberGen->init(23);
 	tag = _numberGen->getId();
 	EXPECT_EQ(23, tag >> 48);
 	EXPECT_EQ(1, tag & 0xffffffffffff);
@@ -48,3 +62,89 @@ TEST_F(NumberGeneratorTest, testTags)
 	EXPECT_EQ(2, tag & 0xffffffffffff);
 }
 
+/**
+* Situation: known answer tests from the Philox reference implementation
+* Expected result: same numbers on every platform
+*/
+TEST_F(NumberGeneratorTest, testPhiloxKnownAnswers)
+{
+	auto block = Philox::generate(0, 0, 0);
+	EXPECT_EQ((vector<uint32_t>{ 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 }),
+		vector<uint32_t>(block.values, block.values + 4));
+
+	block = Philox::generate(0x299f31d0a4093822ull, 0x0370734413198a2eull, 0x85a308d3243f6a88ull);
+	EXPECT_EQ((vector<uint32_t>{ 0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1 }),
+		vector<uint32_t>(block.values, block.values + 4));
+}
+
+/**
+* Situation: generators with same and different seed/thread id
+* Expected result: same seed and thread id reproduce the sequence, otherwise sequences differ
+*/
+TEST_F(NumberGeneratorTest, testReproducibleStreams)
+{
+	auto const drawNumbers = [](NumberGenerator* numberGen) {
+		vector<uint32_t> result(1000);
+		for (auto& number : result) {
+			number = numberGen->getRandomInt();
+		}
+		delete numberGen;
+		return result;
+	};
+	auto const numbers = drawNumbers(buildNumberGenerator(42, 1));
+	EXPECT_EQ(numbers, drawNumbers(buildNumberGenerator(42, 1)));
+	EXPECT_NE(numbers, drawNumbers(buildNumberGenerator(42, 2)));
+	EXPECT_NE(numbers, drawNumbers(buildNumberGenerator(43, 1)));
+	EXPECT_EQ(1000, set<uint32_t>(numbers.begin(), numbers.end()).size());
+}
+
+/**
+* Situation: bulk fill is interleaved with single draws
+* Expected result: same sequence as drawing every number separately
+*/
+TEST_F(NumberGeneratorTest, testBulkFill)
+{
+	auto numberGen1 = buildNumberGenerator(7, 0);
+	auto numberGen2 = buildNumberGenerator(7, 0);
+
+	vector<uint32_t> numbers1;
+	numbers1.emplace_back(numberGen1->getRandomInt());
+	vector<uint32_t> bulkNumbers(101);
+	numberGen1->fillRandomInts(bulkNumbers.data(), static_cast<int>(bulkNumbers.size()));
+	numbers1.insert(numbers1.end(), bulkNumbers.begin(), bulkNumbers.end());
+	numbers1.emplace_back(numberGen1->getRandomInt());
+
+	vector<uint32_t> numbers2(numbers1.size());
+	for (auto& number : numbers2) {
+		number = numberGen2->getRandomInt();
+	}
+	EXPECT_EQ(numbers2, numbers1);
+
+	vector<float> reals(37);
+	numberGen1->fillRandomReals(reals.data(), static_cast<int>(reals.size()));
+	for (auto const& real : reals) {
+		EXPECT_EQ(Philox::toFloat(numberGen2->getRandomInt()), real);
+	}
+	delete numberGen1;
+	delete numberGen2;
+}
+
+TEST_F(NumberGeneratorTest, testRanges)
+{
+	_numberGen->init(0);
+	vector<int> histogram(10, 0);
+	for (int i = 0; i < 10000; ++i) {
+		auto const value = _numberGen->getRandomInt(3, 12);
+		ASSERT_LE(3, value);
+		ASSERT_GE(12, value);
+		++histogram.at(value - 3);
+
+		auto const real = _numberGen->getRandomReal(-1.5, 2.5);
+		ASSERT_LE(-1.5, real);
+		ASSERT_GT(2.5, real);
+	}
+	for (auto const& count : histogram) {
+		EXPECT_LT(800, count);
+	}
+	EXPECT_EQ(13, _numberGen->getRandomArray(13).size());
+}
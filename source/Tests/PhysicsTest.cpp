@@ -21,7 +21,7 @@ PhysicsTest::PhysicsTest()
 {
 	GlobalFactory* factory = ServiceLocator::getInstance().getService<GlobalFactory>();
 	_numberGen = factory->buildRandomNumberGenerator();
-	_numberGen->init(123123, 0);
+	_numberGen->init(0);
 }
 
 PhysicsTest::~PhysicsTest()
@@ -0,0 +1,127 @@
+#include <QImage>
+
+#include "EngineInterface/PixelImageRasterizer.h"
+#include "EngineInterface/TiledPixelImage.h"
+
+#include "IntegrationGpuTestFramework.h"
+
+class PixelImageGpuTests
+	: public IntegrationGpuTestFramework
+{
+public:
+	PixelImageGpuTests()
+		: IntegrationGpuTestFramework({ 600, 300 })
+	{}
+
+	virtual ~PixelImageGpuTests() = default;
+
+protected:
+	QImagePtr getPixelImage(IntRect const& rect, IntVector2D const& imageSize);
+	void checkAgainstReference(PixelImageRasterizer& reference, IntRect const& rect, IntVector2D const& imageSize);
+};
+
+QImagePtr PixelImageGpuTests::getPixelImage(IntRect const& rect, IntVector2D const& imageSize)
+{
+	auto result = boost::make_shared<QImage>(imageSize.x, imageSize.y, QImage::Format_RGB32);
+	std::mutex mutex;
+
+	bool imageReady = false;
+	QEventLoop pause;
+	auto connection = _access->connect(_access, &SimulationAccess::imageReady, [&]() {
+		imageReady = true;
+		pause.quit();
+	});
+	_access->requirePixelImage(rect, result, mutex);
+	if (!imageReady) {
+		pause.exec();
+	}
+	QObject::disconnect(connection);
+	return result;
+}
+
+void PixelImageGpuTests::checkAgainstReference(
+	PixelImageRasterizer& reference,
+	IntRect const& rect,
+	IntVector2D const& imageSize)
+{
+	auto const image = getPixelImage(rect, imageSize);
+	auto const data = IntegrationTestHelper::getContent(_access, { { 0, 0 }, { _universeSize.x, _universeSize.y } });
+
+	IntVector2D const rectSize{ rect.p2.x - rect.p1.x, rect.p2.y - rect.p1.y };
+	reference.update(data, rect, TiledPixelImage::calcLevel(rectSize, imageSize));
+	vector<unsigned int> expectedImageData(imageSize.x * imageSize.y);
+	reference.getImage().drawImage(rect, imageSize, expectedImageData.data());
+
+	auto const imageData = reinterpret_cast<unsigned int const*>(image->constBits());
+	for (int index = 0; index < imageSize.x * imageSize.y; ++index) {
+		ASSERT_EQ(expectedImageData[index], imageData[index]) << "pixel " << index % imageSize.x << ", " << index / imageSize.x;
+	}
+}
+
+/**
+* Situation: moving clusters and particles, images of different levels are requested repeatedly
+* Expected result: incrementally transferred GPU image equals the host reference in every frame
+*/
+TEST_F(PixelImageGpuTests, testIncrementalImageMatchesReference)
+{
+	DataDescription origData;
+	for (int i = 0; i < 20; ++i) {
+		origData.addCluster(createRectangularCluster({ 5, 5 }, boost::none, QVector2D(0.5f, 0.2f)));
+	}
+	for (int i = 0; i < 200; ++i) {
+		origData.addParticle(createParticle(boost::none, QVector2D(-0.3f, 0.4f)));
+	}
+	IntegrationTestHelper::updateData(_access, _context, origData);
+
+	PixelImageRasterizer reference(_universeSize);
+	IntRect const fullRect{ { 0, 0 }, { _universeSize.x, _universeSize.y } };
+	IntRect const partialRect{ { 100, 50 }, { 420, 290 } };
+	for (int frame = 0; frame < 10; ++frame) {
+		IntegrationTestHelper::runSimulation(3, _controller);
+		checkAgainstReference(reference, partialRect, { 320, 240 });
+		checkAgainstReference(reference, fullRect, { _universeSize.x / 2, _universeSize.y / 2 });
+	}
+}
+
+/**
+* Situation: moving clusters and particles, the coarser level is requested once and afterwards always after the finer
+*			 level of the same rect
+* Expected result: coarser image built from the finer level equals the host reference in every frame
+*/
+TEST_F(PixelImageGpuTests, testCoarserLevelMatchesReference)
+{
+	DataDescription origData;
+	for (int i = 0; i < 20; ++i) {
+		origData.addCluster(createRectangularCluster({ 5, 5 }, boost::none, QVector2D(0.5f, 0.2f)));
+	}
+	for (int i = 0; i < 200; ++i) {
+		origData.addParticle(createParticle(boost::none, QVector2D(-0.3f, 0.4f)));
+	}
+	IntegrationTestHelper::updateData(_access, _context, origData);
+
+	PixelImageRasterizer reference(_universeSize);
+	IntRect const fullRect{ { 0, 0 }, { _universeSize.x, _universeSize.y } };
+	IntVector2D const coarserImageSize{ _universeSize.x / 2, _universeSize.y / 2 };
+	checkAgainstReference(reference, fullRect, coarserImageSize);
+	for (int frame = 0; frame < 10; ++frame) {
+		IntegrationTestHelper::runSimulation(3, _controller);
+		checkAgainstReference(reference, fullRect, _universeSize);
+		checkAgainstReference(reference, fullRect, coarserImageSize);
+	}
+}
+
+/**
+* Situation: static world, same image requested twice
+* Expected result: both images are equal
+*/
+TEST_F(PixelImageGpuTests, testStaticWorld)
+{
+	DataDescription origData;
+	origData.addCluster(createRectangularCluster({ 10, 10 }, QVector2D(300, 150), QVector2D()));
+	IntegrationTestHelper::updateData(_access, _context, origData);
+
+	IntRect const rect{ { 0, 0 }, { _universeSize.x, _universeSize.y } };
+	auto const image1 = getPixelImage(rect, _universeSize);
+	auto const image2 = getPixelImage(rect, _universeSize);
+	EXPECT_EQ(*image1, *image2);
+}
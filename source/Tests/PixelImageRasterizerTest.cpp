@@ -0,0 +1,175 @@
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/PixelImageRasterizer.h"
+#include "EngineInterface/TiledPixelImage.h"
+
+class PixelImageRasterizerTest : public ::testing::Test
+{
+public:
+	PixelImageRasterizerTest() = default;
+	~PixelImageRasterizerTest() = default;
+
+protected:
+	DataDescription createRandomData(int numCells, int numParticles);
+	vector<unsigned int> getPixels(TiledPixelImage const& image, IntRect const& rect, int level) const;
+
+	IntVector2D const WorldSize{300, 200};
+	std::mt19937 _random{0};
+	uint64_t _id = 0;
+};
+
+DataDescription PixelImageRasterizerTest::createRandomData(int numCells, int numParticles)
+{
+	std::uniform_real_distribution<float> xDistribution(0, static_cast<float>(WorldSize.x));
+	std::uniform_real_distribution<float> yDistribution(0, static_cast<float>(WorldSize.y));
+	std::uniform_real_distribution<double> energyDistribution(0, 400);
+
+	DataDescription result;
+	ClusterDescription cluster;
+	for (int i = 0; i < numCells; ++i) {
+		CellMetadata metadata;
+		metadata.color = static_cast<quint8>(i % 7);
+		cluster.addCell(CellDescription()
+			.setId(++_id)
+			.setPos({xDistribution(_random), yDistribution(_random)})
+			.setEnergy(energyDistribution(_random))
+			.setMetadata(metadata));
+	}
+	result.addCluster(cluster);
+	for (int i = 0; i < numParticles; ++i) {
+		result.addParticle(ParticleDescription()
+			.setId(++_id)
+			.setPos({xDistribution(_random), yDistribution(_random)})
+			.setEnergy(energyDistribution(_random)));
+	}
+	return result;
+}
+
+vector<unsigned int> PixelImageRasterizerTest::getPixels(TiledPixelImage const& image, IntRect const& rect, int level) const
+{
+	vector<unsigned int> result;
+	for (int y = rect.p1.y >> level; y <= (rect.p2.y - 1) >> level; ++y) {
+		for (int x = rect.p1.x >> level; x <= (rect.p2.x - 1) >> level; ++x) {
+			result.emplace_back(image.getPixel(level, {x, y}));
+		}
+	}
+	return result;
+}
+
+TEST_F(PixelImageRasterizerTest, testStaticSceneHasNoDirtyTiles)
+{
+	auto const data = createRandomData(2000, 500);
+	IntRect const rect{{0, 0}, WorldSize};
+
+	PixelImageRasterizer rasterizer(WorldSize);
+	auto const numTiles = rasterizer.getImage().getNumTiles(0);
+	EXPECT_EQ(numTiles.x * numTiles.y, rasterizer.update(data, rect, 0).size());
+	EXPECT_TRUE(rasterizer.update(data, rect, 0).empty());
+}
+
+TEST_F(PixelImageRasterizerTest, testMovingParticleDirtiesOnlyAffectedTiles)
+{
+	auto data = createRandomData(0, 1);
+	auto& particle = data.particles->front();
+	particle.pos = QVector2D(10.5f, 10.5f);
+	IntRect const rect{{0, 0}, WorldSize};
+
+	PixelImageRasterizer rasterizer(WorldSize);
+	rasterizer.update(data, rect, 0);
+
+	particle.pos = QVector2D(11.5f, 10.5f);
+	EXPECT_EQ(vector<int>{0}, rasterizer.update(data, rect, 0));
+
+	particle.pos = QVector2D(40.5f, 10.5f);
+	EXPECT_EQ((vector<int>{0, 1}), rasterizer.update(data, rect, 0));
+
+	//position wraps around at the world boundary
+	particle.pos = QVector2D(40.5f + WorldSize.x, 10.5f);
+	EXPECT_TRUE(rasterizer.update(data, rect, 0).empty());
+}
+
+TEST_F(PixelImageRasterizerTest, testIncrementalUpdatesMatchFullRendering)
+{
+	auto data = createRandomData(1000, 1000);
+	IntRect const rect{{20, 30}, {250, 190}};
+
+	PixelImageRasterizer incrementalRasterizer(WorldSize);
+	std::uniform_int_distribution<int> indexDistribution(0, 999);
+	std::uniform_real_distribution<float> displacementDistribution(-3, 3);
+	for (int step = 0; step < 20; ++step) {
+		for (int i = 0; i < 10; ++i) {
+			auto& particle = data.particles->at(indexDistribution(_random));
+			*particle.pos += QVector2D(displacementDistribution(_random), displacementDistribution(_random));
+			auto& cell = data.clusters->front().cells->at(indexDistribution(_random));
+			*cell.energy += 50;
+		}
+		for (int level = 0; level <= 2; ++level) {
+			incrementalRasterizer.update(data, rect, level);
+
+			PixelImageRasterizer fullRasterizer(WorldSize);
+			fullRasterizer.update(data, rect, level);
+			ASSERT_EQ(
+				getPixels(fullRasterizer.getImage(), rect, level), getPixels(incrementalRasterizer.getImage(), rect, level));
+		}
+	}
+}
+
+TEST_F(PixelImageRasterizerTest, testResultIsIndependentOfOrder)
+{
+	auto data = createRandomData(3000, 3000);
+	IntRect const rect{{0, 0}, WorldSize};
+
+	PixelImageRasterizer rasterizer1(WorldSize);
+	rasterizer1.update(data, rect, 1);
+
+	std::shuffle(data.particles->begin(), data.particles->end(), _random);
+	std::shuffle(data.clusters->front().cells->begin(), data.clusters->front().cells->end(), _random);
+	PixelImageRasterizer rasterizer2(WorldSize);
+	rasterizer2.update(data, rect, 1);
+
+	EXPECT_EQ(getPixels(rasterizer1.getImage(), rect, 1), getPixels(rasterizer2.getImage(), rect, 1));
+}
+
+TEST_F(PixelImageRasterizerTest, testCoarseLevelSumsColors)
+{
+	DataDescription data;
+	data.addParticle(ParticleDescription().setId(1).setPos({4.5f, 6.5f}).setEnergy(10));
+	data.addParticle(ParticleDescription().setId(2).setPos({5.5f, 7.5f}).setEnergy(10));
+	IntRect const rect{{0, 0}, WorldSize};
+
+	PixelImageRasterizer rasterizer(WorldSize);
+	rasterizer.update(data, rect, 1);
+
+	auto const particleColor = PixelImageRasterizer::calcParticleColor(10, false);
+	auto const expectedColor = PixelImageRasterizer::addColors(
+		PixelImageRasterizer::addColors(Const::PixelImageSpaceColor, particleColor), particleColor);
+	EXPECT_EQ(expectedColor, rasterizer.getImage().getPixel(1, {2, 3}));
+	EXPECT_EQ(Const::PixelImageSpaceColor, rasterizer.getImage().getPixel(1, {3, 3}));
+}
+
+TEST_F(PixelImageRasterizerTest, testDrawImageSelectsLevel)
+{
+	EXPECT_EQ(0, TiledPixelImage::calcLevel({300, 200}, {300, 200}));
+	EXPECT_EQ(1, TiledPixelImage::calcLevel({300, 200}, {150, 100}));
+	EXPECT_EQ(2, TiledPixelImage::calcLevel({300, 200}, {100, 100}));
+	EXPECT_EQ(Const::PixelImageMaxLevel, TiledPixelImage::calcLevel({100000, 100000}, {1, 1}));
+
+	auto const data = createRandomData(500, 500);
+	IntRect const rect{{-20, 0}, {280, 200}};
+
+	PixelImageRasterizer rasterizer(WorldSize);
+	rasterizer.update(data, rect, 1);
+
+	vector<unsigned int> imageData(150 * 100);
+	rasterizer.getImage().drawImage(rect, {150, 100}, imageData.data());
+	EXPECT_EQ(Const::PixelImageNothingnessColor, imageData[0]);
+	EXPECT_EQ(Const::PixelImageNothingnessColor, imageData[9]);
+	for (int y = 0; y < 100; ++y) {
+		for (int x = 10; x < 150; ++x) {
+			ASSERT_EQ(rasterizer.getImage().getPixel(1, {x - 10, y}), imageData[y * 150 + x]);
+		}
+	}
+}
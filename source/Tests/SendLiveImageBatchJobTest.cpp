@@ -0,0 +1,203 @@
+#include <algorithm>
+
+#include <QEventLoop>
+#include <QImage>
+#include <QTimer>
+#include <gtest/gtest.h>
+
+#include "Base/ServiceLocator.h"
+#include "EngineInterface/SimulationAccess.h"
+#include "EngineInterface/SimulationMonitor.h"
+#include "Web/TaskBatcher.h"
+#include "Web/TileDeltaEncoder.h"
+#include "Web/WebAccess.h"
+#include "Web/WebBuilderFacade.h"
+#include "Gui/SendLiveImageBatchJob.h"
+#include "Gui/SendStatisticsJob.h"
+#include "Gui/SimulationConfig.h"
+
+#include "HttpStandInServer.h"
+
+/**
+ * Simulation access which draws a pattern of the world coordinates instead of the simulation.
+ */
+class PatternSimulationAccess : public SimulationAccess
+{
+public:
+	static QRgb getPixel(int x, int y) { return qRgb(x % 256, y % 256, (x + y) % 256); }
+
+	void clear() override {}
+	void updateData(DataChangeDescription const& desc) override {}
+	void requireData(IntRect rect, ResolveDescription const& resolveDesc) override {}
+	void requireData(ResolveDescription const& resolveDesc) override {}
+	void requirePixelImage(IntRect rect, QImagePtr const& target, std::mutex& mutex) override
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			for (int y = 0; y < target->height(); ++y) {
+				for (int x = 0; x < target->width(); ++x) {
+					target->setPixel(x, y, getPixel(rect.p1.x + x, rect.p1.y + y));
+				}
+			}
+		}
+		QTimer::singleShot(0, this, [this] { Q_EMIT imageReady(); });
+	}
+	void requireVectorImage(
+		RealRect worldRect,
+		double zoom,
+		ImageResource const& target,
+		IntVector2D const& imageSize,
+		std::mutex& mutex) override
+	{}
+	void selectEntities(IntVector2D const& pos) override {}
+	void deselectAll() override {}
+	void applyAction(PhysicalAction const& action) override {}
+	ImageResource registerImageResource(GLuint imageId) override { return ImageResource(); }
+	DataDescription const& retrieveData() override { return _data; }
+
+private:
+	DataDescription _data;
+};
+
+class EmptySimulationMonitor : public SimulationMonitor
+{
+public:
+	void requireData() override
+	{
+		QTimer::singleShot(0, this, [this] { Q_EMIT dataReadyToRetrieve(); });
+	}
+	MonitorData const& retrieveData() override { return _data; }
+
+private:
+	MonitorData _data;
+};
+
+class SendLiveImageBatchJobTest : public ::testing::Test
+{
+public:
+	SendLiveImageBatchJobTest()
+	{
+		auto const facade = ServiceLocator::getInstance().getService<WebBuilderFacade>();
+		_webAccess = facade->buildWebAccess(_server.getServerAddress());
+		_config = boost::make_shared<_SimulationConfig>();
+		_config->universeSize = { 600, 300 };
+
+		//answers are delayed so that uploads overlap
+		_server.setResponseDelay(50);
+	}
+
+	~SendLiveImageBatchJobTest() { delete _webAccess; }
+
+protected:
+	//processes the job as WebSimulationController does, returns false on timeout
+	bool runJob(vector<Task> const& tasks);
+
+	QImage createExpectedImage(Task const& task) const;
+	int getNumRequests(QByteArray const& path) const;
+
+	//overlapping and disjoint tasks as in TestData/unprocessed-tasks.json
+	vector<Task> const _tasks = {
+		{ "101", { 0, 0 }, { 200, 150 }, "viewer1" },
+		{ "102", { 100, 50 }, { 200, 150 }, "viewer2" },
+		{ "103", { 400, 0 }, { 100, 100 }, "viewer3" },
+		{ "104", { 250, 180 }, { 100, 100 }, "viewer4" },
+		{ "105", { 0, 250 }, { 50, 50 }, "viewer5" },
+		{ "106", { 420, 20 }, { 40, 40 }, "viewer6" } };
+
+	HttpStandInServer _server;
+	WebAccess* _webAccess = nullptr;
+	PatternSimulationAccess _access;
+	EmptySimulationMonitor _monitor;
+	SimulationConfig _config;
+	unordered_map<string, TileDeltaEncoderPtr> _encoderByTaskId;
+};
+
+bool SendLiveImageBatchJobTest::runJob(vector<Task> const& tasks)
+{
+	for (auto const& task : tasks) {
+		_encoderByTaskId.emplace(task.id, boost::make_shared<TileDeltaEncoder>());
+	}
+	auto const statisticsJob = new SendStatisticsJob("simulation", "token", &_monitor, _webAccess, _config, nullptr);
+	SendLiveImageBatchJob job(
+		"simulation",
+		"token",
+		TaskBatcher::createBatches(tasks),
+		_encoderByTaskId,
+		&_access,
+		_webAccess,
+		statisticsJob,
+		nullptr);
+
+	QEventLoop loop;
+	QTimer processTimer;
+	QObject::connect(&processTimer, &QTimer::timeout, [&] {
+		job.process();
+		if (job.isFinished()) {
+			loop.quit();
+		}
+	});
+	processTimer.start(10);
+	QTimer::singleShot(10000, &loop, &QEventLoop::quit);
+	loop.exec();
+	return job.isFinished();
+}
+
+QImage SendLiveImageBatchJobTest::createExpectedImage(Task const& task) const
+{
+	QImage result(task.size.x, task.size.y, QImage::Format_RGB32);
+	for (int y = 0; y < task.size.y; ++y) {
+		for (int x = 0; x < task.size.x; ++x) {
+			result.setPixel(x, y, PatternSimulationAccess::getPixel(task.pos.x + x, task.pos.y + y));
+		}
+	}
+	return result;
+}
+
+int SendLiveImageBatchJobTest::getNumRequests(QByteArray const& path) const
+{
+	auto const& requests = _server.getRequests();
+	return static_cast<int>(std::count_if(
+		requests.begin(), requests.end(), [&](auto const& request) { return request.path == path; }));
+}
+
+/**
+* Situation: tasks of a polling round are processed together with due statistics
+* Expected result: every task is uploaded once with its cropped region, which becomes the base frame of its encoder,
+*			the number of concurrent uploads is bounded and statistics are sent once
+*/
+TEST_F(SendLiveImageBatchJobTest, testUploadCroppedImages)
+{
+	ASSERT_TRUE(runJob(_tasks));
+
+	EXPECT_EQ(_tasks.size(), getNumRequests("/api/sendprocessedtaskdelta"));
+	EXPECT_EQ(1, getNumRequests("/api/sendstatistics"));
+	EXPECT_LE(_server.getMaxNumOpenRequests("/api/sendprocessedtaskdelta"), SendLiveImageBatchJob::MaxConcurrentUploads);
+
+	for (auto const& task : _tasks) {
+		auto const& encoder = _encoderByTaskId.at(task.id);
+		encoder->encode(createExpectedImage(task));
+		EXPECT_EQ(0, encoder->getNumTilesOfLastFrame());
+	}
+}
+
+/**
+* Situation: server fails to receive the uploaded images
+* Expected result: job finishes nevertheless, no frame is committed and tasks can be processed in the next round
+*/
+TEST_F(SendLiveImageBatchJobTest, testFailedUploads)
+{
+	_server.setFailing("/api/sendprocessedtaskdelta");
+	ASSERT_TRUE(runJob(_tasks));
+
+	EXPECT_EQ(_tasks.size(), getNumRequests("/api/sendprocessedtaskdelta"));
+	EXPECT_EQ(1, getNumRequests("/api/sendstatistics"));
+	for (auto const& task : _tasks) {
+		auto const& encoder = _encoderByTaskId.at(task.id);
+		encoder->encode(createExpectedImage(task));
+		EXPECT_LT(0, encoder->getNumTilesOfLastFrame());
+	}
+
+	//uploads of the same tasks are not blocked by the failed ones
+	ASSERT_TRUE(runJob(_tasks));
+	EXPECT_EQ(2 * _tasks.size(), getNumRequests("/api/sendprocessedtaskdelta"));
+}
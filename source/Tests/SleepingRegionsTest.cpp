@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+
+#include "EngineGpuKernels/SleepingRegions.h"
+
+#include "HostMemory.h"
+
+class SleepingRegionsTest : public ::testing::Test
+{
+public:
+	SleepingRegionsTest() = default;
+	~SleepingRegionsTest() = default;
+
+protected:
+	SleepingRegions createRegions(int sizeX, int sizeY, HostMemory& hostMemory) const;
+
+	vector<SleepingRegions::State> getStates(SleepingRegions const& regions) const;
+
+	//256 x 256 world with 4 x 4 regions
+	int const _size = 4 * SleepingRegions::DefaultRegionSize;
+};
+
+SleepingRegions SleepingRegionsTest::createRegions(int sizeX, int sizeY, HostMemory& hostMemory) const
+{
+	auto const layout = SleepingRegions::calcLayout(sizeX, sizeY);
+	SleepingRegions::Memory memory;
+	memory.activities = hostMemory.getArray<int>(layout.getNumRegions(), 0);
+	memory.idleTimesteps = hostMemory.getArray<int>(layout.getNumRegions(), 0);
+	memory.states = hostMemory.getArray<int>(layout.getNumRegions(), 0);
+	memory.counters = hostMemory.getArray<int>(SleepingRegions::NumCounters, 0);
+
+	SleepingRegions result;
+	result.init(layout, memory);
+	return result;
+}
+
+vector<SleepingRegions::State> SleepingRegionsTest::getStates(SleepingRegions const& regions) const
+{
+	vector<SleepingRegions::State> result;
+	for (int region = 0; region < regions.getLayout().getNumRegions(); ++region) {
+		result.emplace_back(regions.getState(region));
+	}
+	return result;
+}
+
+TEST_F(SleepingRegionsTest, testLayout)
+{
+	HostMemory hostMemory;
+	auto const regions = createRegions(_size + 10, 50, hostMemory);
+	EXPECT_EQ(4, regions.getLayout().numRegionsX);
+	EXPECT_EQ(1, regions.getLayout().numRegionsY);
+	EXPECT_EQ(0, regions.getRegion(63.9f, 49.0f));
+	EXPECT_EQ(3, regions.getRegion(static_cast<float>(_size + 9), 0.0f));
+}
+
+/**
+* Situation: activity is reported for one region in every timestep
+* Expected result: all other regions fall asleep after TimestepsUntilSleep timesteps
+*/
+TEST_F(SleepingRegionsTest, testFallAsleep)
+{
+	HostMemory hostMemory;
+	auto regions = createRegions(_size, _size, hostMemory);
+	for (int timestep = 0; timestep < SleepingRegions::TimestepsUntilSleep - 1; ++timestep) {
+		regions.markActive(100.0f, 100.0f, 1.0f);
+		regions.update();
+	}
+	EXPECT_EQ(vector<SleepingRegions::State>(16, SleepingRegions::Awake), getStates(regions));
+
+	regions.markActive(100.0f, 100.0f, 1.0f);
+	regions.update();
+	auto expectedStates = vector<SleepingRegions::State>(16, SleepingRegions::Sleeping);
+	expectedStates.at(5) = SleepingRegions::Awake;
+	EXPECT_EQ(expectedStates, getStates(regions));
+	EXPECT_EQ(15, regions.getCounter(SleepingRegions::NumSleepingRegions));
+	EXPECT_EQ(15, regions.getCounter(SleepingRegions::NumRegionsFallenAsleep));
+	EXPECT_EQ(0, regions.getCounter(SleepingRegions::NumRegionsWokenUp));
+}
+
+/**
+* Situation: all regions sleep, an entity close to the border of two regions reports activity
+* Expected result: both regions are woken up, they are awake after the next update
+*/
+TEST_F(SleepingRegionsTest, testWakeUpByApproachingEntity)
+{
+	HostMemory hostMemory;
+	auto regions = createRegions(_size, _size, hostMemory);
+	for (int timestep = 0; timestep < SleepingRegions::TimestepsUntilSleep; ++timestep) {
+		regions.update();
+	}
+	ASSERT_EQ(16, regions.getCounter(SleepingRegions::NumSleepingRegions));
+
+	regions.markActive(126.0f, 100.0f, 3.0f);
+	regions.update();
+	EXPECT_TRUE(regions.isWokenUp(100.0f, 100.0f));
+	EXPECT_TRUE(regions.isWokenUp(130.0f, 100.0f));
+	EXPECT_TRUE(regions.isSleeping(100.0f, 130.0f));
+	EXPECT_EQ(14, regions.getCounter(SleepingRegions::NumSleepingRegions));
+	EXPECT_EQ(2, regions.getCounter(SleepingRegions::NumRegionsWokenUp));
+
+	regions.update();
+	EXPECT_EQ(SleepingRegions::Awake, regions.getState(regions.getRegion(100.0f, 100.0f)));
+	EXPECT_EQ(SleepingRegions::Awake, regions.getState(regions.getRegion(130.0f, 100.0f)));
+}
+
+/**
+* Situation: entity centered in a sleeping region whose radius reaches into a neighboring region which is kept awake
+* Expected result: the entity is only considered as sleeping when both regions sleep, and as woken up when one of
+* them wakes up
+*/
+TEST_F(SleepingRegionsTest, testEntitySpanningRegionBoundary)
+{
+	HostMemory hostMemory;
+	auto regions = createRegions(_size, _size, hostMemory);
+	for (int timestep = 0; timestep < SleepingRegions::TimestepsUntilSleep; ++timestep) {
+		regions.markActive(100.0f, 100.0f, 1.0f);
+		regions.update();
+	}
+	ASSERT_TRUE(regions.isSleeping(140.0f, 100.0f));
+	EXPECT_FALSE(regions.areAllSleeping(140.0f, 100.0f, 20.0f));
+	EXPECT_TRUE(regions.areAllSleeping(140.0f, 100.0f, 5.0f));
+
+	for (int timestep = 0; timestep < SleepingRegions::TimestepsUntilSleep; ++timestep) {
+		regions.update();
+	}
+	EXPECT_TRUE(regions.areAllSleeping(140.0f, 100.0f, 20.0f));
+
+	regions.wakeUp(regions.getRegion(100.0f, 100.0f));
+	EXPECT_FALSE(regions.isWokenUp(140.0f, 100.0f));
+	EXPECT_TRUE(regions.isAnyWokenUp(140.0f, 100.0f, 20.0f));
+	EXPECT_FALSE(regions.isAnyWokenUp(140.0f, 100.0f, 5.0f));
+}
+
+/**
+* Situation: activity near the corner of the world
+* Expected result: the regions at all four corners are marked since the world is a torus
+*/
+TEST_F(SleepingRegionsTest, testMarkActiveWrapsAround)
+{
+	HostMemory hostMemory;
+	auto regions = createRegions(_size, _size, hostMemory);
+	regions.markActive(1.0f, 1.0f, 3.0f);
+
+	auto expectedActivities = vector<int>(16, 0);
+	expectedActivities.at(0) = 1;
+	expectedActivities.at(3) = 1;
+	expectedActivities.at(12) = 1;
+	expectedActivities.at(15) = 1;
+	auto const activities = regions.getMemory().activities;
+	EXPECT_EQ(expectedActivities, vector<int>(activities, activities + 16));
+}
+
+/**
+* Situation: a sleeping region is woken up twice by user actions
+* Expected result: the wake up is counted once and the region needs TimestepsUntilSleep idle timesteps to fall
+* asleep again
+*/
+TEST_F(SleepingRegionsTest, testWakeUpByUserAction)
+{
+	HostMemory hostMemory;
+	auto regions = createRegions(_size, _size, hostMemory);
+	for (int timestep = 0; timestep < SleepingRegions::TimestepsUntilSleep; ++timestep) {
+		regions.update();
+	}
+	regions.wakeUp(7);
+	regions.wakeUp(7);
+	EXPECT_EQ(SleepingRegions::WokenUp, regions.getState(7));
+	EXPECT_EQ(15, regions.getCounter(SleepingRegions::NumSleepingRegions));
+	EXPECT_EQ(1, regions.getCounter(SleepingRegions::NumRegionsWokenUp));
+
+	for (int timestep = 0; timestep < SleepingRegions::TimestepsUntilSleep - 1; ++timestep) {
+		regions.update();
+	}
+	EXPECT_EQ(SleepingRegions::Awake, regions.getState(7));
+	regions.update();
+	EXPECT_EQ(SleepingRegions::Sleeping, regions.getState(7));
+	EXPECT_EQ(17, regions.getCounter(SleepingRegions::NumRegionsFallenAsleep));
+}
@@ -0,0 +1,157 @@
+#include <random>
+
+#include <QImage>
+#include <gtest/gtest.h>
+
+#include "EngineInterface/Colors.h"
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/SoftwareRasterizer.h"
+
+class SoftwareRasterizerTest : public ::testing::Test
+{
+public:
+	SoftwareRasterizerTest() = default;
+	~SoftwareRasterizerTest() = default;
+
+protected:
+	DataDescription createRandomData(int numCells, int numParticles);
+	vector<unsigned int> drawVectorImage(
+		SoftwareRasterizer const& rasterizer,
+		DataDescription const& data,
+		RealRect const& rect,
+		double zoom,
+		IntVector2D const& imageSize) const;
+
+	IntVector2D const WorldSize{300, 200};
+	std::mt19937 _random{0};
+	uint64_t _id = 0;
+};
+
+DataDescription SoftwareRasterizerTest::createRandomData(int numCells, int numParticles)
+{
+	std::uniform_real_distribution<float> xDistribution(0, static_cast<float>(WorldSize.x));
+	std::uniform_real_distribution<float> yDistribution(0, static_cast<float>(WorldSize.y));
+	std::uniform_real_distribution<double> energyDistribution(0, 400);
+
+	DataDescription result;
+	ClusterDescription cluster;
+	for (int i = 0; i < numCells; ++i) {
+		CellMetadata metadata;
+		metadata.color = static_cast<quint8>(i % 7);
+		auto cell = CellDescription()
+			.setId(++_id)
+			.setPos({xDistribution(_random), yDistribution(_random)})
+			.setEnergy(energyDistribution(_random))
+			.setMetadata(metadata);
+		if (i > 0) {
+			cell.setConnectingCells({_id - 1});
+		}
+		if (i % 10 == 0) {
+			cell.setTokens({TokenDescription()});
+		}
+		cluster.addCell(cell);
+	}
+	result.addCluster(cluster);
+	for (int i = 0; i < numParticles; ++i) {
+		result.addParticle(ParticleDescription()
+			.setId(++_id)
+			.setPos({xDistribution(_random), yDistribution(_random)})
+			.setEnergy(energyDistribution(_random)));
+	}
+	return result;
+}
+
+vector<unsigned int> SoftwareRasterizerTest::drawVectorImage(
+	SoftwareRasterizer const& rasterizer,
+	DataDescription const& data,
+	RealRect const& rect,
+	double zoom,
+	IntVector2D const& imageSize) const
+{
+	vector<unsigned int> result(imageSize.x * imageSize.y);
+	rasterizer.drawVectorImage(data, rect, zoom, imageSize, result.data());
+	return result;
+}
+
+TEST_F(SoftwareRasterizerTest, testResultIsIndependentOfNumThreads)
+{
+	auto const data = createRandomData(2000, 2000);
+
+	SoftwareRasterizer singleThreadedRasterizer(WorldSize, 1);
+	SoftwareRasterizer multiThreadedRasterizer(WorldSize, 8);
+	for (float zoom : {0.5f, 1.0f, 4.0f}) {
+		RealRect const rect{{-20.0f, 10.0f}, {-20.0f + 400.0f / zoom, 10.0f + 300.0f / zoom}};
+		ASSERT_EQ(
+			drawVectorImage(singleThreadedRasterizer, data, rect, zoom, {400, 300}),
+			drawVectorImage(multiThreadedRasterizer, data, rect, zoom, {400, 300}));
+	}
+}
+
+TEST_F(SoftwareRasterizerTest, testBackground)
+{
+	SoftwareRasterizer rasterizer(WorldSize);
+	auto const imageData =
+		drawVectorImage(rasterizer, DataDescription(), {{-10.0f, 0.0f}, {310.0f, 200.0f}}, 1.0, {320, 200});
+
+	for (int y = 0; y < 200; ++y) {
+		for (int x = 0; x < 320; ++x) {
+			auto const isSpace = x >= 10 && x < 310;
+			ASSERT_EQ(isSpace ? Const::SpaceColor : Const::NothingnessColor, imageData[y * 320 + x]);
+		}
+	}
+}
+
+TEST_F(SoftwareRasterizerTest, testParticleColor)
+{
+	DataDescription data;
+	data.addParticle(ParticleDescription().setId(1).setPos({10.0f, 10.0f}).setEnergy(10));
+
+	SoftwareRasterizer rasterizer(WorldSize);
+	auto const imageData = drawVectorImage(rasterizer, data, {{0.0f, 0.0f}, {300.0f, 200.0f}}, 1.0, WorldSize);
+
+	//intensity (10 + 10) * 5 / 256 * 0.75, blue 0.08, both scaled by 2 * radius = 2/3
+	EXPECT_EQ(0xff260030, imageData[10 * WorldSize.x + 10]);
+	EXPECT_NE(Const::SpaceColor, imageData[10 * WorldSize.x + 11]);
+	EXPECT_EQ(Const::SpaceColor, imageData[10 * WorldSize.x + 13]);
+}
+
+TEST_F(SoftwareRasterizerTest, testConnectionsOnlyDrawnWhenZoomedIn)
+{
+	DataDescription data;
+	ClusterDescription cluster;
+	cluster.addCell(CellDescription().setId(1).setPos({10.0f, 10.0f}).setEnergy(100).setConnectingCells({2}));
+	cluster.addCell(CellDescription().setId(2).setPos({20.0f, 10.0f}).setEnergy(100).setConnectingCells({1}));
+	data.addCluster(cluster);
+
+	SoftwareRasterizer rasterizer(WorldSize);
+	{
+		auto const imageData = drawVectorImage(rasterizer, data, {{0.0f, 0.0f}, {600.0f, 400.0f}}, 0.5, WorldSize);
+		EXPECT_EQ(Const::SpaceColor, imageData[5 * WorldSize.x + 8]);
+	}
+	{
+		auto const imageData = drawVectorImage(rasterizer, data, {{0.0f, 0.0f}, {75.0f, 50.0f}}, 4.0, WorldSize);
+		EXPECT_NE(Const::SpaceColor, imageData[40 * WorldSize.x + 60]);
+	}
+}
+
+TEST_F(SoftwareRasterizerTest, testDrawImage)
+{
+	auto const data = createRandomData(500, 500);
+	IntRect const rect{{0, 0}, {150, 100}};
+
+	SoftwareRasterizer rasterizer(WorldSize);
+	auto const expectedImageData =
+		drawVectorImage(rasterizer, data, {{0.0f, 0.0f}, {150.0f, 100.0f}}, 2.0, {300, 200});
+
+	QImage image(300, 200, QImage::Format_RGB32);
+	rasterizer.drawImage(data, rect, image);
+	for (int y = 0; y < 200; ++y) {
+		for (int x = 0; x < 300; ++x) {
+			auto const expectedPixel = expectedImageData[y * 300 + x];
+			QColor const color(image.pixel(x, y));
+			ASSERT_EQ(static_cast<int>(expectedPixel & 0xff), color.red());
+			ASSERT_EQ(static_cast<int>((expectedPixel >> 8) & 0xff), color.green());
+			ASSERT_EQ(static_cast<int>((expectedPixel >> 16) & 0xff), color.blue());
+		}
+	}
+}
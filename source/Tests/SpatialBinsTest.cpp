@@ -0,0 +1,243 @@
+#include <cmath>
+#include <random>
+#include <gtest/gtest.h>
+
+#include "EngineGpuKernels/SpatialBins.h"
+
+#include "HostMemory.h"
+
+class SpatialBinsTest : public ::testing::Test
+{
+public:
+	SpatialBinsTest() = default;
+	~SpatialBinsTest() = default;
+
+protected:
+	struct Position
+	{
+		float x;
+		float y;
+	};
+
+	SpatialBins<int> createBins(
+		int sizeX,
+		int sizeY,
+		int maxEntries,
+		HostMemory& hostMemory,
+		int bucketSize = SpatialBins<int>::DefaultBucketSize) const;
+
+	//host reference of the GPU build: count, scan, scatter
+	void build(SpatialBins<int>& bins, vector<Position> const& positions) const;
+
+	vector<Position> createRandomPositions(int sizeX, int sizeY, int numPositions, unsigned int seed) const;
+	float calcDistance(Position const& p, Position const& q, int sizeX, int sizeY) const;
+
+	void checkQueries(
+		SpatialBins<int> const& bins,
+		vector<Position> const& positions,
+		int sizeX,
+		int sizeY,
+		float radius) const;
+};
+
+SpatialBins<int> SpatialBinsTest::createBins(
+	int sizeX,
+	int sizeY,
+	int maxEntries,
+	HostMemory& hostMemory,
+	int bucketSize) const
+{
+	auto const layout = SpatialBins<int>::calcLayout(sizeX, sizeY, maxEntries, bucketSize);
+	SpatialBins<int>::Memory memory;
+	memory.counts = hostMemory.getArray<int>(layout.numBuckets, 0);
+	memory.offsets = hostMemory.getArray<int>(layout.numBuckets + 1, 0);
+	memory.entries = hostMemory.getArray<int>(layout.maxEntries, -1);
+
+	SpatialBins<int> result;
+	result.init(layout, memory);
+	return result;
+}
+
+void SpatialBinsTest::build(SpatialBins<int>& bins, vector<Position> const& positions) const
+{
+	for (auto const& position : positions) {
+		bins.countEntry(bins.getBucket(position.x, position.y));
+	}
+	bins.calcOffsets();
+	for (int index = 0; index < static_cast<int>(positions.size()); ++index) {
+		bins.insertEntry(bins.getBucket(positions.at(index).x, positions.at(index).y), index);
+	}
+}
+
+auto SpatialBinsTest::createRandomPositions(int sizeX, int sizeY, int numPositions, unsigned int seed) const
+	-> vector<Position>
+{
+	std::mt19937 engine(seed);
+	std::uniform_real_distribution<float> distributionX(0, static_cast<float>(sizeX));
+	std::uniform_real_distribution<float> distributionY(0, static_cast<float>(sizeY));
+	vector<Position> result;
+	for (int i = 0; i < numPositions; ++i) {
+		result.push_back({ std::fmod(distributionX(engine), static_cast<float>(sizeX)),
+			std::fmod(distributionY(engine), static_cast<float>(sizeY)) });
+	}
+	return result;
+}
+
+float SpatialBinsTest::calcDistance(Position const& p, Position const& q, int sizeX, int sizeY) const
+{
+	auto dx = std::abs(p.x - q.x);
+	auto dy = std::abs(p.y - q.y);
+	dx = std::min(dx, sizeX - dx);
+	dy = std::min(dy, sizeY - dy);
+	return std::sqrt(dx * dx + dy * dy);
+}
+
+void SpatialBinsTest::checkQueries(
+	SpatialBins<int> const& bins,
+	vector<Position> const& positions,
+	int sizeX,
+	int sizeY,
+	float radius) const
+{
+	for (auto const& position : positions) {
+		vector<int> numVisits(positions.size(), 0);
+		bins.forEachEntry(position.x, position.y, radius, [&](int index) { ++numVisits.at(index); });
+
+		for (int index = 0; index < static_cast<int>(positions.size()); ++index) {
+			ASSERT_GE(1, numVisits.at(index));
+			if (calcDistance(position, positions.at(index), sizeX, sizeY) < radius) {
+				ASSERT_EQ(1, numVisits.at(index));
+			}
+		}
+	}
+}
+
+TEST_F(SpatialBinsTest, testLayout)
+{
+	auto const denseLayout = SpatialBins<int>::calcLayout(1001, 500, 500000);
+	EXPECT_EQ(500, denseLayout.numGridCellsX);
+	EXPECT_EQ(250, denseLayout.numGridCellsY);
+	EXPECT_EQ(500 * 250, denseLayout.numBuckets);
+	EXPECT_FALSE(denseLayout.isHashed());
+
+	auto const hashedLayout = SpatialBins<int>::calcLayout(20000, 10000, 1000);
+	EXPECT_EQ(1024, hashedLayout.numBuckets);
+	EXPECT_TRUE(hashedLayout.isHashed());
+
+	EXPECT_EQ(1, SpatialBins<int>::calcLayout(1, 1, 10).numGridCellsX);
+}
+
+/**
+* Situation: random positions in a world with odd size, bins with one bucket per grid cell
+* Expected result: queries visit every entry within the radius exactly once, also across the world boundary
+*/
+TEST_F(SpatialBinsTest, testQueriesWithDenseBuckets)
+{
+	auto const sizeX = 101;
+	auto const sizeY = 53;
+	auto const positions = createRandomPositions(sizeX, sizeY, 2000, 1);
+	HostMemory hostMemory;
+	auto bins = createBins(sizeX, sizeY, 2000, hostMemory);
+	ASSERT_FALSE(bins.getLayout().isHashed());
+
+	build(bins, positions);
+	EXPECT_EQ(2000, bins.getMemory().offsets[bins.getLayout().numBuckets]);
+
+	checkQueries(bins, positions, sizeX, sizeY, 1.3f);
+	checkQueries(bins, positions, sizeX, sizeY, 4.5f);
+}
+
+/**
+* Situation: positions in a world with more grid cells than buckets
+* Expected result: queries visit every entry within the radius exactly once although grid cells share buckets
+*/
+TEST_F(SpatialBinsTest, testQueriesWithHashedBuckets)
+{
+	auto const sizeX = 2000;
+	auto const sizeY = 1000;
+	auto const positions = createRandomPositions(sizeX, sizeY, 300, 2);
+	HostMemory hostMemory;
+	auto bins = createBins(sizeX, sizeY, 300, hostMemory);
+	ASSERT_TRUE(bins.getLayout().isHashed());
+
+	build(bins, positions);
+
+	checkQueries(bins, positions, sizeX, sizeY, 1.3f);
+	checkQueries(bins, positions, sizeX, sizeY, 7.0f);
+}
+
+/**
+* Situation: world smaller than the query range
+* Expected result: every grid cell is visited once, hence every entry is visited exactly once
+*/
+TEST_F(SpatialBinsTest, testQueriesInSmallWorld)
+{
+	auto const positions = createRandomPositions(5, 3, 50, 3);
+	HostMemory hostMemory;
+	auto bins = createBins(5, 3, 50, hostMemory);
+
+	build(bins, positions);
+
+	for (auto const& position : positions) {
+		auto numVisits = 0;
+		bins.forEachEntry(position.x, position.y, 3.0f, [&](int) { ++numVisits; });
+		EXPECT_EQ(50, numVisits);
+	}
+}
+
+/**
+* Situation: bins are built twice with different positions
+* Expected result: counts are zero after each build and the second build only contains the new positions
+*/
+TEST_F(SpatialBinsTest, testRebuild)
+{
+	auto const sizeX = 200;
+	auto const sizeY = 100;
+	HostMemory hostMemory;
+	auto bins = createBins(sizeX, sizeY, 1000, hostMemory);
+	auto const numBuckets = bins.getLayout().numBuckets;
+	auto const counts = bins.getMemory().counts;
+
+	build(bins, createRandomPositions(sizeX, sizeY, 1000, 4));
+	EXPECT_EQ(vector<int>(numBuckets, 0), vector<int>(counts, counts + numBuckets));
+
+	auto const positions = createRandomPositions(sizeX, sizeY, 400, 5);
+	build(bins, positions);
+	EXPECT_EQ(vector<int>(numBuckets, 0), vector<int>(counts, counts + numBuckets));
+	EXPECT_EQ(400, bins.getMemory().offsets[numBuckets]);
+
+	checkQueries(bins, positions, sizeX, sizeY, 1.3f);
+}
+
+/**
+* Situation: bins with large buckets as used for map sections, queried by index ranges
+* Expected result: the ranges are disjoint and contain every entry within the radius
+*/
+TEST_F(SpatialBinsTest, testRangeQueriesWithLargeBuckets)
+{
+	auto const sizeX = 1008;
+	auto const sizeY = 504;
+	auto const positions = createRandomPositions(sizeX, sizeY, 3000, 6);
+	HostMemory hostMemory;
+	auto bins = createBins(sizeX, sizeY, 3000, hostMemory, 50);
+	ASSERT_EQ(20, bins.getLayout().numGridCellsX);
+	ASSERT_FALSE(bins.getLayout().isHashed());
+
+	build(bins, positions);
+	checkQueries(bins, positions, sizeX, sizeY, 50.0f);
+
+	for (auto const& position : positions) {
+		vector<int> numVisits(positions.size(), 0);
+		bins.forEachRange(position.x, position.y, 50.0f, [&](int startIndex, int endIndex) {
+			for (int index = startIndex; index < endIndex; ++index) {
+				++numVisits.at(bins.getMemory().entries[index]);
+			}
+		});
+		for (int index = 0; index < static_cast<int>(positions.size()); ++index) {
+			ASSERT_GE(1, numVisits.at(index));
+			if (calcDistance(position, positions.at(index), sizeX, sizeY) < 50.0f) {
+				ASSERT_EQ(1, numVisits.at(index));
+			}
+		}
+	}
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include "EngineInterface/SpeciesTracker.h"
+
+class SpeciesTrackerTest : public ::testing::Test
+{
+public:
+	SpeciesTrackerTest() = default;
+	~SpeciesTrackerTest() = default;
+
+protected:
+	//chain of cells with given cell functions
+	ClusterDescription createChain(uint64_t clusterId, vector<Enums::CellFunction::Type> const& types) const;
+
+	SpeciesTracker _tracker;
+};
+
+ClusterDescription SpeciesTrackerTest::createChain(uint64_t clusterId, vector<Enums::CellFunction::Type> const& types) const
+{
+	ClusterDescription result;
+	result.setId(clusterId).setPos(QVector2D(0, 0)).setVel(QVector2D(0, 0)).setAngle(0).setAngularVel(0);
+	auto const numCells = static_cast<int>(types.size());
+	for (int index = 0; index < numCells; ++index) {
+		list<uint64_t> connectingCells;
+		if (index > 0) {
+			connectingCells.emplace_back(clusterId * 100 + index - 1);
+		}
+		if (index < numCells - 1) {
+			connectingCells.emplace_back(clusterId * 100 + index + 1);
+		}
+		result.addCell(CellDescription()
+			.setId(clusterId * 100 + index)
+			.setPos(QVector2D(index, 0))
+			.setEnergy(100)
+			.setMaxConnections(2)
+			.setConnectingCells(connectingCells)
+			.setFlagTokenBlocked(false)
+			.setTokenBranchNumber(index)
+			.setCellFeature(CellFeatureDescription().setType(types.at(index))));
+	}
+	return result;
+}
+
+/**
+* Situation: first sample contains a cluster, second sample contains the same cluster, a copy of it with one changed
+*			cell function and a cluster with different cell functions
+* Expected result: copy with changed cell function is a new species descending from the first one, the other cluster is
+*			a new species without ancestor, populations are counted per sample
+*/
+TEST_F(SpeciesTrackerTest, testLineage)
+{
+	using Enums::CellFunction;
+	auto const original = createChain(1, {CellFunction::COMPUTER, CellFunction::SCANNER, CellFunction::WEAPON, CellFunction::PROPULSION});
+	auto const mutant = createChain(2, {CellFunction::COMPUTER, CellFunction::SCANNER, CellFunction::WEAPON, CellFunction::CONSTRUCTOR});
+	auto const unrelated = createChain(3, {CellFunction::SENSOR, CellFunction::COMMUNICATOR, CellFunction::SENSOR, CellFunction::COMMUNICATOR});
+	auto const originalCopy = createChain(4, {CellFunction::COMPUTER, CellFunction::SCANNER, CellFunction::WEAPON, CellFunction::PROPULSION});
+
+	_tracker.addSample(10, DataDescription().addCluster(original));
+	_tracker.addSample(20, DataDescription().addClusters({original, mutant, unrelated, originalCopy}));
+
+	auto const& species = _tracker.getSpecies();
+	ASSERT_EQ(3, species.size());
+	EXPECT_EQ(vector<int>({10, 20}), _tracker.getSampleTimesteps());
+
+	EXPECT_FALSE(species[0].ancestorId);
+	EXPECT_EQ(vector<int>({1, 2}), species[0].populations);
+
+	ASSERT_TRUE(species[1].ancestorId);
+	EXPECT_EQ(0, *species[1].ancestorId);
+	EXPECT_EQ(1, species[1].firstSample);
+	EXPECT_EQ(vector<int>({1}), species[1].populations);
+
+	EXPECT_FALSE(species[2].ancestorId);
+	EXPECT_EQ(vector<int>({1}), species[2].populations);
+}
+
+/**
+* Situation: cluster keeps its id but loses a cell between two samples
+* Expected result: cluster is hashed again and counted as a new species
+*/
+TEST_F(SpeciesTrackerTest, testChangedClusterIsHashedAgain)
+{
+	using Enums::CellFunction;
+	auto const cluster = createChain(1, {CellFunction::COMPUTER, CellFunction::SCANNER, CellFunction::WEAPON});
+	auto const shrunkCluster = createChain(1, {CellFunction::COMPUTER, CellFunction::SCANNER});
+
+	EXPECT_EQ(1, _tracker.addSample(10, DataDescription().addCluster(cluster)));
+	EXPECT_EQ(0, _tracker.addSample(20, DataDescription().addCluster(cluster)));
+	EXPECT_EQ(1, _tracker.addSample(30, DataDescription().addCluster(shrunkCluster)));
+
+	auto const& species = _tracker.getSpecies();
+	ASSERT_EQ(2, species.size());
+	EXPECT_EQ(vector<int>({1, 1}), species[0].populations);
+	EXPECT_EQ(1, species[0].lastSample);
+	EXPECT_EQ(2, species[1].firstSample);
+}
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+
+#include "Web/TaskBatcher.h"
+
+class TaskBatcherTest : public ::testing::Test
+{
+public:
+	TaskBatcherTest() = default;
+	~TaskBatcherTest() = default;
+
+protected:
+	vector<string> getTaskIds(TaskBatch const& batch) const;
+};
+
+vector<string> TaskBatcherTest::getTaskIds(TaskBatch const& batch) const
+{
+	vector<string> result;
+	for (auto const& task : batch.tasks) {
+		result.emplace_back(task.id);
+	}
+	return result;
+}
+
+TEST_F(TaskBatcherTest, testDisjointTasks)
+{
+	vector<Task> tasks{ { "1", { 0, 0 }, { 10, 10 } }, { "2", { 10, 0 }, { 10, 10 } }, { "3", { 0, 20 }, { 5, 5 } } };
+	auto const batches = TaskBatcher::createBatches(tasks);
+
+	ASSERT_EQ(3, batches.size());
+	for (int i = 0; i < 3; ++i) {
+		EXPECT_EQ(vector<string>{ tasks.at(i).id }, getTaskIds(batches.at(i)));
+		EXPECT_EQ(tasks.at(i).pos.x, batches.at(i).rect.p1.x);
+		EXPECT_EQ(tasks.at(i).pos.y + tasks.at(i).size.y, batches.at(i).rect.p2.y);
+	}
+}
+
+TEST_F(TaskBatcherTest, testOverlappingTasks)
+{
+	vector<Task> tasks{ { "1", { 0, 0 }, { 10, 10 } }, { "2", { 5, 5 }, { 10, 10 } }, { "3", { 100, 100 }, { 5, 5 } } };
+	auto const batches = TaskBatcher::createBatches(tasks);
+
+	ASSERT_EQ(2, batches.size());
+	EXPECT_EQ((vector<string>{ "1", "2" }), getTaskIds(batches.at(0)));
+	EXPECT_EQ(0, batches.at(0).rect.p1.x);
+	EXPECT_EQ(0, batches.at(0).rect.p1.y);
+	EXPECT_EQ(15, batches.at(0).rect.p2.x);
+	EXPECT_EQ(15, batches.at(0).rect.p2.y);
+	EXPECT_EQ(vector<string>{ "3" }, getTaskIds(batches.at(1)));
+}
+
+/**
+* Situation: last task connects two existing batches, merged rect overlaps a further task
+* Expected result: all tasks end up in one batch
+*/
+TEST_F(TaskBatcherTest, testTransitiveMerging)
+{
+	vector<Task> tasks{
+		{ "1", { 0, 0 }, { 10, 10 } },
+		{ "2", { 20, 0 }, { 10, 10 } },
+		{ "3", { 25, 12 }, { 10, 10 } },
+		{ "4", { 5, 5 }, { 20, 10 } } };
+	auto const batches = TaskBatcher::createBatches(tasks);
+
+	ASSERT_EQ(1, batches.size());
+	auto taskIds = getTaskIds(batches.front());
+	std::sort(taskIds.begin(), taskIds.end());
+	EXPECT_EQ((vector<string>{ "1", "2", "3", "4" }), taskIds);
+	EXPECT_EQ(35, batches.front().rect.p2.x);
+	EXPECT_EQ(22, batches.front().rect.p2.y);
+}
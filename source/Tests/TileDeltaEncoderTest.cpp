@@ -0,0 +1,130 @@
+#include <QImage>
+#include <gtest/gtest.h>
+
+#include "Web/TileDeltaEncoder.h"
+
+class TileDeltaEncoderTest : public ::testing::Test
+{
+public:
+	TileDeltaEncoderTest() = default;
+	~TileDeltaEncoderTest() = default;
+
+protected:
+	QImage createImage(IntVector2D const& size) const;
+};
+
+QImage TileDeltaEncoderTest::createImage(IntVector2D const& size) const
+{
+	QImage result(size.x, size.y, QImage::Format_RGB32);
+	for (int y = 0; y < size.y; ++y) {
+		for (int x = 0; x < size.x; ++x) {
+			result.setPixel(x, y, qRgb(x % 256, y % 256, (x * y) % 256));
+		}
+	}
+	return result;
+}
+
+TEST_F(TileDeltaEncoderTest, testStaticImageSendsNoTiles)
+{
+	auto const image = createImage({ 200, 150 });
+	TileDeltaEncoder encoder(64, 30);
+
+	QImage decodedImage;
+	int decodedFrame = TileDeltaEncoder::NoFrame;
+	auto const keyframe = encoder.encode(image);
+	EXPECT_TRUE(TileDeltaEncoder::decode(keyframe.data, decodedImage, decodedFrame));
+	EXPECT_EQ(4 * 3, encoder.getNumTilesOfLastFrame());
+	EXPECT_EQ(image, decodedImage);
+	EXPECT_EQ(keyframe.id, decodedFrame);
+	encoder.commit(keyframe.id);
+
+	auto const delta = encoder.encode(image);
+	EXPECT_EQ(0, encoder.getNumTilesOfLastFrame());
+	EXPECT_TRUE(TileDeltaEncoder::decode(delta.data, decodedImage, decodedFrame));
+	EXPECT_EQ(image, decodedImage);
+	EXPECT_EQ(delta.id, decodedFrame);
+}
+
+TEST_F(TileDeltaEncoderTest, testChangedPixelSendsOneTile)
+{
+	auto image = createImage({ 200, 150 });
+	TileDeltaEncoder encoder(64, 30);
+
+	QImage decodedImage;
+	int decodedFrame = TileDeltaEncoder::NoFrame;
+	auto const keyframe = encoder.encode(image);
+	TileDeltaEncoder::decode(keyframe.data, decodedImage, decodedFrame);
+	encoder.commit(keyframe.id);
+
+	image.setPixel(130, 140, qRgb(255, 255, 255));
+	EXPECT_TRUE(TileDeltaEncoder::decode(encoder.encode(image).data, decodedImage, decodedFrame));
+	EXPECT_EQ(1, encoder.getNumTilesOfLastFrame());
+	EXPECT_EQ(image, decodedImage);
+}
+
+TEST_F(TileDeltaEncoderTest, testKeyframes)
+{
+	auto const image = createImage({ 100, 100 });
+	TileDeltaEncoder encoder(32, 3);
+
+	vector<int> numTiles;
+	for (int frame = 0; frame < 7; ++frame) {
+		encoder.commit(encoder.encode(image).id);
+		numTiles.emplace_back(encoder.getNumTilesOfLastFrame());
+	}
+	EXPECT_EQ((vector<int>{ 16, 0, 0, 16, 0, 0, 16 }), numTiles);
+
+	encoder.reset();
+	encoder.commit(encoder.encode(image).id);
+	EXPECT_EQ(16, encoder.getNumTilesOfLastFrame());
+
+	//changed size starts with a keyframe
+	encoder.encode(createImage({ 64, 64 }));
+	EXPECT_EQ(4, encoder.getNumTilesOfLastFrame());
+}
+
+/**
+* Situation: frames are encoded without being committed, e.g. because their upload has failed
+* Expected result: next delta refers to the last committed frame and can be applied to it
+*/
+TEST_F(TileDeltaEncoderTest, testDeltaRefersToCommittedFrame)
+{
+	auto image = createImage({ 100, 100 });
+	TileDeltaEncoder encoder(32, 30);
+
+	QImage decodedImage;
+	int decodedFrame = TileDeltaEncoder::NoFrame;
+	auto const keyframe = encoder.encode(image);
+	TileDeltaEncoder::decode(keyframe.data, decodedImage, decodedFrame);
+	encoder.commit(keyframe.id);
+
+	image.setPixel(10, 10, qRgb(255, 255, 255));
+	encoder.encode(image);
+	image.setPixel(90, 90, qRgb(255, 255, 255));
+	auto const delta = encoder.encode(image);
+	EXPECT_EQ(2, encoder.getNumTilesOfLastFrame());
+
+	EXPECT_TRUE(TileDeltaEncoder::decode(delta.data, decodedImage, decodedFrame));
+	EXPECT_EQ(image, decodedImage);
+}
+
+TEST_F(TileDeltaEncoderTest, testDeltaRequiresMatchingTarget)
+{
+	auto const image = createImage({ 100, 100 });
+	TileDeltaEncoder encoder(32, 30);
+	auto const keyframe = encoder.encode(image);
+	encoder.commit(keyframe.id);
+	auto const delta = encoder.encode(image);
+
+	QImage otherImage(50, 50, QImage::Format_RGB32);
+	int otherFrame = keyframe.id;
+	EXPECT_FALSE(TileDeltaEncoder::decode(delta.data, otherImage, otherFrame));
+	EXPECT_FALSE(TileDeltaEncoder::decode(QByteArray("invalid"), otherImage, otherFrame));
+
+	//image of the right size but without the base frame
+	QImage decodedImage;
+	int decodedFrame = TileDeltaEncoder::NoFrame;
+	TileDeltaEncoder::decode(keyframe.data, decodedImage, decodedFrame);
+	decodedFrame = TileDeltaEncoder::NoFrame;
+	EXPECT_FALSE(TileDeltaEncoder::decode(delta.data, decodedImage, decodedFrame));
+}
@@ -0,0 +1,111 @@
+#include <numeric>
+#include <random>
+#include <gtest/gtest.h>
+
+#include "EngineGpuKernels/TiledMap.h"
+
+#include "HostMemory.h"
+
+class TiledMapTest : public ::testing::Test
+{
+public:
+	TiledMapTest() = default;
+	~TiledMapTest() = default;
+
+protected:
+	TiledMap<int> createMap(int sizeX, int sizeY, int maxEntries, HostMemory& hostMemory) const;
+};
+
+TiledMap<int> TiledMapTest::createMap(int sizeX, int sizeY, int maxEntries, HostMemory& hostMemory) const
+{
+	auto const layout = TiledMap<int>::calcLayout(sizeX, sizeY, maxEntries);
+	TiledMap<int>::Memory memory;
+	memory.tileIndices = hostMemory.getArray<int>(layout.getNumTiles(), TiledMap<int>::NoTile);
+	memory.tiles = hostMemory.getArray<int>(layout.maxTiles * TiledMap<int>::TileArea, 0);
+	memory.freeTiles = hostMemory.getArray<int>(layout.maxTiles);
+	std::iota(memory.freeTiles, memory.freeTiles + layout.maxTiles, 0);
+	memory.numFreeTiles = hostMemory.getArray<int>(1, layout.maxTiles);
+
+	TiledMap<int> result;
+	result.init(layout, memory);
+	return result;
+}
+
+TEST_F(TiledMapTest, testLayout)
+{
+	auto const layout = TiledMap<int>::calcLayout(20000, 10001, 1000);
+	EXPECT_EQ(2500, layout.numTilesX);
+	EXPECT_EQ(1251, layout.numTilesY);
+	EXPECT_EQ(1000, layout.maxTiles);
+
+	EXPECT_EQ(4, TiledMap<int>::calcLayout(16, 9, 1000).maxTiles);
+}
+
+/**
+* Situation: random entries are set in a sparsely populated map
+* Expected result: get returns the same as a dense map, only tiles with entries are allocated
+*/
+TEST_F(TiledMapTest, testSetAndGet)
+{
+	auto const sizeX = 1000;
+	auto const sizeY = 600;
+	HostMemory hostMemory;
+	auto map = createMap(sizeX, sizeY, 500, hostMemory);
+	vector<int> denseMap(sizeX * sizeY, 0);
+
+	std::mt19937 engine(1);
+	std::uniform_int_distribution<int> distributionX(0, sizeX - 1);
+	std::uniform_int_distribution<int> distributionY(0, sizeY - 1);
+	set<pair<int, int>> usedTiles;
+	for (int i = 1; i <= 500; ++i) {
+		auto const x = distributionX(engine);
+		auto const y = distributionY(engine);
+		auto const entry = map.getOrCreateEntry(x, y);
+		ASSERT_TRUE(entry != nullptr);
+		*entry = i;
+		denseMap.at(x + y * sizeX) = i;
+		usedTiles.emplace(x / TiledMap<int>::TileSize, y / TiledMap<int>::TileSize);
+	}
+
+	for (int y = 0; y < sizeY; ++y) {
+		for (int x = 0; x < sizeX; ++x) {
+			auto const entry = map.getEntry(x, y);
+			ASSERT_EQ(denseMap.at(x + y * sizeX), entry ? *entry : 0);
+		}
+	}
+	EXPECT_EQ(usedTiles.size(), map.getNumAllocatedTiles());
+}
+
+/**
+* Situation: entries are cleared and their tiles released, afterwards other entries are set
+* Expected result: tiles are recycled and contain no old entries
+*/
+TEST_F(TiledMapTest, testTileRecycling)
+{
+	HostMemory hostMemory;
+	auto map = createMap(64, 64, 2, hostMemory);
+
+	*map.getOrCreateEntry(1, 1) = 5;
+	*map.getOrCreateEntry(20, 30) = 6;
+	EXPECT_EQ(2, map.getNumAllocatedTiles());
+	EXPECT_TRUE(map.getOrCreateEntry(60, 60) == nullptr);
+
+	for (auto const& pos : { std::make_pair(1, 1), std::make_pair(20, 30) }) {
+		*map.getEntry(pos.first, pos.second) = 0;
+	}
+	for (auto const& pos : { std::make_pair(1, 1), std::make_pair(20, 30) }) {
+		map.releaseTile(pos.first, pos.second);
+	}
+	EXPECT_EQ(0, map.getNumAllocatedTiles());
+	EXPECT_TRUE(map.getEntry(1, 1) == nullptr);
+
+	auto const entry = map.getOrCreateEntry(60, 60);
+	ASSERT_TRUE(entry != nullptr);
+	EXPECT_EQ(0, *entry);
+	for (int y = 56; y < 64; ++y) {
+		for (int x = 56; x < 64; ++x) {
+			EXPECT_EQ(0, *map.getEntry(x, y));
+		}
+	}
+	EXPECT_EQ(1, map.getNumAllocatedTiles());
+}
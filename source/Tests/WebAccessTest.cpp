@@ -0,0 +1,145 @@
+#include <QBuffer>
+#include <QEventLoop>
+#include <QFile>
+#include <QTimer>
+#include <gtest/gtest.h>
+
+#include "Base/ServiceLocator.h"
+#include "Web/TaskBatcher.h"
+#include "Web/TileDeltaEncoder.h"
+#include "Web/WebAccess.h"
+#include "Web/WebBuilderFacade.h"
+
+#include "HttpStandInServer.h"
+
+class WebAccessTest : public ::testing::Test
+{
+public:
+	WebAccessTest()
+	{
+		auto const facade = ServiceLocator::getInstance().getService<WebBuilderFacade>();
+		_webAccess = facade->buildWebAccess(_server.getServerAddress());
+	}
+
+	~WebAccessTest() { delete _webAccess; }
+
+protected:
+	HttpStandInServer _server;
+	WebAccess* _webAccess = nullptr;
+};
+
+TEST_F(WebAccessTest, testSendProcessedTaskDelta)
+{
+	QImage image(100, 80, QImage::Format_RGB32);
+	image.fill(qRgb(0, 0, 27));
+	TileDeltaEncoder encoder;
+	auto data = encoder.encode(image).data;
+	QBuffer buffer(&data);
+	buffer.open(QIODevice::ReadOnly);
+
+	boost::optional<string> processedTaskId;
+	QEventLoop loop;
+	QObject::connect(_webAccess, &WebAccess::sendProcessedTaskReceived, [&](string taskId) {
+		processedTaskId = taskId;
+		loop.quit();
+	});
+	QTimer::singleShot(5000, &loop, &QEventLoop::quit);
+	_webAccess->sendProcessedTaskDelta("simulation", "token", "task1", &buffer);
+	loop.exec();
+
+	ASSERT_TRUE(processedTaskId);
+	EXPECT_EQ(string("task1"), *processedTaskId);
+	ASSERT_EQ(1, _server.getRequests().size());
+	auto const& request = _server.getRequests().front();
+	EXPECT_EQ(QByteArray("/api/sendprocessedtaskdelta"), request.path);
+	EXPECT_TRUE(request.body.contains("name=\"taskId\""));
+	EXPECT_TRUE(request.body.contains("name=\"delta\""));
+	EXPECT_TRUE(request.body.contains(data));
+}
+
+/**
+* Situation: server fails to receive a delta and the delta is sent again
+* Expected result: failure is signaled and does not block the second request
+*/
+TEST_F(WebAccessTest, testFailedProcessedTaskDeltaCanBeSentAgain)
+{
+	_server.setFailing("/api/sendprocessedtaskdelta");
+	QByteArray data("delta");
+	QBuffer buffer(&data);
+	buffer.open(QIODevice::ReadOnly);
+
+	vector<string> failedTaskIds;
+	QEventLoop loop;
+	QObject::connect(_webAccess, &WebAccess::sendProcessedTaskFailed, [&](string taskId) {
+		failedTaskIds.emplace_back(taskId);
+		loop.quit();
+	});
+	for (int i = 0; i < 2; ++i) {
+		buffer.seek(0);
+		QTimer::singleShot(5000, &loop, &QEventLoop::quit);
+		_webAccess->sendProcessedTaskDelta("simulation", "token", "task1", &buffer);
+		loop.exec();
+	}
+
+	EXPECT_EQ(vector<string>({ "task1", "task1" }), failedTaskIds);
+	EXPECT_EQ(2, _server.getRequests().size());
+}
+
+/**
+* Situation: recorded task list is replayed, images of all tasks are sent concurrently
+* Expected result: every task is acknowledged and uploaded once
+*/
+TEST_F(WebAccessTest, testReplayedTasksAreUploadedConcurrently)
+{
+	QFile file("..\\..\\..\\..\\source\\Tests\\TestData\\unprocessed-tasks.json");
+	ASSERT_TRUE(file.open(QIODevice::ReadOnly));
+	_server.setResponse("/api/getunprocessedtasks", file.readAll());
+
+	vector<Task> tasks;
+	QEventLoop loop;
+	QObject::connect(_webAccess, &WebAccess::unprocessedTasksReceived, [&](vector<Task> receivedTasks) {
+		tasks = receivedTasks;
+		loop.quit();
+	});
+	QTimer::singleShot(5000, &loop, &QEventLoop::quit);
+	_webAccess->requestUnprocessedTasks("simulation", "token");
+	loop.exec();
+	ASSERT_EQ(6, tasks.size());
+	EXPECT_EQ(string("viewer1"), tasks.at(0).viewerId);
+	EXPECT_EQ(tasks.at(5).id, tasks.at(5).viewerId);
+
+	auto const batches = TaskBatcher::createBatches(tasks);
+	EXPECT_EQ(2, batches.size());
+
+	std::map<string, QByteArray> dataByTaskId;
+	std::map<string, boost::shared_ptr<QBuffer>> bufferByTaskId;
+	for (auto const& task : tasks) {
+		QImage image(task.size.x, task.size.y, QImage::Format_RGB32);
+		image.fill(qRgb(0, 0, 27));
+		dataByTaskId[task.id] = TileDeltaEncoder().encode(image).data;
+	}
+	set<string> processedTaskIds;
+	QObject::connect(_webAccess, &WebAccess::sendProcessedTaskReceived, [&](string taskId) {
+		processedTaskIds.insert(taskId);
+		if (processedTaskIds.size() == tasks.size()) {
+			loop.quit();
+		}
+	});
+	for (auto& [taskId, data] : dataByTaskId) {
+		auto buffer = boost::make_shared<QBuffer>(&data);
+		buffer->open(QIODevice::ReadOnly);
+		bufferByTaskId.emplace(taskId, buffer);
+		_webAccess->sendProcessedTaskDelta("simulation", "token", taskId, buffer.get());
+	}
+	QTimer::singleShot(5000, &loop, &QEventLoop::quit);
+	loop.exec();
+
+	EXPECT_EQ(tasks.size(), processedTaskIds.size());
+	auto numUploads = 0;
+	for (auto const& request : _server.getRequests()) {
+		if (request.path == "/api/sendprocessedtaskdelta") {
+			++numUploads;
+		}
+	}
+	EXPECT_EQ(tasks.size(), numUploads);
+}
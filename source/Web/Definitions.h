@@ -6,3 +6,5 @@
 
 class WebAccess;
 class HttpClient;
+class TileDeltaEncoder;
+using TileDeltaEncoderPtr = boost::shared_ptr<TileDeltaEncoder>;
@@ -78,8 +78,10 @@ void HttpClient::finished(QNetworkReply * reply)
             Q_EMIT error(QString("Could not read data from server.").toStdString());
         }
 
+        auto handler = _handlerByReply.at(reply);
         reply->deleteLater();
         cleanupOnExit();
+        Q_EMIT requestFailed(handler);
         return;
     }
     auto data = reply->readAll();
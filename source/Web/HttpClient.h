@@ -17,6 +17,7 @@ public:
     Q_SIGNAL void dataReceived(string handler, QByteArray data);
 
     Q_SIGNAL void error(string message);
+    Q_SIGNAL void requestFailed(string handler);    //emitted for every failed request which is not retried
 
 private:
     Q_SLOT void finished(QNetworkReply* reply);
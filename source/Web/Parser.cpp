@@ -2,6 +2,7 @@
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QString>
+#include <QVariant>
 
 #include "Base/Exceptions.h"
 #include "Parser.h"
@@ -93,6 +94,9 @@ vector<Task> Parser::parseForUnprocessedTasks(QByteArray const & raw)
         }
         auto sizeArray = sizeValue.toArray();
         task.size = { sizeArray.at(0).toInt(), sizeArray.at(1).toInt() };
+
+        auto viewerIdValue = taskObject.value("viewerId");
+        task.viewerId = viewerIdValue.isUndefined() ? task.id : viewerIdValue.toVariant().toString().toStdString();
         result.emplace_back(task);
     }
     return result;
@@ -6,4 +6,5 @@ struct Task {
     string id;
     IntVector2D pos;
     IntVector2D size;
+    string viewerId;    //tasks of the same viewer show consecutive images, equals id if not provided
 };
@@ -0,0 +1,43 @@
+#include "TaskBatcher.h"
+
+namespace
+{
+    bool isOverlapping(IntRect const& rect1, IntRect const& rect2)
+    {
+        return rect1.p1.x < rect2.p2.x && rect2.p1.x < rect1.p2.x && rect1.p1.y < rect2.p2.y
+            && rect2.p1.y < rect1.p2.y;
+    }
+
+    IntRect unite(IntRect const& rect1, IntRect const& rect2)
+    {
+        return IntRect{
+            {std::min(rect1.p1.x, rect2.p1.x), std::min(rect1.p1.y, rect2.p1.y)},
+            {std::max(rect1.p2.x, rect2.p2.x), std::max(rect1.p2.y, rect2.p2.y)}};
+    }
+}
+
+vector<TaskBatch> TaskBatcher::createBatches(vector<Task> const& tasks)
+{
+    vector<TaskBatch> result;
+    for (auto const& task : tasks) {
+        TaskBatch batch{{task.pos, {task.pos.x + task.size.x, task.pos.y + task.size.y}}, {task}};
+
+        //merged rect may overlap further batches
+        bool merged;
+        do {
+            merged = false;
+            for (auto it = result.begin(); it != result.end(); ++it) {
+                if (isOverlapping(it->rect, batch.rect)) {
+                    batch.rect = unite(it->rect, batch.rect);
+                    it->tasks.insert(it->tasks.end(), batch.tasks.begin(), batch.tasks.end());
+                    batch.tasks = std::move(it->tasks);
+                    result.erase(it);
+                    merged = true;
+                    break;
+                }
+            }
+        } while (merged);
+        result.emplace_back(std::move(batch));
+    }
+    return result;
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "Definitions.h"
+#include "Task.h"
+
+struct TaskBatch
+{
+    IntRect rect;
+    vector<Task> tasks;
+};
+
+class WEB_EXPORT TaskBatcher
+{
+public:
+    //tasks with overlapping rects are combined so that the image of their region is requested only once
+    static vector<TaskBatch> createBatches(vector<Task> const& tasks);
+};
@@ -0,0 +1,163 @@
+#include "TileDeltaEncoder.h"
+
+#include <QBuffer>
+#include <QDataStream>
+
+#include "Base/Hashing.h"
+
+namespace
+{
+    quint32 const Magic = 0x414c5444;
+    quint8 const Version = 2;
+}
+
+TileDeltaEncoder::TileDeltaEncoder(int tileSize, int keyframeInterval)
+    : _tileSize(std::max(1, tileSize))
+    , _keyframeInterval(std::max(1, keyframeInterval))
+{}
+
+auto TileDeltaEncoder::encode(QImage const& image) -> Frame
+{
+    IntVector2D const imageSize{image.width(), image.height()};
+    IntVector2D const numTiles{(imageSize.x + _tileSize - 1) / _tileSize, (imageSize.y + _tileSize - 1) / _tileSize};
+
+    Frame result;
+    int baseFrame;
+    vector<uint64_t> baseTileHashes;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        result.id = _nextFrame++;
+        auto const isKeyframe = NoFrame == _baseFrame || imageSize.x != _baseImageSize.x
+            || imageSize.y != _baseImageSize.y || result.id - _lastKeyframe >= _keyframeInterval;
+        if (isKeyframe) {
+            _lastKeyframe = result.id;
+            baseFrame = NoFrame;
+        }
+        else {
+            baseFrame = _baseFrame;
+            baseTileHashes = _baseTileHashes;
+        }
+    }
+
+    //tiles are encoded one after another, images of different viewers are encoded in parallel by the caller
+    auto const rgbImage = image.format() == QImage::Format_RGB32 ? image : image.convertToFormat(QImage::Format_RGB32);
+    vector<uint64_t> tileHashes(numTiles.x * numTiles.y);
+    vector<QByteArray> encodedTiles(tileHashes.size());
+    int numEncodedTiles = 0;
+    for (int index = 0; index < static_cast<int>(tileHashes.size()); ++index) {
+        auto const tileX = index % numTiles.x;
+        auto const tileY = index / numTiles.x;
+        tileHashes[index] = calcTileHash(rgbImage, tileX, tileY);
+        if (NoFrame != baseFrame && tileHashes[index] == baseTileHashes[index]) {
+            continue;
+        }
+        QBuffer buffer(&encodedTiles[index]);
+        buffer.open(QIODevice::WriteOnly);
+        rgbImage.copy(tileX * _tileSize, tileY * _tileSize, _tileSize, _tileSize).save(&buffer, "PNG");
+        ++numEncodedTiles;
+    }
+
+    QDataStream stream(&result.data, QIODevice::WriteOnly);
+    stream << Magic << Version << static_cast<qint32>(result.id) << static_cast<qint32>(baseFrame)
+           << static_cast<qint32>(imageSize.x) << static_cast<qint32>(imageSize.y) << static_cast<qint32>(_tileSize)
+           << static_cast<quint32>(numEncodedTiles);
+    for (int index = 0; index < static_cast<int>(encodedTiles.size()); ++index) {
+        if (!encodedTiles[index].isEmpty()) {
+            stream << static_cast<quint16>(index % numTiles.x) << static_cast<quint16>(index / numTiles.x)
+                   << encodedTiles[index];
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _lastFrame = result.id;
+    _lastImageSize = imageSize;
+    _lastTileHashes = std::move(tileHashes);
+    _numTilesOfLastFrame = numEncodedTiles;
+    return result;
+}
+
+void TileDeltaEncoder::commit(int frameId)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (frameId != _lastFrame) {
+        return;
+    }
+    _baseFrame = _lastFrame;
+    _baseImageSize = _lastImageSize;
+    _baseTileHashes = _lastTileHashes;
+}
+
+void TileDeltaEncoder::reset()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _baseFrame = NoFrame;
+    _baseTileHashes.clear();
+    _lastFrame = NoFrame;
+    _lastTileHashes.clear();
+}
+
+int TileDeltaEncoder::getNumTilesOfLastFrame() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _numTilesOfLastFrame;
+}
+
+bool TileDeltaEncoder::decode(QByteArray const& data, QImage& target, int& targetFrame)
+{
+    QDataStream stream(data);
+    quint32 magic, numTiles;
+    quint8 version;
+    qint32 frame, baseFrame, width, height, tileSize;
+    stream >> magic >> version >> frame >> baseFrame >> width >> height >> tileSize >> numTiles;
+    if (stream.status() != QDataStream::Ok || Magic != magic || Version != version || tileSize <= 0) {
+        return false;
+    }
+    auto const isKeyframe = NoFrame == baseFrame;
+    if (!isKeyframe && baseFrame != targetFrame) {
+        return false;
+    }
+    if (target.width() != width || target.height() != height || target.format() != QImage::Format_RGB32) {
+        if (!isKeyframe) {
+            return false;
+        }
+        target = QImage(width, height, QImage::Format_RGB32);
+    }
+
+    for (quint32 i = 0; i < numTiles; ++i) {
+        quint16 tileX, tileY;
+        QByteArray png;
+        stream >> tileX >> tileY >> png;
+        if (stream.status() != QDataStream::Ok) {
+            return false;
+        }
+        auto const tile = QImage::fromData(png, "PNG").convertToFormat(QImage::Format_RGB32);
+        auto const startX = tileX * tileSize;
+        auto const startY = tileY * tileSize;
+        auto const endX = std::min(startX + tile.width(), width);
+        auto const endY = std::min(startY + tile.height(), height);
+        for (int y = startY; y < endY; ++y) {
+            auto const sourceRow = reinterpret_cast<QRgb const*>(tile.constScanLine(y - startY));
+            auto const targetRow = reinterpret_cast<QRgb*>(target.scanLine(y));
+            std::copy(sourceRow, sourceRow + (endX - startX), targetRow + startX);
+        }
+    }
+    targetFrame = frame;
+    return true;
+}
+
+uint64_t TileDeltaEncoder::calcTileHash(QImage const& image, int tileX, int tileY) const
+{
+    auto const startX = tileX * _tileSize;
+    auto const startY = tileY * _tileSize;
+    auto const endX = std::min(startX + _tileSize, image.width());
+    auto const endY = std::min(startY + _tileSize, image.height());
+
+    auto result = Hashing::FnvOffset;
+    for (int y = startY; y < endY; ++y) {
+        auto const row = reinterpret_cast<QRgb const*>(image.constScanLine(y));
+        for (int x = startX; x < endX; ++x) {
+            result = Hashing::addFnv1a(result, row[x]);
+        }
+    }
+    return result;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <mutex>
+
+#include <QByteArray>
+#include <QImage>
+
+#include "Definitions.h"
+
+/**
+ * Encodes consecutive images of the same viewer as deltas: the image is divided into tiles and only tiles
+ * whose hash differs from the last committed frame are sent as png. A frame should be committed when the
+ * receiver has got it, so that later deltas never refer to a frame which has been lost. Every keyframeInterval
+ * frames all tiles are sent so that receivers can resynchronize.
+ *
+ * Format (QDataStream): magic, version, frame, baseFrame (NoFrame for keyframes), width, height, tileSize,
+ * numTiles, followed by tileX (quint16), tileY (quint16) and png data (QByteArray) for every tile.
+ */
+class WEB_EXPORT TileDeltaEncoder
+{
+public:
+    static constexpr int NoFrame = -1;
+
+    TileDeltaEncoder(int tileSize = 64, int keyframeInterval = 30);
+
+    struct Frame
+    {
+        int id = NoFrame;
+        QByteArray data;
+    };
+    //encoding and committing may be called from different threads
+    Frame encode(QImage const& image);
+    void commit(int frameId);   //only the last encoded frame can be committed
+    void reset();   //next frame will be a keyframe
+
+    int getNumTilesOfLastFrame() const;
+
+    //applies an encoded frame to target which contains targetFrame, returns false if data is invalid or does not
+    //fit to target
+    static bool decode(QByteArray const& data, QImage& target, int& targetFrame);
+
+private:
+    uint64_t calcTileHash(QImage const& image, int tileX, int tileY) const;
+
+    int _tileSize = 64;
+    int _keyframeInterval = 30;
+
+    mutable std::mutex _mutex;
+    int _nextFrame = 0;
+    int _lastKeyframe = NoFrame;
+
+    int _baseFrame = NoFrame;
+    IntVector2D _baseImageSize;
+    vector<uint64_t> _baseTileHashes;
+
+    int _lastFrame = NoFrame;
+    IntVector2D _lastImageSize;
+    vector<uint64_t> _lastTileHashes;
+    int _numTilesOfLastFrame = 0;
+};
@@ -20,6 +20,12 @@ public:
     virtual void requestConnectToSimulation(string const& simulationId, string const& password) = 0;
     virtual void requestUnprocessedTasks(string const& simulationId, string const& token) = 0;
     virtual void sendProcessedTask(string const& simulationId, string const& token, string const& taskId, QBuffer* data) = 0;
+    //data is encoded by TileDeltaEncoder, response is signaled via sendProcessedTaskReceived
+    virtual void sendProcessedTaskDelta(
+        string const& simulationId,
+        string const& token,
+        string const& taskId,
+        QBuffer* data) = 0;
     virtual void requestDisconnect(string const& simulationId, string const& token) = 0;
     virtual void sendStatistics(string const& simulationId, string const& token, map<string, string> monitorData) = 0;
     virtual void sendLastImage(string const& simulationId, string const& token, QBuffer* data) = 0;
@@ -30,7 +36,9 @@ public:
     Q_SIGNAL void connectToSimulationReceived(boost::optional<string> token);
     Q_SIGNAL void unprocessedTasksReceived(vector<Task> tasks);
     Q_SIGNAL void sendProcessedTaskReceived(string taskId);
+    Q_SIGNAL void sendProcessedTaskFailed(string taskId);
     Q_SIGNAL void sendLastImageReceived();
+    Q_SIGNAL void sendLastImageFailed();
     Q_SIGNAL void sendBugReportReceived();
     Q_SIGNAL void error(string message);
 };
\ No newline at end of file
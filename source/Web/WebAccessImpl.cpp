@@ -20,12 +20,18 @@ namespace
     auto const ApiDisconnect = "disconnect"s;
     auto const ApiGetUnprocessedTasks = "getunprocessedtasks"s;
     auto const ApiSendProcessedTask = "sendprocessedtask"s;
+    auto const ApiSendProcessedTaskDelta = "sendprocessedtaskdelta"s;
     auto const ApiSendStatistics = "sendstatistics"s;
     auto const ApiSendLastImage = "sendlastimage"s;
     auto const ApiSendBugReport = "sendbugreport"s;
 }
 
 WebAccessImpl::WebAccessImpl()
+    : WebAccessImpl(ServerAddress)
+{}
+
+WebAccessImpl::WebAccessImpl(string const& serverAddress)
+    : _serverAddress(serverAddress)
 {
     init();
 }
@@ -42,6 +48,7 @@ void WebAccessImpl::init()
 
     _connections.emplace_back(connect(_http, &HttpClient::dataReceived, this, &WebAccessImpl::dataReceived));
     _connections.emplace_back(connect(_http, &HttpClient::error, this, &WebAccess::error));
+    _connections.emplace_back(connect(_http, &HttpClient::requestFailed, this, &WebAccessImpl::requestFailed));
 }
 
 void WebAccessImpl::requestCurrentVersion()
@@ -78,6 +85,22 @@ void WebAccessImpl::sendProcessedTask(
         data);
 }
 
+void WebAccessImpl::sendProcessedTaskDelta(
+    string const& simulationId,
+    string const& token,
+    string const& taskId,
+    QBuffer* data)
+{
+    postImage(
+        ApiSendProcessedTaskDelta,
+        RequestType::ProcessedTask,
+        taskId,
+        {{"simulationId", simulationId}, {"token", token}, {"taskId", taskId}},
+        data,
+        "application/octet-stream",
+        "delta");
+}
+
 void WebAccessImpl::requestDisconnect(std::string const & simulationId, string const& token)
 {
     post(ApiDisconnect, RequestType::Disconnect, {{"simulationId", simulationId}, {"token", token}});
@@ -121,7 +144,7 @@ void WebAccessImpl::dataReceived(string handler, QByteArray data)
     auto requestType = static_cast<RequestType>(handlerParts.first().toUInt());
     auto id = handlerParts.last().toStdString();
 
-    _requesting.erase(requestType);
+    _requestingHandlers.erase(handler);
 
     switch (requestType) {
     case RequestType::SimulationInfo : {
@@ -152,32 +175,51 @@ void WebAccessImpl::dataReceived(string handler, QByteArray data)
     }
 }
 
+void WebAccessImpl::requestFailed(string handler)
+{
+    QStringList const handlerParts = QString::fromStdString(handler).split(QChar(':'));
+    auto requestType = static_cast<RequestType>(handlerParts.first().toUInt());
+    auto id = handlerParts.last().toStdString();
+
+    //request may be sent again
+    _requestingHandlers.erase(handler);
+
+    switch (requestType) {
+    case RequestType::ProcessedTask: {
+        Q_EMIT sendProcessedTaskFailed(id);
+    } break;
+    case RequestType::LastImage: {
+        Q_EMIT sendLastImageFailed();
+    } break;
+    default:
+        break;
+    }
+}
+
 void WebAccessImpl::get(string const& apiMethodName, RequestType requestType, bool omitErrorResponse)
 {
-    if (_requesting.find(requestType) != _requesting.end()) {
+    auto const handler = std::to_string(static_cast<int>(requestType)) + ":";
+    if (!_requestingHandlers.insert(handler).second) {
         return;
     }
-    _requesting.insert(requestType);
 
-    auto const handler = std::to_string(static_cast<int>(requestType)) + ":";
-    _http->get(QUrl(QString::fromStdString(ServerAddress + apiMethodName)), handler, omitErrorResponse);
+    _http->get(QUrl(QString::fromStdString(_serverAddress + apiMethodName)), handler, omitErrorResponse);
 }
 
 void WebAccessImpl::post(string const & apiMethodName, RequestType requestType, std::map<string, string> const& keyValues)
 {
-    if (_requesting.find(requestType) != _requesting.end()) {
+    auto const handler = std::to_string(static_cast<int>(requestType)) + ":";
+    if (!_requestingHandlers.insert(handler).second) {
         return;
     }
-    _requesting.insert(requestType);
 
     QUrlQuery params;
     for (auto const& keyValue : keyValues) {
         params.addQueryItem(QString::fromStdString(keyValue.first), QString::fromStdString(keyValue.second));
     }
 
-    auto const handler = std::to_string(static_cast<int>(requestType)) + ":";
     _http->postText(
-        QUrl(QString::fromStdString(ServerAddress + apiMethodName)),
+        QUrl(QString::fromStdString(_serverAddress + apiMethodName)),
         handler,
         params.query().toUtf8());
 }
@@ -187,13 +229,14 @@ void WebAccessImpl::postImage(
     RequestType requestType, 
     string const& id,
     std::map<string, string> const& keyValues, 
-    QBuffer* data)
+    QBuffer* data,
+    string const& contentType,
+    string const& partName)
 {
-    if (_requesting.find(requestType) != _requesting.end()) {
+    auto const handler = std::to_string(static_cast<int>(requestType)) + ":" + id;
+    if (!_requestingHandlers.insert(handler).second) {
         return;
     }
-    _requesting.insert(requestType);
-
 
     QHttpMultiPart *multiPart = new QHttpMultiPart(QHttpMultiPart::FormDataType);
 
@@ -206,15 +249,16 @@ void WebAccessImpl::postImage(
     }
 
     QHttpPart imagePart;
-    imagePart.setHeader(QNetworkRequest::ContentTypeHeader, QVariant("image/png"));
-    imagePart.setHeader(QNetworkRequest::ContentDispositionHeader, QVariant("form-data; name=\"image\""));
+    imagePart.setHeader(QNetworkRequest::ContentTypeHeader, QVariant(QString::fromStdString(contentType)));
+    imagePart.setHeader(
+        QNetworkRequest::ContentDispositionHeader,
+        QVariant("form-data; name=\"" + QString::fromStdString(partName) + "\""));
     imagePart.setBodyDevice(data);
 
     multiPart->append(imagePart);
 
-    auto const handler = std::to_string(static_cast<int>(requestType)) + ":" + id;
     _http->postBinary(
-        QUrl(QString::fromStdString(ServerAddress + apiMethodName)),
+        QUrl(QString::fromStdString(_serverAddress + apiMethodName)),
         handler,
         multiPart);
 }
@@ -6,6 +6,7 @@ class WebAccessImpl : public WebAccess
 {
 public:
     WebAccessImpl();
+    WebAccessImpl(string const& serverAddress);
     virtual ~WebAccessImpl() = default;
 
     void init() override;
@@ -15,6 +16,8 @@ public:
     void requestConnectToSimulation(string const& simulationId, string const& password) override;
     void requestUnprocessedTasks(string const& simulationId, string const& token) override;
     void sendProcessedTask(string const& simulationId, string const& token, string const& taskId, QBuffer* data) override;
+    void sendProcessedTaskDelta(string const& simulationId, string const& token, string const& taskId, QBuffer* data)
+        override;
     void requestDisconnect(string const& simulationId, string const& token) override;
     void sendStatistics(string const& simulationId, string const& token, map<string, string> monitorData) override;
     void sendLastImage(string const& simulationId, string const& token, QBuffer* data) override;
@@ -22,6 +25,7 @@ public:
 
 private:
     Q_SLOT void dataReceived(string handler, QByteArray data);
+    Q_SLOT void requestFailed(string handler);
 
     enum class RequestType {
         CurrentVersion,
@@ -38,12 +42,14 @@ private:
     void get(string const& apiMethodName, RequestType requestType, bool omitErrorResponse = false);
     void post(string const& apiMethodName, RequestType requestType, std::map<string, string> const& keyValues);
     void postImage(string const& apiMethodName, RequestType requestType, string const& id, 
-        std::map<string, string> const& keyValues, QBuffer* data);
+        std::map<string, string> const& keyValues, QBuffer* data,
+        string const& contentType = "image/png", string const& partName = "image");
 
 private:
 
+    string _serverAddress;
     HttpClient* _http = nullptr;
 
-    set<RequestType> _requesting;
+    set<string> _requestingHandlers;    //requests with different ids (e.g. tasks) may run concurrently
     std::vector<QMetaObject::Connection> _connections;
 };
\ No newline at end of file
@@ -8,5 +8,6 @@ public:
     virtual ~WebBuilderFacade() = default;
 
     virtual WebAccess* buildWebAccess() const = 0;
+    virtual WebAccess* buildWebAccess(string const& serverAddress) const = 0;  //e.g. "http://localhost/api/"
 };
 
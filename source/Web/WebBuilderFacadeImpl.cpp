@@ -5,3 +5,8 @@ WebAccess * WebBuilderFacadeImpl::buildWebAccess() const
 {
     return new WebAccessImpl();
 }
+
+WebAccess* WebBuilderFacadeImpl::buildWebAccess(string const& serverAddress) const
+{
+    return new WebAccessImpl(serverAddress);
+}
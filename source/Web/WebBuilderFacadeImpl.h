@@ -8,5 +8,6 @@ public:
     virtual ~WebBuilderFacadeImpl() = default;
 
     WebAccess* buildWebAccess() const override;
+    WebAccess* buildWebAccess(string const& serverAddress) const override;
 };
 